@@ -1,9 +1,11 @@
 #include "AssetParseThreadWorker.h"
 
 #include "Async/ParallelFor.h"
+#include "Async/TaskGraphInterfaces.h"
 #include "HAL/CriticalSection.h"
 #include "HAL/FileManager.h"
 #include "HAL/PlatformProcess.h"
+#include "HAL/PlatformTime.h"
 #include "HAL/RunnableThread.h"
 #include "IPlatformFilePak.h"
 #include "Launch/Resources/Version.h"
@@ -19,6 +21,7 @@
 
 #include "CommonDefines.h"
 #include "ExtractThreadWorker.h"
+#include "PakAnalyzerTrace.h"
 
 class FAssetParseMemoryReader : public FMemoryReader
 {
@@ -53,6 +56,85 @@ protected:
 	const TArray<FNameEntryId>& NameMap;
 };
 
+/** Serves reads inside a prefetched pak range from memory, everything else goes to the pak file. */
+class FAssetRangeReader : public FArchive
+{
+public:
+	FAssetRangeReader(FArchive& InPakReader, int64 InRangeOffset, const TArray<uint8>& InRangeData)
+		: PakReader(InPakReader)
+		, RangeOffset(InRangeOffset)
+		, RangeData(InRangeData)
+		, Pos(0)
+	{
+		SetIsLoading(true);
+		SetIsPersistent(true);
+	}
+
+	virtual void Serialize(void* Data, int64 Length) override
+	{
+		const int64 RangePos = Pos - RangeOffset;
+		if (RangePos >= 0 && RangePos + Length <= RangeData.Num())
+		{
+			FMemory::Memcpy(Data, RangeData.GetData() + RangePos, Length);
+		}
+		else
+		{
+			PakReader.Seek(Pos);
+			PakReader.Serialize(Data, Length);
+			FPakAnalyzerTrace::CountRead(Length);
+			if (PakReader.IsError())
+			{
+				SetError();
+			}
+		}
+
+		Pos += Length;
+	}
+
+	virtual void Seek(int64 InPos) override { Pos = InPos; }
+	virtual int64 Tell() override { return Pos; }
+	virtual int64 TotalSize() override { return PakReader.TotalSize(); }
+	virtual FString GetArchiveName() const override { return TEXT("FAssetRangeReader"); }
+
+protected:
+	FArchive& PakReader;
+	int64 RangeOffset;
+	const TArray<uint8>& RangeData;
+	int64 Pos;
+};
+
+FAssetReadContext::~FAssetReadContext()
+{
+	if (PakReader)
+	{
+		PakReader->Close();
+		delete PakReader;
+		PakReader = nullptr;
+	}
+
+	FMemory::Free(CopyBuffer);
+	FMemory::Free(CompressionBuffer);
+}
+
+FArchive* FAssetReadContext::GetPakReader(const FString& InPakFilePath, int32 InPakIndex)
+{
+	if (PakReader && PakReaderIndex == InPakIndex)
+	{
+		return PakReader;
+	}
+
+	if (PakReader)
+	{
+		PakReader->Close();
+		delete PakReader;
+	}
+
+	PakReader = IFileManager::Get().CreateFileReader(*InPakFilePath);
+	PakReaderIndex = PakReader ? InPakIndex : INDEX_NONE;
+
+	return PakReader;
+}
+
 template<class T>
 FString FindFullPath(const TArray<T>& InMaps, int32 Index, const FString& InPathSpliter = TEXT("/"))
 {
@@ -90,429 +172,692 @@ bool FAssetParseThreadWorker::Init()
 
 uint32 FAssetParseThreadWorker::Run()
 {
+	PAK_ANALYZER_TRACE_SCOPE(AssetParse_Run);
 	UE_LOG(LogPakAnalyzer, Display, TEXT("Asset parse worker starts."));
 
 	FCriticalSection Mutex;
 	const static bool bForceSingleThread = false;
 	const int32 TotalCount = Files.Num();
-	
+	const int32 ThreadCount = bForceSingleThread ? 1 : FMath::Clamp(FTaskGraphInterface::Get().GetNumWorkerThreads(), 1, FMath::Max(TotalCount, 1));
+
 	TMultiMap<FName, FName> DependsMap;
-	TMap<FName, FName> ClassMap;
+	// Owned by the worker, summaries belong to the game thread as soon as they are published
+	TArray<uint8> ParsedFlags;
+	ParsedFlags.SetNumZeroed(TotalCount);
 
-	// Parse assets
-	ParallelFor(TotalCount, [this, &DependsMap, &ClassMap, &Mutex](int32 InIndex){
-		if (StopTaskCounter.GetValue() > 0)
-		{
-			return;
-		}
+	// Parse assets, every task follows a pak stream front to back and checks the shared priority queue between files.
+	// Results are published in batches, prioritized files are published right away.
+	ParallelFor(ThreadCount, [this, &DependsMap, &ParsedFlags, &Mutex](int32 InTaskIndex){
+		PAK_ANALYZER_TRACE_SCOPE(AssetParse_ParseTask);
 
-		TArray<uint8> FileBuffer;
-		bool SerializeSuccess = false;
+		static const int32 MaxBatchCount = 256;
+		static const double MaxBatchInterval = 0.1;
 
-		FPakFileEntryPtr File = Files[InIndex];
-		if (!Summaries.IsValidIndex(File->OwnerPakIndex) || File->PakEntry.IsDeleteRecord())
-		{
-			return;
-		}
-
-		const FPakFileSumary& Summary = Summaries[File->OwnerPakIndex];
-		const FString PakFilePath = Summary.PakFilePath;
-		const int32 PakVersion = Summary.PakInfo.Version;
-		const FAES::FAESKey AESKey = Summary.DecryptAESKey;
+		FAssetReadContext Context;
+		TArray<uint8> FileBuffer;
+		TArray<FAssetParseResult> Batch;
+		double LastPublishTime = FPlatformTime::Seconds();
 
-		if (OnReadAssetContent.IsBound())
-		{
-			OnReadAssetContent.Execute(File, SerializeSuccess, FileBuffer);
-		}
-		else
+		auto ParseFile = [&](int32 InFileIndex, bool bPrioritized)
 		{
-			FArchive* ReaderArchive = IFileManager::Get().CreateFileReader(*PakFilePath);
-			ReaderArchive->Seek(File->PakEntry.Offset);
+			FPakFileEntryPtr File = Files[InFileIndex];
 
-			FPakEntry EntryInfo;
-			EntryInfo.Serialize(*ReaderArchive, PakVersion);
+			FileBuffer.Reset();
+			if (!ReadAssetContent(File, Context, FileBuffer))
+			{
+				return;
+			}
 
-			if (EntryInfo.IndexDataEquals(File->PakEntry))
+			FAssetParseResult& Result = Batch.AddDefaulted_GetRef();
+			if (!ParseAsset(File, FileBuffer, Result))
 			{
-				FMemoryWriter Writer(FileBuffer, false, true);
+				Batch.Pop(false);
+				return;
+			}
 
-				if (EntryInfo.CompressionMethodIndex == 0)
-				{
-					const int64 BufferSize = 8 * 1024 * 1024; // 8MB buffer for extracting
-					void* Buffer = FMemory::Malloc(BufferSize);
+			ParsedFlags[InFileIndex] = 1;
 
-					if (FExtractThreadWorker::BufferedCopyFile(Writer, *ReaderArchive, File->PakEntry, Buffer, BufferSize, AESKey))
-					{
-						SerializeSuccess = true;
-					}
+			if (Result.bParsedDependency)
+			{
+				FScopeLock ScopeLock(&Mutex);
 
-					FMemory::Free(Buffer);
-				}
-				else
+				for (const FPackageInfo& Dependency : Result.Summary->GetDependencies())
 				{
-					uint8* PersistantCompressionBuffer = NULL;
-					int64 CompressionBufferSize = 0;
-					const bool bHasRelativeCompressedChunkOffsets = PakVersion >= FPakInfo::PakFile_Version_RelativeChunkOffsets;
-
-					if (FExtractThreadWorker::UncompressCopyFile(Writer, *ReaderArchive, File->PakEntry, PersistantCompressionBuffer, CompressionBufferSize, AESKey, File->CompressionMethod, bHasRelativeCompressedChunkOffsets))
-					{
-						SerializeSuccess = true;
-					}
-
-					FMemory::Free(PersistantCompressionBuffer);
+					DependsMap.Add(Dependency.PackageName, File->PackagePath);
 				}
 			}
 
-			ReaderArchive->Close();
-			delete ReaderArchive;
-		}
-
-		if (SerializeSuccess)
-		{
-			if (!File->AssetSummary.IsValid())
-			{
-				File->AssetSummary = MakeShared<FAssetSummary>();
-			}
-			else
+			const double CurrentTime = FPlatformTime::Seconds();
+			if (bPrioritized || Batch.Num() >= MaxBatchCount || CurrentTime - LastPublishTime >= MaxBatchInterval)
 			{
-				File->AssetSummary->Names.Empty();
-				File->AssetSummary->ObjectExports.Empty();
-				File->AssetSummary->ObjectImports.Empty();
+				OnPackagesParsed.ExecuteIfBound(Batch);
+				Batch.Reset();
+				LastPublishTime = CurrentTime;
 			}
-			
-			TArray<FNameEntryId> NameMap;
-			FAssetParseMemoryReader Reader(NameMap, FileBuffer);
+		};
 
-			// Serialize summary
-			Reader << File->AssetSummary->PackageSummary;
+		int32 StreamIndex = ReadStreams.Num() > 0 ? InTaskIndex % ReadStreams.Num() : INDEX_NONE;
+		int32 RangeIndex = INDEX_NONE;
+		int32 FileIndex = INDEX_NONE;
 
-#if ENGINE_MAJOR_VERSION >= 5
-			Reader.Seek(0);
-			int32 Tag = 0;
-			Reader << Tag;
-			if (Tag == PACKAGE_FILE_TAG_SWAPPED)
+		while (StopTaskCounter.GetValue() <= 0 && FetchNextRange(StreamIndex, RangeIndex))
+		{
+			const FAssetReadRange& Range = ReadRanges[RangeIndex];
+			ReadRange(Range, Context);
+
+			for (int32 i = Range.FirstFile; i < Range.FirstFile + Range.NumFiles && StopTaskCounter.GetValue() <= 0; ++i)
 			{
-				if (Reader.ForceByteSwapping())
+				while (FetchPrioritizedFile(FileIndex))
 				{
-					Reader.SetByteSwapping(false);
+					ParseFile(FileIndex, true);
 				}
-				else
+
+				if (ClaimFile(i))
 				{
-					Reader.SetByteSwapping(true);
+					ParseFile(i, false);
 				}
 			}
+		}
 
-			int32 LegacyFileVersion = -8;
-			Reader << LegacyFileVersion;
+		if (Batch.Num() > 0)
+		{
+			OnPackagesParsed.ExecuteIfBound(Batch);
+		}
+	}, bForceSingleThread);
 
-			if (LegacyFileVersion >= -7)
+	// Parse depends, the summaries are published already so only collect the lists here.
+	// The game thread keeps the registry dependents when it has them.
+	DependentTypeArray Dependents;
+	Dependents.SetNum(TotalCount);
+	{
+		PAK_ANALYZER_TRACE_SCOPE(AssetParse_CollectDependents);
+		ParallelFor(TotalCount, [this, &DependsMap, &ParsedFlags, &Dependents](int32 InIndex) {
+			if (StopTaskCounter.GetValue() > 0)
 			{
-				// UE4 pak
-				Reader.SetUEVer(FPackageFileVersion(VER_LATEST_ENGINE_UE4, EUnrealEngineObjectUE5Version::INITIAL_VERSION));
+				return;
 			}
-#endif
 
-			// Serialize Names
-			const int32 NameCount = File->AssetSummary->PackageSummary.NameCount;
-			if (NameCount > 0)
+			if (!ParsedFlags[InIndex])
 			{
-				NameMap.Reserve(NameCount);
+				return;
 			}
 
-			FNameEntrySerialized NameEntry(ENAME_LinkerConstructor);
-			Reader.Seek(File->AssetSummary->PackageSummary.NameOffset);
-
-			for (int32 i = 0; i < NameCount; ++i)
+			TArray<FName> Assets;
+			DependsMap.MultiFind(Files[InIndex]->PackagePath, Assets);
+			if (Assets.Num() <= 0)
 			{
-				Reader << NameEntry;
-				NameMap.Emplace(FName(NameEntry).GetDisplayIndex());
-
-				if (NameEntry.bIsWide)
-				{
-					File->AssetSummary->Names.Add(MakeShared<FName>(NameEntry.WideName));
-				}
-				else
-				{
-					File->AssetSummary->Names.Add(MakeShared<FName>(NameEntry.AnsiName));
-				}
+				return;
 			}
-			File->AssetSummary->Names.Shrink();
 
-			// Serialize Export Table
-			TArray<FObjectExport> Exports;
-			Exports.AddZeroed(File->AssetSummary->PackageSummary.ExportCount);
-			Reader.Seek(File->AssetSummary->PackageSummary.ExportOffset);
-			for (int32 i = 0; i < File->AssetSummary->PackageSummary.ExportCount; ++i)
+			Dependents[InIndex].Key = Files[InIndex];
+			TArray<FPackageInfo>& DependentList = Dependents[InIndex].Value;
+			DependentList.Reserve(Assets.Num());
+			for (const FName& Asset : Assets)
 			{
-				Reader << Exports[i];
-
-				FObjectExportPtrType ExportEx = MakeShared<FObjectExportEx>();
-				ExportEx->Index = i;
-				ExportEx->ObjectName = Exports[i].ObjectName;
-				ExportEx->SerialSize = Exports[i].SerialSize;
-				ExportEx->SerialOffset = Exports[i].SerialOffset;
-				ExportEx->bIsAsset = Exports[i].bIsAsset;
-				ExportEx->bNotForClient = Exports[i].bNotForClient;
-				ExportEx->bNotForServer = Exports[i].bNotForServer;
-
-				File->AssetSummary->ObjectExports.Add(ExportEx);
+				DependentList.Emplace(Asset);
 			}
-			File->AssetSummary->ObjectExports.Shrink();
+		}, bForceSingleThread);
+	}
 
-			// Serialize Import Table
-			TArray<FObjectImport> Imports;
-			Imports.AddZeroed(File->AssetSummary->PackageSummary.ImportCount);
-			Reader.Seek(File->AssetSummary->PackageSummary.ImportOffset);
-			for (int32 i = 0; i < File->AssetSummary->PackageSummary.ImportCount; ++i)
-			{
-				Reader << Imports[i];
+	Dependents.RemoveAll([](const TPair<FPakFileEntryPtr, TArray<FPackageInfo>>& InPair) { return !InPair.Key.IsValid(); });
 
-				FObjectImportPtrType ImportEx = MakeShared<FObjectImportEx>();
-				ImportEx->Index = i;
-				ImportEx->ObjectName = Imports[i].ObjectName;
-				ImportEx->ClassPackage = Imports[i].ClassPackage;
-				ImportEx->ClassName = Imports[i].ClassName;
+	OnParseFinish.ExecuteIfBound(StopTaskCounter.GetValue() > 0, Dependents);
 
-				File->AssetSummary->ObjectImports.Add(ImportEx);
-			}
-			File->AssetSummary->ObjectImports.Shrink();
+	StopTaskCounter.Reset();
 
-			FName MainObjectName = *FPaths::GetBaseFilename(File->Filename.ToString());
-			FName MainClassObjectName = *FString::Printf(TEXT("%s_C"), *MainObjectName.ToString());
-			FName MainObjectClassName = NAME_None;
-			FName MainClassObjectClassName = NAME_None;
-			FName AssetClass = NAME_None;
+	UE_LOG(LogPakAnalyzer, Display, TEXT("Asset parse worker exits."));
 
-			// Parse Export Object Path
-			for (int32 i = 0; i < File->AssetSummary->ObjectExports.Num(); ++i)
-			{
-				const FObjectExport& Export = Exports[i];
-				FObjectExportPtrType& ExportEx = File->AssetSummary->ObjectExports[i];
-				ExportEx->ObjectPath = *FindFullPath(Exports, i, TEXT("."));
+	return 0;
+}
+
+void FAssetParseThreadWorker::Stop()
+{
+	StopTaskCounter.Increment();
+	EnsureCompletion();
+	StopTaskCounter.Reset();
+}
 
-				ParseObjectName(Imports, Exports, Export.ClassIndex, ExportEx->ClassName);
-				ParseObjectName(Imports, Exports, Export.TemplateIndex, ExportEx->TemplateObject);
-				ParseObjectName(Imports, Exports, Export.SuperIndex, ExportEx->Super);
+void FAssetParseThreadWorker::Exit()
+{
 
-				FName ObjectName = *FPaths::GetBaseFilename(ExportEx->ObjectName.ToString());
-				if (ObjectName == MainObjectName)
-				{
-					MainObjectClassName = ExportEx->ClassName;
-				}
-				else if (ObjectName == MainClassObjectName)
-				{
-					MainClassObjectClassName = ExportEx->ClassName;
-				}
+}
 
-				if (ExportEx->bIsAsset)
-				{
-					AssetClass = ExportEx->ClassName;
-				}
-			}
+void FAssetParseThreadWorker::Shutdown()
+{
+	Stop();
+
+	if (Thread)
+	{
+		UE_LOG(LogPakAnalyzer, Log, TEXT("Shutdown asset parse worker."));
 
-			if (MainObjectClassName == NAME_None && MainClassObjectClassName == NAME_None)
+		delete Thread;
+		Thread = nullptr;
+	}
+}
+
+void FAssetParseThreadWorker::EnsureCompletion()
+{
+	if (Thread)
+	{
+		Thread->WaitForCompletion();
+	}
+}
+
+void FAssetParseThreadWorker::StartParse(TArray<FPakFileEntryPtr>& InFiles, TArray<FPakFileSumary>& InSummaries)
+{
+	Shutdown();
+
+	UE_LOG(LogPakAnalyzer, Log, TEXT("Start asset parse worker, file count: %d."), InFiles.Num());
+
+	Files = MoveTemp(InFiles);
+	Summaries = MoveTemp(InSummaries);
+
+	// Read every pak front to back
+	Files.Sort([](const FPakFileEntryPtr& A, const FPakFileEntryPtr& B) -> bool
+		{
+			if (A->OwnerPakIndex != B->OwnerPakIndex)
 			{
-				if (File->AssetSummary->ObjectExports.Num() == 1)
-				{
-					MainObjectClassName = File->AssetSummary->ObjectExports[0]->ClassName;
-				}
-				else if (!AssetClass.IsNone())
-				{
-					MainObjectClassName = AssetClass;
-				}
+				return A->OwnerPakIndex < B->OwnerPakIndex;
 			}
 
-			if (MainObjectClassName != NAME_None || MainClassObjectClassName != NAME_None)
+			return A->PakEntry.Offset < B->PakEntry.Offset;
+		});
+
+	BuildReadStreams();
+
+	FileIndexMap.Empty(Files.Num());
+	for (int32 i = 0; i < Files.Num(); ++i)
+	{
+		FileIndexMap.Add(Files[i].Get(), i);
+	}
+
+	FileStates.Reset();
+	FileStates.AddZeroed(Files.Num());
+	PriorityQueue.Empty();
+
+	Thread = FRunnableThread::Create(this, TEXT("AssetParseThreadWorker"), 0, EThreadPriority::TPri_Highest);
+}
+
+void FAssetParseThreadWorker::Prioritize(const TArray<FPakFileEntryPtr>& InFiles)
+{
+	if (!Thread)
+	{
+		return;
+	}
+
+	FScopeLock Lock(&QueueCriticalSection);
+
+	// Queue is consumed from the back, so push in reverse to keep the given order
+	for (int32 i = InFiles.Num() - 1; i >= 0; --i)
+	{
+		const int32* FileIndex = InFiles[i].IsValid() ? FileIndexMap.Find(InFiles[i].Get()) : nullptr;
+		if (FileIndex && FileStates[*FileIndex] == 0)
+		{
+			PriorityQueue.Add(*FileIndex);
+		}
+	}
+}
+
+void FAssetParseThreadWorker::BuildReadStreams()
+{
+	// Entries closer than this are read together, skipping a small gap is cheaper than a seek
+	static const int64 MaxRangeGap = 64 * 1024;
+	static const int64 MaxRangeSize = 4 * 1024 * 1024;
+
+	PAK_ANALYZER_TRACE_SCOPE(AssetParse_BuildReadStreams);
+
+	ReadRanges.Empty();
+	ReadStreams.Empty();
+
+	// Loose files are read through the delegate, there is nothing to coalesce
+	const bool bCanCoalesce = !OnReadAssetContent.IsBound();
+
+	for (int32 i = 0; i < Files.Num(); ++i)
+	{
+		const FPakFileEntryPtr& File = Files[i];
+		const FPakEntry& Entry = File->PakEntry;
+		const int32 PakVersion = Summaries.IsValidIndex(File->OwnerPakIndex) ? Summaries[File->OwnerPakIndex].PakInfo.Version : FPakInfo::PakFile_Version_Latest;
+
+		// Estimated on disk size, reads past the range fall back to the pak file
+		const int64 EntrySize = Entry.GetSerializedSize(PakVersion) + (Entry.IsEncrypted() ? Align(Entry.Size, FAES::AESBlockSize) : Entry.Size);
+
+		FAssetReadRange* LastRange = ReadRanges.Num() > 0 ? &ReadRanges.Last() : nullptr;
+		const bool bSamePak = LastRange && LastRange->PakIndex == File->OwnerPakIndex;
+		if (bCanCoalesce && bSamePak && Entry.Offset >= LastRange->Offset + LastRange->Size
+			&& Entry.Offset - (LastRange->Offset + LastRange->Size) <= MaxRangeGap
+			&& Entry.Offset + EntrySize - LastRange->Offset <= MaxRangeSize)
+		{
+			LastRange->NumFiles++;
+			LastRange->Size = Entry.Offset + EntrySize - LastRange->Offset;
+			continue;
+		}
+
+		if (!bSamePak)
+		{
+			FAssetReadStream& Stream = ReadStreams.AddDefaulted_GetRef();
+			Stream.FirstRange = ReadRanges.Num();
+		}
+
+		FAssetReadRange& Range = ReadRanges.AddDefaulted_GetRef();
+		Range.PakIndex = File->OwnerPakIndex;
+		Range.FirstFile = i;
+		Range.NumFiles = 1;
+		Range.Offset = Entry.Offset;
+		Range.Size = EntrySize;
+
+		ReadStreams.Last().NumRanges++;
+	}
+
+	UE_LOG(LogPakAnalyzer, Log, TEXT("Asset parse worker reads %d files in %d ranges from %d streams."), Files.Num(), ReadRanges.Num(), ReadStreams.Num());
+}
+
+bool FAssetParseThreadWorker::FetchPrioritizedFile(int32& OutIndex)
+{
+	FScopeLock Lock(&QueueCriticalSection);
+
+	while (PriorityQueue.Num() > 0)
+	{
+		const int32 FileIndex = PriorityQueue.Pop(false);
+		if (ClaimFile(FileIndex))
+		{
+			OutIndex = FileIndex;
+			return true;
+		}
+	}
+
+	return false;
+}
+
+bool FAssetParseThreadWorker::FetchNextRange(int32& InOutStreamIndex, int32& OutRangeIndex)
+{
+	while (ReadStreams.IsValidIndex(InOutStreamIndex))
+	{
+		FAssetReadStream& Stream = ReadStreams[InOutStreamIndex];
+		const int32 NextRange = FPlatformAtomics::InterlockedIncrement(&Stream.NextRange) - 1;
+		if (NextRange < Stream.NumRanges)
+		{
+			OutRangeIndex = Stream.FirstRange + NextRange;
+			return true;
+		}
+
+		// Current stream is drained, help the one with the most work left
+		InOutStreamIndex = INDEX_NONE;
+		int32 MaxRemaining = 0;
+		for (int32 i = 0; i < ReadStreams.Num(); ++i)
+		{
+			const int32 Remaining = ReadStreams[i].NumRanges - FPlatformAtomics::AtomicRead(&ReadStreams[i].NextRange);
+			if (Remaining > MaxRemaining)
 			{
-				FScopeLock ScopeLock(&Mutex);
-				ClassMap.Add(File->PackagePath, MainObjectClassName != NAME_None ? MainObjectClassName : MainClassObjectClassName);
+				MaxRemaining = Remaining;
+				InOutStreamIndex = i;
 			}
+		}
+	}
 
-			const bool bFillDependency = File->AssetSummary->DependencyList.Num() <= 0;
-			for (int32 i = 0; i < File->AssetSummary->ObjectImports.Num(); ++i)
-			{
-				const FObjectImport& Import = Imports[i];
-				FObjectImportPtrType& ImportEx = File->AssetSummary->ObjectImports[i];
+	return false;
+}
 
-				ImportEx->ObjectPath = *FindFullPath(Imports, i);
+bool FAssetParseThreadWorker::ClaimFile(int32 InIndex)
+{
+	return FPlatformAtomics::InterlockedCompareExchange(&FileStates[InIndex], 1, 0) == 0;
+}
 
-				if (bFillDependency && Import.ClassName == "Package" && !ImportEx->ObjectPath.ToString().StartsWith(TEXT("/Script")))
-				{
-					FPackageInfoPtr Depends = MakeShared<FPackageInfo>();
-					Depends->PackageName = ImportEx->ObjectPath;
-					File->AssetSummary->DependencyList.Add(Depends);
+bool FAssetParseThreadWorker::ReadRange(const FAssetReadRange& InRange, FAssetReadContext& InContext)
+{
+	PAK_ANALYZER_TRACE_SCOPE(AssetParse_ReadRange);
 
-					FScopeLock ScopeLock(&Mutex);
-					DependsMap.Add(ImportEx->ObjectPath, File->PackagePath);
-				}
-			}
-			File->AssetSummary->DependencyList.Shrink();
+	InContext.RangeData.Reset();
+	InContext.RangePakIndex = INDEX_NONE;
 
-			// Serialize Preload Dependency
-			TArray<FPackageIndex> PreloadDependencies;
-			if (File->AssetSummary->PackageSummary.PreloadDependencyCount > 0)
-			{
-				PreloadDependencies.AddZeroed(File->AssetSummary->PackageSummary.PreloadDependencyCount);
-				Reader.Seek(File->AssetSummary->PackageSummary.PreloadDependencyOffset);
-				for (int32 i = 0; i < File->AssetSummary->PackageSummary.PreloadDependencyCount; ++i)
-				{
-					Reader << PreloadDependencies[i];
-				}
+	// A single entry is read straight into its own buffer
+	if (InRange.NumFiles <= 1 || OnReadAssetContent.IsBound() || !Summaries.IsValidIndex(InRange.PakIndex))
+	{
+		return false;
+	}
 
-				// Parse Preload Dependency
-				for (int32 i = 0; i < File->AssetSummary->ObjectExports.Num(); ++i)
-				{
-					const FObjectExport& Export = Exports[i];
-					FObjectExportPtrType& ExportEx = File->AssetSummary->ObjectExports[i];
+	FArchive* PakReader = InContext.GetPakReader(Summaries[InRange.PakIndex].PakFilePath, InRange.PakIndex);
+	if (!PakReader)
+	{
+		return false;
+	}
 
-					if (Export.FirstExportDependency >= 0)
-					{
-						FName ObjectName;
-						int32 RunningIndex = Export.FirstExportDependency;
-						for (int32 Index = Export.SerializationBeforeSerializationDependencies; Index > 0; Index--)
-						{
-							FPackageIndex Dep = PreloadDependencies[RunningIndex++];
+	const int64 Size = FMath::Min(InRange.Size, PakReader->TotalSize() - InRange.Offset);
+	if (Size <= 0)
+	{
+		return false;
+	}
 
-							if (ParseObjectPath(File->AssetSummary, Dep, ObjectName))
-							{
-								FPackageInfoPtr Depends = MakeShared<FPackageInfo>();
-								Depends->PackageName = ObjectName;
-								Depends->ExtraInfo = TEXT("Serialization Before Serialization");
+	InContext.RangeData.SetNumUninitialized(Size);
+	PakReader->Seek(InRange.Offset);
+	PakReader->Serialize(InContext.RangeData.GetData(), Size);
+	FPakAnalyzerTrace::CountRead(Size);
 
-								ExportEx->DependencyList.Add(Depends);
-							}
-						}
+	if (PakReader->IsError())
+	{
+		PakReader->ClearError();
+		InContext.RangeData.Reset();
+		return false;
+	}
 
-						for (int32 Index = Export.CreateBeforeSerializationDependencies; Index > 0; Index--)
-						{
-							FPackageIndex Dep = PreloadDependencies[RunningIndex++];
+	InContext.RangePakIndex = InRange.PakIndex;
+	InContext.RangeOffset = InRange.Offset;
 
-							if (ParseObjectPath(File->AssetSummary, Dep, ObjectName))
-							{
-								FPackageInfoPtr Depends = MakeShared<FPackageInfo>();
-								Depends->PackageName = ObjectName;
-								Depends->ExtraInfo = TEXT("Create Before Serialization");
+	return true;
+}
 
-								ExportEx->DependencyList.Add(Depends);
-							}
-						}
+bool FAssetParseThreadWorker::ReadAssetContent(FPakFileEntryPtr InFile, FAssetReadContext& InContext, TArray<uint8>& OutContent)
+{
+	if (!Summaries.IsValidIndex(InFile->OwnerPakIndex) || InFile->PakEntry.IsDeleteRecord())
+	{
+		return false;
+	}
 
-						for (int32 Index = Export.SerializationBeforeCreateDependencies; Index > 0; Index--)
-						{
-							FPackageIndex Dep = PreloadDependencies[RunningIndex++];
+	bool SerializeSuccess = false;
+	if (OnReadAssetContent.IsBound())
+	{
+		OnReadAssetContent.Execute(InFile, SerializeSuccess, OutContent);
+		FPakAnalyzerTrace::CountRead(OutContent.Num());
+		return SerializeSuccess;
+	}
 
-							if (ParseObjectPath(File->AssetSummary, Dep, ObjectName))
-							{
-								FPackageInfoPtr Depends = MakeShared<FPackageInfo>();
-								Depends->PackageName = ObjectName;
-								Depends->ExtraInfo = TEXT("Serialization Before Create");
+	const FPakFileSumary& Summary = Summaries[InFile->OwnerPakIndex];
+	const int32 PakVersion = Summary.PakInfo.Version;
 
-								ExportEx->DependencyList.Add(Depends);
-							}
-						}
+	FArchive* PakReader = InContext.GetPakReader(Summary.PakFilePath, InFile->OwnerPakIndex);
+	if (!PakReader)
+	{
+		return false;
+	}
 
-						for (int32 Index = Export.CreateBeforeCreateDependencies; Index > 0; Index--)
-						{
-							FPackageIndex Dep = PreloadDependencies[RunningIndex++];
+	static const TArray<uint8> EmptyRange;
+	const bool bInRange = InContext.RangePakIndex == InFile->OwnerPakIndex;
+	FAssetRangeReader ReaderArchive(*PakReader, InContext.RangeOffset, bInRange ? InContext.RangeData : EmptyRange);
+	ReaderArchive.Seek(InFile->PakEntry.Offset);
 
-							if (ParseObjectPath(File->AssetSummary, Dep, ObjectName))
-							{
-								FPackageInfoPtr Depends = MakeShared<FPackageInfo>();
-								Depends->PackageName = ObjectName;
-								Depends->ExtraInfo = TEXT("Create Before Create");
+	FPakEntry EntryInfo;
+	EntryInfo.Serialize(ReaderArchive, PakVersion);
 
-								ExportEx->DependencyList.Add(Depends);
-							}
-						}
+	if (EntryInfo.IndexDataEquals(InFile->PakEntry))
+	{
+		FMemoryWriter Writer(OutContent, false, true);
 
-						ExportEx->DependencyList.Shrink();
-					}
-				}
+		if (EntryInfo.CompressionMethodIndex == 0)
+		{
+			const int64 BufferSize = 8 * 1024 * 1024; // 8MB buffer for extracting
+			if (!InContext.CopyBuffer)
+			{
+				InContext.CopyBuffer = FMemory::Malloc(BufferSize);
 			}
+
+			SerializeSuccess = FExtractThreadWorker::BufferedCopyFile(Writer, ReaderArchive, InFile->PakEntry, InContext.CopyBuffer, BufferSize, Summary.DecryptAESKey);
 		}
-	}, bForceSingleThread);
+		else
+		{
+			const bool bHasRelativeCompressedChunkOffsets = PakVersion >= FPakInfo::PakFile_Version_RelativeChunkOffsets;
+			SerializeSuccess = FExtractThreadWorker::UncompressCopyFile(Writer, ReaderArchive, InFile->PakEntry, InContext.CompressionBuffer, InContext.CompressionBufferSize, Summary.DecryptAESKey, InFile->CompressionMethod, bHasRelativeCompressedChunkOffsets);
+		}
+	}
+
+	if (PakReader->IsError())
+	{
+		PakReader->ClearError();
+	}
 
-	// Parse depends
-	ParallelFor(TotalCount, [this, &DependsMap](int32 InIndex) {
-		if (StopTaskCounter.GetValue() > 0)
+	return SerializeSuccess;
+}
+
+bool FAssetParseThreadWorker::ParseAsset(FPakFileEntryPtr InFile, const TArray<uint8>& InContent, FAssetParseResult& OutResult)
+{
+	// Parse into a fresh summary so the flat arrays are allocated exactly once.
+	// Published summaries belong to the game thread, registry edges are merged there.
+	FAssetSummaryPtr AssetSummary = MakeShared<FAssetSummary>();
+
+	TArray<FNameEntryId> NameMap;
+	FAssetParseMemoryReader Reader(NameMap, InContent);
+
+	{
+		PAK_ANALYZER_TRACE_SCOPE(AssetParse_Summary);
+
+		// Serialize summary
+		Reader << AssetSummary->PackageSummary;
+
+#if ENGINE_MAJOR_VERSION >= 5
+		Reader.Seek(0);
+		int32 Tag = 0;
+		Reader << Tag;
+		if (Tag == PACKAGE_FILE_TAG_SWAPPED)
 		{
-			return;
+			if (Reader.ForceByteSwapping())
+			{
+				Reader.SetByteSwapping(false);
+			}
+			else
+			{
+				Reader.SetByteSwapping(true);
+			}
 		}
 
-		FPakFileEntryPtr File = Files[InIndex];
-		if (!File->AssetSummary.IsValid())
+		int32 LegacyFileVersion = -8;
+		Reader << LegacyFileVersion;
+
+		if (LegacyFileVersion >= -7)
 		{
-			return;
+			// UE4 pak
+			Reader.SetUEVer(FPackageFileVersion(VER_LATEST_ENGINE_UE4, EUnrealEngineObjectUE5Version::INITIAL_VERSION));
 		}
-		if (File->AssetSummary->DependentList.Num() > 0)
+#endif
+	}
+
+	{
+		PAK_ANALYZER_TRACE_SCOPE(AssetParse_NameMap);
+
+		// Serialize Names
+		const int32 NameCount = AssetSummary->PackageSummary.NameCount;
+		if (NameCount > 0)
 		{
-			return;
+			NameMap.Reserve(NameCount);
+			AssetSummary->Names.Reserve(NameCount);
 		}
 
-		TArray<FName> Assets;
-		DependsMap.MultiFind(File->PackagePath, Assets);
+		FNameEntrySerialized NameEntry(ENAME_LinkerConstructor);
+		Reader.Seek(AssetSummary->PackageSummary.NameOffset);
 
-		for (const FName& Asset : Assets)
+		for (int32 i = 0; i < NameCount; ++i)
 		{
-			FPackageInfoPtr Depends = MakeShared<FPackageInfo>();
-			Depends->PackageName = Asset;
-			File->AssetSummary->DependentList.Add(Depends);
+			Reader << NameEntry;
+			NameMap.Emplace(FName(NameEntry).GetDisplayIndex());
+
+			if (NameEntry.bIsWide)
+			{
+				AssetSummary->Names.Emplace(NameEntry.WideName);
+			}
+			else
+			{
+				AssetSummary->Names.Emplace(NameEntry.AnsiName);
+			}
 		}
-		File->AssetSummary->DependentList.Shrink();
-	}, bForceSingleThread);
+	}
 
-	OnParseFinish.ExecuteIfBound(StopTaskCounter.GetValue() > 0, ClassMap);
+	const int32 ExportCount = FMath::Max(AssetSummary->PackageSummary.ExportCount, 0);
+	FObjectExportTable& ExportTable = AssetSummary->ObjectExports;
+	TArray<FObjectExport> Exports;
 
-	StopTaskCounter.Reset();
+	{
+		PAK_ANALYZER_TRACE_SCOPE(AssetParse_ExportTable);
 
-	UE_LOG(LogPakAnalyzer, Display, TEXT("Asset parse worker exits."));
+		// Serialize Export Table
+		ExportTable.SetNum(ExportCount);
+		Exports.AddZeroed(ExportCount);
+		Reader.Seek(AssetSummary->PackageSummary.ExportOffset);
+		for (int32 i = 0; i < ExportCount; ++i)
+		{
+			Reader << Exports[i];
 
-	return 0;
-}
+			ExportTable.ObjectNames[i] = Exports[i].ObjectName;
+			ExportTable.SerialSizes[i] = Exports[i].SerialSize;
+			ExportTable.SerialOffsets[i] = Exports[i].SerialOffset;
 
-void FAssetParseThreadWorker::Stop()
-{
-	StopTaskCounter.Increment();
-	EnsureCompletion();
-	StopTaskCounter.Reset();
-}
+			EObjectExportFlags& Flags = ExportTable.Flags[i];
+			Flags |= Exports[i].bIsAsset ? EObjectExportFlags::IsAsset : EObjectExportFlags::None;
+			Flags |= Exports[i].bNotForClient ? EObjectExportFlags::NotForClient : EObjectExportFlags::None;
+			Flags |= Exports[i].bNotForServer ? EObjectExportFlags::NotForServer : EObjectExportFlags::None;
+		}
+	}
 
-void FAssetParseThreadWorker::Exit()
-{
+	const int32 ImportCount = FMath::Max(AssetSummary->PackageSummary.ImportCount, 0);
+	TArray<FObjectImport> Imports;
 
-}
+	{
+		PAK_ANALYZER_TRACE_SCOPE(AssetParse_ImportTable);
 
-void FAssetParseThreadWorker::Shutdown()
-{
-	Stop();
+		// Serialize Import Table
+		AssetSummary->ObjectImports.SetNum(ImportCount);
+		Imports.AddZeroed(ImportCount);
+		Reader.Seek(AssetSummary->PackageSummary.ImportOffset);
+		for (int32 i = 0; i < ImportCount; ++i)
+		{
+			Reader << Imports[i];
+
+			FObjectImportEx& ImportEx = AssetSummary->ObjectImports[i];
+			ImportEx.ObjectName = Imports[i].ObjectName;
+			ImportEx.ClassPackage = Imports[i].ClassPackage;
+			ImportEx.ClassName = Imports[i].ClassName;
+		}
+	}
 
-	if (Thread)
 	{
-		UE_LOG(LogPakAnalyzer, Log, TEXT("Shutdown asset parse worker."));
+		PAK_ANALYZER_TRACE_SCOPE(AssetParse_ExportPaths);
 
-		delete Thread;
-		Thread = nullptr;
+		FName MainObjectName = *FPaths::GetBaseFilename(InFile->Filename.ToString());
+		FName MainClassObjectName = *FString::Printf(TEXT("%s_C"), *MainObjectName.ToString());
+		FName MainObjectClassName = NAME_None;
+		FName MainClassObjectClassName = NAME_None;
+		FName AssetClass = NAME_None;
+
+		// Parse Export Object Path
+		for (int32 i = 0; i < ExportCount; ++i)
+		{
+			const FObjectExport& Export = Exports[i];
+			ExportTable.ObjectPaths[i] = *FindFullPath(Exports, i, TEXT("."));
+
+			ParseObjectName(Imports, Exports, Export.ClassIndex, ExportTable.ClassNames[i]);
+			ParseObjectName(Imports, Exports, Export.TemplateIndex, ExportTable.TemplateObjects[i]);
+			ParseObjectName(Imports, Exports, Export.SuperIndex, ExportTable.Supers[i]);
+
+			FName ObjectName = *FPaths::GetBaseFilename(ExportTable.ObjectNames[i].ToString());
+			if (ObjectName == MainObjectName)
+			{
+				MainObjectClassName = ExportTable.ClassNames[i];
+			}
+			else if (ObjectName == MainClassObjectName)
+			{
+				MainClassObjectClassName = ExportTable.ClassNames[i];
+			}
+
+			if (ExportTable.HasFlag(i, EObjectExportFlags::IsAsset))
+			{
+				AssetClass = ExportTable.ClassNames[i];
+			}
+		}
+
+		if (MainObjectClassName == NAME_None && MainClassObjectClassName == NAME_None)
+		{
+			if (ExportCount == 1)
+			{
+				MainObjectClassName = ExportTable.ClassNames[0];
+			}
+			else if (!AssetClass.IsNone())
+			{
+				MainObjectClassName = AssetClass;
+			}
+		}
+
+		OutResult.ClassName = MainObjectClassName != NAME_None ? MainObjectClassName : MainClassObjectClassName;
 	}
-}
 
-void FAssetParseThreadWorker::EnsureCompletion()
-{
-	if (Thread)
 	{
-		Thread->WaitForCompletion();
+		PAK_ANALYZER_TRACE_SCOPE(AssetParse_Dependencies);
+
+		TArray<FPackageInfo> Dependencies;
+		for (int32 i = 0; i < ImportCount; ++i)
+		{
+			const FObjectImport& Import = Imports[i];
+			FObjectImportEx& ImportEx = AssetSummary->ObjectImports[i];
+
+			ImportEx.ObjectPath = *FindFullPath(Imports, i);
+
+			if (Import.ClassName == NAME_Package && !ImportEx.ObjectPath.ToString().StartsWith(TEXT("/Script")))
+			{
+				Dependencies.Emplace(ImportEx.ObjectPath);
+			}
+		}
+
+		AssetSummary->SetDependencies(Dependencies);
+		OutResult.bParsedDependency = true;
 	}
-}
 
-void FAssetParseThreadWorker::StartParse(TArray<FPakFileEntryPtr>& InFiles, TArray<FPakFileSumary>& InSummaries)
-{
-	Shutdown();
+	{
+		PAK_ANALYZER_TRACE_SCOPE(AssetParse_PreloadDependencies);
 
-	UE_LOG(LogPakAnalyzer, Log, TEXT("Start asset parse worker, file count: %d."), InFiles.Num());
+		// Serialize Preload Dependency
+		TArray<FPackageIndex> PreloadDependencies;
+		if (AssetSummary->PackageSummary.PreloadDependencyCount > 0)
+		{
+			PreloadDependencies.AddZeroed(AssetSummary->PackageSummary.PreloadDependencyCount);
+			Reader.Seek(AssetSummary->PackageSummary.PreloadDependencyOffset);
+			for (int32 i = 0; i < AssetSummary->PackageSummary.PreloadDependencyCount; ++i)
+			{
+				Reader << PreloadDependencies[i];
+			}
 
-	Files = MoveTemp(InFiles);
-	Summaries = MoveTemp(InSummaries);
+			static const FName SerializationBeforeSerializationName(TEXT("Serialization Before Serialization"));
+			static const FName CreateBeforeSerializationName(TEXT("Create Before Serialization"));
+			static const FName SerializationBeforeCreateName(TEXT("Serialization Before Create"));
+			static const FName CreateBeforeCreateName(TEXT("Create Before Create"));
 
-	Thread = FRunnableThread::Create(this, TEXT("AssetParseThreadWorker"), 0, EThreadPriority::TPri_Highest);
+			// Parse Preload Dependency, the edges of every export are appended to the shared pool
+			for (int32 i = 0; i < ExportCount; ++i)
+			{
+				const FObjectExport& Export = Exports[i];
+				if (Export.FirstExportDependency < 0)
+				{
+					continue;
+				}
+
+				FPackageInfoSpan& Span = ExportTable.DependencySpans[i];
+				Span.Start = AssetSummary->PackageEdges.Num();
+
+				FName ObjectName;
+				int32 RunningIndex = Export.FirstExportDependency;
+				auto AppendPreloadDependencies = [&](int32 InCount, FName InExtraInfo)
+				{
+					for (int32 Index = InCount; Index > 0; Index--)
+					{
+						FPackageIndex Dep = PreloadDependencies[RunningIndex++];
+
+						if (ParseObjectPath(*AssetSummary, Dep, ObjectName))
+						{
+							AssetSummary->PackageEdges.Emplace(ObjectName, InExtraInfo);
+						}
+					}
+				};
+
+				AppendPreloadDependencies(Export.SerializationBeforeSerializationDependencies, SerializationBeforeSerializationName);
+				AppendPreloadDependencies(Export.CreateBeforeSerializationDependencies, CreateBeforeSerializationName);
+				AppendPreloadDependencies(Export.SerializationBeforeCreateDependencies, SerializationBeforeCreateName);
+				AppendPreloadDependencies(Export.CreateBeforeCreateDependencies, CreateBeforeCreateName);
+
+				Span.Num = AssetSummary->PackageEdges.Num() - Span.Start;
+			}
+		}
+	}
+
+	AssetSummary->PackageEdges.Shrink();
+
+	OutResult.File = InFile;
+	OutResult.Summary = AssetSummary;
+
+	return true;
 }
 
 bool FAssetParseThreadWorker::ParseObjectName(const TArray<FObjectImport>& Imports, const TArray<FObjectExport>& Exports, FPackageIndex Index, FName& OutObjectName)
@@ -539,23 +884,23 @@ bool FAssetParseThreadWorker::ParseObjectName(const TArray<FObjectImport>& Impor
 	return false;
 }
 
-bool FAssetParseThreadWorker::ParseObjectPath(FAssetSummaryPtr InSummary, FPackageIndex Index, FName& OutFullPath)
+bool FAssetParseThreadWorker::ParseObjectPath(const FAssetSummary& InSummary, FPackageIndex Index, FName& OutFullPath)
 {
 	if (Index.IsImport())
 	{
 		const int32 RawIndex = Index.ToImport();
-		if (InSummary->ObjectImports.IsValidIndex(RawIndex))
+		if (InSummary.ObjectImports.IsValidIndex(RawIndex))
 		{
-			OutFullPath = InSummary->ObjectImports[RawIndex]->ObjectPath;
+			OutFullPath = InSummary.ObjectImports[RawIndex].ObjectPath;
 			return true;
 		}
 	}
 	else if (Index.IsExport())
 	{
 		const int32 RawIndex = Index.ToExport();
-		if (InSummary->ObjectExports.IsValidIndex(RawIndex))
+		if (InSummary.ObjectExports.IsValidIndex(RawIndex))
 		{
-			OutFullPath = InSummary->ObjectExports[RawIndex]->ObjectPath;
+			OutFullPath = InSummary.ObjectExports.ObjectPaths[RawIndex];
 			return true;
 		}
 	}
@@ -1,15 +1,62 @@
 #pragma once
 
 #include "CoreMinimal.h"
+#include "HAL/CriticalSection.h"
 #include "HAL/Runnable.h"
 #include "Misc/AES.h"
 
 #include "Misc/Guid.h"
 #include "PakFileEntry.h"
 
-typedef TMap<FName, FName> ClassTypeMap;
+struct FAssetParseResult
+{
+	FPakFileEntryPtr File;
+	FAssetSummaryPtr Summary;
+	FName ClassName;
+	bool bParsedDependency = false;
+};
+
+typedef TArray<TPair<FPakFileEntryPtr, TArray<FPackageInfo>>> DependentTypeArray;
 DECLARE_DELEGATE_ThreeParams(FOnReadAssetContent, FPakFileEntryPtr /*InFile*/, bool& /*bOutSuccess*/, TArray<uint8>& /*OutContent*/);
-DECLARE_DELEGATE_TwoParams(FOnParseFinish, bool/* bCancel*/, const ClassTypeMap&/* ClassMap*/);
+DECLARE_DELEGATE_OneParam(FOnPackagesParsed, TArray<FAssetParseResult>&/* Results*/);
+DECLARE_DELEGATE_TwoParams(FOnParseFinish, bool/* bCancel*/, DependentTypeArray&/* Dependents*/);
+
+/** Contiguous pak entries that are read with a single request. */
+struct FAssetReadRange
+{
+	int32 PakIndex = INDEX_NONE;
+	int32 FirstFile = 0;
+	int32 NumFiles = 0;
+	int64 Offset = 0;
+	int64 Size = 0;
+};
+
+/** Offset ordered read ranges of a single pak. */
+struct FAssetReadStream
+{
+	int32 FirstRange = 0;
+	int32 NumRanges = 0;
+	int32 NextRange = 0;
+};
+
+/** Per task reader and buffers, kept alive across files so a pak is opened once per stream. */
+struct FAssetReadContext
+{
+	~FAssetReadContext();
+
+	FArchive* GetPakReader(const FString& InPakFilePath, int32 InPakIndex);
+
+	FArchive* PakReader = nullptr;
+	int32 PakReaderIndex = INDEX_NONE;
+
+	TArray<uint8> RangeData;
+	int32 RangePakIndex = INDEX_NONE;
+	int64 RangeOffset = 0;
+
+	void* CopyBuffer = nullptr;
+	uint8* CompressionBuffer = nullptr;
+	int64 CompressionBufferSize = 0;
+};
 
 class FAssetParseThreadWorker : public FRunnable
 {
@@ -26,12 +73,23 @@ public:
 	void EnsureCompletion();
 	void StartParse(TArray<FPakFileEntryPtr>& InFiles, TArray<FPakFileSumary>& InSummaries);
 
+	/** Moves the files to the front of the parse queue, the last prioritized file is parsed first. */
+	void Prioritize(const TArray<FPakFileEntryPtr>& InFiles);
+
 	FOnReadAssetContent OnReadAssetContent;
+	FOnPackagesParsed OnPackagesParsed;
 	FOnParseFinish OnParseFinish;
 
 protected:
+	void BuildReadStreams();
+	bool FetchPrioritizedFile(int32& OutIndex);
+	bool FetchNextRange(int32& InOutStreamIndex, int32& OutRangeIndex);
+	bool ClaimFile(int32 InIndex);
+	bool ReadRange(const FAssetReadRange& InRange, FAssetReadContext& InContext);
+	bool ReadAssetContent(FPakFileEntryPtr InFile, FAssetReadContext& InContext, TArray<uint8>& OutContent);
+	bool ParseAsset(FPakFileEntryPtr InFile, const TArray<uint8>& InContent, FAssetParseResult& OutResult);
 	bool ParseObjectName(const TArray<FObjectImport>& Imports, const TArray<FObjectExport>& Exports, FPackageIndex Index, FName& OutObjectName);
-	bool ParseObjectPath(FAssetSummaryPtr InSummary, FPackageIndex Index, FName& OutFullPath);
+	bool ParseObjectPath(const FAssetSummary& InSummary, FPackageIndex Index, FName& OutFullPath);
 
 protected:
 	class FRunnableThread* Thread;
@@ -39,4 +97,12 @@ protected:
 
 	TArray<FPakFileEntryPtr> Files;
 	TArray<FPakFileSumary> Summaries;
+
+	// Scheduling
+	TMap<const FPakFileEntry*, int32> FileIndexMap;
+	TArray<int32> FileStates;
+	TArray<int32> PriorityQueue;
+	FCriticalSection QueueCriticalSection;
+	TArray<FAssetReadRange> ReadRanges;
+	TArray<FAssetReadStream> ReadStreams;
 };
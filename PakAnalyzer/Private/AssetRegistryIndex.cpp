@@ -0,0 +1,172 @@
+#include "AssetRegistryIndex.h"
+
+#if ENGINE_MAJOR_VERSION >= 5 && ENGINE_MINOR_VERSION >= 1
+#include "AssetRegistry/AssetData.h"
+#include "AssetRegistry/AssetRegistryState.h"
+#else
+#include "AssetData.h"
+#include "AssetRegistryState.h"
+#endif
+#include "Launch/Resources/Version.h"
+
+#include "PakAnalyzerTrace.h"
+
+bool FAssetRegistryIndex::Build(const FAssetRegistryState& InState, TFunctionRef<bool(float)> InProgress)
+{
+	PAK_ANALYZER_TRACE_SCOPE(AssetRegistry_BuildIndex);
+
+	PackageIdMap.Empty();
+	PackageNames.Empty();
+	Records.Empty();
+	EdgePool.Empty();
+
+	TArray<FAssetData> AssetDataList;
+	InState.GetAllAssets(TSet<FName>(), AssetDataList);
+
+	TArray<int32> AssetPackageIds;
+	AssetPackageIds.Reserve(AssetDataList.Num());
+	for (const FAssetData& AssetData : AssetDataList)
+	{
+		const int32 PackageCount = PackageNames.Num();
+		const int32 PackageId = FindOrAddPackageId(AssetData.PackageName);
+		if (PackageId == PackageCount)
+		{
+			AssetPackageIds.Add(PackageId);
+		}
+	}
+	AssetDataList.Empty();
+
+	TArray<FAssetIdentifier> Identifiers;
+	for (int32 i = 0; i < AssetPackageIds.Num(); ++i)
+	{
+		if ((i & 4095) == 0 && !InProgress((float)i / AssetPackageIds.Num()))
+		{
+			return false;
+		}
+
+		const int32 PackageId = AssetPackageIds[i];
+		const FName PackageName = PackageNames[PackageId];
+
+#if ENGINE_MAJOR_VERSION >= 5 || ENGINE_MINOR_VERSION >= 27
+		TArrayView<FAssetData const* const> AssetDataArray = InState.GetAssetsByPackageName(PackageName);
+#else
+		const TArray<const FAssetData*>& AssetDataArray = InState.GetAssetsByPackageName(PackageName);
+#endif
+		if (AssetDataArray.Num() > 0)
+		{
+#if ENGINE_MAJOR_VERSION >= 5 && ENGINE_MINOR_VERSION >= 1
+			Records[PackageId].ClassName = AssetDataArray[0]->AssetClassPath.GetAssetName();
+#else
+			Records[PackageId].ClassName = AssetDataArray[0]->AssetClass;
+#endif
+		}
+
+		Identifiers.Reset();
+#if ENGINE_MAJOR_VERSION >= 5 || ENGINE_MINOR_VERSION >= 26
+		InState.GetDependencies(PackageName, Identifiers, UE::AssetRegistry::EDependencyCategory::All);
+#else
+		InState.GetDependencies(PackageName, Identifiers, EAssetRegistryDependencyType::All);
+#endif
+		FPackageInfoSpan Dependencies;
+		Dependencies.Start = EdgePool.Num();
+		for (const FAssetIdentifier& Identifier : Identifiers)
+		{
+			EdgePool.Add(FindOrAddPackageId(Identifier.PackageName));
+		}
+		Dependencies.Num = EdgePool.Num() - Dependencies.Start;
+
+		Identifiers.Reset();
+#if ENGINE_MAJOR_VERSION >= 5 || ENGINE_MINOR_VERSION >= 26
+		InState.GetReferencers(PackageName, Identifiers, UE::AssetRegistry::EDependencyCategory::All);
+#else
+		InState.GetReferencers(PackageName, Identifiers, EAssetRegistryDependencyType::All);
+#endif
+		FPackageInfoSpan Referencers;
+		Referencers.Start = EdgePool.Num();
+		for (const FAssetIdentifier& Identifier : Identifiers)
+		{
+			EdgePool.Add(FindOrAddPackageId(Identifier.PackageName));
+		}
+		Referencers.Num = EdgePool.Num() - Referencers.Start;
+
+		// Records may have grown while adding the edges
+		Records[PackageId].Dependencies = Dependencies;
+		Records[PackageId].Referencers = Referencers;
+	}
+
+	PackageNames.Shrink();
+	Records.Shrink();
+	EdgePool.Shrink();
+
+	InProgress(1.f);
+
+	return true;
+}
+
+FName FAssetRegistryIndex::GetPackageClass(FName InPackageName) const
+{
+	const int32 PackageId = FindPackageId(InPackageName);
+	return PackageId != INDEX_NONE ? Records[PackageId].ClassName : NAME_None;
+}
+
+bool FAssetRegistryIndex::GetDependencies(FName InPackageName, TArray<FPackageInfo>& OutPackages) const
+{
+	return GetPackages(InPackageName, true, OutPackages);
+}
+
+bool FAssetRegistryIndex::GetReferencers(FName InPackageName, TArray<FPackageInfo>& OutPackages) const
+{
+	return GetPackages(InPackageName, false, OutPackages);
+}
+
+int32 FAssetRegistryIndex::FindPackageId(FName InPackageName) const
+{
+	const int32* PackageId = PackageIdMap.Find(InPackageName);
+	return PackageId ? *PackageId : INDEX_NONE;
+}
+
+TArrayView<const int32> FAssetRegistryIndex::GetDependencyIds(int32 InPackageId) const
+{
+	const FPackageInfoSpan& Span = Records[InPackageId].Dependencies;
+	return TArrayView<const int32>(EdgePool.GetData() + Span.Start, Span.Num);
+}
+
+TArrayView<const int32> FAssetRegistryIndex::GetReferencerIds(int32 InPackageId) const
+{
+	const FPackageInfoSpan& Span = Records[InPackageId].Referencers;
+	return TArrayView<const int32>(EdgePool.GetData() + Span.Start, Span.Num);
+}
+
+int32 FAssetRegistryIndex::FindOrAddPackageId(FName InPackageName)
+{
+	const int32* PackageId = PackageIdMap.Find(InPackageName);
+	if (PackageId)
+	{
+		return *PackageId;
+	}
+
+	const int32 NewPackageId = PackageNames.Add(InPackageName);
+	Records.AddDefaulted();
+	PackageIdMap.Add(InPackageName, NewPackageId);
+
+	return NewPackageId;
+}
+
+bool FAssetRegistryIndex::GetPackages(FName InPackageName, bool bDependencies, TArray<FPackageInfo>& OutPackages) const
+{
+	const int32 PackageId = FindPackageId(InPackageName);
+	if (PackageId == INDEX_NONE)
+	{
+		return false;
+	}
+
+	const TArrayView<const int32> PackageIds = bDependencies ? GetDependencyIds(PackageId) : GetReferencerIds(PackageId);
+
+	OutPackages.Reset(PackageIds.Num());
+	for (const int32 Id : PackageIds)
+	{
+		OutPackages.Emplace(PackageNames[Id]);
+	}
+
+	return true;
+}
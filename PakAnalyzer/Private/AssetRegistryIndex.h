@@ -0,0 +1,48 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Templates/Function.h"
+
+#include "PakFileEntry.h"
+
+class FAssetRegistryState;
+
+/** Package level data derived from an asset registry, lets the registry state be released once loaded. */
+class FAssetRegistryIndex
+{
+public:
+	/** Builds the index, InProgress receives the build progress and returns false to cancel. */
+	bool Build(const FAssetRegistryState& InState, TFunctionRef<bool(float)> InProgress);
+
+	FName GetPackageClass(FName InPackageName) const;
+	bool GetDependencies(FName InPackageName, TArray<FPackageInfo>& OutPackages) const;
+	bool GetReferencers(FName InPackageName, TArray<FPackageInfo>& OutPackages) const;
+
+	int32 GetPackageCount() const { return PackageNames.Num(); }
+	SIZE_T GetAllocatedSize() const { return PackageIdMap.GetAllocatedSize() + PackageNames.GetAllocatedSize() + Records.GetAllocatedSize() + EdgePool.GetAllocatedSize(); }
+	int32 FindPackageId(FName InPackageName) const;
+	FName GetPackageName(int32 InPackageId) const { return PackageNames[InPackageId]; }
+	TArrayView<const int32> GetDependencyIds(int32 InPackageId) const;
+	TArrayView<const int32> GetReferencerIds(int32 InPackageId) const;
+
+protected:
+	struct FPackageRecord
+	{
+		FName ClassName;
+		FPackageInfoSpan Dependencies;
+		FPackageInfoSpan Referencers;
+	};
+
+	int32 FindOrAddPackageId(FName InPackageName);
+	bool GetPackages(FName InPackageName, bool bDependencies, TArray<FPackageInfo>& OutPackages) const;
+
+protected:
+	TMap<FName, int32> PackageIdMap;
+	TArray<FName> PackageNames;
+	TArray<FPackageRecord> Records;
+
+	/** Package ids referenced by the dependency and referencer spans of all records. */
+	TArray<int32> EdgePool;
+};
+
+typedef TSharedPtr<FAssetRegistryIndex, ESPMode::ThreadSafe> FAssetRegistryIndexPtr;
@@ -0,0 +1,181 @@
+#include "AssetRegistryThreadWorker.h"
+
+#if ENGINE_MAJOR_VERSION >= 5 && ENGINE_MINOR_VERSION >= 1
+#include "AssetRegistry/AssetRegistryState.h"
+#else
+#include "AssetRegistryState.h"
+#endif
+#include "HAL/FileManager.h"
+#include "HAL/PlatformTime.h"
+#include "HAL/RunnableThread.h"
+#include "Launch/Resources/Version.h"
+#include "Serialization/MemoryReader.h"
+
+#include "CommonDefines.h"
+#include "PakAnalyzerTrace.h"
+
+// Progress share of every load step
+static const float ReadProgressRatio = 0.4f;
+static const float SerializeProgressRatio = 0.3f;
+
+FAssetRegistryThreadWorker::FAssetRegistryThreadWorker()
+	: Thread(nullptr)
+{
+}
+
+FAssetRegistryThreadWorker::~FAssetRegistryThreadWorker()
+{
+	Shutdown();
+}
+
+bool FAssetRegistryThreadWorker::Init()
+{
+	return true;
+}
+
+uint32 FAssetRegistryThreadWorker::Run()
+{
+	PAK_ANALYZER_TRACE_SCOPE(AssetRegistry_Run);
+	UE_LOG(LogPakAnalyzer, Display, TEXT("Asset registry worker starts, path: %s."), *RegistryPath);
+
+	const double StartTime = FPlatformTime::Seconds();
+
+	FAssetRegistryIndexPtr Index = nullptr;
+	if (RegistryData.Num() > 0 || ReadRegistryFile(RegistryData))
+	{
+		OnLoadProgress.ExecuteIfBound(ReadProgressRatio);
+
+		FAssetRegistrySerializationOptions LoadOptions;
+		LoadOptions.bSerializeDependencies = true;
+		LoadOptions.bSerializeSearchableNameDependencies = true;
+		LoadOptions.bSerializeManageDependencies = true;
+		LoadOptions.bSerializePackageData = false;
+
+		FAssetRegistryState State;
+		FMemoryReader Reader(RegistryData);
+		const bool bSerialized = StopTaskCounter.GetValue() <= 0 && State.Serialize(Reader, LoadOptions);
+
+		// Raw data is not needed once the state is loaded
+		RegistryData.Empty();
+
+		if (bSerialized)
+		{
+			OnLoadProgress.ExecuteIfBound(ReadProgressRatio + SerializeProgressRatio);
+
+			Index = MakeShared<FAssetRegistryIndex, ESPMode::ThreadSafe>();
+			const bool bBuilt = Index->Build(State, [this](float InProgress) -> bool
+				{
+					OnLoadProgress.ExecuteIfBound(ReadProgressRatio + SerializeProgressRatio + (1.f - ReadProgressRatio - SerializeProgressRatio) * InProgress);
+					return StopTaskCounter.GetValue() <= 0;
+				});
+
+			if (!bBuilt)
+			{
+				Index.Reset();
+			}
+		}
+	}
+
+	RegistryData.Empty();
+
+	if (StopTaskCounter.GetValue() <= 0)
+	{
+		UE_LOG(LogPakAnalyzer, Log, TEXT("Asset registry worker finished, path: %s, package count: %d, cost: %.2fs."), *RegistryPath, Index.IsValid() ? Index->GetPackageCount() : 0, FPlatformTime::Seconds() - StartTime);
+
+		OnLoadFinish.ExecuteIfBound(Index, RegistryPath);
+	}
+	else
+	{
+		UE_LOG(LogPakAnalyzer, Warning, TEXT("Asset registry worker interrupted, path: %s."), *RegistryPath);
+	}
+
+	StopTaskCounter.Reset();
+
+	return 0;
+}
+
+void FAssetRegistryThreadWorker::Stop()
+{
+	StopTaskCounter.Increment();
+	EnsureCompletion();
+	StopTaskCounter.Reset();
+}
+
+void FAssetRegistryThreadWorker::Exit()
+{
+
+}
+
+void FAssetRegistryThreadWorker::Shutdown()
+{
+	Stop();
+
+	if (Thread)
+	{
+		UE_LOG(LogPakAnalyzer, Log, TEXT("Shutdown asset registry worker."));
+
+		delete Thread;
+		Thread = nullptr;
+	}
+}
+
+void FAssetRegistryThreadWorker::EnsureCompletion()
+{
+	if (Thread)
+	{
+		Thread->WaitForCompletion();
+	}
+}
+
+void FAssetRegistryThreadWorker::StartLoad(const FString& InRegistryPath)
+{
+	Shutdown();
+
+	RegistryPath = InRegistryPath;
+	RegistryData.Empty();
+
+	Thread = FRunnableThread::Create(this, TEXT("AssetRegistryThreadWorker"), 0, EThreadPriority::TPri_Normal);
+}
+
+void FAssetRegistryThreadWorker::StartLoad(TArray<uint8>& InData, const FString& InRegistryPath)
+{
+	Shutdown();
+
+	RegistryPath = InRegistryPath;
+	RegistryData = MoveTemp(InData);
+
+	Thread = FRunnableThread::Create(this, TEXT("AssetRegistryThreadWorker"), 0, EThreadPriority::TPri_Normal);
+}
+
+bool FAssetRegistryThreadWorker::ReadRegistryFile(TArray<uint8>& OutData)
+{
+	PAK_ANALYZER_TRACE_SCOPE(AssetRegistry_ReadFile);
+	static const int64 ChunkSize = 16 * 1024 * 1024;
+
+	TUniquePtr<FArchive> Reader(IFileManager::Get().CreateFileReader(*RegistryPath));
+	if (!Reader)
+	{
+		UE_LOG(LogPakAnalyzer, Error, TEXT("Open asset registry failed! Path: %s."), *RegistryPath);
+		return false;
+	}
+
+	const int64 TotalSize = Reader->TotalSize();
+	OutData.SetNumUninitialized(TotalSize);
+
+	// Read in chunks to report progress
+	for (int64 Offset = 0; Offset < TotalSize; Offset += ChunkSize)
+	{
+		if (StopTaskCounter.GetValue() > 0)
+		{
+			return false;
+		}
+
+		const int64 Size = FMath::Min(ChunkSize, TotalSize - Offset);
+		Reader->Serialize(OutData.GetData() + Offset, Size);
+		FPakAnalyzerTrace::CountRead(Size);
+
+		OnLoadProgress.ExecuteIfBound(ReadProgressRatio * (Offset + Size) / TotalSize);
+	}
+
+	return !Reader->IsError();
+}
@@ -0,0 +1,40 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HAL/Runnable.h"
+#include "HAL/ThreadSafeCounter.h"
+
+#include "AssetRegistryIndex.h"
+
+DECLARE_DELEGATE_OneParam(FOnAssetRegistryLoadProgress, float/* Progress*/);
+DECLARE_DELEGATE_TwoParams(FOnAssetRegistryLoadFinish, FAssetRegistryIndexPtr/* Index, null if failed*/, const FString&/* RegistryPath*/);
+
+class FAssetRegistryThreadWorker : public FRunnable
+{
+public:
+	FAssetRegistryThreadWorker();
+	~FAssetRegistryThreadWorker();
+
+	virtual bool Init() override;
+	virtual uint32 Run() override;
+	virtual void Stop() override;
+	virtual void Exit() override;
+
+	void Shutdown();
+	void EnsureCompletion();
+	void StartLoad(const FString& InRegistryPath);
+	void StartLoad(TArray<uint8>& InData, const FString& InRegistryPath);
+
+	FOnAssetRegistryLoadProgress OnLoadProgress;
+	FOnAssetRegistryLoadFinish OnLoadFinish;
+
+protected:
+	bool ReadRegistryFile(TArray<uint8>& OutData);
+
+protected:
+	class FRunnableThread* Thread;
+	FThreadSafeCounter StopTaskCounter;
+
+	FString RegistryPath;
+	TArray<uint8> RegistryData;
+};
@@ -1,27 +1,53 @@
 #include "BaseAnalyzer.h"
 
-#if ENGINE_MAJOR_VERSION >= 5 && ENGINE_MINOR_VERSION >= 1
-#include "AssetRegistry/AssetRegistryState.h"
-#else
-#include "AssetRegistryState.h"
-#endif
-#include "Json.h"
+#include "Async/Async.h"
+#include "Async/ParallelFor.h"
 #include "Launch/Resources/Version.h"
 #include "Misc/Base64.h"
 #include "Misc/FileHelper.h"
+#include "Async/TaskGraphInterfaces.h"
+#include "HAL/FileManager.h"
+#include "HAL/PlatformTime.h"
 #include "Misc/Paths.h"
-#include "Serialization/ArrayReader.h"
+#include "Serialization/MemoryWriter.h"
 
+#include "ColumnarExporter.h"
 #include "CommonDefines.h"
+#include "ExportWriter.h"
+#include "ExtractThreadWorker.h"
+#include "LoadSimulator.h"
+#include "PakAnalyzerTrace.h"
+#include "PakDiff.h"
+#include "PakLayoutAnalyzer.h"
+#include "PakOrderOptimizer.h"
+#include "PakVerifier.h"
+#include "RecompressionEstimator.h"
+#include "SqlExporter.h"
+
+// Reference controller of a MakeShared allocation, vtable and two counts
+static const int64 SharedControllerSize = sizeof(void*) + sizeof(int32) * 2;
 
 FBaseAnalyzer::FBaseAnalyzer()
+	: AssetRegistryLoadSerial(0)
+	, bExporting(false)
+	, ExportSerial(0)
+	, bEstimatingRecompression(false)
+	, EstimateSerial(0)
+	, bSimulatingLoad(false)
+	, SimulateSerial(0)
+	, bDiffing(false)
+	, DiffSerial(0)
 {
 
 }
 
 FBaseAnalyzer::~FBaseAnalyzer()
 {
-
+	if (AssetRegistryWorker.IsValid())
+	{
+		AssetRegistryWorker->Shutdown();
+		AssetRegistryWorker.Reset();
+	}
 }
 
 bool FBaseAnalyzer::LoadPakFiles(const TArray<FString>& InPakPaths, const TArray<FString>& InDefaultAESKeys)
@@ -32,6 +58,7 @@ bool FBaseAnalyzer::LoadPakFiles(const TArray<FString>& InPakPaths, const TArray
 
 void FBaseAnalyzer::GetFiles(const FString& InFilterText, const TMap<FName, bool>& InClassFilterMap, const TMap<int32, bool>& InPakIndexFilter, TArray<FPakFileEntryPtr>& OutFiles) const
 {
+	PAK_ANALYZER_TRACE_SCOPE(PakAnalyzer_RetriveFiles);
 	FScopeLock Lock(const_cast<FCriticalSection*>(&CriticalSection));
 
 	for (FPakTreeEntryPtr PakTreeRoot : PakTreeRoots)
@@ -50,51 +77,196 @@ const TArray<FPakTreeEntryPtr>& FBaseAnalyzer::GetPakTreeRootNode() const
 	return PakTreeRoots;
 }
 
-bool FBaseAnalyzer::LoadAssetRegistry(const FString& InRegristryPath)
+bool FBaseAnalyzer::StartLoadAssetRegistry(const FString& InRegristryPath)
 {
-	FArrayReader ContentReader;
-	if (!FFileHelper::LoadFileToArray(ContentReader, *InRegristryPath))
+	if (!FPaths::FileExists(InRegristryPath))
 	{
 		return false;
 	}
 
-	if (!LoadAssetRegistry(ContentReader))
+	// The previous load finishes first, so its results carry the old serial and are dropped with its lookup
+	GetAssetRegistryWorker().Shutdown();
+	++AssetRegistryLoadSerial;
+	AssetRegistryApplyStopCounter.Increment();
+
+	GetAssetRegistryWorker().StartLoad(FPaths::ConvertRelativePathToFull(InRegristryPath));
+
+	return true;
+}
+
+void FBaseAnalyzer::StartLoadAssetRegistry(TArray<uint8>& InData, const FString& InRegistryPath)
+{
+	GetAssetRegistryWorker().Shutdown();
+	++AssetRegistryLoadSerial;
+	AssetRegistryApplyStopCounter.Increment();
+
+	GetAssetRegistryWorker().StartLoad(InData, InRegistryPath);
+}
+
+FAssetRegistryThreadWorker& FBaseAnalyzer::GetAssetRegistryWorker()
+{
+	if (!AssetRegistryWorker.IsValid())
 	{
-		return false;
+		AssetRegistryWorker = MakeShared<FAssetRegistryThreadWorker>();
+		AssetRegistryWorker->OnLoadProgress.BindRaw(this, &FBaseAnalyzer::OnAssetRegistryLoadProgress);
+		AssetRegistryWorker->OnLoadFinish.BindRaw(this, &FBaseAnalyzer::OnAssetRegistryLoadFinish);
 	}
 
-	AssetRegistryPath = FPaths::ConvertRelativePathToFull(InRegristryPath);
+	return *AssetRegistryWorker;
+}
+
+void FBaseAnalyzer::OnAssetRegistryLoadProgress(float InProgress)
+{
+	FFunctionGraphTask::CreateAndDispatchWhenReady([InProgress]()
+		{
+			FPakAnalyzerDelegates::OnAssetRegistryLoadProgress.Broadcast(InProgress);
+		},
+		TStatId(), nullptr, ENamedThreads::GameThread);
+}
+
+void FBaseAnalyzer::OnAssetRegistryLoadFinish(FAssetRegistryIndexPtr InIndex, const FString& InRegistryPath)
+{
+	const int32 LoadSerial = AssetRegistryLoadSerial;
+
+	DispatchTreeUpdate([this, LoadSerial, InIndex, InRegistryPath]()
+		{
+			if (LoadSerial != AssetRegistryLoadSerial)
+			{
+				return;
+			}
+
+			if (!InIndex.IsValid())
+			{
+				UE_LOG(LogPakAnalyzer, Error, TEXT("Load asset registry failed! Path: %s."), *InRegistryPath);
+				FPakAnalyzerDelegates::OnAssetRegistryLoadFinish.Broadcast(false);
+				return;
+			}
+
+			TArray<FPakFileEntryPtr> Files;
+			{
+				FScopeLock Lock(&CriticalSection);
+
+				// Files parsed from now on merge the registry edges themselves
+				AssetRegistryIndex = InIndex;
+				AssetRegistryPath = InRegistryPath;
+
+				for (const FPakTreeEntryPtr& TreeRoot : PakTreeRoots)
+				{
+					RetriveFiles(TreeRoot, TEXT(""), TMap<FName, bool>(), TMap<int32, bool>(), Files);
+				}
+			}
+
+			// The lookup keeps its own index and stops once a newer load starts. It runs after the previous
+			// lookup so that waiting on the last future waits on all of them
+			const int32 StopValue = AssetRegistryApplyStopCounter.GetValue();
+			TFuture<void> PreviousFuture = MoveTemp(AssetRegistryApplyFuture);
+			AssetRegistryApplyFuture = Async(EAsyncExecution::ThreadPool, [this, LoadSerial, StopValue, Index = InIndex, PreviousFuture = MoveTemp(PreviousFuture), Files = MoveTemp(Files)]() mutable
+				{
+					if (PreviousFuture.IsValid())
+					{
+						PreviousFuture.Wait();
+					}
+
+					LookupAssetRegistry(LoadSerial, StopValue, *Index, Files);
+				});
+		});
+}
+
+void FBaseAnalyzer::LookupAssetRegistry(int32 InLoadSerial, int32 InStopValue, const FAssetRegistryIndex& InIndex, TArray<FPakFileEntryPtr>& InFiles)
+{
+	PAK_ANALYZER_TRACE_SCOPE(PakAnalyzer_LookupAssetRegistry);
+
+	static const int32 MaxBatchCount = 4096;
+
+	// Only the immutable paths of the files are read here
+	TArray<FAssetRegistryFileResult> Results;
+	Results.SetNum(InFiles.Num());
+	ParallelFor(InFiles.Num(), [this, InStopValue, &InIndex, &InFiles, &Results](int32 InFileIndex)
+		{
+			FAssetRegistryFileResult& Result = Results[InFileIndex];
+			Result.File = MoveTemp(InFiles[InFileIndex]);
+
+			if (AssetRegistryApplyStopCounter.GetValue() != InStopValue)
+			{
+				return;
+			}
+
+			const FName PackagePath = Result.File->PackagePath;
+			Result.Class = InIndex.GetPackageClass(PackagePath);
+			Result.bHasDependencies = InIndex.GetDependencies(PackagePath, Result.Dependencies);
+			Result.bHasReferencers = InIndex.GetReferencers(PackagePath, Result.Referencers);
+		});
 
-	for (FPakTreeEntryPtr TreeRoot : PakTreeRoots)
+	// Entries are released on the game thread, so stopped batches are still sent and dropped there
+	for (int32 Start = 0; Start < Results.Num(); Start += MaxBatchCount)
 	{
-		RefreshClassMap(TreeRoot, TreeRoot);
-		RefreshPackageDependency(TreeRoot, TreeRoot);
+		const int32 End = FMath::Min(Start + MaxBatchCount, Results.Num());
+
+		TArray<FAssetRegistryFileResult> Batch;
+		Batch.Reserve(End - Start);
+		for (int32 i = Start; i < End; ++i)
+		{
+			Batch.Add(MoveTemp(Results[i]));
+		}
+
+		DispatchTreeUpdate([this, InLoadSerial, Batch = MoveTemp(Batch)]()
+			{
+				if (InLoadSerial == AssetRegistryLoadSerial)
+				{
+					ApplyAssetRegistryResults(Batch);
+				}
+			});
 	}
-	
-	return true;
+
+	DispatchTreeUpdate([this, InLoadSerial]()
+		{
+			if (InLoadSerial != AssetRegistryLoadSerial)
+			{
+				return;
+			}
+
+			DependencyGraph.Reset();
+			FPakAnalyzerDelegates::OnAssetRegistryLoadFinish.Broadcast(true);
+		});
 }
 
-bool FBaseAnalyzer::LoadAssetRegistry(FArrayReader& InData)
+void FBaseAnalyzer::ApplyAssetRegistryResults(const TArray<FAssetRegistryFileResult>& InResults)
 {
-	FAssetRegistrySerializationOptions LoadOptions;
-	LoadOptions.bSerializeDependencies = true;
-	LoadOptions.bSerializeSearchableNameDependencies = true;
-	LoadOptions.bSerializeManageDependencies = true;
-	LoadOptions.bSerializePackageData = false;
+	FScopeLock Lock(&CriticalSection);
 
-	TSharedPtr<FAssetRegistryState> NewAssetRegistryState = MakeShared<FAssetRegistryState>();
-	if (NewAssetRegistryState->Serialize(InData, LoadOptions))
+	for (const FAssetRegistryFileResult& Result : InResults)
 	{
-		AssetRegistryState = NewAssetRegistryState;
-		return true;
-	}
+		const FPakFileEntryPtr& File = Result.File;
 
-	return false;
+		if (Result.bHasDependencies || Result.bHasReferencers)
+		{
+			CountAssetSummary(File->AssetSummary, -1);
+
+			if (!File->AssetSummary.IsValid())
+			{
+				File->AssetSummary = MakeShared<FAssetSummary>();
+			}
+
+			if (Result.bHasDependencies)
+			{
+				File->AssetSummary->SetDependencies(Result.Dependencies);
+			}
+
+			if (Result.bHasReferencers)
+			{
+				File->AssetSummary->SetDependents(Result.Referencers);
+			}
+
+			CountAssetSummary(File->AssetSummary, 1);
+		}
+
+		UpdateFileClass(File, Result.Class.IsNone() ? GetAssetClass(File->Path, File->PackagePath) : Result.Class);
+	}
 }
 
 void FBaseAnalyzer::RefreshPackageDependency(FPakTreeEntryPtr InTreeRoot, FPakTreeEntryPtr InRoot)
 {
-	if (!AssetRegistryState.IsValid())
+	if (!AssetRegistryIndex.IsValid())
 	{
 		return;
 	}
@@ -109,95 +281,68 @@ void FBaseAnalyzer::RefreshPackageDependency(FPakTreeEntryPtr InTreeRoot, FPakTr
 		}
 		else
 		{
-			TArray<FAssetIdentifier> Dependencies;
-#if ENGINE_MAJOR_VERSION >= 5 || ENGINE_MINOR_VERSION >= 26
-			if (AssetRegistryState->GetDependencies(Child->PackagePath, Dependencies, UE::AssetRegistry::EDependencyCategory::All))
-#else
-			if (AssetRegistryState->GetDependencies(Child->PackagePath, Dependencies, EAssetRegistryDependencyType::All))
-#endif
-			{
-				if (!Child->AssetSummary.IsValid())
-				{
-					Child->AssetSummary = MakeShared<FAssetSummary>();
-				}
-				else
-				{
-					Child->AssetSummary->DependencyList.Empty();
-				}
-
-				for (const FAssetIdentifier& Identifier : Dependencies)
-				{
-					FPackageInfoPtr Depends = MakeShared<FPackageInfo>();
-					Depends->PackageName = Identifier.PackageName;
+			CountAssetSummary(Child->AssetSummary, -1);
 
-					Child->AssetSummary->DependencyList.Add(Depends);
-				}
+			if (!Child->AssetSummary.IsValid() && AssetRegistryIndex->FindPackageId(Child->PackagePath) != INDEX_NONE)
+			{
+				Child->AssetSummary = MakeShared<FAssetSummary>();
 			}
 
-			TArray<FAssetIdentifier> Dependents;
-#if ENGINE_MAJOR_VERSION >= 5 || ENGINE_MINOR_VERSION >= 26
-			if (AssetRegistryState->GetReferencers(Child->PackagePath, Dependents, UE::AssetRegistry::EDependencyCategory::All))
-#else
-			if (AssetRegistryState->GetReferencers(Child->PackagePath, Dependents, EAssetRegistryDependencyType::All))
-#endif
+			if (Child->AssetSummary.IsValid())
 			{
-				if (!Child->AssetSummary.IsValid())
-				{
-					Child->AssetSummary = MakeShared<FAssetSummary>();
-				}
-				else
-				{
-					Child->AssetSummary->DependentList.Empty();
-				}
-
-				for (const FAssetIdentifier& Identifier : Dependents)
-				{
-					FPackageInfoPtr Depends = MakeShared<FPackageInfo>();
-					Depends->PackageName = Identifier.PackageName;
-
-					Child->AssetSummary->DependentList.Add(Depends);
-				}
+				ApplyRegistryDependencies(*Child->AssetSummary, Child->PackagePath);
 			}
+
+			CountAssetSummary(Child->AssetSummary, 1);
 		}
 	}
 }
 
-bool FBaseAnalyzer::ExportToJson(const FString& InOutputPath, const TArray<FPakFileEntryPtr>& InFiles)
+void FBaseAnalyzer::ApplyRegistryDependencies(FAssetSummary& InOutSummary, FName InPackagePath) const
+{
+	if (!AssetRegistryIndex.IsValid())
+	{
+		return;
+	}
+
+	TArray<FPackageInfo> Packages;
+	if (AssetRegistryIndex->GetDependencies(InPackagePath, Packages))
+	{
+		InOutSummary.SetDependencies(Packages);
+	}
+
+	if (AssetRegistryIndex->GetReferencers(InPackagePath, Packages))
+	{
+		InOutSummary.SetDependents(Packages);
+	}
+}
+
+bool FBaseAnalyzer::WriteJson(const FString& InOutputPath, const TArray<FPakFileEntryPtr>& InFiles, FExportProgress* InProgress)
 {
+	PAK_ANALYZER_TRACE_SCOPE(PakAnalyzer_ExportToJson);
 	UE_LOG(LogPakAnalyzer, Log, TEXT("Export to json: %s."), *InOutputPath);
 
-	TSharedRef<FJsonObject> RootObject = MakeShareable(new FJsonObject);
-	RootObject->SetNumberField(TEXT("Exported File Count"), InFiles.Num());
+	FExportWriter Writer(InOutputPath, InProgress);
+	if (!Writer.IsValid())
+	{
+		UE_LOG(LogPakAnalyzer, Error, TEXT("Export to json: %s failed, can't open file for writing."), *InOutputPath);
+		return false;
+	}
 
-	TArray<TSharedPtr<FJsonValue>> FileObjects;
+	if (InProgress)
+	{
+		InProgress->TotalRows = InFiles.Num();
+	}
 
 	int64 TotalSize = 0;
 	int64 TotalCompressedSize = 0;
 
 	TMap<FName, FPakClassEntry> ExportedClassMap;
 
-	for (const FPakFileEntryPtr It : InFiles)
+	for (const FPakFileEntryPtr& It : InFiles)
 	{
 		const FPakEntry& PakEntry = It->PakEntry;
 
-		TSharedRef<FJsonObject> FileObject = MakeShareable(new FJsonObject);
-
-		FileObject->SetStringField(TEXT("Name"), It->Filename.ToString());
-		FileObject->SetStringField(TEXT("Path"), It->Path);
-		FileObject->SetNumberField(TEXT("Offset"), PakEntry.Offset);
-		FileObject->SetNumberField(TEXT("Size"), PakEntry.UncompressedSize);
-		FileObject->SetNumberField(TEXT("Compressed Size"), PakEntry.Size);
-		FileObject->SetNumberField(TEXT("Compressed Block Count"), PakEntry.CompressionBlocks.Num());
-		FileObject->SetNumberField(TEXT("Compressed Block Size"), PakEntry.CompressionBlockSize);
-		FileObject->SetStringField(TEXT("SHA1"), BytesToHex(PakEntry.Hash, sizeof(PakEntry.Hash)));
-		FileObject->SetStringField(TEXT("IsEncrypted"), PakEntry.IsEncrypted() ? TEXT("True") : TEXT("False"));
-		FileObject->SetStringField(TEXT("Class"), It->Class.ToString());
-		FileObject->SetNumberField(TEXT("Dependency Count"), It->AssetSummary.IsValid() ? It->AssetSummary->DependencyList.Num() : 0);
-		FileObject->SetNumberField(TEXT("Dependent Count"), It->AssetSummary.IsValid() ? It->AssetSummary->DependentList.Num() : 0);
-		FileObject->SetStringField(TEXT("OwnerPak"), PakFileSummaries.IsValidIndex(It->OwnerPakIndex) ? FPaths::GetCleanFilename(PakFileSummaries[It->OwnerPakIndex]->PakFilePath) : TEXT(""));
-
-		FileObjects.Add(MakeShareable(new FJsonValueObject(FileObject)));
-
 		TotalSize += PakEntry.UncompressedSize;
 		TotalCompressedSize += PakEntry.Size;
 
@@ -214,87 +359,304 @@ bool FBaseAnalyzer::ExportToJson(const FString& InOutputPath, const TArray<FPakF
 		}
 	}
 
-	RootObject->SetNumberField(TEXT("Exported Total Size"), TotalSize);
-	RootObject->SetNumberField(TEXT("Exported Total Compressed Size"), TotalCompressedSize);
-
 	ExportedClassMap.ValueSort(
 		[](const FPakClassEntry& A, const FPakClassEntry& B) -> bool
 		{
 			return A.CompressedSize > B.CompressedSize;
 		});
 
-	TArray<TSharedPtr<FJsonValue>> ClassObjects;
+	FExportBuffer Header;
+	Header.Append("{\n\t\"Exported File Count\": ").AppendInt(InFiles.Num());
+	Header.Append(",\n\t\"Exported Total Size\": ").AppendInt(TotalSize);
+	Header.Append(",\n\t\"Exported Total Compressed Size\": ").AppendInt(TotalCompressedSize);
+	Header.Append(",\n\t\"Group By Class\": [");
+
+	bool bFirstClass = true;
 	for (const auto& Pair : ExportedClassMap)
 	{
 		const FPakClassEntry& ClassEntry = Pair.Value;
 
-		TSharedRef<FJsonObject> ClassObject = MakeShareable(new FJsonObject);
-		ClassObject->SetStringField(TEXT("Class"), ClassEntry.Class.ToString());
-		ClassObject->SetNumberField(TEXT("File Count"), ClassEntry.FileCount);
-		ClassObject->SetNumberField(TEXT("Size"), ClassEntry.Size);
-		ClassObject->SetNumberField(TEXT("Compressed Size"), ClassEntry.CompressedSize);
-		ClassObject->SetNumberField(TEXT("Compressed Size Percent Of Exported"), TotalCompressedSize > 0 ? 100 * (float)ClassEntry.CompressedSize / TotalCompressedSize : 0.f);
-
-		ClassObjects.Add(MakeShareable(new FJsonValueObject(ClassObject)));
+		Header.Append(bFirstClass ? "\n\t\t{" : ",\n\t\t{");
+		Header.Append("\n\t\t\t\"Class\": ").AppendJsonString(ClassEntry.Class);
+		Header.Append(",\n\t\t\t\"File Count\": ").AppendInt(ClassEntry.FileCount);
+		Header.Append(",\n\t\t\t\"Size\": ").AppendInt(ClassEntry.Size);
+		Header.Append(",\n\t\t\t\"Compressed Size\": ").AppendInt(ClassEntry.CompressedSize);
+		Header.Append(",\n\t\t\t\"Compressed Size Percent Of Exported\": ").AppendFloat(TotalCompressedSize > 0 ? 100.0 * ClassEntry.CompressedSize / TotalCompressedSize : 0.0);
+		Header.Append("\n\t\t}");
+		bFirstClass = false;
 	}
 
-	RootObject->SetArrayField(TEXT("Group By Class"), ClassObjects);
-	RootObject->SetArrayField(TEXT("Files"), FileObjects);
+	Header.Append("\n\t],\n\t\"Files\": [");
+	Writer.Write(Header);
 
-	bool bExportResult = false;
+	TArray<FString> OwnerPakNames;
+	GetOwnerPakNames(OwnerPakNames);
 
-	FString FileContents;
-	TSharedRef<TJsonWriter<>> JsonWriter = TJsonWriterFactory<>::Create(&FileContents);
-	if (FJsonSerializer::Serialize(RootObject, JsonWriter))
-	{
-		JsonWriter->Close();
-		bExportResult = FFileHelper::SaveStringToFile(FileContents, *InOutputPath, FFileHelper::EEncodingOptions::ForceUTF8WithoutBOM);
-	}
+	Writer.WriteRows(InFiles.Num(), [&InFiles, &OwnerPakNames](int32 InRow, FExportBuffer& OutBuffer)
+		{
+			const FPakFileEntry& File = *InFiles[InRow];
+			const FPakEntry& PakEntry = File.PakEntry;
+
+			OutBuffer.Append(InRow > 0 ? ",\n\t\t{" : "\n\t\t{");
+			OutBuffer.Append("\n\t\t\t\"Name\": ").AppendJsonString(File.Filename);
+			OutBuffer.Append(",\n\t\t\t\"Path\": ").AppendJsonString(File.Path);
+			OutBuffer.Append(",\n\t\t\t\"Offset\": ").AppendInt(PakEntry.Offset);
+			OutBuffer.Append(",\n\t\t\t\"Size\": ").AppendInt(PakEntry.UncompressedSize);
+			OutBuffer.Append(",\n\t\t\t\"Compressed Size\": ").AppendInt(PakEntry.Size);
+			OutBuffer.Append(",\n\t\t\t\"Compressed Block Count\": ").AppendInt(PakEntry.CompressionBlocks.Num());
+			OutBuffer.Append(",\n\t\t\t\"Compressed Block Size\": ").AppendInt(PakEntry.CompressionBlockSize);
+			OutBuffer.Append(",\n\t\t\t\"SHA1\": \"").AppendHex(PakEntry.Hash, sizeof(PakEntry.Hash)).Append("\"");
+			OutBuffer.Append(",\n\t\t\t\"IsEncrypted\": ").Append(PakEntry.IsEncrypted() ? "\"True\"" : "\"False\"");
+			OutBuffer.Append(",\n\t\t\t\"Class\": ").AppendJsonString(File.Class);
+			OutBuffer.Append(",\n\t\t\t\"Dependency Count\": ").AppendInt(File.AssetSummary.IsValid() ? File.AssetSummary->GetDependencyCount() : 0);
+			OutBuffer.Append(",\n\t\t\t\"Dependent Count\": ").AppendInt(File.AssetSummary.IsValid() ? File.AssetSummary->GetDependentCount() : 0);
+			OutBuffer.Append(",\n\t\t\t\"OwnerPak\": ");
+			if (OwnerPakNames.IsValidIndex(File.OwnerPakIndex))
+			{
+				OutBuffer.AppendJsonString(OwnerPakNames[File.OwnerPakIndex]);
+			}
+			else
+			{
+				OutBuffer.Append("\"\"");
+			}
+			OutBuffer.Append("\n\t\t}");
+		});
+
+	FExportBuffer Footer;
+	Footer.Append("\n\t]\n}");
+	Writer.Write(Footer);
+
+	FPakAnalyzerTrace::CountWrite(Writer.GetWrittenSize());
+
+	const bool bExportResult = Writer.Close();
 
 	UE_LOG(LogPakAnalyzer, Log, TEXT("Export to json: %s finished, file count: %d, result: %d."), *InOutputPath, InFiles.Num(), bExportResult);
 
 	return bExportResult;
 }
 
-bool FBaseAnalyzer::ExportToCsv(const FString& InOutputPath, const TArray<FPakFileEntryPtr>& InFiles)
+bool FBaseAnalyzer::WriteCsv(const FString& InOutputPath, const TArray<FPakFileEntryPtr>& InFiles, FExportProgress* InProgress)
 {
+	PAK_ANALYZER_TRACE_SCOPE(PakAnalyzer_ExportToCsv);
 	UE_LOG(LogPakAnalyzer, Log, TEXT("Export to csv: %s."), *InOutputPath);
 
-	TArray<FString> Lines;
-	Lines.Empty(InFiles.Num() + 2);
-	Lines.Add(TEXT("Id, Name, Path, Offset, Class, Size, Compressed Size, Compressed Block Count, Compressed Block Size, SHA1, IsEncrypted, Dependency Count, Dependent Count, OwnerPak"));
+	FExportWriter Writer(InOutputPath, InProgress);
+	if (!Writer.IsValid())
+	{
+		UE_LOG(LogPakAnalyzer, Error, TEXT("Export to csv: %s failed, can't open file for writing."), *InOutputPath);
+		return false;
+	}
 
-	int32 Index = 1;
-	for (const FPakFileEntryPtr It : InFiles)
+	if (InProgress)
 	{
-		const FPakEntry& PakEntry = It->PakEntry;
+		InProgress->TotalRows = InFiles.Num();
+	}
+
+	const int32 LineTerminatorLen = FCString::Strlen(LINE_TERMINATOR);
+
+	FExportBuffer Header;
+	Header.Append("Id, Name, Path, Offset, Class, Size, Compressed Size, Compressed Block Count, Compressed Block Size, SHA1, IsEncrypted, Dependency Count, Dependent Count, OwnerPak");
+	Header.Append(LINE_TERMINATOR, LineTerminatorLen);
+	Writer.Write(Header);
+
+	TArray<FString> OwnerPakNames;
+	GetOwnerPakNames(OwnerPakNames);
+
+	Writer.WriteRows(InFiles.Num(), [&InFiles, &OwnerPakNames, LineTerminatorLen](int32 InRow, FExportBuffer& OutBuffer)
+		{
+			const FPakFileEntry& File = *InFiles[InRow];
+			const FPakEntry& PakEntry = File.PakEntry;
+
+			OutBuffer.AppendInt(InRow + 1);
+			OutBuffer.Append(", ").Append(File.Filename);
+			OutBuffer.Append(", ").Append(File.Path);
+			OutBuffer.Append(", ").AppendInt(PakEntry.Offset);
+			OutBuffer.Append(", ").Append(File.Class);
+			OutBuffer.Append(", ").AppendInt(PakEntry.UncompressedSize);
+			OutBuffer.Append(", ").AppendInt(PakEntry.Size);
+			OutBuffer.Append(", ").AppendInt(PakEntry.CompressionBlocks.Num());
+			OutBuffer.Append(", ").AppendInt(PakEntry.CompressionBlockSize);
+			OutBuffer.Append(", ").AppendHex(PakEntry.Hash, sizeof(PakEntry.Hash));
+			OutBuffer.Append(PakEntry.IsEncrypted() ? ", True" : ", False");
+			OutBuffer.Append(", ").AppendInt(File.AssetSummary.IsValid() ? File.AssetSummary->GetDependencyCount() : 0);
+			OutBuffer.Append(", ").AppendInt(File.AssetSummary.IsValid() ? File.AssetSummary->GetDependentCount() : 0);
+			OutBuffer.Append(", ");
+			if (OwnerPakNames.IsValidIndex(File.OwnerPakIndex))
+			{
+				OutBuffer.Append(OwnerPakNames[File.OwnerPakIndex]);
+			}
+			OutBuffer.Append(LINE_TERMINATOR, LineTerminatorLen);
+		});
 
-		Lines.Add(FString::Printf(TEXT("%d, %s, %s, %lld, %s, %lld, %lld, %d, %d, %s, %s, %d, %d, %s"),
-			Index,
-			*It->Filename.ToString(),
-			*It->Path,
-			PakEntry.Offset,
-			*It->Class.ToString(),
-			PakEntry.UncompressedSize,
-			PakEntry.Size,
-			PakEntry.CompressionBlocks.Num(),
-			PakEntry.CompressionBlockSize,
-			*BytesToHex(PakEntry.Hash, sizeof(PakEntry.Hash)),
-			PakEntry.IsEncrypted() ? TEXT("True") : TEXT("False"),
-			It->AssetSummary.IsValid() ? It->AssetSummary->DependencyList.Num() : 0,
-			It->AssetSummary.IsValid() ? It->AssetSummary->DependentList.Num() : 0,
-			PakFileSummaries.IsValidIndex(It->OwnerPakIndex) ? *FPaths::GetCleanFilename(PakFileSummaries[It->OwnerPakIndex]->PakFilePath) : TEXT(""))
-			);
-		++Index;
-	}
-
-	const bool bExportResult = FFileHelper::SaveStringArrayToFile(Lines, *InOutputPath, FFileHelper::EEncodingOptions::ForceUTF8WithoutBOM);
+	FPakAnalyzerTrace::CountWrite(Writer.GetWrittenSize());
+
+	const bool bExportResult = Writer.Close();
 
 	UE_LOG(LogPakAnalyzer, Log, TEXT("Export to csv: %s finished, file count: %d, result: %d."), *InOutputPath, InFiles.Num(), bExportResult);
 
 	return bExportResult;
 }
 
+bool FBaseAnalyzer::WriteColumnar(const FString& InOutputPath, const TArray<FPakFileEntryPtr>& InFiles, FExportProgress* InProgress)
+{
+	PAK_ANALYZER_TRACE_SCOPE(PakAnalyzer_ExportToColumnar);
+	UE_LOG(LogPakAnalyzer, Log, TEXT("Export to columnar: %s."), *InOutputPath);
+
+	TArray<FString> OwnerPakNames;
+	GetOwnerPakNames(OwnerPakNames);
+
+	const bool bExportResult = FColumnarExporter::Export(InOutputPath, InFiles, OwnerPakNames, GetDependencyGraph(), InProgress);
+	if (bExportResult)
+	{
+		FPakAnalyzerTrace::CountWrite(IFileManager::Get().FileSize(*InOutputPath));
+	}
+
+	return bExportResult;
+}
+
+bool FBaseAnalyzer::WriteSql(const FString& InOutputPath, const TArray<FPakFileEntryPtr>& InFiles, FExportProgress* InProgress)
+{
+	PAK_ANALYZER_TRACE_SCOPE(PakAnalyzer_ExportToSql);
+	UE_LOG(LogPakAnalyzer, Log, TEXT("Export to sql: %s."), *InOutputPath);
+
+	const bool bExportResult = FSqlExporter::Export(InOutputPath, InFiles, PakFileSummaries, GetDependencyGraph(), InProgress);
+	if (bExportResult)
+	{
+		FPakAnalyzerTrace::CountWrite(IFileManager::Get().FileSize(*InOutputPath));
+	}
+
+	return bExportResult;
+}
+
+bool FBaseAnalyzer::ExportToJson(const FString& InOutputPath, const TArray<FPakFileEntryPtr>& InFiles)
+{
+	return WriteJson(InOutputPath, InFiles, nullptr);
+}
+
+bool FBaseAnalyzer::ExportToCsv(const FString& InOutputPath, const TArray<FPakFileEntryPtr>& InFiles)
+{
+	return WriteCsv(InOutputPath, InFiles, nullptr);
+}
+
+bool FBaseAnalyzer::ExportToColumnar(const FString& InOutputPath, const TArray<FPakFileEntryPtr>& InFiles)
+{
+	return WriteColumnar(InOutputPath, InFiles, nullptr);
+}
+
+bool FBaseAnalyzer::ExportToSql(const FString& InOutputPath, const TArray<FPakFileEntryPtr>& InFiles)
+{
+	return WriteSql(InOutputPath, InFiles, nullptr);
+}
+
+void FBaseAnalyzer::StartExport(EPakExportFormat InFormat, const FString& InOutputPath, const TArray<FPakFileEntryPtr>& InFiles)
+{
+	if (bExporting)
+	{
+		UE_LOG(LogPakAnalyzer, Warning, TEXT("Export to %s ignored, another export is running."), *InOutputPath);
+		return;
+	}
+
+	// Built here, the export thread only reads it
+	if (InFormat == EPakExportFormat::Columnar || InFormat == EPakExportFormat::Sql)
+	{
+		GetDependencyGraph();
+	}
+
+	bExporting = true;
+	ExportStopCounter.Reset();
+	const int32 Serial = ++ExportSerial;
+
+	FPakAnalyzerDelegates::OnExportStart.ExecuteIfBound();
+
+	ExportFuture = Async(EAsyncExecution::Thread, [this, InFormat, InOutputPath, Files = InFiles, Serial]() mutable
+		{
+			FExportProgress Progress;
+			Progress.StopCounter = &ExportStopCounter;
+			Progress.OnProgress = &FBaseAnalyzer::DispatchExportProgress;
+
+			bool bResult = false;
+			switch (InFormat)
+			{
+			case EPakExportFormat::Json: bResult = WriteJson(InOutputPath, Files, &Progress); break;
+			case EPakExportFormat::Csv: bResult = WriteCsv(InOutputPath, Files, &Progress); break;
+			case EPakExportFormat::Columnar: bResult = WriteColumnar(InOutputPath, Files, &Progress); break;
+			case EPakExportFormat::Sql: bResult = WriteSql(InOutputPath, Files, &Progress); break;
+			}
+
+			// The file list is released on the game thread, which owns the entries
+			const int32 TotalRows = (int32)Progress.TotalRows;
+			FFunctionGraphTask::CreateAndDispatchWhenReady([this, Serial, bResult, TotalRows, Files = MoveTemp(Files)]()
+				{
+					OnExportFinish(Serial, bResult, TotalRows);
+				},
+				TStatId(), nullptr, ENamedThreads::GameThread);
+
+			return bResult;
+		});
+}
+
+void FBaseAnalyzer::CancelExport()
+{
+	ExportStopCounter.Increment();
+}
+
+bool FBaseAnalyzer::IsExporting() const
+{
+	return bExporting;
+}
+
+void FBaseAnalyzer::DispatchExportProgress(int64 InCompleteRows, int64 InTotalRows)
+{
+	FFunctionGraphTask::CreateAndDispatchWhenReady([InCompleteRows, InTotalRows]()
+		{
+			FPakAnalyzerDelegates::OnUpdateExportProgress.ExecuteIfBound((int32)InCompleteRows, 0, (int32)InTotalRows);
+		},
+		TStatId(), nullptr, ENamedThreads::GameThread);
+}
+
+void FBaseAnalyzer::OnExportFinish(int32 InSerial, bool bSuccess, int32 InTotalRows)
+{
+	if (InSerial != ExportSerial)
+	{
+		return;
+	}
+
+	bExporting = false;
+	FPakAnalyzerDelegates::OnUpdateExportProgress.ExecuteIfBound(InTotalRows, bSuccess ? 0 : 1, InTotalRows);
+
+	TArray<TUniqueFunction<void()>> Updates = MoveTemp(DeferredUpdates);
+	for (TUniqueFunction<void()>& Update : Updates)
+	{
+		Update();
+	}
+}
+
+void FBaseAnalyzer::DispatchTreeUpdate(TUniqueFunction<void()>&& InUpdate)
+{
+	FFunctionGraphTask::CreateAndDispatchWhenReady([this, Update = MoveTemp(InUpdate)]() mutable
+		{
+			// A running export reads the tree, so changes wait until it finishes
+			if (bExporting)
+			{
+				DeferredUpdates.Add(MoveTemp(Update));
+			}
+			else
+			{
+				Update();
+			}
+		},
+		TStatId(), nullptr, ENamedThreads::GameThread);
+}
+
+void FBaseAnalyzer::GetOwnerPakNames(TArray<FString>& OutNames) const
+{
+	OutNames.Empty(PakFileSummaries.Num());
+	for (const FPakFileSumaryPtr& Summary : PakFileSummaries)
+	{
+		OutNames.Add(FPaths::GetCleanFilename(Summary->PakFilePath));
+	}
+}
+
 FString FBaseAnalyzer::GetAssetRegistryPath() const
 {
 	return AssetRegistryPath;
@@ -438,31 +800,27 @@ void FBaseAnalyzer::InsertClassInfo(FPakTreeEntryPtr InTreeRoot, FPakTreeEntryPt
 }
 
 FName FBaseAnalyzer::GetAssetClass(const FString& InFilename, FName InPackagePath)
+{
+	return GetAssetClass(InFilename, InPackagePath, AssetRegistryIndex.Get(), DefaultClassMap);
+}
+
+FName FBaseAnalyzer::GetAssetClass(const FString& InFilename, const FName InPackagePath, const FAssetRegistryIndex* InIndex, const TMap<FName, FName>& InDefaultClassMap)
 {
 	bool bFoundClassInRegistry = false;
 	FName AssetClass = *FPaths::GetExtension(InFilename);
-	if (AssetRegistryState.IsValid())
+	if (InIndex)
 	{
-#if ENGINE_MAJOR_VERSION >= 5 || ENGINE_MINOR_VERSION >= 27
-		TArrayView<FAssetData const* const> AssetDataArray = AssetRegistryState->GetAssetsByPackageName(InPackagePath);
-#else
-		const TArray<const FAssetData*>& AssetDataArray = AssetRegistryState->GetAssetsByPackageName(InPackagePath);
-#endif
-		if (AssetDataArray.Num() > 0)
+		const FName RegistryClass = InIndex->GetPackageClass(InPackagePath);
+		if (!RegistryClass.IsNone())
 		{
 			bFoundClassInRegistry = true;
-
-#if ENGINE_MAJOR_VERSION >= 5 && ENGINE_MINOR_VERSION >= 1
-			AssetClass = AssetDataArray[0]->AssetClassPath.GetAssetName();
-#else
-			AssetClass = AssetDataArray[0]->AssetClass;
-#endif
+			AssetClass = RegistryClass;
 		}
 	}
 	
 	if (!bFoundClassInRegistry)
 	{
-		const FName* ClassName = DefaultClassMap.Find(InPackagePath);
+		const FName* ClassName = InDefaultClassMap.Find(InPackagePath);
 		if (ClassName)
 		{
 			AssetClass = *ClassName;
@@ -472,13 +830,1178 @@ FName FBaseAnalyzer::GetAssetClass(const FString& InFilename, FName InPackagePat
 	return AssetClass.IsNone() ? TEXT("Unknown") : AssetClass;
 }
 
-FName FBaseAnalyzer::GetPackagePath(const FString& InFilePath)
+bool FBaseAnalyzer::GetTreeAncestors(FPakFileEntryPtr InFile, TArray<FPakTreeEntryPtr>& OutAncestors) const
 {
-	FString Left, Right;
-	if (InFilePath.Split(TEXT("/Content/"), &Left, &Right))
-	{
-		const FString Prefix = FPaths::GetPathLeaf(Left);
-		const bool bNotUseGamePrefix = Prefix == TEXT("Engine") || InFilePath.Contains(TEXT("Plugin"));
+	static const TCHAR* Delims[2] = { TEXT("\\"), TEXT("/") };
+
+	OutAncestors.Reset();
+
+	if (!PakTreeRoots.IsValidIndex(InFile->OwnerPakIndex) || !PakTreeRoots[InFile->OwnerPakIndex].IsValid())
+	{
+		return false;
+	}
+
+	TArray<FString> PathItems;
+	InFile->Path.ParseIntoArray(PathItems, Delims, 2);
+
+	FPakTreeEntryPtr Node = PakTreeRoots[InFile->OwnerPakIndex];
+	for (const FString& PathItem : PathItems)
+	{
+		OutAncestors.Add(Node);
+
+		FPakTreeEntryPtr* Child = Node->ChildrenMap.Find(*PathItem);
+		if (!Child)
+		{
+			return false;
+		}
+
+		Node = *Child;
+	}
+
+	// The file may belong to a tree that has been unloaded already
+	return Node.Get() == InFile.Get();
+}
+
+bool FBaseAnalyzer::UpdateFileClass(FPakFileEntryPtr InFile, FName InNewClass)
+{
+	const FName OldClass = InFile->Class;
+	const FName NewClass = InNewClass;
+	if (OldClass == NewClass)
+	{
+		return false;
+	}
+
+	TArray<FPakTreeEntryPtr> Ancestors;
+	if (!GetTreeAncestors(InFile, Ancestors))
+	{
+		return false;
+	}
+
+	const FPakTreeEntryPtr& TreeRoot = Ancestors[0];
+	for (const FPakTreeEntryPtr& Ancestor : Ancestors)
+	{
+		if (Ancestor->FileClassMap.Contains(OldClass))
+		{
+			InsertClassInfo(TreeRoot, Ancestor, OldClass, -1, -InFile->Size, -InFile->CompressedSize);
+			if (Ancestor->FileClassMap[OldClass]->FileCount <= 0)
+			{
+				Ancestor->FileClassMap.Remove(OldClass);
+			}
+		}
+
+		InsertClassInfo(TreeRoot, Ancestor, NewClass, 1, InFile->Size, InFile->CompressedSize);
+	}
+
+	InFile->Class = NewClass;
+
+	return true;
+}
+
+void FBaseAnalyzer::OnPackagesParsed(TArray<FAssetParseResult>& InResults)
+{
+	DispatchTreeUpdate([this, Results = MoveTemp(InResults)]()
+		{
+			TArray<FPakFileEntryPtr> ParsedFiles;
+			ParsedFiles.Reserve(Results.Num());
+
+			{
+				FScopeLock Lock(&CriticalSection);
+
+				for (const FAssetParseResult& Result : Results)
+				{
+					// The registry is more complete than the import table, it wins whenever it knows the package
+					ApplyRegistryDependencies(*Result.Summary, Result.File->PackagePath);
+
+					CountAssetSummary(Result.File->AssetSummary, -1);
+					CountAssetSummary(Result.Summary, 1);
+					Result.File->AssetSummary = Result.Summary;
+
+					if (!Result.ClassName.IsNone())
+					{
+						DefaultClassMap.Add(Result.File->PackagePath, Result.ClassName);
+						UpdateFileClass(Result.File, GetAssetClass(Result.File->Path, Result.File->PackagePath));
+					}
+
+					ParsedFiles.Add(Result.File);
+				}
+			}
+
+			DependencyGraph.Reset();
+
+			FPakAnalyzerDelegates::OnPackagesParsed.Broadcast(ParsedFiles);
+		});
+}
+
+void FBaseAnalyzer::OnAssetParseFinish(bool bCancel, DependentTypeArray& Dependents)
+{
+	if (bCancel)
+	{
+		return;
+	}
+
+	DispatchTreeUpdate([this, Dependents = MoveTemp(Dependents)]()
+		{
+			// Summaries are owned by the game thread once published
+			for (const auto& Pair : Dependents)
+			{
+				const FAssetSummaryPtr& AssetSummary = Pair.Key->AssetSummary;
+				if (AssetSummary.IsValid() && AssetSummary->GetDependentCount() <= 0)
+				{
+					CountAssetSummary(AssetSummary, -1);
+					AssetSummary->SetDependents(Pair.Value);
+					CountAssetSummary(AssetSummary, 1);
+				}
+			}
+
+			DependencyGraph.Reset();
+
+			FPakAnalyzerDelegates::OnAssetParseFinish.Broadcast();
+		});
+}
+
+bool FBaseAnalyzer::GetDependencyClosure(const TArray<FName>& InPackageNames, bool bReverse, FDependencyClosure& OutClosure)
+{
+	const FDependencyGraph& Graph = GetDependencyGraph();
+
+	TArray<int32> Roots;
+	for (const FName& PackageName : InPackageNames)
+	{
+		const int32 PackageId = Graph.FindPackageId(PackageName);
+		if (PackageId != INDEX_NONE)
+		{
+			Roots.Add(PackageId);
+		}
+	}
+
+	if (Roots.Num() <= 0)
+	{
+		return false;
+	}
+
+	TArray<int32> PackageIds;
+	Graph.GetClosure(Roots, bReverse, PackageIds);
+
+	OutClosure = FDependencyClosure();
+	OutClosure.Packages.Reserve(PackageIds.Num());
+	for (const int32 PackageId : PackageIds)
+	{
+		const TArrayView<const FPakFileEntryPtr> Files = Graph.GetFiles(PackageId);
+
+		OutClosure.Packages.Add(Graph.GetPackageName(PackageId));
+		OutClosure.Files.Append(Files.GetData(), Files.Num());
+		OutClosure.Size += Graph.GetSize(PackageId);
+		OutClosure.CompressedSize += Graph.GetCompressedSize(PackageId);
+	}
+
+	return true;
+}
+
+void FBaseAnalyzer::ExtractFilesWithDependencies(const FString& InOutputPath, const TArray<FPakFileEntryPtr>& InFiles)
+{
+	TArray<FName> PackageNames;
+	for (const FPakFileEntryPtr& File : InFiles)
+	{
+		if (!File->PackagePath.IsNone())
+		{
+			PackageNames.AddUnique(File->PackagePath);
+		}
+	}
+
+	FDependencyClosure Closure;
+	GetDependencyClosure(PackageNames, false, Closure);
+
+	// Selected files always win, a dependency found in several paks is taken from the last loaded one like a patch pak
+	TMap<FString, FPakFileEntryPtr> FileMap;
+	FileMap.Reserve(InFiles.Num() + Closure.Files.Num());
+	for (const FPakFileEntryPtr& File : InFiles)
+	{
+		FileMap.Add(File->Path, File);
+	}
+
+	const int32 SelectedCount = FileMap.Num();
+	TSet<FString> SelectedPaths;
+	FileMap.GetKeys(SelectedPaths);
+
+	for (const FPakFileEntryPtr& File : Closure.Files)
+	{
+		FPakFileEntryPtr* Existing = FileMap.Find(File->Path);
+		if (!Existing)
+		{
+			FileMap.Add(File->Path, File);
+		}
+		else if (!SelectedPaths.Contains(File->Path) && (*Existing)->OwnerPakIndex < File->OwnerPakIndex)
+		{
+			*Existing = File;
+		}
+	}
+
+	TArray<FPakFileEntryPtr> Files;
+	FileMap.GenerateValueArray(Files);
+
+	UE_LOG(LogPakAnalyzer, Log, TEXT("Extract with dependencies, selected file count: %d, closure package count: %d, total file count: %d."), SelectedCount, Closure.Packages.Num(), Files.Num());
+
+	ExtractFiles(InOutputPath, Files);
+}
+
+bool FBaseAnalyzer::GetShortestDependencyChain(FName InFrom, FName InTo, TArray<FName>& OutChain)
+{
+	const FDependencyGraph& Graph = GetDependencyGraph();
+
+	TArray<int32> Chain;
+	if (!Graph.GetShortestChain(Graph.FindPackageId(InFrom), Graph.FindPackageId(InTo), Chain))
+	{
+		return false;
+	}
+
+	OutChain.Reset(Chain.Num());
+	for (const int32 PackageId : Chain)
+	{
+		OutChain.Add(Graph.GetPackageName(PackageId));
+	}
+
+	return true;
+}
+
+void FBaseAnalyzer::GetDependencyCycles(TArray<FDependencyCyclePtr>& OutCycles)
+{
+	OutCycles.Reset();
+
+	const FDependencyGraph& Graph = GetDependencyGraph();
+
+	TArray<int32> Offsets;
+	TArray<int32> PackageIds;
+	const int32 ComponentCount = Graph.GetStronglyConnectedComponents(Offsets, PackageIds);
+
+	for (int32 Component = 0; Component < ComponentCount; ++Component)
+	{
+		// Self references are dropped by the graph, a single package is never a cycle
+		if (Offsets[Component + 1] - Offsets[Component] <= 1)
+		{
+			continue;
+		}
+
+		FDependencyCyclePtr Cycle = MakeShared<FDependencyCycle>();
+		for (int32 i = Offsets[Component]; i < Offsets[Component + 1]; ++i)
+		{
+			const int32 PackageId = PackageIds[i];
+			const TArrayView<const FPakFileEntryPtr> Files = Graph.GetFiles(PackageId);
+
+			Cycle->Packages.Add(Graph.GetPackageName(PackageId));
+			Cycle->Files.Append(Files.GetData(), Files.Num());
+			Cycle->Size += Graph.GetSize(PackageId);
+			Cycle->CompressedSize += Graph.GetCompressedSize(PackageId);
+		}
+
+		OutCycles.Add(Cycle);
+	}
+
+	OutCycles.Sort([](const FDependencyCyclePtr& A, const FDependencyCyclePtr& B) { return A->Size > B->Size; });
+}
+
+void FBaseAnalyzer::GetUnreferencedPackages(const FUnreferencedPackageOptions& InOptions, TArray<FUnreferencedPackagePtr>& OutPackages)
+{
+	OutPackages.Reset();
+
+	const double StartTime = FPlatformTime::Seconds();
+	const FDependencyGraph& Graph = GetDependencyGraph();
+
+	const TSet<FName> RootClasses(InOptions.RootClasses);
+	static const FName WorldClassName(TEXT("World"));
+
+	for (int32 PackageId = 0; PackageId < Graph.Num(); ++PackageId)
+	{
+		if (Graph.GetDependents(PackageId).Num() > 0)
+		{
+			continue;
+		}
+
+		const TArrayView<const FPakFileEntryPtr> Files = Graph.GetFiles(PackageId);
+		if (Files.Num() <= 0)
+		{
+			continue;
+		}
+
+		const FName PackageName = Graph.GetPackageName(PackageId);
+		const FString PackageString = PackageName.ToString();
+		if (InOptions.RootPaths.ContainsByPredicate([&PackageString](const FString& RootPath) { return PackageString.StartsWith(RootPath); }))
+		{
+			continue;
+		}
+
+		FUnreferencedPackagePtr Package = nullptr;
+		bool bIsRoot = false;
+		for (const FPakFileEntryPtr& File : Files)
+		{
+			if (File->Class == WorldClassName || RootClasses.Contains(File->Class) || File->Filename.ToString().EndsWith(TEXT(".umap")))
+			{
+				bIsRoot = true;
+				break;
+			}
+
+			if ((InOptions.PakIndex != INDEX_NONE && File->OwnerPakIndex != InOptions.PakIndex) || !File->Path.StartsWith(InOptions.Folder))
+			{
+				continue;
+			}
+
+			if (!Package.IsValid())
+			{
+				Package = MakeShared<FUnreferencedPackage>();
+				Package->PackageName = PackageName;
+			}
+
+			if (File->Filename.ToString().EndsWith(TEXT(".uasset")) || Package->Class.IsNone())
+			{
+				Package->Class = File->Class;
+			}
+			Package->Files.Add(File);
+			Package->Size += File->PakEntry.UncompressedSize;
+			Package->CompressedSize += File->PakEntry.Size;
+		}
+
+		if (Package.IsValid() && !bIsRoot)
+		{
+			OutPackages.Add(Package);
+		}
+	}
+
+	OutPackages.Sort([](const FUnreferencedPackagePtr& A, const FUnreferencedPackagePtr& B) { return A->CompressedSize > B->CompressedSize; });
+
+	UE_LOG(LogPakAnalyzer, Log, TEXT("Find unreferenced packages, package count: %d, cost: %.2fms."), OutPackages.Num(), (FPlatformTime::Seconds() - StartTime) * 1000.0);
+}
+
+struct FDuplicateKey
+{
+	FSHAHash Hash;
+	int64 Size = 0;
+
+	bool operator==(const FDuplicateKey& Other) const
+	{
+		return Size == Other.Size && Hash == Other.Hash;
+	}
+
+	friend uint32 GetTypeHash(const FDuplicateKey& InKey)
+	{
+		return HashCombine(GetTypeHash(InKey.Hash), GetTypeHash(InKey.Size));
+	}
+};
+
+void FBaseAnalyzer::GetDuplicateFiles(TArray<FDuplicateGroupPtr>& OutGroups)
+{
+	OutGroups.Reset();
+
+	const double StartTime = FPlatformTime::Seconds();
+
+	TArray<FPakFileEntryPtr> Files;
+	for (const FPakTreeEntryPtr& TreeRoot : PakTreeRoots)
+	{
+		RetriveFiles(TreeRoot, TEXT(""), TMap<FName, bool>(), TMap<int32, bool>(), Files);
+	}
+
+	// Hash the keys in parallel, then bucket the files by key hash so each shard aggregates on its own
+	static const int32 ShardCount = 64;
+	static const int32 BatchSize = 4096;
+
+	TArray<FDuplicateKey> Keys;
+	Keys.SetNum(Files.Num());
+	TArray<uint32> KeyHashes;
+	KeyHashes.SetNumZeroed(Files.Num());
+
+	const int32 BatchCount = FMath::DivideAndRoundUp(Files.Num(), BatchSize);
+	ParallelFor(BatchCount, [&Files, &Keys, &KeyHashes](int32 InBatch)
+		{
+			const int32 End = FMath::Min((InBatch + 1) * BatchSize, Files.Num());
+			for (int32 i = InBatch * BatchSize; i < End; ++i)
+			{
+				const FPakEntry& PakEntry = Files[i]->PakEntry;
+				FMemory::Memcpy(Keys[i].Hash.Hash, PakEntry.Hash, sizeof(Keys[i].Hash.Hash));
+				Keys[i].Size = PakEntry.UncompressedSize;
+				KeyHashes[i] = GetTypeHash(Keys[i]);
+			}
+		});
+
+	TArray<int32> Shards[ShardCount];
+	for (int32 i = 0; i < Files.Num(); ++i)
+	{
+		// Empty files and loose files without a hash can't be told apart by content
+		if (Keys[i].Size > 0 && Keys[i].Hash != FSHAHash())
+		{
+			Shards[KeyHashes[i] % ShardCount].Add(i);
+		}
+	}
+
+	TArray<FDuplicateGroupPtr> ShardGroups[ShardCount];
+	ParallelFor(ShardCount, [&](int32 InShard)
+		{
+			TMap<FDuplicateKey, int32> GroupMap;
+			GroupMap.Reserve(Shards[InShard].Num());
+			TArray<TArray<int32>> Groups;
+
+			for (const int32 FileIndex : Shards[InShard])
+			{
+				const int32* GroupIndex = GroupMap.FindByHash(KeyHashes[FileIndex], Keys[FileIndex]);
+				if (GroupIndex)
+				{
+					Groups[*GroupIndex].Add(FileIndex);
+				}
+				else
+				{
+					GroupMap.AddByHash(KeyHashes[FileIndex], Keys[FileIndex], Groups.Num());
+					Groups.AddDefaulted_GetRef().Add(FileIndex);
+				}
+			}
+
+			for (const TArray<int32>& Group : Groups)
+			{
+				if (Group.Num() <= 1)
+				{
+					continue;
+				}
+
+				FDuplicateGroupPtr DuplicateGroup = MakeShared<FDuplicateGroup>();
+				DuplicateGroup->Size = Keys[Group[0]].Size;
+
+				int64 TotalSize = 0;
+				int64 MinSize = MAX_int64;
+				for (const int32 FileIndex : Group)
+				{
+					const int64 CompressedSize = Files[FileIndex]->PakEntry.Size;
+					TotalSize += CompressedSize;
+					MinSize = FMath::Min(MinSize, CompressedSize);
+					DuplicateGroup->Files.Add(Files[FileIndex]);
+				}
+				DuplicateGroup->WastedSize = TotalSize - MinSize;
+
+				ShardGroups[InShard].Add(DuplicateGroup);
+			}
+		});
+
+	for (TArray<FDuplicateGroupPtr>& Groups : ShardGroups)
+	{
+		OutGroups.Append(MoveTemp(Groups));
+	}
+
+	OutGroups.Sort([](const FDuplicateGroupPtr& A, const FDuplicateGroupPtr& B) { return A->WastedSize > B->WastedSize; });
+
+	UE_LOG(LogPakAnalyzer, Log, TEXT("Find duplicate files, file count: %d, group count: %d, cost: %.2fms."), Files.Num(), OutGroups.Num(), (FPlatformTime::Seconds() - StartTime) * 1000.0);
+}
+
+void FBaseAnalyzer::SimulateLoad(const TArray<FName>& InRootPackages, const FLoadDeviceModel& InDevice, TArray<FLoadSimulation>& OutSimulations)
+{
+	TArray<int32> PakVersions;
+	GetPakVersions(PakVersions);
+
+	RunLoadSimulation(GetDependencyGraph(), PakVersions, InRootPackages, InDevice, nullptr, OutSimulations);
+}
+
+void FBaseAnalyzer::StartSimulateLoad(const TArray<FName>& InRootPackages, const FLoadDeviceModel& InDevice)
+{
+	// A newer request replaces the running one, its result would be stale anyway
+	CancelSimulateLoad();
+
+	// Built and copied here, the simulation thread only reads them
+	GetDependencyGraph();
+	TArray<int32> PakVersions;
+	GetPakVersions(PakVersions);
+
+	bSimulatingLoad = true;
+	SimulateStopCounter.Reset();
+	const int32 Serial = ++SimulateSerial;
+
+	SimulateFuture = Async(EAsyncExecution::Thread, [this, Graph = DependencyGraph, PakVersions = MoveTemp(PakVersions), InRootPackages, InDevice, Serial]() mutable
+		{
+			TSharedPtr<TArray<FLoadSimulation>> Simulations = MakeShared<TArray<FLoadSimulation>>();
+			const bool bResult = RunLoadSimulation(*Graph, PakVersions, InRootPackages, InDevice, &SimulateStopCounter, *Simulations);
+
+			// The graph is released on the game thread, which owns it and its entries
+			FFunctionGraphTask::CreateAndDispatchWhenReady([this, Serial, bResult, Simulations, Graph = MoveTemp(Graph)]()
+				{
+					if (Serial == SimulateSerial)
+					{
+						bSimulatingLoad = false;
+						if (bResult)
+						{
+							FPakAnalyzerDelegates::OnLoadSimulationFinish.Broadcast(*Simulations);
+						}
+					}
+				},
+				TStatId(), nullptr, ENamedThreads::GameThread);
+		});
+}
+
+void FBaseAnalyzer::CancelSimulateLoad()
+{
+	SimulateStopCounter.Increment();
+	if (SimulateFuture.IsValid())
+	{
+		SimulateFuture.Wait();
+		SimulateFuture = TFuture<void>();
+	}
+
+	++SimulateSerial;
+	bSimulatingLoad = false;
+}
+
+bool FBaseAnalyzer::IsSimulatingLoad() const
+{
+	return bSimulatingLoad;
+}
+
+bool FBaseAnalyzer::RunLoadSimulation(const FDependencyGraph& InGraph, const TArray<int32>& InPakVersions, const TArray<FName>& InRootPackages, const FLoadDeviceModel& InDevice, const FThreadSafeCounter* InStopCounter, TArray<FLoadSimulation>& OutSimulations)
+{
+	const double StartTime = FPlatformTime::Seconds();
+	const FDependencyGraph& Graph = InGraph;
+
+	OutSimulations.Reset();
+	OutSimulations.SetNum(InRootPackages.Num());
+
+	// Roots are independent, the graph is only read from here on
+	ParallelFor(InRootPackages.Num(), [&Graph, &InPakVersions, &InRootPackages, &InDevice, InStopCounter, &OutSimulations](int32 InIndex)
+		{
+			if (InStopCounter && InStopCounter->GetValue() > 0)
+			{
+				return;
+			}
+
+			FLoadSimulation& Simulation = OutSimulations[InIndex];
+			Simulation.RootPackage = InRootPackages[InIndex];
+
+			const int32 RootId = Graph.FindPackageId(InRootPackages[InIndex]);
+			if (RootId == INDEX_NONE)
+			{
+				return;
+			}
+
+			// Packages are requested in breadth first order from the root, like the async loader walks imports
+			TArray<int32> PackageIds;
+			Graph.GetClosure({ RootId }, false, PackageIds);
+
+			TArray<FLoadRead> Reads;
+			for (const int32 PackageId : PackageIds)
+			{
+				for (const FPakFileEntryPtr& File : Graph.GetFiles(PackageId))
+				{
+					const int32 PakVersion = InPakVersions.IsValidIndex(File->OwnerPakIndex) ? InPakVersions[File->OwnerPakIndex] : FPakInfo::PakFile_Version_Latest;
+					Reads.Add(FLoadSimulator::MakeRead(*File, PakVersion));
+				}
+			}
+
+			Simulation.PackageCount = PackageIds.Num();
+			FLoadSimulator::Simulate(Reads, InDevice, Simulation);
+		});
+
+	if (InStopCounter && InStopCounter->GetValue() > 0)
+	{
+		UE_LOG(LogPakAnalyzer, Log, TEXT("Simulate load canceled, device: %s, root count: %d."), *InDevice.Name.ToString(), InRootPackages.Num());
+		return false;
+	}
+
+	UE_LOG(LogPakAnalyzer, Log, TEXT("Simulate load, device: %s, root count: %d, cost: %.2fms."), *InDevice.Name.ToString(), InRootPackages.Num(), (FPlatformTime::Seconds() - StartTime) * 1000.0);
+	return true;
+}
+
+bool FBaseAnalyzer::GetPakLayout(int32 InPakIndex, FPakLayout& OutLayout)
+{
+	if (!PakFileSummaries.IsValidIndex(InPakIndex) || !PakFileSummaries[InPakIndex].IsValid())
+	{
+		return false;
+	}
+
+	TMap<int32, bool> PakIndexFilter;
+	PakIndexFilter.Add(InPakIndex, true);
+
+	TArray<FPakFileEntryPtr> Files;
+	for (const FPakTreeEntryPtr& TreeRoot : PakTreeRoots)
+	{
+		RetriveFiles(TreeRoot, TEXT(""), TMap<FName, bool>(), PakIndexFilter, Files);
+	}
+
+	FPakLayoutAnalyzer::Analyze(*PakFileSummaries[InPakIndex], InPakIndex, Files, OutLayout);
+
+	return true;
+}
+
+bool FBaseAnalyzer::VerifyPakFiles(FPakVerifyResult& OutResult)
+{
+	PAK_ANALYZER_TRACE_SCOPE(PakAnalyzer_VerifyPakFiles);
+	const double StartTime = FPlatformTime::Seconds();
+
+	OutResult = FPakVerifyResult();
+
+	TArray<FPakFileEntryPtr> Files;
+	for (const FPakTreeEntryPtr& TreeRoot : PakTreeRoots)
+	{
+		RetriveFiles(TreeRoot, TEXT(""), TMap<FName, bool>(), TMap<int32, bool>(), Files);
+	}
+
+	TArray<TArray<FPakFileEntryPtr>> PakFiles;
+	PakFiles.SetNum(PakFileSummaries.Num());
+	for (const FPakFileEntryPtr& File : Files)
+	{
+		if (PakFiles.IsValidIndex(File->OwnerPakIndex))
+		{
+			PakFiles[File->OwnerPakIndex].Add(File);
+		}
+	}
+
+	bool bResult = true;
+	for (int32 PakIndex = 0; PakIndex < PakFileSummaries.Num(); ++PakIndex)
+	{
+		if (PakFileSummaries[PakIndex].IsValid() && !FPakVerifier::Verify(*PakFileSummaries[PakIndex], PakFiles[PakIndex], OutResult))
+		{
+			bResult = false;
+		}
+	}
+
+	OutResult.Seconds = FPlatformTime::Seconds() - StartTime;
+
+	UE_LOG(LogPakAnalyzer, Log, TEXT("Verify pak files, pak count: %d, file count: %d, corrupt count: %d, unchecked count: %d, cost: %.2fms."),
+		OutResult.PakCount, OutResult.FileCount, OutResult.Issues.Num(), OutResult.UncheckedCount, OutResult.Seconds * 1000.0);
+
+	return bResult;
+}
+
+bool FBaseAnalyzer::EstimateRecompression(const TArray<FPakFileEntryPtr>& InFiles, const FRecompressionOptions& InOptions, FRecompressionResult& OutResult)
+{
+	TArray<FPakFileSumary> Summaries;
+	CopyPakSummaries(Summaries);
+
+	return RunRecompressionEstimate(InFiles, InOptions, Summaries, nullptr, OutResult);
+}
+
+void FBaseAnalyzer::StartEstimateRecompression(const TArray<FPakFileEntryPtr>& InFiles, const FRecompressionOptions& InOptions)
+{
+	if (bEstimatingRecompression)
+	{
+		UE_LOG(LogPakAnalyzer, Warning, TEXT("Estimate recompression ignored, another estimate is running."));
+		return;
+	}
+
+	// Reset clears the summaries, the task reads its own copy
+	TArray<FPakFileSumary> Summaries;
+	CopyPakSummaries(Summaries);
+
+	bEstimatingRecompression = true;
+	EstimateStopCounter.Reset();
+	const int32 Serial = ++EstimateSerial;
+
+	EstimateFuture = Async(EAsyncExecution::Thread, [this, Files = InFiles, InOptions, Summaries = MoveTemp(Summaries), Serial]() mutable
+		{
+			TSharedPtr<FRecompressionResult> Result = MakeShared<FRecompressionResult>();
+			if (!RunRecompressionEstimate(Files, InOptions, Summaries, &EstimateStopCounter, *Result))
+			{
+				Result.Reset();
+			}
+
+			// The file list is released on the game thread, which owns the entries
+			FFunctionGraphTask::CreateAndDispatchWhenReady([this, Serial, Result, Files = MoveTemp(Files)]()
+				{
+					if (Serial == EstimateSerial)
+					{
+						bEstimatingRecompression = false;
+						FPakAnalyzerDelegates::OnRecompressionEstimateFinish.Broadcast(Result);
+					}
+				},
+				TStatId(), nullptr, ENamedThreads::GameThread);
+		});
+}
+
+void FBaseAnalyzer::CancelEstimateRecompression()
+{
+	EstimateStopCounter.Increment();
+}
+
+bool FBaseAnalyzer::IsEstimatingRecompression() const
+{
+	return bEstimatingRecompression;
+}
+
+bool FBaseAnalyzer::RunRecompressionEstimate(const TArray<FPakFileEntryPtr>& InFiles, const FRecompressionOptions& InOptions, const TArray<FPakFileSumary>& InSummaries, const FThreadSafeCounter* InStopCounter, FRecompressionResult& OutResult) const
+{
+	return FRecompressionEstimator::Estimate(InFiles, InOptions,
+		[this, &InSummaries](const FPakFileEntry& InFile, FFileReadContext& InContext, TArray<uint8>& OutContent)
+		{
+			return InSummaries.IsValidIndex(InFile.OwnerPakIndex) && ReadFileContent(InSummaries[InFile.OwnerPakIndex], InFile, InContext, OutContent);
+		},
+		InStopCounter, OutResult);
+}
+
+void FBaseAnalyzer::CopyPakSummaries(TArray<FPakFileSumary>& OutSummaries) const
+{
+	OutSummaries.Empty(PakFileSummaries.Num());
+	for (const FPakFileSumaryPtr& Summary : PakFileSummaries)
+	{
+		OutSummaries.Add(Summary.IsValid() ? *Summary : FPakFileSumary());
+	}
+}
+
+bool FBaseAnalyzer::ReadFileContent(const FPakFileSumary& InSummary, const FPakFileEntry& InFile, FFileReadContext& InContext, TArray<uint8>& OutContent) const
+{
+	if (!InContext.Reader || InContext.ReaderPakIndex != InFile.OwnerPakIndex)
+	{
+		InContext.Reader.Reset(IFileManager::Get().CreateFileReader(*InSummary.PakFilePath));
+		InContext.ReaderPakIndex = InContext.Reader ? InFile.OwnerPakIndex : INDEX_NONE;
+	}
+
+	if (!InContext.Reader)
+	{
+		return false;
+	}
+
+	FArchive& Reader = *InContext.Reader;
+	Reader.Seek(InFile.PakEntry.Offset);
+
+	FPakEntry EntryInfo;
+	EntryInfo.Serialize(Reader, InSummary.PakInfo.Version);
+	if (Reader.IsError() || !EntryInfo.IndexDataEquals(InFile.PakEntry))
+	{
+		Reader.ClearError();
+		return false;
+	}
+
+	OutContent.Reset(InFile.PakEntry.UncompressedSize);
+	FMemoryWriter Writer(OutContent);
+
+	bool bReadResult = false;
+	if (EntryInfo.CompressionMethodIndex == 0)
+	{
+		const int64 BufferSize = 8 * 1024 * 1024; // 8MB buffer for extracting
+		if (!InContext.CopyBuffer)
+		{
+			InContext.CopyBuffer = FMemory::Malloc(BufferSize);
+		}
+
+		bReadResult = FExtractThreadWorker::BufferedCopyFile(Writer, Reader, InFile.PakEntry, InContext.CopyBuffer, BufferSize, InSummary.DecryptAESKey);
+	}
+	else
+	{
+		const bool bHasRelativeCompressedChunkOffsets = InSummary.PakInfo.Version >= FPakInfo::PakFile_Version_RelativeChunkOffsets;
+		bReadResult = FExtractThreadWorker::UncompressCopyFile(Writer, Reader, InFile.PakEntry, InContext.CompressionBuffer, InContext.CompressionBufferSize, InSummary.DecryptAESKey, InFile.CompressionMethod, bHasRelativeCompressedChunkOffsets);
+	}
+
+	if (Reader.IsError())
+	{
+		Reader.ClearError();
+		return false;
+	}
+
+	return bReadResult;
+}
+
+bool FBaseAnalyzer::DiffPakFiles(const TArray<FString>& InPakPaths, const TArray<FString>& InDefaultAESKeys, FPakDiffResult& OutResult)
+{
+	TArray<FString> Keys;
+	TArray<FPakDiffRecord> NewRecords;
+	if (!ResolveDiffKeys(InPakPaths, InDefaultAESKeys, Keys) || !LoadDiffRecords(InPakPaths, Keys, AssetRegistryIndex.Get(), DefaultClassMap, nullptr, NewRecords))
+	{
+		UE_LOG(LogPakAnalyzer, Error, TEXT("Diff pak files failed! Load file table failed!"));
+		return false;
+	}
+
+	TArray<FPakFileEntryPtr> Files;
+	TArray<FName> Classes;
+	GetDiffFiles(Files, Classes);
+
+	TArray<FPakDiffRecord> OldRecords;
+	MakeDiffRecords(Files, Classes, OldRecords);
+
+	FPakDiff::Diff(OldRecords, NewRecords, OutResult);
+
+	return true;
+}
+
+void FBaseAnalyzer::StartDiffPakFiles(const TArray<FString>& InPakPaths, const TArray<FString>& InDefaultAESKeys)
+{
+	// A newer request replaces the running one, it also has to finish with the pak key delegate first
+	CancelDiffPakFiles();
+
+	// The compared paks didn't change, only the loaded side is joined again
+	TSharedPtr<const TArray<FPakDiffRecord>, ESPMode::ThreadSafe> CachedRecords;
+	TArray<FString> Keys;
+	if (DiffRecords.IsValid() && DiffPakPaths == InPakPaths)
+	{
+		CachedRecords = DiffRecords;
+		Keys = InDefaultAESKeys;
+	}
+	else if (!ResolveDiffKeys(InPakPaths, InDefaultAESKeys, Keys))
+	{
+		UE_LOG(LogPakAnalyzer, Error, TEXT("Diff pak files failed! Resolve keys failed!"));
+		FPakAnalyzerDelegates::OnPakDiffFinish.Broadcast(nullptr, InDefaultAESKeys);
+		return;
+	}
+
+	TArray<FPakFileEntryPtr> Files;
+	TArray<FName> Classes;
+	GetDiffFiles(Files, Classes);
+
+	bDiffing = true;
+	DiffStopCounter.Reset();
+	const int32 Serial = ++DiffSerial;
+
+	DiffFuture = Async(EAsyncExecution::Thread, [this, InPakPaths, Keys, CachedRecords, Files = MoveTemp(Files), Classes = MoveTemp(Classes), Index = AssetRegistryIndex, ClassMap = DefaultClassMap, Serial]() mutable
+		{
+			TSharedPtr<const TArray<FPakDiffRecord>, ESPMode::ThreadSafe> NewRecords = CachedRecords;
+			if (!NewRecords.IsValid())
+			{
+				TSharedPtr<TArray<FPakDiffRecord>, ESPMode::ThreadSafe> Records = MakeShared<TArray<FPakDiffRecord>, ESPMode::ThreadSafe>();
+				if (LoadDiffRecords(InPakPaths, Keys, Index.Get(), ClassMap, &DiffStopCounter, *Records))
+				{
+					NewRecords = Records;
+				}
+			}
+
+			TSharedPtr<FPakDiffResult> Result;
+			if (NewRecords.IsValid() && DiffStopCounter.GetValue() <= 0)
+			{
+				TArray<FPakDiffRecord> OldRecords;
+				MakeDiffRecords(Files, Classes, OldRecords);
+
+				Result = MakeShared<FPakDiffResult>();
+				FPakDiff::Diff(OldRecords, *NewRecords, *Result);
+			}
+
+			// Entries and the registry index are released on the game thread, which owns them
+			FFunctionGraphTask::CreateAndDispatchWhenReady([this, Serial, InPakPaths, Keys, NewRecords, Result, Files = MoveTemp(Files), Index = MoveTemp(Index)]()
+				{
+					if (Serial != DiffSerial)
+					{
+						return;
+					}
+
+					bDiffing = false;
+					if (NewRecords.IsValid())
+					{
+						DiffPakPaths = InPakPaths;
+						DiffRecords = NewRecords;
+					}
+
+					FPakAnalyzerDelegates::OnPakDiffFinish.Broadcast(Result, Keys);
+				},
+				TStatId(), nullptr, ENamedThreads::GameThread);
+		});
+}
+
+void FBaseAnalyzer::CancelDiffPakFiles()
+{
+	DiffStopCounter.Increment();
+	if (DiffFuture.IsValid())
+	{
+		DiffFuture.Wait();
+		DiffFuture = TFuture<void>();
+	}
+
+	++DiffSerial;
+	bDiffing = false;
+}
+
+bool FBaseAnalyzer::IsDiffingPakFiles() const
+{
+	return bDiffing;
+}
+
+bool FBaseAnalyzer::ResolveDiffKeys(const TArray<FString>& InPakPaths, const TArray<FString>& InDefaultAESKeys, TArray<FString>& OutKeys)
+{
+	OutKeys.Reset();
+	for (int32 i = 0; i < InPakPaths.Num(); ++i)
+	{
+		OutKeys.Add(InDefaultAESKeys.IsValidIndex(i) ? InDefaultAESKeys[i] : TEXT(""));
+	}
+
+	return true;
+}
+
+void FBaseAnalyzer::GetDiffFiles(TArray<FPakFileEntryPtr>& OutFiles, TArray<FName>& OutClasses) const
+{
+	OutFiles.Reset();
+	for (const FPakTreeEntryPtr& TreeRoot : PakTreeRoots)
+	{
+		RetriveFiles(TreeRoot, TEXT(""), TMap<FName, bool>(), TMap<int32, bool>(), OutFiles);
+	}
+
+	// Classes change with the registry and parse results, the rest of an entry is fixed after load
+	OutClasses.SetNumUninitialized(OutFiles.Num());
+	for (int32 i = 0; i < OutFiles.Num(); ++i)
+	{
+		OutClasses[i] = OutFiles[i]->Class;
+	}
+}
+
+void FBaseAnalyzer::MakeDiffRecords(const TArray<FPakFileEntryPtr>& InFiles, const TArray<FName>& InClasses, TArray<FPakDiffRecord>& OutRecords)
+{
+	OutRecords.SetNum(InFiles.Num());
+	for (int32 i = 0; i < InFiles.Num(); ++i)
+	{
+		FPakDiffRecord& Record = OutRecords[i];
+		Record.Path = InFiles[i]->Path;
+		Record.Class = InClasses[i];
+		Record.Size = InFiles[i]->PakEntry.UncompressedSize;
+		Record.CompressedSize = InFiles[i]->PakEntry.Size;
+		FMemory::Memcpy(Record.Hash.Hash, InFiles[i]->PakEntry.Hash, sizeof(Record.Hash.Hash));
+	}
+}
+
+bool FBaseAnalyzer::ExportFileOrder(const FString& InOutputPath, const TArray<FName>& InRootPackages, const FLoadDeviceModel& InDevice, FPakOrderEstimate& OutEstimate)
+{
+	TArray<FPakFileEntryPtr> Files;
+	for (const FPakTreeEntryPtr& TreeRoot : PakTreeRoots)
+	{
+		RetriveFiles(TreeRoot, TEXT(""), TMap<FName, bool>(), TMap<int32, bool>(), Files);
+	}
+
+	return WriteFileOrder(InOutputPath, Files, GetDependencyGraph(), InRootPackages, InDevice, OutEstimate, nullptr);
+}
+
+void FBaseAnalyzer::StartExportFileOrder(const FString& InOutputPath, const TArray<FName>& InRootPackages, const FLoadDeviceModel& InDevice)
+{
+	if (bExporting)
+	{
+		UE_LOG(LogPakAnalyzer, Warning, TEXT("Export file order to %s ignored, another export is running."), *InOutputPath);
+		return;
+	}
+
+	// The file list is gathered here, the export thread builds its own graph from it. Tree updates wait until the export finishes
+	TArray<FPakFileEntryPtr> Files;
+	for (const FPakTreeEntryPtr& TreeRoot : PakTreeRoots)
+	{
+		RetriveFiles(TreeRoot, TEXT(""), TMap<FName, bool>(), TMap<int32, bool>(), Files);
+	}
+
+	bExporting = true;
+	ExportStopCounter.Reset();
+	const int32 Serial = ++ExportSerial;
+
+	FPakAnalyzerDelegates::OnExportStart.ExecuteIfBound();
+
+	ExportFuture = Async(EAsyncExecution::Thread, [this, InOutputPath, RootPackages = InRootPackages, Device = InDevice, Files = MoveTemp(Files), Serial]() mutable
+		{
+			FExportProgress Progress;
+			Progress.StopCounter = &ExportStopCounter;
+			Progress.OnProgress = &FBaseAnalyzer::DispatchExportProgress;
+
+			TSharedPtr<FDependencyGraph> Graph = MakeShared<FDependencyGraph>();
+			Graph->Build(Files);
+
+			FPakOrderEstimate Estimate;
+			const bool bResult = WriteFileOrder(InOutputPath, Files, *Graph, RootPackages, Device, Estimate, &Progress);
+
+			// The graph and the entries are released on the game thread, which owns them
+			const int32 TotalRows = (int32)Progress.TotalRows;
+			FFunctionGraphTask::CreateAndDispatchWhenReady([this, Serial, bResult, TotalRows, Estimate, Files = MoveTemp(Files), Graph = MoveTemp(Graph)]()
+				{
+					if (Serial == ExportSerial)
+					{
+						OnExportFinish(Serial, bResult, TotalRows);
+						FPakAnalyzerDelegates::OnExportFileOrderFinish.Broadcast(bResult, Estimate);
+					}
+				},
+				TStatId(), nullptr, ENamedThreads::GameThread);
+
+			return bResult;
+		});
+}
+
+bool FBaseAnalyzer::WriteFileOrder(const FString& InOutputPath, const TArray<FPakFileEntryPtr>& InFiles, const FDependencyGraph& InGraph, const TArray<FName>& InRootPackages, const FLoadDeviceModel& InDevice, FPakOrderEstimate& OutEstimate, FExportProgress* InProgress)
+{
+	PAK_ANALYZER_TRACE_SCOPE(PakAnalyzer_ExportFileOrder);
+	UE_LOG(LogPakAnalyzer, Log, TEXT("Export file order: %s."), *InOutputPath);
+
+	const double StartTime = FPlatformTime::Seconds();
+
+	TArray<FLoadRead> Reads;
+	Reads.Reserve(InFiles.Num());
+	for (const FPakFileEntryPtr& File : InFiles)
+	{
+		Reads.Add(FLoadSimulator::MakeRead(*File, GetPakVersion(File->OwnerPakIndex)));
+	}
+
+	TArray<int32> Roots;
+	for (const FName& PackageName : InRootPackages)
+	{
+		const int32 PackageId = InGraph.FindPackageId(PackageName);
+		if (PackageId != INDEX_NONE)
+		{
+			Roots.AddUnique(PackageId);
+		}
+	}
+
+	FPakOrderOptimizer Optimizer(InGraph, InFiles, Reads);
+
+	TArray<int32> FileOrder;
+	Optimizer.Optimize(Roots, FileOrder);
+
+	if (InProgress && InProgress->IsStopped())
+	{
+		UE_LOG(LogPakAnalyzer, Warning, TEXT("Export file order: %s canceled."), *InOutputPath);
+		return false;
+	}
+
+	TArray<int64> Offsets;
+	Optimizer.GetCurrentOffsets(Offsets);
+	Optimizer.Simulate(Roots, Offsets, InDevice, OutEstimate.Before);
+
+	Optimizer.GetOffsets(FileOrder, Offsets);
+	Optimizer.Simulate(Roots, Offsets, InDevice, OutEstimate.After);
+
+	OutEstimate.RootCount = Roots.Num();
+	OutEstimate.FileCount = FileOrder.Num();
+
+	// The tree strips the relative prefix of the mount point, UnrealPak matches the path the file was added with
+	TArray<FString> MountPoints;
+	TArray<int32> TreePrefixLens;
+	MountPoints.SetNum(PakFileSummaries.Num());
+	TreePrefixLens.SetNumZeroed(PakFileSummaries.Num());
+	for (int32 i = 0; i < PakFileSummaries.Num(); ++i)
+	{
+		if (!PakFileSummaries[i].IsValid())
+		{
+			continue;
+		}
+
+		MountPoints[i] = PakFileSummaries[i]->MountPoint;
+		if (MountPoints[i].Len() > 0 && !MountPoints[i].EndsWith(TEXT("/")) && !MountPoints[i].EndsWith(TEXT("\\")))
+		{
+			MountPoints[i].AppendChar(TEXT('/'));
+		}
+
+		const int32 TreeMountPointLen = GetTreeMountPoint(PakFileSummaries[i]->MountPoint).Len();
+		TreePrefixLens[i] = TreeMountPointLen > 0 ? TreeMountPointLen + 1 : 0;
+	}
+
+	FExportWriter Writer(InOutputPath, InProgress);
+	if (!Writer.IsValid())
+	{
+		UE_LOG(LogPakAnalyzer, Error, TEXT("Export file order: %s failed, can't open file for writing."), *InOutputPath);
+		return false;
+	}
+
+	if (InProgress)
+	{
+		InProgress->TotalRows = FileOrder.Num();
+	}
+
+	const int32 LineTerminatorLen = FCString::Strlen(LINE_TERMINATOR);
+
+	// UnrealPak order file, one quoted path and its order per line
+	Writer.WriteRows(FileOrder.Num(), [&InFiles, &FileOrder, &MountPoints, &TreePrefixLens, LineTerminatorLen](int32 InRow, FExportBuffer& OutBuffer)
+		{
+			const FPakFileEntry& File = *InFiles[FileOrder[InRow]];
+
+			OutBuffer.Append("\"");
+			if (MountPoints.IsValidIndex(File.OwnerPakIndex) && File.Path.Len() > TreePrefixLens[File.OwnerPakIndex])
+			{
+				const int32 PrefixLen = TreePrefixLens[File.OwnerPakIndex];
+				OutBuffer.Append(MountPoints[File.OwnerPakIndex]);
+				OutBuffer.Append(*File.Path + PrefixLen, File.Path.Len() - PrefixLen);
+			}
+			else
+			{
+				OutBuffer.Append(File.Path);
+			}
+			OutBuffer.Append("\" ").AppendInt(InRow + 1);
+			OutBuffer.Append(LINE_TERMINATOR, LineTerminatorLen);
+		});
+
+	FPakAnalyzerTrace::CountWrite(Writer.GetWrittenSize());
+
+	const bool bExportResult = Writer.Close();
+
+	UE_LOG(LogPakAnalyzer, Log, TEXT("Export file order: %s finished, root count: %d, file count: %d, estimated time: %.3fs -> %.3fs, cost: %.2fs, result: %d."),
+		*InOutputPath, OutEstimate.RootCount, OutEstimate.FileCount, OutEstimate.Before.EstimatedTime, OutEstimate.After.EstimatedTime, FPlatformTime::Seconds() - StartTime, bExportResult);
+
+	return bExportResult;
+}
+
+const FDependencyGraph& FBaseAnalyzer::GetDependencyGraph()
+{
+	if (!DependencyGraph.IsValid())
+	{
+		FScopeLock Lock(&CriticalSection);
+
+		DependencyGraph = MakeShared<FDependencyGraph>();
+		DependencyGraph->Build(PakTreeRoots);
+	}
+
+	return *DependencyGraph;
+}
+
+void FBaseAnalyzer::GetSessionStats(FPakSessionStats& OutStats) const
+{
+	OutStats = SessionStats;
+
+	if (AssetRegistryIndex.IsValid())
+	{
+		OutStats.RegistryPackageCount = AssetRegistryIndex->GetPackageCount();
+		OutStats.RegistryMemory = AssetRegistryIndex->GetAllocatedSize();
+	}
+
+	if (DependencyGraph.IsValid())
+	{
+		OutStats.GraphPackageCount = DependencyGraph->Num();
+		OutStats.GraphMemory = DependencyGraph->GetAllocatedSize();
+	}
+}
+
+void FBaseAnalyzer::CountAssetSummary(const FAssetSummaryPtr& InSummary, int32 InSign)
+{
+	if (!InSummary.IsValid())
+	{
+		return;
+	}
+
+	const FObjectExportTable& Exports = InSummary->ObjectExports;
+	const int64 ExportMemory = Exports.ObjectNames.GetAllocatedSize() + Exports.ObjectPaths.GetAllocatedSize() + Exports.ClassNames.GetAllocatedSize()
+		+ Exports.TemplateObjects.GetAllocatedSize() + Exports.Supers.GetAllocatedSize() + Exports.SerialSizes.GetAllocatedSize()
+		+ Exports.SerialOffsets.GetAllocatedSize() + Exports.Flags.GetAllocatedSize() + Exports.DependencySpans.GetAllocatedSize();
+
+	SessionStats.AssetSummaryCount += InSign;
+	SessionStats.AssetSummaryMemory += InSign * (int64)(sizeof(FAssetSummary) + SharedControllerSize);
+	SessionStats.NameMemory += InSign * (int64)InSummary->Names.GetAllocatedSize();
+	SessionStats.ImportMemory += InSign * (int64)InSummary->ObjectImports.GetAllocatedSize();
+	SessionStats.ExportMemory += InSign * ExportMemory;
+	SessionStats.EdgeMemory += InSign * (int64)InSummary->PackageEdges.GetAllocatedSize();
+}
+
+FString FBaseAnalyzer::GetTreeMountPoint(const FString& InMountPoint)
+{
+	static const TCHAR* Delims[2] = { TEXT("\\"), TEXT("/") };
+
+	FString MountPoint = InMountPoint;
+	MountPoint.ReplaceInline(TEXT("../"), TEXT(""));
+	MountPoint.ReplaceInline(TEXT("..\\"), TEXT(""));
+
+	// Same form as the paths built by InsertFileToTree
+	TArray<FString> PathItems;
+	MountPoint.ParseIntoArray(PathItems, Delims, 2);
+
+	FString TreeMountPoint;
+	for (const FString& PathItem : PathItems)
+	{
+		TreeMountPoint = TreeMountPoint / PathItem;
+	}
+
+	return TreeMountPoint;
+}
+
+int32 FBaseAnalyzer::GetPakVersion(int32 InPakIndex) const
+{
+	return PakFileSummaries.IsValidIndex(InPakIndex) && PakFileSummaries[InPakIndex].IsValid() ? PakFileSummaries[InPakIndex]->PakInfo.Version : FPakInfo::PakFile_Version_Latest;
+}
+
+void FBaseAnalyzer::GetPakVersions(TArray<int32>& OutVersions) const
+{
+	OutVersions.Empty(PakFileSummaries.Num());
+	for (int32 PakIndex = 0; PakIndex < PakFileSummaries.Num(); ++PakIndex)
+	{
+		OutVersions.Add(GetPakVersion(PakIndex));
+	}
+}
+
+FName FBaseAnalyzer::GetPackagePath(const FString& InFilePath)
+{
+	FString Left, Right;
+	if (InFilePath.Split(TEXT("/Content/"), &Left, &Right))
+	{
+		const FString Prefix = FPaths::GetPathLeaf(Left);
+		const bool bNotUseGamePrefix = Prefix == TEXT("Engine") || InFilePath.Contains(TEXT("Plugin"));
 
 		const FString RemoveFirstExtension = FPaths::SetExtension(Right, TEXT(""));
 		const FString RemoveSecondExtension = FPaths::SetExtension(RemoveFirstExtension, TEXT(""));
@@ -493,6 +2016,17 @@ FName FBaseAnalyzer::GetPackagePath(const FString& InFilePath)
 
 void FBaseAnalyzer::Reset()
 {
+	CancelExport();
+	if (ExportFuture.IsValid())
+	{
+		ExportFuture.Wait();
+		ExportFuture = TFuture<bool>();
+	}
+
+	++ExportSerial;
+	bExporting = false;
+	DeferredUpdates.Empty();
+
 	for (FPakFileSumaryPtr Summary : PakFileSummaries)
 	{
 		Summary.Reset();
@@ -506,10 +2040,41 @@ void FBaseAnalyzer::Reset()
 	PakFileSummaries.Empty();
 	PakTreeRoots.Empty();
 
-	AssetRegistryState.Reset();
+	if (AssetRegistryWorker.IsValid())
+	{
+		AssetRegistryWorker->Shutdown();
+	}
+
+	AssetRegistryApplyStopCounter.Increment();
+	if (AssetRegistryApplyFuture.IsValid())
+	{
+		AssetRegistryApplyFuture.Wait();
+		AssetRegistryApplyFuture = TFuture<void>();
+	}
+
+	CancelSimulateLoad();
+
+	// The compared file table stays cached, the next diff only joins again
+	CancelDiffPakFiles();
+
+	CancelEstimateRecompression();
+	if (EstimateFuture.IsValid())
+	{
+		EstimateFuture.Wait();
+		EstimateFuture = TFuture<void>();
+	}
+
+	++EstimateSerial;
+	bEstimatingRecompression = false;
+
+	++AssetRegistryLoadSerial;
+	AssetRegistryIndex.Reset();
+	DependencyGraph.Reset();
 
 	AssetRegistryPath = TEXT("");
 	DefaultClassMap.Empty();
+
+	SessionStats = FPakSessionStats();
 }
 
 FString FBaseAnalyzer::ResolveCompressionMethod(const FPakFileSumary& Summary, const FPakEntry* InPakEntry) const
@@ -572,8 +2137,20 @@ FPakTreeEntryPtr FBaseAnalyzer::InsertFileToTree(FPakTreeEntryPtr InRoot, const
 				NewChild->PakEntry = InPakEntry;
 				NewChild->CompressionMethod = *ResolveCompressionMethod(Summary, &InPakEntry);
 				NewChild->PackagePath = GetPackagePath(CurrentPath);
+
+				SessionStats.FileCount++;
+				SessionStats.CompressionBlockMemory += NewChild->PakEntry.CompressionBlocks.GetAllocatedSize();
+			}
+			else
+			{
+				SessionStats.DirectoryCount++;
 			}
 
+			// The node with its shared reference controller, plus its slot in the parent map
+			SessionStats.TreeNodeCount++;
+			SessionStats.TreeNodeMemory += sizeof(FPakTreeEntry) + SharedControllerSize + sizeof(TPair<FName, FPakTreeEntryPtr>) + sizeof(FSetElementId) * 2;
+			SessionStats.PathMemory += NewChild->Path.GetAllocatedSize();
+
 			Parent->ChildrenMap.Add(*PathItems[i], NewChild);
 			Parent = NewChild;
 		}
@@ -4,14 +4,30 @@
 
 #include "CoreMinimal.h"
 
+#include "Async/Future.h"
 #include "HAL/CriticalSection.h"
+#include "HAL/ThreadSafeCounter.h"
 #include "Misc/AES.h"
 #include "Misc/Guid.h"
 #include "Misc/SecureHash.h"
 
+#include "AssetParseThreadWorker.h"
+#include "AssetRegistryThreadWorker.h"
+#include "DependencyGraph.h"
 #include "IPakAnalyzer.h"
 
-class FArrayReader;
+struct FFileReadContext;
+
+/** Registry data of one loaded file, looked up off the game thread. */
+struct FAssetRegistryFileResult
+{
+	FPakFileEntryPtr File;
+	FName Class;
+	bool bHasDependencies = false;
+	bool bHasReferencers = false;
+	TArray<FPackageInfo> Dependencies;
+	TArray<FPackageInfo> Referencers;
+};
 
 class FBaseAnalyzer : public IPakAnalyzer
 {
@@ -23,29 +39,117 @@ public:
 	virtual void GetFiles(const FString& InFilterText, const TMap<FName, bool>& InClassFilterMap, const TMap<int32, bool>& InPakIndexFilter, TArray<FPakFileEntryPtr>& OutFiles) const override;
 	virtual const TArray<FPakFileSumaryPtr>& GetPakFileSumary() const override;
 	virtual const TArray<FPakTreeEntryPtr>& GetPakTreeRootNode() const override;
-	virtual bool LoadAssetRegistry(const FString& InRegristryPath) override;
+	virtual bool StartLoadAssetRegistry(const FString& InRegristryPath) override;
 	virtual bool ExportToJson(const FString& InOutputPath, const TArray<FPakFileEntryPtr>& InFiles) override;
 	virtual bool ExportToCsv(const FString& InOutputPath, const TArray<FPakFileEntryPtr>& InFiles) override;
+	virtual bool ExportToColumnar(const FString& InOutputPath, const TArray<FPakFileEntryPtr>& InFiles) override;
+	virtual bool ExportToSql(const FString& InOutputPath, const TArray<FPakFileEntryPtr>& InFiles) override;
+	virtual void StartExport(EPakExportFormat InFormat, const FString& InOutputPath, const TArray<FPakFileEntryPtr>& InFiles) override;
+	virtual void CancelExport() override;
+	virtual bool IsExporting() const override;
 	virtual FString GetAssetRegistryPath() const override;
 	virtual void ExtractFiles(const FString& InOutputPath, TArray<FPakFileEntryPtr>& InFiles) override {}
+	virtual void ExtractFilesWithDependencies(const FString& InOutputPath, const TArray<FPakFileEntryPtr>& InFiles) override;
 	virtual void CancelExtract() override {}
 	virtual void SetExtractThreadCount(int32 InThreadCount) override {}
+	virtual void PrioritizeAssetParse(const TArray<FPakFileEntryPtr>& InFiles) override {}
+	virtual bool GetDependencyClosure(const TArray<FName>& InPackageNames, bool bReverse, FDependencyClosure& OutClosure) override;
+	virtual bool GetShortestDependencyChain(FName InFrom, FName InTo, TArray<FName>& OutChain) override;
+	virtual void GetDependencyCycles(TArray<FDependencyCyclePtr>& OutCycles) override;
+	virtual void GetUnreferencedPackages(const FUnreferencedPackageOptions& InOptions, TArray<FUnreferencedPackagePtr>& OutPackages) override;
+	virtual void GetDuplicateFiles(TArray<FDuplicateGroupPtr>& OutGroups) override;
+	virtual void SimulateLoad(const TArray<FName>& InRootPackages, const FLoadDeviceModel& InDevice, TArray<FLoadSimulation>& OutSimulations) override;
+	virtual void StartSimulateLoad(const TArray<FName>& InRootPackages, const FLoadDeviceModel& InDevice) override;
+	virtual void CancelSimulateLoad() override;
+	virtual bool IsSimulatingLoad() const override;
+	virtual bool GetPakLayout(int32 InPakIndex, FPakLayout& OutLayout) override;
+	virtual bool EstimateRecompression(const TArray<FPakFileEntryPtr>& InFiles, const FRecompressionOptions& InOptions, FRecompressionResult& OutResult) override;
+	virtual void StartEstimateRecompression(const TArray<FPakFileEntryPtr>& InFiles, const FRecompressionOptions& InOptions) override;
+	virtual void CancelEstimateRecompression() override;
+	virtual bool IsEstimatingRecompression() const override;
+	virtual bool DiffPakFiles(const TArray<FString>& InPakPaths, const TArray<FString>& InDefaultAESKeys, FPakDiffResult& OutResult) override;
+	virtual void StartDiffPakFiles(const TArray<FString>& InPakPaths, const TArray<FString>& InDefaultAESKeys) override;
+	virtual void CancelDiffPakFiles() override;
+	virtual bool IsDiffingPakFiles() const override;
+	virtual bool VerifyPakFiles(FPakVerifyResult& OutResult) override;
+	virtual bool ExportFileOrder(const FString& InOutputPath, const TArray<FName>& InRootPackages, const FLoadDeviceModel& InDevice, FPakOrderEstimate& OutEstimate) override;
+	virtual void StartExportFileOrder(const FString& InOutputPath, const TArray<FName>& InRootPackages, const FLoadDeviceModel& InDevice) override;
+	virtual void GetSessionStats(FPakSessionStats& OutStats) const override;
 
 protected:
 	virtual void Reset();
 	virtual FString ResolveCompressionMethod(const FPakFileSumary& Summary, const FPakEntry* InPakEntry) const;
 
 	FPakTreeEntryPtr InsertFileToTree(FPakTreeEntryPtr InRoot, const FPakFileSumary& Summary, const FString& InFullPath, const FPakEntry& InPakEntry);
-	bool LoadAssetRegistry(FArrayReader& InData);
+	void StartLoadAssetRegistry(TArray<uint8>& InData, const FString& InRegistryPath);
+	FAssetRegistryThreadWorker& GetAssetRegistryWorker();
 	void RefreshPackageDependency(FPakTreeEntryPtr InTreeRoot, FPakTreeEntryPtr InRoot);
+
+	/** Replaces the edges of a summary with the registry ones when the registry knows the package, game thread only. */
+	void ApplyRegistryDependencies(FAssetSummary& InOutSummary, FName InPackagePath) const;
 	void RefreshClassMap(FPakTreeEntryPtr InTreeRoot, FPakTreeEntryPtr InRoot);
 	void RefreshTreeNode(FPakTreeEntryPtr InRoot);
 	void RefreshTreeNodeSizePercent(FPakTreeEntryPtr InTreeRoot, FPakTreeEntryPtr InRoot);
 	void RetriveFiles(FPakTreeEntryPtr InRoot, const FString& InFilterText, const TMap<FName, bool>& InClassFilterMap, const TMap<int32, bool>& InPakIndexFilter, TArray<FPakFileEntryPtr>& OutFiles) const;
 	void RetriveUAssetFiles(FPakTreeEntryPtr InRoot, TArray<FPakFileEntryPtr>& OutFiles) const;
 	void InsertClassInfo(FPakTreeEntryPtr InTreeRoot, FPakTreeEntryPtr InRoot, FName InClassName, int32 InFileCount, int64 InSize, int64 InCompressedSize);
+	bool GetTreeAncestors(FPakFileEntryPtr InFile, TArray<FPakTreeEntryPtr>& OutAncestors) const;
+	bool UpdateFileClass(FPakFileEntryPtr InFile, FName InNewClass);
 	FName GetAssetClass(const FString& InFilename, const FName InPackagePath);
-	FName GetPackagePath(const FString& InFilePath);
+	static FName GetAssetClass(const FString& InFilename, const FName InPackagePath, const FAssetRegistryIndex* InIndex, const TMap<FName, FName>& InDefaultClassMap);
+	static FName GetPackagePath(const FString& InFilePath);
+	const FDependencyGraph& GetDependencyGraph();
+	int32 GetPakVersion(int32 InPakIndex) const;
+	void GetPakVersions(TArray<int32>& OutVersions) const;
+
+	/** Reads nothing but its arguments, false when stopped. */
+	static bool RunLoadSimulation(const FDependencyGraph& InGraph, const TArray<int32>& InPakVersions, const TArray<FName>& InRootPackages, const FLoadDeviceModel& InDevice, const FThreadSafeCounter* InStopCounter, TArray<FLoadSimulation>& OutSimulations);
+	void GetOwnerPakNames(TArray<FString>& OutNames) const;
+
+	/** Mount point as it prefixes the paths of the tree, the relative part stripped. */
+	static FString GetTreeMountPoint(const FString& InMountPoint);
+
+	// Export writers, safe to call from the export thread while the tree is left untouched
+	bool WriteJson(const FString& InOutputPath, const TArray<FPakFileEntryPtr>& InFiles, struct FExportProgress* InProgress);
+	bool WriteCsv(const FString& InOutputPath, const TArray<FPakFileEntryPtr>& InFiles, struct FExportProgress* InProgress);
+	bool WriteColumnar(const FString& InOutputPath, const TArray<FPakFileEntryPtr>& InFiles, struct FExportProgress* InProgress);
+	bool WriteSql(const FString& InOutputPath, const TArray<FPakFileEntryPtr>& InFiles, struct FExportProgress* InProgress);
+	bool WriteFileOrder(const FString& InOutputPath, const TArray<FPakFileEntryPtr>& InFiles, const FDependencyGraph& InGraph, const TArray<FName>& InRootPackages, const FLoadDeviceModel& InDevice, FPakOrderEstimate& OutEstimate, struct FExportProgress* InProgress);
+	static void DispatchExportProgress(int64 InCompleteRows, int64 InTotalRows);
+	void OnExportFinish(int32 InSerial, bool bSuccess, int32 InTotalRows);
+
+	/** Runs a tree update on the game thread, held back until a running export finishes. */
+	void DispatchTreeUpdate(TUniqueFunction<void()>&& InUpdate);
+
+	/** Adds or removes the estimated memory of a summary from the session stats, InSign is 1 or -1. */
+	void CountAssetSummary(const FAssetSummaryPtr& InSummary, int32 InSign);
+
+	/** Checks the paks to compare and asks for missing keys, on the game thread. */
+	virtual bool ResolveDiffKeys(const TArray<FString>& InPakPaths, const TArray<FString>& InDefaultAESKeys, TArray<FString>& OutKeys);
+
+	/** Reads the file table of another pak set without loading it, safe to call from any thread with resolved keys. */
+	virtual bool LoadDiffRecords(const TArray<FString>& InPakPaths, const TArray<FString>& InKeys, const FAssetRegistryIndex* InIndex, const TMap<FName, FName>& InDefaultClassMap, const FThreadSafeCounter* InStopCounter, TArray<FPakDiffRecord>& OutRecords) { return false; }
+
+	/** Old side of a diff, the files in load order so a patch pak overrides the paks before it. */
+	void GetDiffFiles(TArray<FPakFileEntryPtr>& OutFiles, TArray<FName>& OutClasses) const;
+	static void MakeDiffRecords(const TArray<FPakFileEntryPtr>& InFiles, const TArray<FName>& InClasses, TArray<FPakDiffRecord>& OutRecords);
+
+	/** Reads the uncompressed content of a file, safe to call from any thread with its own context and a copy of the owner pak summary. */
+	virtual bool ReadFileContent(const FPakFileSumary& InSummary, const FPakFileEntry& InFile, FFileReadContext& InContext, TArray<uint8>& OutContent) const;
+	bool RunRecompressionEstimate(const TArray<FPakFileEntryPtr>& InFiles, const FRecompressionOptions& InOptions, const TArray<FPakFileSumary>& InSummaries, const FThreadSafeCounter* InStopCounter, FRecompressionResult& OutResult) const;
+	void CopyPakSummaries(TArray<FPakFileSumary>& OutSummaries) const;
+
+	// Asset parse results, called from the parse worker
+	void OnPackagesParsed(TArray<FAssetParseResult>& InResults);
+	void OnAssetParseFinish(bool bCancel, DependentTypeArray& Dependents);
+
+	// Asset registry results, called from the registry worker
+	void OnAssetRegistryLoadProgress(float InProgress);
+	void OnAssetRegistryLoadFinish(FAssetRegistryIndexPtr InIndex, const FString& InRegistryPath);
+
+	/** Looks up the registry data of every file on a pool thread and applies it on the game thread in batches. Stops when the stop counter moves past InStopValue. */
+	void LookupAssetRegistry(int32 InLoadSerial, int32 InStopValue, const FAssetRegistryIndex& InIndex, TArray<FPakFileEntryPtr>& InFiles);
+	void ApplyAssetRegistryResults(const TArray<FAssetRegistryFileResult>& InResults);
 
 protected:
 	FCriticalSection CriticalSection;
@@ -56,5 +160,52 @@ protected:
 
 	FString AssetRegistryPath;
 
-	TSharedPtr<class FAssetRegistryState> AssetRegistryState;
+	FAssetRegistryIndexPtr AssetRegistryIndex;
+	TSharedPtr<FAssetRegistryThreadWorker> AssetRegistryWorker;
+
+	/** Built on demand, reset whenever package dependencies change. */
+	FDependencyGraphPtr DependencyGraph;
+
+	/** Increased on reset and on every registry load, results of an earlier load are dropped. */
+	int32 AssetRegistryLoadSerial;
+
+	/** Increased on the same events, a running lookup stops once it differs from the value it started with. */
+	FThreadSafeCounter AssetRegistryApplyStopCounter;
+	TFuture<void> AssetRegistryApplyFuture;
+
+	/** Updated where tree nodes and summaries are created, registry and graph sizes are read on request. */
+	FPakSessionStats SessionStats;
+
+	FThreadSafeCounter ExportStopCounter;
+	TFuture<bool> ExportFuture;
+	bool bExporting;
+
+	/** Increased per export and on reset, a finished export of an earlier session is dropped. */
+	int32 ExportSerial;
+	TArray<TUniqueFunction<void()>> DeferredUpdates;
+
+	FThreadSafeCounter EstimateStopCounter;
+	TFuture<void> EstimateFuture;
+	bool bEstimatingRecompression;
+
+	/** Increased per estimate and on reset, a finished estimate of an earlier session is dropped. */
+	int32 EstimateSerial;
+
+	FThreadSafeCounter SimulateStopCounter;
+	TFuture<void> SimulateFuture;
+	bool bSimulatingLoad;
+
+	/** Increased per simulation and on cancel, only the latest simulation is published. */
+	int32 SimulateSerial;
+
+	FThreadSafeCounter DiffStopCounter;
+	TFuture<void> DiffFuture;
+	bool bDiffing;
+
+	/** Increased per diff and on cancel, only the latest diff is published. */
+	int32 DiffSerial;
+
+	/** File table of the last compared paks, kept across pak loads so a reload only joins again. */
+	TArray<FString> DiffPakPaths;
+	TSharedPtr<const TArray<FPakDiffRecord>, ESPMode::ThreadSafe> DiffRecords;
 };
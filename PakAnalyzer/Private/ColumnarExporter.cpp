@@ -0,0 +1,363 @@
+#include "ColumnarExporter.h"
+
+#include "HAL/FileManager.h"
+
+#include "CommonDefines.h"
+#include "DependencyGraph.h"
+#include "ExportWriter.h"
+
+namespace ColumnarExporterPrivate
+{
+	static const uint32 Magic = 0x43565055; // "UPVC"
+	static const uint32 Version = 1;
+	static const int32 StagingSize = 1024 * 1024;
+
+	// Columns of the file table, progress counts every value written
+	static const int32 FileColumnCount = 15;
+
+	enum class EColumnType : uint8
+	{
+		Int32,
+		Int64,
+		UInt8,
+		FixedBinary,
+		Dictionary,
+	};
+
+	struct FColumnInfo
+	{
+		FString Name;
+		EColumnType Type;
+		int32 Width;
+		int32 Dictionary;
+		int64 Offset;
+		int64 Size;
+	};
+
+	struct FTableInfo
+	{
+		FString Name;
+		int64 RowCount = 0;
+		TArray<FColumnInfo> Columns;
+	};
+
+	struct FDictionaryInfo
+	{
+		FString Name;
+		int32 Count;
+		int64 Offset;
+		int64 DataSize;
+	};
+
+	/** Unique strings of a column in first seen order. */
+	template<typename KeyType>
+	struct TDictionary
+	{
+		TMap<KeyType, int32> IndexMap;
+		TArray<FString> Values;
+
+		int32 FindOrAdd(const KeyType& InKey)
+		{
+			if (const int32* Index = IndexMap.Find(InKey))
+			{
+				return *Index;
+			}
+
+			const int32 Index = Values.Add(ToString(InKey));
+			IndexMap.Add(InKey, Index);
+			return Index;
+		}
+
+		static FString ToString(FName InKey) { return InKey.ToString(); }
+		static const FString& ToString(const FString& InKey) { return InKey; }
+	};
+
+	class FColumnWriter
+	{
+	public:
+		FColumnWriter(FArchive& InArchive, FExportProgress* InProgress)
+			: Archive(InArchive)
+			, Progress(InProgress)
+		{
+			Staging.Reserve(StagingSize);
+		}
+
+		void Write(const void* InData, int32 InSize)
+		{
+			if (Staging.Num() + InSize > StagingSize)
+			{
+				Flush();
+			}
+			Staging.Append((const uint8*)InData, InSize);
+		}
+
+		template<typename ValueType>
+		void Write(ValueType InValue)
+		{
+			Write(&InValue, sizeof(ValueType));
+		}
+
+		void WriteString(const FString& InText)
+		{
+			FTCHARToUTF8 Converter(*InText, InText.Len());
+			Write<int32>(Converter.Length());
+			Write(Converter.Get(), Converter.Length());
+		}
+
+		/** Every buffer starts 8 bytes aligned, so readers can map it without copying. */
+		int64 BeginBuffer()
+		{
+			static const uint8 Padding[8] = { 0 };
+			const int64 Position = Tell();
+			if (Position % 8 != 0)
+			{
+				Write(Padding, (int32)(8 - Position % 8));
+			}
+			return Tell();
+		}
+
+		bool IsStopped() const
+		{
+			return Progress && Progress->IsStopped();
+		}
+
+		void Advance(int64 InRows)
+		{
+			if (Progress)
+			{
+				Progress->Advance(InRows);
+			}
+		}
+
+		template<typename ValueType, typename FuncType>
+		void WriteColumn(FTableInfo& InTable, const TCHAR* InName, EColumnType InType, int32 InDictionary, FuncType InGetValue)
+		{
+			if (IsStopped())
+			{
+				return;
+			}
+
+			FColumnInfo& Column = InTable.Columns.AddDefaulted_GetRef();
+			Column.Name = InName;
+			Column.Type = InType;
+			Column.Width = sizeof(ValueType);
+			Column.Dictionary = InDictionary;
+			Column.Offset = BeginBuffer();
+
+			for (int64 Row = 0; Row < InTable.RowCount; ++Row)
+			{
+				Write<ValueType>(InGetValue(Row));
+			}
+
+			Column.Size = Tell() - Column.Offset;
+			Advance(InTable.RowCount);
+		}
+
+		void WriteDictionary(TArray<FDictionaryInfo>& InDictionaries, const TCHAR* InName, const TArray<FString>& InValues)
+		{
+			FDictionaryInfo& Info = InDictionaries.AddDefaulted_GetRef();
+			Info.Name = InName;
+			Info.Count = InValues.Num();
+			Info.Offset = BeginBuffer();
+
+			// Offsets of Count + 1 strings first, then the utf-8 bytes
+			int64 DataOffset = 0;
+			Write<int64>(DataOffset);
+			for (const FString& Value : InValues)
+			{
+				DataOffset += FTCHARToUTF8(*Value, Value.Len()).Length();
+				Write<int64>(DataOffset);
+			}
+
+			for (const FString& Value : InValues)
+			{
+				FTCHARToUTF8 Converter(*Value, Value.Len());
+				Write(Converter.Get(), Converter.Length());
+			}
+
+			Info.DataSize = DataOffset;
+		}
+
+		int64 Tell() const
+		{
+			return Archive.Tell() + Staging.Num();
+		}
+
+		void Flush()
+		{
+			if (Staging.Num() > 0)
+			{
+				Archive.Serialize(Staging.GetData(), Staging.Num());
+				Staging.Reset();
+			}
+		}
+
+	protected:
+		FArchive& Archive;
+		FExportProgress* Progress;
+		TArray<uint8> Staging;
+	};
+}
+
+bool FColumnarExporter::Export(const FString& InOutputPath, const TArray<FPakFileEntryPtr>& InFiles, const TArray<FString>& InPakNames, const FDependencyGraph& InGraph, FExportProgress* InProgress)
+{
+	using namespace ColumnarExporterPrivate;
+
+	TUniquePtr<FArchive> Archive(IFileManager::Get().CreateFileWriter(*InOutputPath));
+	if (!Archive.IsValid())
+	{
+		UE_LOG(LogPakAnalyzer, Error, TEXT("Export to columnar: %s failed, can't open file for writing."), *InOutputPath);
+		return false;
+	}
+
+	FColumnWriter Writer(*Archive, InProgress);
+	Writer.Write<uint32>(Magic);
+	Writer.Write<uint32>(Version);
+
+	enum EDictionary { Directories, Names, Classes, CompressionMethods, Paks, Packages };
+
+	TDictionary<FString> DirectoryDictionary;
+	TDictionary<FName> NameDictionary;
+	TDictionary<FName> ClassDictionary;
+	TDictionary<FName> MethodDictionary;
+
+	TArray<int32> PackageIds;
+	PackageIds.SetNumUninitialized(InFiles.Num());
+	TBitArray<> ExportedPackages(false, InGraph.Num());
+
+	for (int32 i = 0; i < InFiles.Num(); ++i)
+	{
+		const FName PackagePath = InFiles[i]->PackagePath;
+		PackageIds[i] = PackagePath.IsNone() ? INDEX_NONE : InGraph.FindPackageId(PackagePath);
+		if (PackageIds[i] != INDEX_NONE)
+		{
+			ExportedPackages[PackageIds[i]] = true;
+		}
+	}
+
+	// Edges whose source package has a file in the export, in graph order
+	TArray<TPair<int32, int32>> Edges;
+	for (TConstSetBitIterator<> It(ExportedPackages); It; ++It)
+	{
+		for (const int32 Dependency : InGraph.GetDependencies(It.GetIndex()))
+		{
+			Edges.Emplace(It.GetIndex(), Dependency);
+		}
+	}
+
+	if (InProgress)
+	{
+		InProgress->TotalRows = (int64)InFiles.Num() * FileColumnCount + Edges.Num() * 2;
+	}
+
+	FTableInfo FileTable;
+	FileTable.Name = TEXT("Files");
+	FileTable.RowCount = InFiles.Num();
+
+	Writer.WriteColumn<int32>(FileTable, TEXT("Directory"), EColumnType::Dictionary, Directories, [&](int64 Row)
+		{
+			const FString& Path = InFiles[Row]->Path;
+			int32 SlashIndex = INDEX_NONE;
+			return DirectoryDictionary.FindOrAdd(Path.FindLastChar(TEXT('/'), SlashIndex) ? Path.Left(SlashIndex) : FString());
+		});
+	Writer.WriteColumn<int32>(FileTable, TEXT("Name"), EColumnType::Dictionary, Names, [&](int64 Row) { return NameDictionary.FindOrAdd(InFiles[Row]->Filename); });
+	Writer.WriteColumn<int32>(FileTable, TEXT("Class"), EColumnType::Dictionary, Classes, [&](int64 Row) { return ClassDictionary.FindOrAdd(InFiles[Row]->Class); });
+	Writer.WriteColumn<int32>(FileTable, TEXT("CompressionMethod"), EColumnType::Dictionary, CompressionMethods, [&](int64 Row) { return MethodDictionary.FindOrAdd(InFiles[Row]->CompressionMethod); });
+	Writer.WriteColumn<int32>(FileTable, TEXT("OwnerPak"), EColumnType::Dictionary, Paks, [&](int64 Row) { return InPakNames.IsValidIndex(InFiles[Row]->OwnerPakIndex) ? (int32)InFiles[Row]->OwnerPakIndex : INDEX_NONE; });
+	Writer.WriteColumn<int32>(FileTable, TEXT("Package"), EColumnType::Dictionary, Packages, [&](int64 Row) { return PackageIds[Row]; });
+	Writer.WriteColumn<int64>(FileTable, TEXT("Offset"), EColumnType::Int64, INDEX_NONE, [&](int64 Row) { return InFiles[Row]->PakEntry.Offset; });
+	Writer.WriteColumn<int64>(FileTable, TEXT("Size"), EColumnType::Int64, INDEX_NONE, [&](int64 Row) { return InFiles[Row]->PakEntry.UncompressedSize; });
+	Writer.WriteColumn<int64>(FileTable, TEXT("CompressedSize"), EColumnType::Int64, INDEX_NONE, [&](int64 Row) { return InFiles[Row]->PakEntry.Size; });
+	Writer.WriteColumn<int32>(FileTable, TEXT("CompressionBlockCount"), EColumnType::Int32, INDEX_NONE, [&](int64 Row) { return InFiles[Row]->PakEntry.CompressionBlocks.Num(); });
+	Writer.WriteColumn<int32>(FileTable, TEXT("CompressionBlockSize"), EColumnType::Int32, INDEX_NONE, [&](int64 Row) { return (int32)InFiles[Row]->PakEntry.CompressionBlockSize; });
+	Writer.WriteColumn<uint8>(FileTable, TEXT("Encrypted"), EColumnType::UInt8, INDEX_NONE, [&](int64 Row) { return (uint8)(InFiles[Row]->PakEntry.IsEncrypted() ? 1 : 0); });
+	Writer.WriteColumn<int32>(FileTable, TEXT("DependencyCount"), EColumnType::Int32, INDEX_NONE, [&](int64 Row) { return InFiles[Row]->AssetSummary.IsValid() ? InFiles[Row]->AssetSummary->GetDependencyCount() : 0; });
+	Writer.WriteColumn<int32>(FileTable, TEXT("DependentCount"), EColumnType::Int32, INDEX_NONE, [&](int64 Row) { return InFiles[Row]->AssetSummary.IsValid() ? InFiles[Row]->AssetSummary->GetDependentCount() : 0; });
+
+	if (!Writer.IsStopped())
+	{
+		FColumnInfo& Column = FileTable.Columns.AddDefaulted_GetRef();
+		Column.Name = TEXT("SHA1");
+		Column.Type = EColumnType::FixedBinary;
+		Column.Width = sizeof(FPakEntry::Hash);
+		Column.Dictionary = INDEX_NONE;
+		Column.Offset = Writer.BeginBuffer();
+		for (const FPakFileEntryPtr& File : InFiles)
+		{
+			Writer.Write(File->PakEntry.Hash, sizeof(File->PakEntry.Hash));
+		}
+		Column.Size = Writer.Tell() - Column.Offset;
+		Writer.Advance(InFiles.Num());
+	}
+
+	FTableInfo EdgeTable;
+	EdgeTable.Name = TEXT("DependencyEdges");
+	EdgeTable.RowCount = Edges.Num();
+
+	Writer.WriteColumn<int32>(EdgeTable, TEXT("From"), EColumnType::Dictionary, Packages, [&](int64 Row) { return Edges[Row].Key; });
+	Writer.WriteColumn<int32>(EdgeTable, TEXT("To"), EColumnType::Dictionary, Packages, [&](int64 Row) { return Edges[Row].Value; });
+
+	if (Writer.IsStopped())
+	{
+		Archive.Reset();
+		IFileManager::Get().Delete(*InOutputPath);
+
+		UE_LOG(LogPakAnalyzer, Log, TEXT("Export to columnar: %s cancelled."), *InOutputPath);
+		return false;
+	}
+
+	TArray<FString> PackageNames;
+	PackageNames.Reserve(InGraph.Num());
+	for (int32 i = 0; i < InGraph.Num(); ++i)
+	{
+		PackageNames.Add(InGraph.GetPackageName(i).ToString());
+	}
+
+	// Written in EDictionary order
+	TArray<FDictionaryInfo> Dictionaries;
+	Writer.WriteDictionary(Dictionaries, TEXT("Directories"), DirectoryDictionary.Values);
+	Writer.WriteDictionary(Dictionaries, TEXT("Names"), NameDictionary.Values);
+	Writer.WriteDictionary(Dictionaries, TEXT("Classes"), ClassDictionary.Values);
+	Writer.WriteDictionary(Dictionaries, TEXT("CompressionMethods"), MethodDictionary.Values);
+	Writer.WriteDictionary(Dictionaries, TEXT("Paks"), InPakNames);
+	Writer.WriteDictionary(Dictionaries, TEXT("Packages"), PackageNames);
+
+	// Footer: dictionaries and tables, then its offset and the magic again
+	const int64 FooterOffset = Writer.BeginBuffer();
+	Writer.Write<int32>(Dictionaries.Num());
+	for (const FDictionaryInfo& Dictionary : Dictionaries)
+	{
+		Writer.WriteString(Dictionary.Name);
+		Writer.Write<int32>(Dictionary.Count);
+		Writer.Write<int64>(Dictionary.Offset);
+		Writer.Write<int64>(Dictionary.DataSize);
+	}
+
+	const FTableInfo* Tables[] = { &FileTable, &EdgeTable };
+	Writer.Write<int32>(UE_ARRAY_COUNT(Tables));
+	for (const FTableInfo* Table : Tables)
+	{
+		Writer.WriteString(Table->Name);
+		Writer.Write<int64>(Table->RowCount);
+		Writer.Write<int32>(Table->Columns.Num());
+		for (const FColumnInfo& Column : Table->Columns)
+		{
+			Writer.WriteString(Column.Name);
+			Writer.Write<uint8>((uint8)Column.Type);
+			Writer.Write<int32>(Column.Width);
+			Writer.Write<int32>(Column.Dictionary);
+			Writer.Write<int64>(Column.Offset);
+			Writer.Write<int64>(Column.Size);
+		}
+	}
+
+	Writer.Write<int64>(FooterOffset);
+	Writer.Write<uint32>(Magic);
+	Writer.Flush();
+
+	const bool bSuccess = Archive->Close() && !Archive->IsError();
+
+	UE_LOG(LogPakAnalyzer, Log, TEXT("Export to columnar: %s finished, file count: %d, edge count: %d, result: %d."), *InOutputPath, InFiles.Num(), Edges.Num(), bSuccess);
+
+	return bSuccess;
+}
@@ -0,0 +1,18 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+#include "PakFileEntry.h"
+
+class FDependencyGraph;
+struct FExportProgress;
+
+/**
+ * Writes the file table and the dependency edges column by column, so notebooks can map them straight into arrays.
+ * Strings are dictionary encoded, the layout is described in the readme.
+ */
+class FColumnarExporter
+{
+public:
+	static bool Export(const FString& InOutputPath, const TArray<FPakFileEntryPtr>& InFiles, const TArray<FString>& InPakNames, const FDependencyGraph& InGraph, FExportProgress* InProgress = nullptr);
+};
@@ -0,0 +1,392 @@
+#include "DependencyGraph.h"
+
+#include "Algo/Reverse.h"
+#include "Algo/Unique.h"
+#include "Async/ParallelFor.h"
+#include "HAL/PlatformAtomics.h"
+#include "HAL/PlatformTime.h"
+
+#include "CommonDefines.h"
+
+namespace DependencyGraphPrivate
+{
+	// Frontiers smaller than this are expanded on the calling thread
+	static const int32 ParallelFrontierSize = 4096;
+	static const int32 FrontierChunkSize = 1024;
+
+	void CollectFiles(const FPakTreeEntryPtr& InRoot, TArray<FPakFileEntryPtr>& OutFiles)
+	{
+		for (const auto& Pair : InRoot->ChildrenMap)
+		{
+			if (Pair.Value->bIsDirectory)
+			{
+				CollectFiles(Pair.Value, OutFiles);
+			}
+			else
+			{
+				OutFiles.Add(Pair.Value);
+			}
+		}
+	}
+
+	/** Sorts (source, target) pairs into compressed rows indexed by source. */
+	void BuildRows(int32 InNodeCount, const TArray<TPair<int32, int32>>& InEdges, bool bBySource, TArray<int32>& OutOffsets, TArray<int32>& OutIds)
+	{
+		OutOffsets.SetNumZeroed(InNodeCount + 1);
+		for (const TPair<int32, int32>& Edge : InEdges)
+		{
+			++OutOffsets[(bBySource ? Edge.Key : Edge.Value) + 1];
+		}
+
+		for (int32 i = 0; i < InNodeCount; ++i)
+		{
+			OutOffsets[i + 1] += OutOffsets[i];
+		}
+
+		TArray<int32> Cursors(OutOffsets.GetData(), InNodeCount);
+		OutIds.SetNumUninitialized(InEdges.Num());
+		for (const TPair<int32, int32>& Edge : InEdges)
+		{
+			const int32 Row = bBySource ? Edge.Key : Edge.Value;
+			OutIds[Cursors[Row]++] = bBySource ? Edge.Value : Edge.Key;
+		}
+	}
+}
+
+void FDependencyGraph::Build(const TArray<FPakTreeEntryPtr>& InTreeRoots)
+{
+	TArray<FPakFileEntryPtr> AllFiles;
+	for (const FPakTreeEntryPtr& TreeRoot : InTreeRoots)
+	{
+		DependencyGraphPrivate::CollectFiles(TreeRoot, AllFiles);
+	}
+
+	Build(AllFiles);
+}
+
+void FDependencyGraph::Build(const TArray<FPakFileEntryPtr>& InFiles)
+{
+	using namespace DependencyGraphPrivate;
+
+	const double StartTime = FPlatformTime::Seconds();
+
+	PackageIdMap.Empty();
+	PackageNames.Empty();
+
+	TArray<TPair<int32, int32>> FileEdges;
+	FileEdges.Reserve(InFiles.Num());
+
+	TArray<TPair<int32, int32>> Edges;
+	for (int32 i = 0; i < InFiles.Num(); ++i)
+	{
+		const FPakFileEntryPtr& File = InFiles[i];
+		if (File->PackagePath.IsNone())
+		{
+			continue;
+		}
+
+		const int32 PackageId = FindOrAddPackageId(File->PackagePath);
+		FileEdges.Emplace(PackageId, i);
+
+		if (File->AssetSummary.IsValid())
+		{
+			for (const FPackageInfo& Dependency : File->AssetSummary->GetDependencies())
+			{
+				Edges.Emplace(PackageId, FindOrAddPackageId(Dependency.PackageName));
+			}
+
+			// Referencers from the asset registry may live in paks that are not loaded
+			for (const FPackageInfo& Dependent : File->AssetSummary->GetDependents())
+			{
+				Edges.Emplace(FindOrAddPackageId(Dependent.PackageName), PackageId);
+			}
+		}
+	}
+
+	// The same package may be listed by several paks or sources
+	Edges.Sort([](const TPair<int32, int32>& A, const TPair<int32, int32>& B) { return A.Key != B.Key ? A.Key < B.Key : A.Value < B.Value; });
+	Edges.SetNum(Algo::Unique(Edges), false);
+	Edges.RemoveAll([](const TPair<int32, int32>& Edge) { return Edge.Key == Edge.Value; });
+
+	const int32 NodeCount = PackageNames.Num();
+	BuildRows(NodeCount, Edges, true, DependencyOffsets, DependencyIds);
+	BuildRows(NodeCount, Edges, false, DependentOffsets, DependentIds);
+
+	TArray<int32> FileIndices;
+	BuildRows(NodeCount, FileEdges, true, FileOffsets, FileIndices);
+
+	Files.SetNum(FileIndices.Num());
+	Sizes.SetNumZeroed(NodeCount);
+	CompressedSizes.SetNumZeroed(NodeCount);
+	for (int32 PackageId = 0; PackageId < NodeCount; ++PackageId)
+	{
+		for (int32 i = FileOffsets[PackageId]; i < FileOffsets[PackageId + 1]; ++i)
+		{
+			Files[i] = InFiles[FileIndices[i]];
+			Sizes[PackageId] += Files[i]->PakEntry.UncompressedSize;
+			CompressedSizes[PackageId] += Files[i]->PakEntry.Size;
+		}
+	}
+
+	UE_LOG(LogPakAnalyzer, Log, TEXT("Build dependency graph, package count: %d, edge count: %d, cost: %.2fms."), NodeCount, Edges.Num(), (FPlatformTime::Seconds() - StartTime) * 1000.0);
+}
+
+SIZE_T FDependencyGraph::GetAllocatedSize() const
+{
+	return PackageIdMap.GetAllocatedSize() + PackageNames.GetAllocatedSize() + Sizes.GetAllocatedSize() + CompressedSizes.GetAllocatedSize()
+		+ DependencyOffsets.GetAllocatedSize() + DependencyIds.GetAllocatedSize() + DependentOffsets.GetAllocatedSize() + DependentIds.GetAllocatedSize()
+		+ FileOffsets.GetAllocatedSize() + Files.GetAllocatedSize();
+}
+
+int32 FDependencyGraph::FindPackageId(FName InPackageName) const
+{
+	const int32* PackageId = PackageIdMap.Find(InPackageName);
+	return PackageId ? *PackageId : INDEX_NONE;
+}
+
+TArrayView<const FPakFileEntryPtr> FDependencyGraph::GetFiles(int32 InPackageId) const
+{
+	return TArrayView<const FPakFileEntryPtr>(Files.GetData() + FileOffsets[InPackageId], FileOffsets[InPackageId + 1] - FileOffsets[InPackageId]);
+}
+
+void FDependencyGraph::GetClosure(const TArray<int32>& InRoots, bool bReverse, TArray<int32>& OutPackageIds) const
+{
+	using namespace DependencyGraphPrivate;
+
+	OutPackageIds.Reset();
+
+	const TArray<int32>& Offsets = bReverse ? DependentOffsets : DependencyOffsets;
+	const TArray<int32>& Ids = bReverse ? DependentIds : DependencyIds;
+
+	TArray<int32> Visited;
+	Visited.SetNumZeroed((Num() + 31) / 32);
+
+	auto TryVisit = [&Visited](int32 InPackageId) -> bool
+	{
+		volatile int32* Word = &Visited[InPackageId >> 5];
+		const int32 Bit = 1 << (InPackageId & 31);
+
+		int32 OldWord = *Word;
+		while ((OldWord & Bit) == 0)
+		{
+			const int32 PrevWord = FPlatformAtomics::InterlockedCompareExchange(Word, OldWord | Bit, OldWord);
+			if (PrevWord == OldWord)
+			{
+				return true;
+			}
+			OldWord = PrevWord;
+		}
+
+		return false;
+	};
+
+	for (const int32 Root : InRoots)
+	{
+		if (Root >= 0 && Root < Num() && TryVisit(Root))
+		{
+			OutPackageIds.Add(Root);
+		}
+	}
+
+	// Level synchronous search, every level is the tail of the output that has not been expanded yet
+	int32 FrontierStart = 0;
+	while (FrontierStart < OutPackageIds.Num())
+	{
+		const int32 FrontierEnd = OutPackageIds.Num();
+		const int32 FrontierSize = FrontierEnd - FrontierStart;
+
+		if (FrontierSize < ParallelFrontierSize)
+		{
+			for (int32 i = FrontierStart; i < FrontierEnd; ++i)
+			{
+				const int32 PackageId = OutPackageIds[i];
+				for (int32 Edge = Offsets[PackageId]; Edge < Offsets[PackageId + 1]; ++Edge)
+				{
+					if (TryVisit(Ids[Edge]))
+					{
+						OutPackageIds.Add(Ids[Edge]);
+					}
+				}
+			}
+		}
+		else
+		{
+			const int32 ChunkCount = FMath::DivideAndRoundUp(FrontierSize, FrontierChunkSize);
+			TArray<TArray<int32>> NextFrontiers;
+			NextFrontiers.SetNum(ChunkCount);
+
+			ParallelFor(ChunkCount, [&](int32 InChunkIndex)
+				{
+					TArray<int32>& NextFrontier = NextFrontiers[InChunkIndex];
+					const int32 ChunkStart = FrontierStart + InChunkIndex * FrontierChunkSize;
+					const int32 ChunkEnd = FMath::Min(ChunkStart + FrontierChunkSize, FrontierEnd);
+
+					for (int32 i = ChunkStart; i < ChunkEnd; ++i)
+					{
+						const int32 PackageId = OutPackageIds[i];
+						for (int32 Edge = Offsets[PackageId]; Edge < Offsets[PackageId + 1]; ++Edge)
+						{
+							if (TryVisit(Ids[Edge]))
+							{
+								NextFrontier.Add(Ids[Edge]);
+							}
+						}
+					}
+				});
+
+			for (const TArray<int32>& NextFrontier : NextFrontiers)
+			{
+				OutPackageIds.Append(NextFrontier);
+			}
+		}
+
+		FrontierStart = FrontierEnd;
+	}
+}
+
+bool FDependencyGraph::GetShortestChain(int32 InFrom, int32 InTo, TArray<int32>& OutChain) const
+{
+	OutChain.Reset();
+
+	if (InFrom < 0 || InFrom >= Num() || InTo < 0 || InTo >= Num())
+	{
+		return false;
+	}
+
+	TArray<int32> Parents;
+	Parents.Init(INDEX_NONE, Num());
+	Parents[InFrom] = InFrom;
+
+	TArray<int32> Queue;
+	Queue.Add(InFrom);
+
+	for (int32 Head = 0; Head < Queue.Num() && Parents[InTo] == INDEX_NONE; ++Head)
+	{
+		for (const int32 Dependency : GetDependencies(Queue[Head]))
+		{
+			if (Parents[Dependency] == INDEX_NONE)
+			{
+				Parents[Dependency] = Queue[Head];
+				Queue.Add(Dependency);
+			}
+		}
+	}
+
+	if (Parents[InTo] == INDEX_NONE)
+	{
+		return false;
+	}
+
+	for (int32 PackageId = InTo; PackageId != InFrom; PackageId = Parents[PackageId])
+	{
+		OutChain.Add(PackageId);
+	}
+	OutChain.Add(InFrom);
+	Algo::Reverse(OutChain);
+
+	return true;
+}
+
+int32 FDependencyGraph::GetStronglyConnectedComponents(TArray<int32>& OutOffsets, TArray<int32>& OutPackageIds) const
+{
+	const double StartTime = FPlatformTime::Seconds();
+	const int32 NodeCount = Num();
+
+	OutOffsets.Reset();
+	OutOffsets.Add(0);
+	OutPackageIds.Reset(NodeCount);
+
+	// Tarjan's algorithm with an explicit call stack, dependency chains of large games are too deep to recurse
+	struct FFrame
+	{
+		int32 PackageId;
+		int32 Edge;
+	};
+
+	TArray<int32> Indices;
+	Indices.Init(INDEX_NONE, NodeCount);
+	TArray<int32> LowLinks;
+	LowLinks.SetNumUninitialized(NodeCount);
+	TBitArray<> OnStack(false, NodeCount);
+
+	TArray<int32> Stack;
+	TArray<FFrame> CallStack;
+	int32 NextIndex = 0;
+
+	auto Visit = [&](int32 InPackageId)
+	{
+		Indices[InPackageId] = LowLinks[InPackageId] = NextIndex++;
+		Stack.Push(InPackageId);
+		OnStack[InPackageId] = true;
+		CallStack.Push({ InPackageId, DependencyOffsets[InPackageId] });
+	};
+
+	for (int32 Root = 0; Root < NodeCount; ++Root)
+	{
+		if (Indices[Root] != INDEX_NONE)
+		{
+			continue;
+		}
+
+		Visit(Root);
+		while (CallStack.Num() > 0)
+		{
+			FFrame& Frame = CallStack.Last();
+			const int32 PackageId = Frame.PackageId;
+
+			if (Frame.Edge < DependencyOffsets[PackageId + 1])
+			{
+				const int32 Dependency = DependencyIds[Frame.Edge++];
+				if (Indices[Dependency] == INDEX_NONE)
+				{
+					Visit(Dependency);
+				}
+				else if (OnStack[Dependency])
+				{
+					LowLinks[PackageId] = FMath::Min(LowLinks[PackageId], Indices[Dependency]);
+				}
+				continue;
+			}
+
+			CallStack.Pop(false);
+
+			if (LowLinks[PackageId] == Indices[PackageId])
+			{
+				int32 Member = INDEX_NONE;
+				do
+				{
+					Member = Stack.Pop(false);
+					OnStack[Member] = false;
+					OutPackageIds.Add(Member);
+				} while (Member != PackageId);
+
+				OutOffsets.Add(OutPackageIds.Num());
+			}
+
+			if (CallStack.Num() > 0)
+			{
+				const int32 Parent = CallStack.Last().PackageId;
+				LowLinks[Parent] = FMath::Min(LowLinks[Parent], LowLinks[PackageId]);
+			}
+		}
+	}
+
+	const int32 ComponentCount = OutOffsets.Num() - 1;
+	UE_LOG(LogPakAnalyzer, Log, TEXT("Find strongly connected components, package count: %d, component count: %d, cost: %.2fms."), NodeCount, ComponentCount, (FPlatformTime::Seconds() - StartTime) * 1000.0);
+
+	return ComponentCount;
+}
+
+int32 FDependencyGraph::FindOrAddPackageId(FName InPackageName)
+{
+	const int32* PackageId = PackageIdMap.Find(InPackageName);
+	if (PackageId)
+	{
+		return *PackageId;
+	}
+
+	const int32 NewPackageId = PackageNames.Add(InPackageName);
+	PackageIdMap.Add(InPackageName, NewPackageId);
+
+	return NewPackageId;
+}
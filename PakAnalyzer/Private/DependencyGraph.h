@@ -0,0 +1,58 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+#include "PakFileEntry.h"
+
+/** Package dependency graph over dense ids, adjacency is stored in compressed rows for both directions. */
+class FDependencyGraph
+{
+public:
+	void Build(const TArray<FPakTreeEntryPtr>& InTreeRoots);
+
+	/** Builds from a file list gathered by the caller, only reads the entries. */
+	void Build(const TArray<FPakFileEntryPtr>& InFiles);
+
+	int32 Num() const { return PackageNames.Num(); }
+	SIZE_T GetAllocatedSize() const;
+	int32 FindPackageId(FName InPackageName) const;
+	FName GetPackageName(int32 InPackageId) const { return PackageNames[InPackageId]; }
+	int64 GetSize(int32 InPackageId) const { return Sizes[InPackageId]; }
+	int64 GetCompressedSize(int32 InPackageId) const { return CompressedSizes[InPackageId]; }
+
+	TArrayView<const int32> GetDependencies(int32 InPackageId) const { return GetRow(DependencyOffsets, DependencyIds, InPackageId); }
+	TArrayView<const int32> GetDependents(int32 InPackageId) const { return GetRow(DependentOffsets, DependentIds, InPackageId); }
+	TArrayView<const FPakFileEntryPtr> GetFiles(int32 InPackageId) const;
+
+	/** Collects every package reachable from the roots, roots first. Follows dependents instead of dependencies when bReverse. */
+	void GetClosure(const TArray<int32>& InRoots, bool bReverse, TArray<int32>& OutPackageIds) const;
+
+	/** Shortest dependency chain from InFrom to InTo, both ends included. */
+	bool GetShortestChain(int32 InFrom, int32 InTo, TArray<int32>& OutChain) const;
+
+	/** Splits the graph into strongly connected components, component i is OutPackageIds[OutOffsets[i], OutOffsets[i + 1]). Returns the component count. */
+	int32 GetStronglyConnectedComponents(TArray<int32>& OutOffsets, TArray<int32>& OutPackageIds) const;
+
+protected:
+	static TArrayView<const int32> GetRow(const TArray<int32>& InOffsets, const TArray<int32>& InIds, int32 InPackageId)
+	{
+		return TArrayView<const int32>(InIds.GetData() + InOffsets[InPackageId], InOffsets[InPackageId + 1] - InOffsets[InPackageId]);
+	}
+
+	int32 FindOrAddPackageId(FName InPackageName);
+
+protected:
+	TMap<FName, int32> PackageIdMap;
+	TArray<FName> PackageNames;
+	TArray<int64> Sizes;
+	TArray<int64> CompressedSizes;
+
+	TArray<int32> DependencyOffsets;
+	TArray<int32> DependencyIds;
+	TArray<int32> DependentOffsets;
+	TArray<int32> DependentIds;
+	TArray<int32> FileOffsets;
+	TArray<FPakFileEntryPtr> Files;
+};
+
+typedef TSharedPtr<FDependencyGraph> FDependencyGraphPtr;
@@ -0,0 +1,262 @@
+#include "ExportWriter.h"
+
+#include "Async/ParallelFor.h"
+#include "Async/TaskGraphInterfaces.h"
+#include "HAL/FileManager.h"
+
+static const int32 ExportChunkRowCount = 2048;
+
+FExportBuffer& FExportBuffer::Append(const ANSICHAR* InText)
+{
+	Data.Append(InText, FCStringAnsi::Strlen(InText));
+	return *this;
+}
+
+FExportBuffer& FExportBuffer::Append(const TCHAR* InText, int32 InLen)
+{
+	int32 Start = 0;
+	while (Start < InLen)
+	{
+		int32 End = Start;
+		while (End < InLen && InText[End] < 0x80)
+		{
+			++End;
+		}
+
+		if (End > Start)
+		{
+			ANSICHAR* Dest = Data.GetData() + Data.AddUninitialized(End - Start);
+			for (int32 i = Start; i < End; ++i)
+			{
+				*Dest++ = (ANSICHAR)InText[i];
+			}
+			Start = End;
+		}
+
+		while (End < InLen && InText[End] >= 0x80)
+		{
+			++End;
+		}
+
+		if (End > Start)
+		{
+			FTCHARToUTF8 Converter(InText + Start, End - Start);
+			Data.Append(Converter.Get(), Converter.Length());
+			Start = End;
+		}
+	}
+
+	return *this;
+}
+
+FExportBuffer& FExportBuffer::Append(FName InName)
+{
+	NameScratch.Reset();
+	InName.AppendString(NameScratch);
+	return Append(NameScratch);
+}
+
+FExportBuffer& FExportBuffer::AppendJsonString(const TCHAR* InText, int32 InLen)
+{
+	Data.Add('"');
+
+	int32 Start = 0;
+	for (int32 i = 0; i < InLen; ++i)
+	{
+		const TCHAR Char = InText[i];
+		const ANSICHAR* Escape = nullptr;
+		ANSICHAR Code[8];
+
+		switch (Char)
+		{
+		case TEXT('"'): Escape = "\\\""; break;
+		case TEXT('\\'): Escape = "\\\\"; break;
+		case TEXT('\n'): Escape = "\\n"; break;
+		case TEXT('\r'): Escape = "\\r"; break;
+		case TEXT('\t'): Escape = "\\t"; break;
+		case TEXT('\b'): Escape = "\\b"; break;
+		case TEXT('\f'): Escape = "\\f"; break;
+		default:
+			if (Char < 0x20)
+			{
+				FCStringAnsi::Sprintf(Code, "\\u%04x", (uint32)Char);
+				Escape = Code;
+			}
+			break;
+		}
+
+		if (Escape)
+		{
+			Append(InText + Start, i - Start);
+			Append(Escape);
+			Start = i + 1;
+		}
+	}
+	Append(InText + Start, InLen - Start);
+
+	Data.Add('"');
+	return *this;
+}
+
+FExportBuffer& FExportBuffer::AppendJsonString(FName InName)
+{
+	NameScratch.Reset();
+	InName.AppendString(NameScratch);
+	return AppendJsonString(NameScratch);
+}
+
+FExportBuffer& FExportBuffer::AppendSqlString(const TCHAR* InText, int32 InLen)
+{
+	Data.Add('\'');
+
+	int32 Start = 0;
+	for (int32 i = 0; i < InLen; ++i)
+	{
+		if (InText[i] == TEXT('\''))
+		{
+			Append(InText + Start, i + 1 - Start);
+			Data.Add('\'');
+			Start = i + 1;
+		}
+	}
+	Append(InText + Start, InLen - Start);
+
+	Data.Add('\'');
+	return *this;
+}
+
+FExportBuffer& FExportBuffer::AppendSqlString(FName InName)
+{
+	if (InName.IsNone())
+	{
+		return Append("NULL");
+	}
+
+	NameScratch.Reset();
+	InName.AppendString(NameScratch);
+	return AppendSqlString(NameScratch);
+}
+
+FExportBuffer& FExportBuffer::AppendInt(int64 InValue)
+{
+	ANSICHAR Digits[24];
+	ANSICHAR* End = Digits + UE_ARRAY_COUNT(Digits);
+	ANSICHAR* Begin = End;
+
+	uint64 Value = InValue < 0 ? (uint64)0 - (uint64)InValue : (uint64)InValue;
+	do
+	{
+		*--Begin = (ANSICHAR)('0' + Value % 10);
+		Value /= 10;
+	} while (Value > 0);
+
+	if (InValue < 0)
+	{
+		*--Begin = '-';
+	}
+
+	Data.Append(Begin, (int32)(End - Begin));
+	return *this;
+}
+
+FExportBuffer& FExportBuffer::AppendHex(const uint8* InBytes, int32 InCount)
+{
+	static const ANSICHAR HexDigits[] = "0123456789ABCDEF";
+
+	const int32 Start = Data.AddUninitialized(InCount * 2);
+	for (int32 i = 0; i < InCount; ++i)
+	{
+		Data[Start + i * 2] = HexDigits[InBytes[i] >> 4];
+		Data[Start + i * 2 + 1] = HexDigits[InBytes[i] & 0xF];
+	}
+
+	return *this;
+}
+
+FExportBuffer& FExportBuffer::AppendFloat(double InValue)
+{
+	ANSICHAR Text[64];
+	FCStringAnsi::Sprintf(Text, "%.4f", InValue);
+	return Append(Text);
+}
+
+FExportWriter::FExportWriter(const FString& InOutputPath, FExportProgress* InProgress)
+	: OutputPath(InOutputPath)
+	, Progress(InProgress)
+{
+	Archive.Reset(IFileManager::Get().CreateFileWriter(*InOutputPath));
+}
+
+void FExportWriter::Write(const FExportBuffer& InBuffer)
+{
+	if (Archive.IsValid() && InBuffer.Data.Num() > 0)
+	{
+		Archive->Serialize((void*)InBuffer.Data.GetData(), InBuffer.Data.Num());
+		WrittenSize += InBuffer.Data.Num();
+	}
+}
+
+void FExportWriter::WriteRows(int32 InRowCount, FFormatRow InFormatRow)
+{
+	if (!Archive.IsValid() || InRowCount <= 0)
+	{
+		return;
+	}
+
+	const int32 ChunkCount = FMath::DivideAndRoundUp(InRowCount, ExportChunkRowCount);
+	const int32 WindowSize = FMath::Min(ChunkCount, FMath::Max(1, FTaskGraphInterface::Get().GetNumWorkerThreads() * 2));
+	ChunkBuffers.SetNum(FMath::Max(ChunkBuffers.Num(), WindowSize));
+
+	for (int32 WindowStart = 0; WindowStart < ChunkCount; WindowStart += WindowSize)
+	{
+		if (Progress && Progress->IsStopped())
+		{
+			return;
+		}
+
+		const int32 WindowEnd = FMath::Min(WindowStart + WindowSize, ChunkCount);
+
+		ParallelFor(WindowEnd - WindowStart, [&](int32 InIndex)
+			{
+				FExportBuffer& Buffer = ChunkBuffers[InIndex];
+				Buffer.Reset();
+
+				const int32 RowStart = (WindowStart + InIndex) * ExportChunkRowCount;
+				const int32 RowEnd = FMath::Min(RowStart + ExportChunkRowCount, InRowCount);
+				for (int32 Row = RowStart; Row < RowEnd; ++Row)
+				{
+					InFormatRow(Row, Buffer);
+				}
+			});
+
+		for (int32 i = 0; i < WindowEnd - WindowStart; ++i)
+		{
+			Write(ChunkBuffers[i]);
+		}
+
+		if (Progress)
+		{
+			Progress->Advance(FMath::Min(WindowEnd * ExportChunkRowCount, InRowCount) - WindowStart * ExportChunkRowCount);
+		}
+	}
+}
+
+bool FExportWriter::Close()
+{
+	if (!Archive.IsValid())
+	{
+		return false;
+	}
+
+	const bool bSuccess = Archive->Close() && !Archive->IsError();
+	Archive.Reset();
+	ChunkBuffers.Empty();
+
+	if (Progress && Progress->IsStopped())
+	{
+		IFileManager::Get().Delete(*OutputPath);
+		return false;
+	}
+
+	return bSuccess;
+}
@@ -0,0 +1,75 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HAL/ThreadSafeCounter.h"
+#include "Templates/Function.h"
+
+/** Progress of an export counted in rows, the stop counter cancels it at the next chunk. */
+struct FExportProgress
+{
+	TFunction<void(int64 /*InCompleteRows*/, int64 /*InTotalRows*/)> OnProgress;
+	const FThreadSafeCounter* StopCounter = nullptr;
+	int64 TotalRows = 0;
+	int64 CompleteRows = 0;
+
+	bool IsStopped() const { return StopCounter && StopCounter->GetValue() > 0; }
+
+	void Advance(int64 InRows)
+	{
+		CompleteRows += InRows;
+		if (OnProgress)
+		{
+			OnProgress(CompleteRows, TotalRows);
+		}
+	}
+};
+
+/** UTF-8 text of one chunk of rows, formats the values exports write without temporary strings. */
+struct FExportBuffer
+{
+	TArray<ANSICHAR> Data;
+	FString NameScratch;
+
+	void Reset() { Data.Reset(); }
+
+	FExportBuffer& Append(const ANSICHAR* InText);
+	FExportBuffer& Append(const TCHAR* InText, int32 InLen);
+	FExportBuffer& Append(const FString& InText) { return Append(*InText, InText.Len()); }
+	FExportBuffer& Append(FName InName);
+	FExportBuffer& AppendJsonString(const TCHAR* InText, int32 InLen);
+	FExportBuffer& AppendJsonString(const FString& InText) { return AppendJsonString(*InText, InText.Len()); }
+	FExportBuffer& AppendJsonString(FName InName);
+	FExportBuffer& AppendSqlString(const TCHAR* InText, int32 InLen);
+	FExportBuffer& AppendSqlString(const FString& InText) { return AppendSqlString(*InText, InText.Len()); }
+	FExportBuffer& AppendSqlString(FName InName);
+	FExportBuffer& AppendInt(int64 InValue);
+	FExportBuffer& AppendHex(const uint8* InBytes, int32 InCount);
+	FExportBuffer& AppendFloat(double InValue);
+};
+
+/** Writes to a buffered file handle, rows are formatted in parallel chunks and written in order. */
+class FExportWriter
+{
+public:
+	typedef TFunctionRef<void(int32 /*InRow*/, FExportBuffer& /*OutBuffer*/)> FFormatRow;
+
+	FExportWriter(const FString& InOutputPath, FExportProgress* InProgress = nullptr);
+
+	bool IsValid() const { return Archive.IsValid(); }
+	int64 GetWrittenSize() const { return WrittenSize; }
+
+	void Write(const FExportBuffer& InBuffer);
+
+	/** Only a window of chunks is formatted at once, so memory does not grow with the row count. */
+	void WriteRows(int32 InRowCount, FFormatRow InFormatRow);
+
+	/** A stopped export deletes the partial file and fails. */
+	bool Close();
+
+protected:
+	FString OutputPath;
+	FExportProgress* Progress;
+	TUniquePtr<FArchive> Archive;
+	TArray<FExportBuffer> ChunkBuffers;
+	int64 WrittenSize = 0;
+};
@@ -9,6 +9,7 @@
 #include "Serialization/Archive.h"
 
 #include "CommonDefines.h"
+#include "PakAnalyzerTrace.h"
 
 FExtractThreadWorker::FExtractThreadWorker()
 	: Thread(nullptr)
@@ -28,6 +29,8 @@ bool FExtractThreadWorker::Init()
 
 uint32 FExtractThreadWorker::Run()
 {
+	PAK_ANALYZER_TRACE_SCOPE(Extract_Run);
+
 	const int64 BufferSize = 8 * 1024 * 1024; // 8MB buffer for extracting
 	void* Buffer = FMemory::Malloc(BufferSize);
 	uint8* PersistantCompressionBuffer = NULL;
@@ -52,6 +55,8 @@ uint32 FExtractThreadWorker::Run()
 			continue;
 		}
 
+		PAK_ANALYZER_TRACE_SCOPE(Extract_File);
+
 		const FPakFileSumary& Summary = Summaries[File.OwnerPakIndex];
 
 		if (!ReaderArchive || File.OwnerPakIndex != LastReaderIndex)
@@ -79,35 +84,53 @@ uint32 FExtractThreadWorker::Run()
 
 			FPakEntry EntryInfo;
 			EntryInfo.Serialize(*ReaderArchive, Summary.PakInfo.Version);
+			FPakAnalyzerTrace::CountRead(EntryInfo.GetSerializedSize(Summary.PakInfo.Version));
 			if (File.PakEntry == EntryInfo)
 			{
 				const FString OutputFilePath = OutputPath / File.Path;
 				const FString BasePath = FPaths::GetPath(OutputFilePath);
-				if (!FPaths::DirectoryExists(BasePath))
+
+				TUniquePtr<FArchive> FileHandle;
 				{
-					IFileManager::Get().MakeDirectory(*BasePath, true);
+					PAK_ANALYZER_TRACE_SCOPE(Extract_CreateFile);
+
+					if (!FPaths::DirectoryExists(BasePath))
+					{
+						IFileManager::Get().MakeDirectory(*BasePath, true);
+					}
+
+					FileHandle.Reset(IFileManager::Get().CreateFileWriter(*OutputFilePath));
 				}
 
-				TUniquePtr<FArchive> FileHandle(IFileManager::Get().CreateFileWriter(*OutputFilePath));
 				if (FileHandle)
 				{
 					if (EntryInfo.CompressionMethodIndex == 0)
 					{
+						PAK_ANALYZER_TRACE_SCOPE(Extract_Copy);
+
 						if (!BufferedCopyFile(*FileHandle, *ReaderArchive, File.PakEntry, Buffer, BufferSize, Summary.DecryptAESKey))
 						{
 							// Add to failed list
 							++ErrorCount;
 							UE_LOG(LogPakAnalyzer, Error, TEXT("Extract none-compressed file failed! File: %s"), *File.Path);
 						}
+
+						FPakAnalyzerTrace::CountRead(File.PakEntry.Size);
+						FPakAnalyzerTrace::CountWrite(FileHandle->Tell());
 					}
 					else
 					{
+						PAK_ANALYZER_TRACE_SCOPE(Extract_Decompress);
+
 						if (!UncompressCopyFile(*FileHandle, *ReaderArchive, File.PakEntry, PersistantCompressionBuffer, CompressionBufferSize, Summary.DecryptAESKey, File.CompressionMethod, bHasRelativeCompressedChunkOffsets))
 						{
 							// Add to failed list
 							++ErrorCount;
 							UE_LOG(LogPakAnalyzer, Error, TEXT("Extract compressed file failed! File: %s"), *File.Path);
 						}
+
+						FPakAnalyzerTrace::CountRead(File.PakEntry.Size);
+						FPakAnalyzerTrace::CountWrite(FileHandle->Tell());
 					}
 				}
 				else
@@ -25,6 +25,7 @@
 
 #include "AssetParseThreadWorker.h"
 #include "CommonDefines.h"
+#include "PakAnalyzerTrace.h"
 
 FFolderAnalyzer::FFolderAnalyzer()
 {
@@ -40,6 +41,8 @@ FFolderAnalyzer::~FFolderAnalyzer()
 
 bool FFolderAnalyzer::LoadPakFiles(const TArray<FString>& InPakPaths, const TArray<FString>& InDefaultAESKeys)
 {
+	PAK_ANALYZER_TRACE_SCOPE(FolderAnalyzer_LoadPakFiles);
+
 	const FString InPakPath = InPakPaths.Num() > 0 ? InPakPaths[0] : TEXT("");
 	if (InPakPath.IsEmpty())
 	{
@@ -76,37 +79,44 @@ bool FFolderAnalyzer::LoadPakFiles(const TArray<FString>& InPakPaths, const TArr
 	PlatformFile.FindFilesRecursively(FoundFiles, *InPakPath, TEXT(""));
 
 	int64 TotalSize = 0;
-	for (const FString& File : FoundFiles)
 	{
-		FPakEntry Entry;
-		Entry.Offset = 0;
-		Entry.UncompressedSize = PlatformFile.FileSize(*File);
-		Entry.Size = Entry.UncompressedSize;
+		PAK_ANALYZER_TRACE_SCOPE(FolderAnalyzer_InsertFileToTree);
 
-		TotalSize += Entry.UncompressedSize;
+		for (const FString& File : FoundFiles)
+		{
+			FPakEntry Entry;
+			Entry.Offset = 0;
+			Entry.UncompressedSize = PlatformFile.FileSize(*File);
+			Entry.Size = Entry.UncompressedSize;
 
-		FString RelativeFilename = File;
-		RelativeFilename.RemoveFromStart(InPakPath);
+			TotalSize += Entry.UncompressedSize;
 
-		InsertFileToTree(TreeRoot, *Summary, RelativeFilename, Entry);
+			FString RelativeFilename = File;
+			RelativeFilename.RemoveFromStart(InPakPath);
 
-		if (File.Contains(TEXT("DevelopmentAssetRegistry.bin")))
-		{
-			AssetRegistryPath = File;
+			InsertFileToTree(TreeRoot, *Summary, RelativeFilename, Entry);
+
+			if (File.Contains(TEXT("DevelopmentAssetRegistry.bin")))
+			{
+				AssetRegistryPath = File;
+			}
 		}
 	}
 
 	Summary->PakFileSize = TotalSize;
 	Summary->FileCount = TreeRoot->FileCount;
 
-	RefreshTreeNode(TreeRoot);
-	RefreshTreeNodeSizePercent(TreeRoot, TreeRoot);
+	{
+		PAK_ANALYZER_TRACE_SCOPE(FolderAnalyzer_RefreshTreeNode);
+		RefreshTreeNode(TreeRoot);
+		RefreshTreeNodeSizePercent(TreeRoot, TreeRoot);
+	}
 
 	PakTreeRoots.Add(TreeRoot);
 
 	if (!AssetRegistryPath.IsEmpty())
 	{
-		LoadAssetRegistry(AssetRegistryPath);
+		StartLoadAssetRegistry(AssetRegistryPath);
 	}
 
 	ParseAssetFile(TreeRoot);
@@ -130,6 +140,14 @@ void FFolderAnalyzer::SetExtractThreadCount(int32 InThreadCount)
 {
 }
 
+void FFolderAnalyzer::PrioritizeAssetParse(const TArray<FPakFileEntryPtr>& InFiles)
+{
+	if (AssetParseWorker.IsValid())
+	{
+		AssetParseWorker->Prioritize(InFiles);
+	}
+}
+
 void FFolderAnalyzer::ParseAssetFile(FPakTreeEntryPtr InRoot)
 {
 	if (AssetParseWorker.IsValid())
@@ -150,6 +168,7 @@ void FFolderAnalyzer::InitializeAssetParseWorker()
 	{
 		AssetParseWorker = MakeShared<FAssetParseThreadWorker>();
 		AssetParseWorker->OnReadAssetContent.BindRaw(this, &FFolderAnalyzer::OnReadAssetContent);
+		AssetParseWorker->OnPackagesParsed.BindRaw(this, &FFolderAnalyzer::OnPackagesParsed);
 		AssetParseWorker->OnParseFinish.BindRaw(this, &FFolderAnalyzer::OnAssetParseFinish);
 	}
 }
@@ -176,27 +195,8 @@ void FFolderAnalyzer::OnReadAssetContent(FPakFileEntryPtr InFile, bool& bOutSucc
 	bOutSuccess = FFileHelper::LoadFileToArray(OutContent, *FilePath);
 }
 
-void FFolderAnalyzer::OnAssetParseFinish(bool bCancel, const TMap<FName, FName>& ClassMap)
+bool FFolderAnalyzer::ReadFileContent(const FPakFileSumary& InSummary, const FPakFileEntry& InFile, FFileReadContext& InContext, TArray<uint8>& OutContent) const
 {
-	if (bCancel)
-	{
-		return;
-	}
-
-	DefaultClassMap = ClassMap;
-	const bool bRefreshClass = ClassMap.Num() > 0;
-
-	FFunctionGraphTask::CreateAndDispatchWhenReady([this, bRefreshClass]()
-		{
-			if (bRefreshClass)
-			{
-				for (const FPakTreeEntryPtr& PakTreeRoot : PakTreeRoots)
-				{
-					RefreshClassMap(PakTreeRoot, PakTreeRoot);
-				}
-			}
-
-			FPakAnalyzerDelegates::OnAssetParseFinish.Broadcast();
-		},
-		TStatId(), nullptr, ENamedThreads::GameThread);
+	// Loose files are small enough to load in one go, no reader to keep around
+	return FFileHelper::LoadFileToArray(OutContent, *(InSummary.MountPoint / InFile.Path));
 }
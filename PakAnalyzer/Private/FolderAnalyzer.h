@@ -25,13 +25,16 @@ public:
 	virtual void ExtractFiles(const FString& InOutputPath, TArray<FPakFileEntryPtr>& InFiles) override;
 	virtual void CancelExtract() override;
 	virtual void SetExtractThreadCount(int32 InThreadCount) override;
+	virtual void PrioritizeAssetParse(const TArray<FPakFileEntryPtr>& InFiles) override;
+	virtual bool GetPakLayout(int32 InPakIndex, FPakLayout& OutLayout) override { return false; }
+	virtual bool VerifyPakFiles(FPakVerifyResult& OutResult) override { return false; }
 
 protected:
 	void ParseAssetFile(FPakTreeEntryPtr InRoot);
 	void InitializeAssetParseWorker();
 	void ShutdownAssetParseWorker();
 	void OnReadAssetContent(FPakFileEntryPtr InFile, bool& bOutSuccess, TArray<uint8>& OutContent);
-	void OnAssetParseFinish(bool bCancel, const TMap<FName, FName>& ClassMap);
+	virtual bool ReadFileContent(const FPakFileSumary& InSummary, const FPakFileEntry& InFile, FFileReadContext& InContext, TArray<uint8>& OutContent) const override;
 
 protected:
 	TSharedPtr<class FAssetParseThreadWorker> AssetParseWorker;
@@ -529,7 +529,7 @@ bool FIoStoreAnalyzer::InitializeReaders(const TArray<FString>& InPaks, const TA
 			AssetPackageSummary.NameOffset = 0;
 			for (int32 i = 0; i < PackageFNames.Num(); ++i)
 			{
-				PackageInfo.AssetSummary->Names[i] = MakeShared<FName>(FName::CreateFromDisplayId(PackageFNames[i], 0));
+				PackageInfo.AssetSummary->Names[i] = FName::CreateFromDisplayId(PackageFNames[i], 0);
 			}
 
 			// Imports
@@ -690,24 +690,22 @@ bool FIoStoreAnalyzer::InitializeReaders(const TArray<FString>& InPaks, const TA
 		{
 			FIoStoreExport& Export = PackageInfo.Exports[i];
 
-			FObjectExportPtrType ObjectExport = MakeShared<FObjectExportEx>();
-			ObjectExport->Index = i;
-			ObjectExport->ObjectName = Export.Name;
-			ObjectExport->SerialSize = Export.SerialSize;
-			ObjectExport->SerialOffset = Export.SerialOffset;
-			ObjectExport->bIsAsset = (Export.ObjectFlags & RF_Public) && !(Export.ObjectFlags & (RF_Transient | RF_ClassDefaultObject));
-			ObjectExport->bNotForClient = Export.FilterFlags == EExportFilterFlags::NotForClient;
-			ObjectExport->bNotForServer = Export.FilterFlags == EExportFilterFlags::NotForServer;
-			ObjectExport->ClassName = FindObjectName(Export.ClassIndex, &PackageInfo);
-			ObjectExport->Super = FindObjectName(Export.SuperIndex, &PackageInfo);
-			ObjectExport->TemplateObject = FindObjectName(Export.TemplateIndex, &PackageInfo);
-			ObjectExport->ObjectPath = Export.FullName;
-			ObjectExport->DependencyList.SetNum(0);
-
-			PackageInfo.AssetSummary->ObjectExports[i] = ObjectExport;
-
-			FName ObjectClass = *FPaths::GetBaseFilename(ObjectExport->ClassName.ToString());
-			FName ObjectName = *FPaths::GetBaseFilename(ObjectExport->ObjectName.ToString());
+			FObjectExportTable& ExportTable = PackageInfo.AssetSummary->ObjectExports;
+			const bool bIsAsset = (Export.ObjectFlags & RF_Public) && !(Export.ObjectFlags & (RF_Transient | RF_ClassDefaultObject));
+
+			ExportTable.ObjectNames[i] = Export.Name;
+			ExportTable.SerialSizes[i] = Export.SerialSize;
+			ExportTable.SerialOffsets[i] = Export.SerialOffset;
+			ExportTable.Flags[i] |= bIsAsset ? EObjectExportFlags::IsAsset : EObjectExportFlags::None;
+			ExportTable.Flags[i] |= Export.FilterFlags == EExportFilterFlags::NotForClient ? EObjectExportFlags::NotForClient : EObjectExportFlags::None;
+			ExportTable.Flags[i] |= Export.FilterFlags == EExportFilterFlags::NotForServer ? EObjectExportFlags::NotForServer : EObjectExportFlags::None;
+			ExportTable.ClassNames[i] = FindObjectName(Export.ClassIndex, &PackageInfo);
+			ExportTable.Supers[i] = FindObjectName(Export.SuperIndex, &PackageInfo);
+			ExportTable.TemplateObjects[i] = FindObjectName(Export.TemplateIndex, &PackageInfo);
+			ExportTable.ObjectPaths[i] = Export.FullName;
+
+			FName ObjectClass = *FPaths::GetBaseFilename(ExportTable.ClassNames[i].ToString());
+			FName ObjectName = *FPaths::GetBaseFilename(ExportTable.ObjectNames[i].ToString());
 			if (ObjectName == MainObjectName)
 			{
 				MainObjectClassName = ObjectClass;
@@ -717,7 +715,7 @@ bool FIoStoreAnalyzer::InitializeReaders(const TArray<FString>& InPaks, const TA
 				MainClassObjectClassName = ObjectClass;
 			}
 
-			if (ObjectExport->bIsAsset)
+			if (bIsAsset)
 			{
 				AssetClass = ObjectClass;
 			}
@@ -727,7 +725,7 @@ bool FIoStoreAnalyzer::InitializeReaders(const TArray<FString>& InPaks, const TA
 		{
 			if (PackageInfo.AssetSummary->ObjectExports.Num() == 1)
 			{
-				MainObjectClassName = *FPaths::GetBaseFilename(PackageInfo.AssetSummary->ObjectExports[0]->ClassName.ToString());
+				MainObjectClassName = *FPaths::GetBaseFilename(PackageInfo.AssetSummary->ObjectExports.ClassNames[0].ToString());
 			}
 			else if (!AssetClass.IsNone())
 			{
@@ -745,10 +743,9 @@ bool FIoStoreAnalyzer::InitializeReaders(const TArray<FString>& InPaks, const TA
 			FIoStoreImport& Import = PackageInfo.Imports[i];
 			Import.Name = FindObjectName(Import.GlobalImportIndex, &PackageInfo);
 
-			FObjectImportPtrType ObjectImport = MakeShared<FObjectImportEx>();
-			ObjectImport->Index = i;
-			ObjectImport->ObjectPath = Import.Name;
-			ObjectImport->ObjectName = *FPaths::GetBaseFilename(ObjectImport->ObjectPath.ToString());
+			FObjectImportEx& ObjectImport = PackageInfo.AssetSummary->ObjectImports[i];
+			ObjectImport.ObjectPath = Import.Name;
+			ObjectImport.ObjectName = *FPaths::GetBaseFilename(ObjectImport.ObjectPath.ToString());
 
 			//if (!Import.GlobalImportIndex.IsNull())
 			//{
@@ -757,12 +754,12 @@ bool FIoStoreAnalyzer::InitializeReaders(const TArray<FString>& InPaks, const TA
 			//		const FIoStoreExport* Export = ExportByGlobalIdMap.FindRef(Import.GlobalImportIndex);
 			//		if (Export)
 			//		{
-			//			ObjectImport->ClassName = FindObjectName(Export->ClassIndex, Export->Package);
+			//			ObjectImport.ClassName = FindObjectName(Export->ClassIndex, Export->Package);
 			//			//ObjectImport->
 			//		}
 			//		else
 			//		{
-			//			ObjectImport->ClassName = TEXT("Missing package class!");
+			//			ObjectImport.ClassName = TEXT("Missing package class!");
 			//		}
 			//	}
 			//	else
@@ -770,36 +767,34 @@ bool FIoStoreAnalyzer::InitializeReaders(const TArray<FString>& InPaks, const TA
 			//		const FScriptObjectDesc* ScriptObjectDesc = ScriptObjectByGlobalIdMap.Find(Import.GlobalImportIndex);
 			//		if (ScriptObjectDesc)
 			//		{
-			//			ObjectImport->ClassName = ScriptObjectDesc->FullName;
+			//			ObjectImport.ClassName = ScriptObjectDesc->FullName;
 			//		}
 			//		else
 			//		{
-			//			ObjectImport->ClassName = TEXT("Missing script class!");
+			//			ObjectImport.ClassName = TEXT("Missing script class!");
 			//		}
 			//	}
 			//}
-
-			PackageInfo.AssetSummary->ObjectImports[i] = ObjectImport;
 		}
 
-		PackageInfo.AssetSummary->DependencyList.SetNum(PackageInfo.DependencyPackages.Num());
+		TArray<FPackageInfo> Dependencies;
+		Dependencies.SetNum(PackageInfo.DependencyPackages.Num());
 		for (int32 i = 0; i < PackageInfo.DependencyPackages.Num(); ++i)
 		{
-			FPackageInfoPtr DependencyPackage = MakeShared<struct FPackageInfo>();
+			FPackageInfo& DependencyPackage = Dependencies[i];
 			if (FName* PackageName = PackageNameMap.Find(PackageInfo.DependencyPackages[i]))
 			{
-				DependencyPackage->PackageName = *PackageName;
+				DependencyPackage.PackageName = *PackageName;
 
 				FScopeLock ScopeLock(&Mutex);
-				DependsMap.Add(DependencyPackage->PackageName.ToString().ToLower(), PackageInfo.PackageName.ToString());
+				DependsMap.Add(DependencyPackage.PackageName.ToString().ToLower(), PackageInfo.PackageName.ToString());
 			}
 			else
 			{
-				DependencyPackage->PackageName = *FString::Printf(TEXT("Missing package: 0x%X, may be in other ucas!"), PackageInfo.DependencyPackages[i].ValueForDebugging());
+				DependencyPackage.PackageName = *FString::Printf(TEXT("Missing package: 0x%X, may be in other ucas!"), PackageInfo.DependencyPackages[i].ValueForDebugging());
 			}
-
-			PackageInfo.AssetSummary->DependencyList[i] = DependencyPackage;
 		}
+		PackageInfo.AssetSummary->SetDependencies(Dependencies);
 	}, ParallelForFlags);
 
 	UE_LOG(LogPakAnalyzer, Display, TEXT("Parsing dependents..."));
@@ -814,12 +809,13 @@ bool FIoStoreAnalyzer::InitializeReaders(const TArray<FString>& InPaks, const TA
 		TArray<FString> Assets;
 		DependsMap.MultiFind(PackageInfo.PackageName.ToString().ToLower(), Assets);
 
+		TArray<FPackageInfo> Dependents;
+		Dependents.Reserve(Assets.Num());
 		for (const FString& Asset : Assets)
 		{
-			FPackageInfoPtr Depends = MakeShared<FPackageInfo>();
-			Depends->PackageName = *Asset;
-			PackageInfo.AssetSummary->DependentList.Add(Depends);
+			Dependents.Emplace(*Asset);
 		}
+		PackageInfo.AssetSummary->SetDependents(Dependents);
 	}, ParallelForFlags);
 
 	UE_LOG(LogPakAnalyzer, Display, TEXT("IoStore creating container readers finish."));
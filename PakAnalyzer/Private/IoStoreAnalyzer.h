@@ -30,6 +30,7 @@ public:
 	virtual void ExtractFiles(const FString& InOutputPath, TArray<FPakFileEntryPtr>& InFiles) override;
 	virtual void CancelExtract() override;
 	virtual void SetExtractThreadCount(int32 InThreadCount) override;
+	virtual bool VerifyPakFiles(FPakVerifyResult& OutResult) override { return false; }
 
 protected:
 	virtual void Reset() override;
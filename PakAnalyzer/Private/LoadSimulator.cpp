@@ -0,0 +1,51 @@
+#include "LoadSimulator.h"
+
+#include "Misc/AES.h"
+
+void FLoadSimulator::Simulate(TArrayView<const FLoadRead> InReads, const FLoadDeviceModel& InDevice, FLoadSimulation& OutSimulation)
+{
+	OutSimulation.FileCount = InReads.Num();
+	OutSimulation.BlockCount = 0;
+	OutSimulation.ReadCount = 0;
+	OutSimulation.ReadSize = 0;
+	OutSimulation.SeekDistance = 0;
+
+	int32 HeadPakIndex = INDEX_NONE;
+	int64 HeadOffset = 0;
+
+	for (const FLoadRead& Read : InReads)
+	{
+		if (Read.PakIndex != HeadPakIndex)
+		{
+			++OutSimulation.ReadCount;
+		}
+		else if (Read.Offset != HeadOffset)
+		{
+			++OutSimulation.ReadCount;
+			OutSimulation.SeekDistance += FMath::Abs(Read.Offset - HeadOffset);
+		}
+
+		HeadPakIndex = Read.PakIndex;
+		HeadOffset = Read.Offset + Read.Size;
+
+		OutSimulation.BlockCount += Read.BlockCount;
+		OutSimulation.ReadSize += Read.Size;
+	}
+
+	OutSimulation.EstimatedTime = OutSimulation.ReadCount * InDevice.SeekLatency
+		+ OutSimulation.SeekDistance / (1024.0 * 1024.0 * 1024.0) * InDevice.SeekTimePerGB
+		+ OutSimulation.ReadSize / InDevice.ReadBandwidth;
+}
+
+FLoadRead FLoadSimulator::MakeRead(const FPakFileEntry& InFile, int32 InPakVersion)
+{
+	const FPakEntry& Entry = InFile.PakEntry;
+
+	FLoadRead Read;
+	Read.PakIndex = InFile.OwnerPakIndex;
+	Read.Offset = Entry.Offset;
+	Read.Size = Entry.GetSerializedSize(InPakVersion) + (Entry.IsEncrypted() ? Align(Entry.Size, FAES::AESBlockSize) : Entry.Size);
+	Read.BlockCount = FMath::Max(Entry.CompressionBlocks.Num(), 1);
+
+	return Read;
+}
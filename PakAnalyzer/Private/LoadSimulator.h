@@ -0,0 +1,24 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+#include "PakFileEntry.h"
+
+/** One file read as the loader issues it, offsets are absolute in the owning pak. */
+struct FLoadRead
+{
+	int32 PakIndex = 0;
+	int64 Offset = 0;
+	int64 Size = 0;
+	int32 BlockCount = 1;
+};
+
+/** Replays reads against a device model, the reads are issued in the given order. */
+class FLoadSimulator
+{
+public:
+	static void Simulate(TArrayView<const FLoadRead> InReads, const FLoadDeviceModel& InDevice, FLoadSimulation& OutSimulation);
+
+	/** Bytes a file occupies in its pak, the entry header included. */
+	static FLoadRead MakeRead(const FPakFileEntry& InFile, int32 InPakVersion);
+};
@@ -14,6 +14,7 @@
 #include "HAL/FileManager.h"
 #include "HAL/PlatformFile.h"
 #include "HAL/PlatformMisc.h"
+#include "HAL/PlatformTime.h"
 #include "Json.h"
 #include "Launch/Resources/Version.h"
 #include "Misc/Base64.h"
@@ -25,6 +26,7 @@
 #include "AssetParseThreadWorker.h"
 #include "CommonDefines.h"
 #include "ExtractThreadWorker.h"
+#include "PakAnalyzerTrace.h"
 
 #if ENGINE_MAJOR_VERSION >= 5 || ENGINE_MINOR_VERSION >= 26
 typedef FPakFile::FPakEntryIterator RecordIterator;
@@ -49,6 +51,8 @@ FPakAnalyzer::~FPakAnalyzer()
 
 FPakTreeEntryPtr FPakAnalyzer::LoadPakFile(const FString& InPakPath, const FString& InDefaultAESKey/* = TEXT("")*/)
 {
+	PAK_ANALYZER_TRACE_SCOPE(PakAnalyzer_LoadPakFile);
+
 	if (InPakPath.IsEmpty())
 	{
 		UE_LOG(LogPakAnalyzer, Error, TEXT("Load pak file failed! Pak path is empty!"));
@@ -105,6 +109,9 @@ FPakTreeEntryPtr FPakAnalyzer::LoadPakFile(const FString& InPakPath, const FStri
 	Summary->PakFilePath = InPakPath;
 	Summary->PakFileSize = PakFilePtr->TotalSize();
 	Summary->DecryptAESKeyStr = DecryptAESKey;
+
+	// FPakFile reads the whole index when it opens
+	FPakAnalyzerTrace::CountRead(Summary->PakInfo.IndexSize);
 	if (!FBase64::Decode(*DecryptAESKey, DecryptAESKey.Len(), Summary->DecryptAESKey.Key))
 	{
 		Summary->DecryptAESKey.Reset();
@@ -130,18 +137,23 @@ FPakTreeEntryPtr FPakAnalyzer::LoadPakFile(const FString& InPakPath, const FStri
 	};
 
 	TArray<FPakEntryWithFilename> Records;
-	for (RecordIterator It(*PakFilePtr, true); It; ++It)
 	{
+		PAK_ANALYZER_TRACE_SCOPE(PakAnalyzer_RecordLoop);
+
+		for (RecordIterator It(*PakFilePtr, true); It; ++It)
+		{
 #if ENGINE_MAJOR_VERSION >= 5 || ENGINE_MINOR_VERSION >= 26
-		const FString& Filename = *It.TryGetFilename();
+			const FString& Filename = *It.TryGetFilename();
 #else
-		const FString& Filename = It.Filename();
+			const FString& Filename = It.Filename();
 #endif
 
-		Records.Add({ It.Info(), Filename });
+			Records.Add({ It.Info(), Filename });
+		}
 	}
 
 	{
+		PAK_ANALYZER_TRACE_SCOPE(PakAnalyzer_InsertFileToTree);
 		FScopeLock Lock(&CriticalSection);
 
 		for (FPakEntryWithFilename& Record : Records)
@@ -172,8 +184,11 @@ FPakTreeEntryPtr FPakAnalyzer::LoadPakFile(const FString& InPakPath, const FStri
 		}
 	}
 
-	RefreshTreeNode(PakTreeRoot);
-	RefreshTreeNodeSizePercent(PakTreeRoot, PakTreeRoot);
+	{
+		PAK_ANALYZER_TRACE_SCOPE(PakAnalyzer_RefreshTreeNode);
+		RefreshTreeNode(PakTreeRoot);
+		RefreshTreeNodeSizePercent(PakTreeRoot, PakTreeRoot);
+	}
 
 	Summary->FileCount = PakTreeRoot->FileCount;
 
@@ -182,8 +197,101 @@ FPakTreeEntryPtr FPakAnalyzer::LoadPakFile(const FString& InPakPath, const FStri
 	return PakTreeRoot;
 }
 
+bool FPakAnalyzer::ResolveDiffKeys(const TArray<FString>& InPakPaths, const TArray<FString>& InDefaultAESKeys, TArray<FString>& OutKeys)
+{
+	OutKeys.Reset();
+
+	for (int32 i = 0; i < InPakPaths.Num(); ++i)
+	{
+		FString DecryptAESKey;
+		if (!PreLoadPak(InPakPaths[i], InDefaultAESKeys.IsValidIndex(i) ? InDefaultAESKeys[i] : TEXT(""), DecryptAESKey))
+		{
+			UE_LOG(LogPakAnalyzer, Error, TEXT("Resolve key for diff failed! Pre load pak file failed! Path: %s."), *InPakPaths[i]);
+			return false;
+		}
+
+		OutKeys.Add(DecryptAESKey);
+	}
+
+	return true;
+}
+
+bool FPakAnalyzer::LoadDiffRecords(const TArray<FString>& InPakPaths, const TArray<FString>& InKeys, const FAssetRegistryIndex* InIndex, const TMap<FName, FName>& InDefaultClassMap, const FThreadSafeCounter* InStopCounter, TArray<FPakDiffRecord>& OutRecords)
+{
+	OutRecords.Reset();
+
+	for (int32 i = 0; i < InPakPaths.Num(); ++i)
+	{
+		if (InStopCounter && InStopCounter->GetValue() > 0)
+		{
+			UE_LOG(LogPakAnalyzer, Log, TEXT("Load file table for diff canceled."));
+			return false;
+		}
+
+		const FString& PakPath = InPakPaths[i];
+		UE_LOG(LogPakAnalyzer, Log, TEXT("Load file table for diff: %s."), *PakPath);
+
+		// Keys were resolved on the game thread, this binds the right one for the pak file to open
+		FString DecryptAESKey;
+		if (!PreLoadPak(PakPath, InKeys.IsValidIndex(i) ? InKeys[i] : TEXT(""), DecryptAESKey, false))
+		{
+			UE_LOG(LogPakAnalyzer, Error, TEXT("Load file table for diff failed! Pre load pak file failed! Path: %s."), *PakPath);
+			return false;
+		}
+
+#if ENGINE_MAJOR_VERSION >= 5 || ENGINE_MINOR_VERSION >= 27
+		TRefCountPtr<FPakFile> PakFile = new FPakFile(*PakPath, false);
+		FPakFile* PakFilePtr = PakFile.GetReference();
+#else
+		TSharedPtr<FPakFile> PakFile = MakeShared<FPakFile>(*PakPath, false);
+		FPakFile* PakFilePtr = PakFile.Get();
+#endif // ENGINE_MAJOR_VERSION >= 5 || ENGINE_MINOR_VERSION >= 27
+		if (!PakFilePtr || !PakFilePtr->IsValid())
+		{
+			UE_LOG(LogPakAnalyzer, Error, TEXT("Load file table for diff failed! Unable to open pak file! Path: %s."), *PakPath);
+			return false;
+		}
+
+		const FString MountPoint = PakFilePtr->GetMountPoint();
+		for (RecordIterator It(*PakFilePtr, true); It; ++It)
+		{
+			if (InStopCounter && (OutRecords.Num() & 4095) == 0 && InStopCounter->GetValue() > 0)
+			{
+				UE_LOG(LogPakAnalyzer, Log, TEXT("Load file table for diff canceled."));
+				return false;
+			}
+
+#if ENGINE_MAJOR_VERSION >= 5 || ENGINE_MINOR_VERSION >= 26
+			const FString& Filename = *It.TryGetFilename();
+#else
+			const FString& Filename = It.Filename();
+#endif
+			FPakEntry PakEntry = It.Info();
+#if ENGINE_MAJOR_VERSION >= 5 || ENGINE_MINOR_VERSION >= 26
+			PakFilePtr->ReadHashFromPayload(PakEntry, PakEntry.Hash);
+#endif
+
+			// Same path form as the loaded tree
+			FString FullFilePath = MountPoint / Filename;
+			FullFilePath.ReplaceInline(TEXT("../"), TEXT(""));
+			FullFilePath.ReplaceInline(TEXT("..\\"), TEXT(""));
+
+			FPakDiffRecord& Record = OutRecords.AddDefaulted_GetRef();
+			Record.Path = MoveTemp(FullFilePath);
+			Record.Class = GetAssetClass(FPaths::GetCleanFilename(Filename), GetPackagePath(Record.Path), InIndex, InDefaultClassMap);
+			Record.Size = PakEntry.UncompressedSize;
+			Record.CompressedSize = PakEntry.Size;
+			FMemory::Memcpy(Record.Hash.Hash, PakEntry.Hash, sizeof(Record.Hash.Hash));
+		}
+	}
+
+	return true;
+}
+
 bool FPakAnalyzer::LoadPakFiles(const TArray<FString>& InPakPaths, const TArray<FString>& InDefaultAESKeys)
 {
+	PAK_ANALYZER_TRACE_SCOPE(PakAnalyzer_LoadPakFiles);
+
 	TArray<FString> PakFiles;
 	TArray<FString> UsedDefaultAESKeys;
 	IPlatformFile& PlatformFile = IPlatformFile::GetPlatformPhysical();
@@ -219,6 +327,8 @@ bool FPakAnalyzer::LoadPakFiles(const TArray<FString>& InPakPaths, const TArray<
 
 	if (!AssetRegistryPath.IsEmpty())
 	{
+		PAK_ANALYZER_TRACE_SCOPE(PakAnalyzer_RefreshClassMap);
+
 		for (const FPakTreeEntryPtr& PakTreeRoot : PakTreeRoots)
 		{
 			RefreshClassMap(PakTreeRoot, PakTreeRoot);
@@ -235,6 +345,8 @@ bool FPakAnalyzer::LoadPakFiles(const TArray<FString>& InPakPaths, const TArray<
 
 void FPakAnalyzer::ExtractFiles(const FString& InOutputPath, TArray<FPakFileEntryPtr>& InFiles)
 {
+	PAK_ANALYZER_TRACE_SCOPE(PakAnalyzer_DispatchExtract);
+
 	const int32 WorkerCount = ExtractWorkers.Num();
 	const int32 FileCount = InFiles.Num();
 
@@ -276,6 +388,15 @@ void FPakAnalyzer::ExtractFiles(const FString& InOutputPath, TArray<FPakFileEntr
 
 	ResetProgress();
 
+	SessionStats.LastExtractFileCount = FileCount;
+	SessionStats.LastExtractSize = 0;
+	SessionStats.LastExtractSeconds = 0.0;
+	for (const FPakFileEntryPtr& File : InFiles)
+	{
+		SessionStats.LastExtractSize += File->PakEntry.UncompressedSize;
+	}
+	ExtractStartTime = FPlatformTime::Seconds();
+
 	TArray<FPakFileSumary> Summaries;
 	Summaries.AddDefaulted(PakFileSummaries.Num());
 	for (int32 i = 0; i < PakFileSummaries.Num(); ++i)
@@ -317,6 +438,8 @@ void FPakAnalyzer::Reset()
 
 bool FPakAnalyzer::LoadAssetRegistryFromPak(FPakFile* InPakFile, FPakFileEntryPtr InPakFileEntry, const FAES::FAESKey& DecryptAESKey)
 {
+	PAK_ANALYZER_TRACE_SCOPE(PakAnalyzer_LoadAssetRegistryFromPak);
+
 	if (!InPakFile || !InPakFile->IsValid() || !InPakFileEntry.IsValid())
 	{
 		return false;
@@ -332,10 +455,10 @@ bool FPakAnalyzer::LoadAssetRegistryFromPak(FPakFile* InPakFile, FPakFileEntryPt
 	bool bReadResult = true;
 	const FPakEntry& EntryInfo = InPakFileEntry->PakEntry;
 
-	FArrayReader ContentReader;
-	ContentReader.AddZeroed(InPakFileEntry->PakEntry.UncompressedSize);
+	TArray<uint8> Content;
+	Content.AddZeroed(InPakFileEntry->PakEntry.UncompressedSize);
 
-	FMemoryWriter ContentWriter(ContentReader);
+	FMemoryWriter ContentWriter(Content);
 
 	if (EntryInfo.CompressionMethodIndex == 0)
 	{
@@ -363,22 +486,22 @@ bool FPakAnalyzer::LoadAssetRegistryFromPak(FPakFile* InPakFile, FPakFileEntryPt
 	FMemory::Free(Buffer);
 	FMemory::Free(PersistantCompressionBuffer);
 
+	FPakAnalyzerTrace::CountRead(EntryInfo.Size);
+
 	if (!bReadResult)
 	{
 		return false;
 	}
 
-	const bool bLoadResult = LoadAssetRegistry(ContentReader);
-	if (bLoadResult)
-	{
-		AssetRegistryPath = InPakFileEntry->Path;
-	}
+	StartLoadAssetRegistry(Content, InPakFileEntry->Path);
 
-	return bLoadResult;
+	return true;
 }
 
-bool FPakAnalyzer::PreLoadPak(const FString& InPakPath, const FString& InDefaultAESKey, FString& OutDecryptKey)
+bool FPakAnalyzer::PreLoadPak(const FString& InPakPath, const FString& InDefaultAESKey, FString& OutDecryptKey, bool bInteractive/* = true*/)
 {
+	PAK_ANALYZER_TRACE_SCOPE(PakAnalyzer_PreLoadPak);
+
 	UE_LOG(LogPakAnalyzer, Log, TEXT("Pre load pak file: %s and check file hash."), *InPakPath);
 
 	FArchive* Reader = IFileManager::Get().CreateFileReader(*InPakPath);
@@ -408,6 +531,7 @@ bool FPakAnalyzer::PreLoadPak(const FString& InPakPath, const FString& InDefault
 
 			// Serialize trailer and check if everything is as expected.
 			Info.Serialize(*Reader, CompatibleVersion);
+			FPakAnalyzerTrace::CountRead(Info.GetSerializedSize(CompatibleVersion));
 			if (Info.Magic == FPakInfo::PakFile_Magic)
 			{
 				bShouldLoad = true;
@@ -418,7 +542,10 @@ bool FPakAnalyzer::PreLoadPak(const FString& InPakPath, const FString& InDefault
 	if (!bShouldLoad)
 	{
 		UE_LOG(LogPakAnalyzer, Error, TEXT("%s is not a valid pak file!"), *InPakPath);
-		FPakAnalyzerDelegates::OnLoadPakFailed.ExecuteIfBound(FString::Printf(TEXT("%s is not a valid pak file!"), *InPakPath));
+		if (bInteractive)
+		{
+			FPakAnalyzerDelegates::OnLoadPakFailed.ExecuteIfBound(FString::Printf(TEXT("%s is not a valid pak file!"), *InPakPath));
+		}
 
 		Reader->Close();
 		delete Reader;
@@ -430,7 +557,11 @@ bool FPakAnalyzer::PreLoadPak(const FString& InPakPath, const FString& InDefault
 		OutDecryptKey = InDefaultAESKey;
 		bShouldLoad = InDefaultAESKey.IsEmpty() ? false : TryDecryptPak(Reader, Info, InDefaultAESKey, false);
 
-		if (!bShouldLoad)
+		if (!bShouldLoad && !bInteractive)
+		{
+			UE_LOG(LogPakAnalyzer, Error, TEXT("AES encryption key of %s is missing or not correct!"), *InPakPath);
+		}
+		else if (!bShouldLoad)
 		{
 			if (FPakAnalyzerDelegates::OnGetAESKey.IsBound())
 			{
@@ -469,6 +600,8 @@ bool FPakAnalyzer::ValidateEncryptionKey(TArray<uint8>& IndexData, const FSHAHas
 
 bool FPakAnalyzer::TryDecryptPak(FArchive* InReader, const FPakInfo& InPakInfo, const FString& InKey, bool bShowWarning)
 {
+	PAK_ANALYZER_TRACE_SCOPE(PakAnalyzer_TryDecryptPak);
+
 	const FString KeyString = InKey;
 	bool bShouldLoad = true;
 
@@ -508,6 +641,7 @@ bool FPakAnalyzer::TryDecryptPak(FArchive* InReader, const FPakInfo& InPakInfo,
 		InReader->Seek(InPakInfo.IndexOffset);
 		PrimaryIndexData.SetNum(InPakInfo.IndexSize);
 		InReader->Serialize(PrimaryIndexData.GetData(), InPakInfo.IndexSize);
+		FPakAnalyzerTrace::CountRead(InPakInfo.IndexSize);
 
 		if (!ValidateEncryptionKey(PrimaryIndexData, InPakInfo.IndexHash, AESKey))
 		{
@@ -571,6 +705,8 @@ void FPakAnalyzer::ShutdownAllExtractWorker()
 
 void FPakAnalyzer::ParseAssetFile()
 {
+	PAK_ANALYZER_TRACE_SCOPE(PakAnalyzer_StartAssetParse);
+
 	if (AssetParseWorker.IsValid())
 	{
 		TArray<FPakFileEntryPtr> UAssetFiles;
@@ -601,6 +737,7 @@ void FPakAnalyzer::InitializeAssetParseWorker()
 	if (!AssetParseWorker.IsValid())
 	{
 		AssetParseWorker = MakeShared<FAssetParseThreadWorker>();
+		AssetParseWorker->OnPackagesParsed.BindRaw(this, &FPakAnalyzer::OnPackagesParsed);
 		AssetParseWorker->OnParseFinish.BindRaw(this, &FPakAnalyzer::OnAssetParseFinish);
 	}
 }
@@ -613,29 +750,12 @@ void FPakAnalyzer::ShutdownAssetParseWorker()
 	}
 }
 
-void FPakAnalyzer::OnAssetParseFinish(bool bCancel, const TMap<FName, FName>& ClassMap)
+void FPakAnalyzer::PrioritizeAssetParse(const TArray<FPakFileEntryPtr>& InFiles)
 {
-	if (bCancel)
+	if (AssetParseWorker.IsValid())
 	{
-		return;
+		AssetParseWorker->Prioritize(InFiles);
 	}
-
-	DefaultClassMap = ClassMap;
-	const bool bRefreshClass = ClassMap.Num() > 0;
-
-	FFunctionGraphTask::CreateAndDispatchWhenReady([this, bRefreshClass]()
-		{
-			if (bRefreshClass)
-			{
-				for (const FPakTreeEntryPtr& PakTreeRoot : PakTreeRoots)
-				{
-					RefreshClassMap(PakTreeRoot, PakTreeRoot);
-				}
-			}
-
-			FPakAnalyzerDelegates::OnAssetParseFinish.Broadcast();
-		},
-		TStatId(), nullptr, ENamedThreads::GameThread);
 }
 
 void FPakAnalyzer::OnUpdateExtractProgress(const FGuid& WorkerGuid, int32 CompleteCount, int32 ErrorCount, int32 TotalCount)
@@ -658,6 +778,11 @@ void FPakAnalyzer::OnUpdateExtractProgress(const FGuid& WorkerGuid, int32 Comple
 				TotalTotalCount += It.Value.TotalCount;
 			}
 
+			if (TotalCompleteCount >= SessionStats.LastExtractFileCount && SessionStats.LastExtractSeconds <= 0.0)
+			{
+				SessionStats.LastExtractSeconds = FPlatformTime::Seconds() - ExtractStartTime;
+			}
+
 			FPakAnalyzerDelegates::OnUpdateExtractProgress.ExecuteIfBound(TotalCompleteCount, TotalErrorCount, TotalTotalCount);
 		},
 		TStatId(), nullptr, ENamedThreads::GameThread);
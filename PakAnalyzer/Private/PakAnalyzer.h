@@ -25,13 +25,17 @@ public:
 	virtual void ExtractFiles(const FString& InOutputPath, TArray<FPakFileEntryPtr>& InFiles) override;
 	virtual void CancelExtract() override;
 	virtual void SetExtractThreadCount(int32 InThreadCount) override;
+	virtual void PrioritizeAssetParse(const TArray<FPakFileEntryPtr>& InFiles) override;
 	virtual void Reset() override;
 
 protected:
 	FPakTreeEntryPtr LoadPakFile(const FString& InPakPath, const FString& InDefaultAESKey = TEXT(""));
+	virtual bool ResolveDiffKeys(const TArray<FString>& InPakPaths, const TArray<FString>& InDefaultAESKeys, TArray<FString>& OutKeys) override;
+	virtual bool LoadDiffRecords(const TArray<FString>& InPakPaths, const TArray<FString>& InKeys, const FAssetRegistryIndex* InIndex, const TMap<FName, FName>& InDefaultClassMap, const FThreadSafeCounter* InStopCounter, TArray<FPakDiffRecord>& OutRecords) override;
 	bool LoadAssetRegistryFromPak(FPakFile* InPakFile, FPakFileEntryPtr InPakFileEntry, const FAES::FAESKey& DecryptAESKey);
 
-	bool PreLoadPak(const FString& InPakPath, const FString& InDefaultAESKey, FString& OutDecryptKey);
+	/** Not interactive, it neither asks for a key nor reports failures to the UI, for worker threads. */
+	bool PreLoadPak(const FString& InPakPath, const FString& InDefaultAESKey, FString& OutDecryptKey, bool bInteractive = true);
 	bool ValidateEncryptionKey(TArray<uint8>& IndexData, const FSHAHash& InExpectedHash, const FAES::FAESKey& InAESKey);
 	bool TryDecryptPak(FArchive* InReader, const FPakInfo& InPakInfo, const FString& InKey, bool bShowWarning);
 
@@ -41,7 +45,6 @@ protected:
 	void ParseAssetFile();
 	void InitializeAssetParseWorker();
 	void ShutdownAssetParseWorker();
-	void OnAssetParseFinish(bool bCancel, const TMap<FName, FName>& ClassMap);
 
 	// Extract progress
 	void OnUpdateExtractProgress(const FGuid& WorkerGuid, int32 CompleteCount, int32 ErrorCount, int32 TotalCount);
@@ -59,6 +62,7 @@ protected:
 	int32 ExtractWorkerCount;
 	TArray<TSharedPtr<class FExtractThreadWorker>> ExtractWorkers;
 	TMap<FGuid, FExtractProgress> ExtractWorkerProgresses;
+	double ExtractStartTime = 0.0;
 
 	TArray<FString> DefaultAESKeys;
 
@@ -3,6 +3,8 @@
 #include "PakAnalyzerModule.h"
 
 #include "HAL/PlatformFile.h"
+#include "Misc/CommandLine.h"
+#include "Misc/Parse.h"
 #include "Misc/Paths.h"
 #include "Modules/ModuleManager.h"
 
@@ -10,6 +12,7 @@
 #include "CommonDefines.h"
 #include "FolderAnalyzer.h"
 #include "PakAnalyzer.h"
+#include "PakAnalyzerTrace.h"
 #include "IoStoreAnalyzer.h"
 
 DEFINE_LOG_CATEGORY(LogPakAnalyzer);
@@ -18,8 +21,17 @@ FPakAnalyzerDelegates::FOnGetAESKey FPakAnalyzerDelegates::OnGetAESKey;
 FPakAnalyzerDelegates::FOnLoadPakFailed FPakAnalyzerDelegates::OnLoadPakFailed;
 FPakAnalyzerDelegates::FOnUpdateExtractProgress FPakAnalyzerDelegates::OnUpdateExtractProgress;
 FPakAnalyzerDelegates::FOnExtractStart FPakAnalyzerDelegates::OnExtractStart;
+FPakAnalyzerDelegates::FOnUpdateExtractProgress FPakAnalyzerDelegates::OnUpdateExportProgress;
+FPakAnalyzerDelegates::FOnExportStart FPakAnalyzerDelegates::OnExportStart;
+FPakAnalyzerDelegates::FOnPackagesParsed FPakAnalyzerDelegates::OnPackagesParsed;
 FPakAnalyzerDelegates::FOnAssetParseFinish FPakAnalyzerDelegates::OnAssetParseFinish;
 FPakAnalyzerDelegates::FOnPakLoadFinish FPakAnalyzerDelegates::OnPakLoadFinish;
+FPakAnalyzerDelegates::FOnAssetRegistryLoadProgress FPakAnalyzerDelegates::OnAssetRegistryLoadProgress;
+FPakAnalyzerDelegates::FOnAssetRegistryLoadFinish FPakAnalyzerDelegates::OnAssetRegistryLoadFinish;
+FPakAnalyzerDelegates::FOnExportFileOrderFinish FPakAnalyzerDelegates::OnExportFileOrderFinish;
+FPakAnalyzerDelegates::FOnPakDiffFinish FPakAnalyzerDelegates::OnPakDiffFinish;
+FPakAnalyzerDelegates::FOnLoadSimulationFinish FPakAnalyzerDelegates::OnLoadSimulationFinish;
+FPakAnalyzerDelegates::FOnRecompressionEstimateFinish FPakAnalyzerDelegates::OnRecompressionEstimateFinish;
 
 class FPakAnalyzerModule : public IPakAnalyzerModule
 {
@@ -39,12 +51,22 @@ IMPLEMENT_MODULE(FPakAnalyzerModule, PakAnalyzer);
 
 void FPakAnalyzerModule::StartupModule()
 {
+	FPakAnalyzerTrace::Initialize();
+
 	AnalyzerInstance = MakeShared<FBaseAnalyzer>();
+
+	FString TracePath;
+	if (FParse::Value(FCommandLine::Get(), TEXT("-PakTrace="), TracePath, false) && !TracePath.IsEmpty())
+	{
+		FPakAnalyzerTrace::StartFileTrace(TracePath);
+	}
 }
 
 void FPakAnalyzerModule::ShutdownModule()
 {
 	AnalyzerInstance.Reset();
+
+	FPakAnalyzerTrace::StopFileTrace();
 }
 
 void FPakAnalyzerModule::InitializeAnalyzerBackend(const FString& InFullPath)
@@ -0,0 +1,362 @@
+// Copyright 1998-2019 Epic Games, Inc. All Rights Reserved.
+
+#include "PakAnalyzerTrace.h"
+
+#include "HAL/CriticalSection.h"
+#include "HAL/MemoryBase.h"
+#include "HAL/PlatformTLS.h"
+#include "HAL/PlatformTime.h"
+#include "HAL/ThreadSafeBool.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Misc/ScopeLock.h"
+
+#include "CommonDefines.h"
+
+namespace PakAnalyzerTrace
+{
+	struct FTraceEvent
+	{
+		int32 StageId;
+		uint64 StartCycles;
+		uint64 EndCycles;
+		int64 BytesRead;
+		int64 BytesWritten;
+		int64 AllocCount;
+	};
+
+	struct FStageSlot
+	{
+		int32 CallCount = 0;
+		uint64 TotalCycles = 0;
+		uint64 LastCycles = 0;
+		uint64 LastEndCycles = 0;
+		int64 BytesRead = 0;
+		int64 BytesWritten = 0;
+		int64 AllocCount = 0;
+	};
+
+	/** Stats of one thread, indexed by stage id. The lock is only contended while stats are merged, reset or written. */
+	struct FThreadStats
+	{
+		FCriticalSection Lock;
+		uint32 ThreadId = 0;
+		TArray<FStageSlot> Slots;
+		TArray<FTraceEvent> Events;
+	};
+
+	// Guards the stage names, the thread list and the trace file settings, taken once per call site and thread
+	static FCriticalSection RegistryLock;
+	static TArray<const TCHAR*> StageNames;
+	static TArray<FThreadStats*> AllThreadStats;
+	static FString TraceFilePath;
+	static uint64 TraceStartCycles = 0;
+	static FThreadSafeBool bFileTracing = false;
+
+	static thread_local FPakAnalyzerTraceScope* CurrentScope = nullptr;
+	static thread_local FThreadStats* CurrentThreadStats = nullptr;
+
+	/** Heap allocations of the calling thread, counted by FCountingMalloc. */
+	static thread_local int64 ThreadAllocCount = 0;
+
+	static FThreadStats& GetThreadStats()
+	{
+		if (!CurrentThreadStats)
+		{
+			// Kept after the thread exits, its stats still count and threads are few
+			FThreadStats* Stats = new FThreadStats();
+			Stats->ThreadId = FPlatformTLS::GetCurrentThreadId();
+
+			FScopeLock Lock(&RegistryLock);
+			AllThreadStats.Add(Stats);
+			CurrentThreadStats = Stats;
+		}
+
+		return *CurrentThreadStats;
+	}
+
+	/** Forwards to the allocator it wraps and counts every allocation of the calling thread. */
+	class FCountingMalloc final : public FMalloc
+	{
+	public:
+		explicit FCountingMalloc(FMalloc* InMalloc)
+			: UsedMalloc(InMalloc)
+		{
+		}
+
+		virtual void* Malloc(SIZE_T Count, uint32 Alignment) override
+		{
+			++ThreadAllocCount;
+			return UsedMalloc->Malloc(Count, Alignment);
+		}
+
+		virtual void* Realloc(void* Original, SIZE_T Count, uint32 Alignment) override
+		{
+			// A shrink to zero frees, anything else may allocate
+			if (Count > 0)
+			{
+				++ThreadAllocCount;
+			}
+			return UsedMalloc->Realloc(Original, Count, Alignment);
+		}
+
+		virtual void Free(void* Original) override { UsedMalloc->Free(Original); }
+		virtual bool GetAllocationSize(void* Original, SIZE_T& SizeOut) override { return UsedMalloc->GetAllocationSize(Original, SizeOut); }
+		virtual SIZE_T QuantizeSize(SIZE_T Count, uint32 Alignment) override { return UsedMalloc->QuantizeSize(Count, Alignment); }
+#if ENGINE_MAJOR_VERSION >= 5 || ENGINE_MINOR_VERSION >= 25
+		virtual void Trim(bool bTrimThreadCaches) override { UsedMalloc->Trim(bTrimThreadCaches); }
+#endif
+		virtual void SetupTLSCachesOnCurrentThread() override { UsedMalloc->SetupTLSCachesOnCurrentThread(); }
+		virtual void ClearAndDisableTLSCachesOnCurrentThread() override { UsedMalloc->ClearAndDisableTLSCachesOnCurrentThread(); }
+		virtual void InitializeStatsMetadata() override { UsedMalloc->InitializeStatsMetadata(); }
+		virtual void UpdateStats() override { UsedMalloc->UpdateStats(); }
+		virtual void GetAllocatorStats(FGenericMemoryStats& OutStats) override { UsedMalloc->GetAllocatorStats(OutStats); }
+		virtual void DumpAllocatorStats(FOutputDevice& Ar) override { UsedMalloc->DumpAllocatorStats(Ar); }
+		virtual bool IsInternallyThreadSafe() const override { return UsedMalloc->IsInternallyThreadSafe(); }
+		virtual bool ValidateHeap() override { return UsedMalloc->ValidateHeap(); }
+		virtual const TCHAR* GetDescriptiveName() override { return UsedMalloc->GetDescriptiveName(); }
+
+	protected:
+		FMalloc* UsedMalloc;
+	};
+}
+
+FPakAnalyzerTraceScope::FPakAnalyzerTraceScope(int32 InStageId)
+	: StageId(InStageId)
+	, StartCycles(FPlatformTime::Cycles64())
+	, StartAllocCount(PakAnalyzerTrace::ThreadAllocCount)
+	, Parent(PakAnalyzerTrace::CurrentScope)
+{
+	PakAnalyzerTrace::CurrentScope = this;
+}
+
+FPakAnalyzerTraceScope::~FPakAnalyzerTraceScope()
+{
+	using namespace PakAnalyzerTrace;
+
+	const uint64 EndCycles = FPlatformTime::Cycles64();
+	const int64 AllocCount = ThreadAllocCount - StartAllocCount;
+
+	// Allocations of nested scopes are already in the thread count, bytes are passed up
+	CurrentScope = Parent;
+	if (Parent)
+	{
+		Parent->BytesRead += BytesRead;
+		Parent->BytesWritten += BytesWritten;
+	}
+
+	FThreadStats& Stats = GetThreadStats();
+	FScopeLock Lock(&Stats.Lock);
+
+	if (Stats.Slots.Num() <= StageId)
+	{
+		Stats.Slots.SetNum(StageId + 1);
+	}
+
+	FStageSlot& Slot = Stats.Slots[StageId];
+	Slot.CallCount++;
+	Slot.TotalCycles += EndCycles - StartCycles;
+	Slot.LastCycles = EndCycles - StartCycles;
+	Slot.LastEndCycles = EndCycles;
+	Slot.BytesRead += BytesRead;
+	Slot.BytesWritten += BytesWritten;
+	Slot.AllocCount += AllocCount;
+
+	if (bFileTracing)
+	{
+		Stats.Events.Add({ StageId, StartCycles, EndCycles, BytesRead, BytesWritten, AllocCount });
+	}
+}
+
+void FPakAnalyzerTrace::Initialize()
+{
+	using namespace PakAnalyzerTrace;
+
+	static bool bInitialized = false;
+	if (bInitialized || !GMalloc)
+	{
+		return;
+	}
+
+	// Other threads may still call the old allocator for a moment, both end up in the same heap
+	bInitialized = true;
+	GMalloc = new FCountingMalloc(GMalloc);
+}
+
+void FPakAnalyzerTrace::StartFileTrace(const FString& InPath)
+{
+	using namespace PakAnalyzerTrace;
+
+	FScopeLock Lock(&RegistryLock);
+
+	for (FThreadStats* Stats : AllThreadStats)
+	{
+		FScopeLock StatsLock(&Stats->Lock);
+		Stats->Events.Reset();
+	}
+
+	TraceFilePath = FPaths::ConvertRelativePathToFull(InPath);
+	TraceStartCycles = FPlatformTime::Cycles64();
+	bFileTracing = true;
+
+	UE_LOG(LogPakAnalyzer, Log, TEXT("Start analyzer trace: %s."), *TraceFilePath);
+}
+
+bool FPakAnalyzerTrace::StopFileTrace()
+{
+	using namespace PakAnalyzerTrace;
+
+	struct FThreadEvents
+	{
+		uint32 ThreadId;
+		TArray<FTraceEvent> Events;
+	};
+
+	TArray<FThreadEvents> ThreadEvents;
+	TArray<const TCHAR*> Names;
+	FString Path;
+	uint64 StartCycles = 0;
+	{
+		FScopeLock Lock(&RegistryLock);
+		if (!bFileTracing)
+		{
+			return false;
+		}
+
+		bFileTracing = false;
+		for (FThreadStats* Stats : AllThreadStats)
+		{
+			FScopeLock StatsLock(&Stats->Lock);
+			ThreadEvents.Add({ Stats->ThreadId, MoveTemp(Stats->Events) });
+		}
+
+		Names = StageNames;
+		Path = TraceFilePath;
+		StartCycles = TraceStartCycles;
+	}
+
+	// Chrome trace event format, loads in chrome://tracing and Perfetto
+	int32 EventCount = 0;
+	FString Content;
+	Content += TEXT("{\"traceEvents\":[");
+	for (const FThreadEvents& Thread : ThreadEvents)
+	{
+		for (const FTraceEvent& Event : Thread.Events)
+		{
+			const double StartMicroseconds = FPlatformTime::ToSeconds64(Event.StartCycles - FMath::Min(Event.StartCycles, StartCycles)) * 1000000.0;
+			const double DurationMicroseconds = FPlatformTime::ToSeconds64(Event.EndCycles - Event.StartCycles) * 1000000.0;
+
+			Content += FString::Printf(TEXT("%s\n{\"name\":\"%s\",\"cat\":\"PakAnalyzer\",\"ph\":\"X\",\"pid\":1,\"tid\":%u,\"ts\":%.3f,\"dur\":%.3f,\"args\":{\"BytesRead\":%lld,\"BytesWritten\":%lld,\"Allocs\":%lld}}"),
+				EventCount > 0 ? TEXT(",") : TEXT(""), Names[Event.StageId], Thread.ThreadId, StartMicroseconds, DurationMicroseconds, Event.BytesRead, Event.BytesWritten, Event.AllocCount);
+			++EventCount;
+		}
+	}
+	Content += TEXT("\n]}\n");
+
+	const bool bResult = FFileHelper::SaveStringToFile(Content, *Path);
+	UE_LOG(LogPakAnalyzer, Log, TEXT("Write analyzer trace: %s, event count: %d, result: %d."), *Path, EventCount, bResult);
+
+	return bResult;
+}
+
+bool FPakAnalyzerTrace::IsFileTracing()
+{
+	return PakAnalyzerTrace::bFileTracing;
+}
+
+void FPakAnalyzerTrace::CountRead(int64 InBytes)
+{
+	if (FPakAnalyzerTraceScope* Scope = PakAnalyzerTrace::CurrentScope)
+	{
+		Scope->BytesRead += InBytes;
+	}
+}
+
+void FPakAnalyzerTrace::CountWrite(int64 InBytes)
+{
+	if (FPakAnalyzerTraceScope* Scope = PakAnalyzerTrace::CurrentScope)
+	{
+		Scope->BytesWritten += InBytes;
+	}
+}
+
+int32 FPakAnalyzerTrace::RegisterStage(const TCHAR* InName)
+{
+	using namespace PakAnalyzerTrace;
+
+	FScopeLock Lock(&RegistryLock);
+
+	for (int32 StageId = 0; StageId < StageNames.Num(); ++StageId)
+	{
+		if (FCString::Strcmp(StageNames[StageId], InName) == 0)
+		{
+			return StageId;
+		}
+	}
+
+	return StageNames.Add(InName);
+}
+
+void FPakAnalyzerTrace::GetStageStats(TArray<FPakAnalyzerStageStat>& OutStats)
+{
+	using namespace PakAnalyzerTrace;
+
+	OutStats.Reset();
+
+	FScopeLock Lock(&RegistryLock);
+
+	TArray<FStageSlot> Merged;
+	Merged.SetNum(StageNames.Num());
+	for (FThreadStats* Stats : AllThreadStats)
+	{
+		FScopeLock StatsLock(&Stats->Lock);
+		for (int32 StageId = 0; StageId < Stats->Slots.Num(); ++StageId)
+		{
+			const FStageSlot& Slot = Stats->Slots[StageId];
+			FStageSlot& Total = Merged[StageId];
+			Total.CallCount += Slot.CallCount;
+			Total.TotalCycles += Slot.TotalCycles;
+			Total.BytesRead += Slot.BytesRead;
+			Total.BytesWritten += Slot.BytesWritten;
+			Total.AllocCount += Slot.AllocCount;
+
+			// The last call is the one that ended last on any thread
+			if (Slot.CallCount > 0 && Slot.LastEndCycles >= Total.LastEndCycles)
+			{
+				Total.LastCycles = Slot.LastCycles;
+				Total.LastEndCycles = Slot.LastEndCycles;
+			}
+		}
+	}
+
+	for (int32 StageId = 0; StageId < Merged.Num(); ++StageId)
+	{
+		const FStageSlot& Total = Merged[StageId];
+		if (Total.CallCount <= 0)
+		{
+			continue;
+		}
+
+		FPakAnalyzerStageStat& Stat = OutStats.AddDefaulted_GetRef();
+		Stat.Name = StageNames[StageId];
+		Stat.CallCount = Total.CallCount;
+		Stat.TotalSeconds = FPlatformTime::ToSeconds64(Total.TotalCycles);
+		Stat.LastSeconds = FPlatformTime::ToSeconds64(Total.LastCycles);
+		Stat.BytesRead = Total.BytesRead;
+		Stat.BytesWritten = Total.BytesWritten;
+		Stat.AllocCount = Total.AllocCount;
+	}
+}
+
+void FPakAnalyzerTrace::ResetStageStats()
+{
+	using namespace PakAnalyzerTrace;
+
+	FScopeLock Lock(&RegistryLock);
+
+	for (FThreadStats* Stats : AllThreadStats)
+	{
+		FScopeLock StatsLock(&Stats->Lock);
+		Stats->Slots.Reset();
+	}
+}
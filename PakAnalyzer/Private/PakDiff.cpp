@@ -0,0 +1,164 @@
+#include "PakDiff.h"
+
+#include "Async/ParallelFor.h"
+#include "HAL/PlatformTime.h"
+#include "Misc/Paths.h"
+
+#include "CommonDefines.h"
+
+void FPakDiff::Diff(const TArray<FPakDiffRecord>& InOld, const TArray<FPakDiffRecord>& InNew, FPakDiffResult& OutResult)
+{
+	const double StartTime = FPlatformTime::Seconds();
+
+	OutResult = FPakDiffResult();
+
+	TMap<FString, int32> OldPathMap;
+	TArray<int32> OldRecords;
+	BuildPathMap(InOld, OldPathMap, OldRecords);
+
+	TMap<FString, int32> NewPathMap;
+	TArray<int32> NewRecords;
+	BuildPathMap(InNew, NewPathMap, NewRecords);
+	NewPathMap.Empty();
+
+	// Probe the old table with every new record, each old record is matched at most once
+	TArray<FPakDiffEntry> NewEntries;
+	NewEntries.SetNum(NewRecords.Num());
+	TArray<uint8> OldMatched;
+	OldMatched.SetNumZeroed(InOld.Num());
+
+	ParallelFor(NewRecords.Num(), [&](int32 InIndex)
+		{
+			const FPakDiffRecord& NewRecord = InNew[NewRecords[InIndex]];
+			FPakDiffEntry& Entry = NewEntries[InIndex];
+			Entry.Path = NewRecord.Path;
+			Entry.Class = NewRecord.Class;
+			Entry.NewSize = NewRecord.Size;
+			Entry.NewCompressedSize = NewRecord.CompressedSize;
+
+			const int32* OldIndex = OldPathMap.Find(NewRecord.Path);
+			if (!OldIndex)
+			{
+				Entry.Type = EPakDiffType::Added;
+				return;
+			}
+
+			const FPakDiffRecord& OldRecord = InOld[*OldIndex];
+			OldMatched[*OldIndex] = 1;
+
+			Entry.OldSize = OldRecord.Size;
+			Entry.OldCompressedSize = OldRecord.CompressedSize;
+			// Loose files carry no hash, their size is all there is to compare
+			const bool bSame = OldRecord.Hash == FSHAHash() && NewRecord.Hash == FSHAHash() ? OldRecord.Size == NewRecord.Size : OldRecord.Hash == NewRecord.Hash;
+			Entry.Type = bSame ? EPakDiffType::Unchanged : EPakDiffType::Modified;
+		});
+
+	// Removed records that reappear under another path with the same content are moves
+	TMap<FSHAHash, int32> RemovedHashMap;
+	for (const int32 OldIndex : OldRecords)
+	{
+		if (!OldMatched[OldIndex] && InOld[OldIndex].Hash != FSHAHash())
+		{
+			RemovedHashMap.Add(InOld[OldIndex].Hash, OldIndex);
+		}
+	}
+
+	for (FPakDiffEntry& Entry : NewEntries)
+	{
+		if (Entry.Type != EPakDiffType::Added)
+		{
+			continue;
+		}
+
+		const FPakDiffRecord& NewRecord = InNew[NewRecords[&Entry - NewEntries.GetData()]];
+		int32 OldIndex = INDEX_NONE;
+		if (RemovedHashMap.RemoveAndCopyValue(NewRecord.Hash, OldIndex))
+		{
+			const FPakDiffRecord& OldRecord = InOld[OldIndex];
+			OldMatched[OldIndex] = 1;
+
+			Entry.Type = EPakDiffType::Moved;
+			Entry.OldPath = OldRecord.Path;
+			Entry.OldSize = OldRecord.Size;
+			Entry.OldCompressedSize = OldRecord.CompressedSize;
+		}
+	}
+
+	OutResult.Entries.Reserve(NewEntries.Num());
+	for (FPakDiffEntry& Entry : NewEntries)
+	{
+		if (Entry.Type != EPakDiffType::Unchanged)
+		{
+			OutResult.Entries.Add(MoveTemp(Entry));
+		}
+		else
+		{
+			++OutResult.Total.Counts[(int32)EPakDiffType::Unchanged];
+		}
+	}
+	NewEntries.Empty();
+
+	for (const int32 OldIndex : OldRecords)
+	{
+		if (!OldMatched[OldIndex])
+		{
+			const FPakDiffRecord& OldRecord = InOld[OldIndex];
+
+			FPakDiffEntry& Entry = OutResult.Entries.AddDefaulted_GetRef();
+			Entry.Type = EPakDiffType::Removed;
+			Entry.Path = OldRecord.Path;
+			Entry.Class = OldRecord.Class;
+			Entry.OldSize = OldRecord.Size;
+			Entry.OldCompressedSize = OldRecord.CompressedSize;
+		}
+	}
+
+	TMap<FString, int32> FolderMap;
+	TMap<FName, int32> ClassMap;
+	for (const FPakDiffEntry& Entry : OutResult.Entries)
+	{
+		AddToGroup(OutResult.Total, Entry);
+
+		const FString Folder = FPaths::GetPath(Entry.Path);
+		int32* FolderIndex = FolderMap.Find(Folder);
+		if (!FolderIndex)
+		{
+			FolderIndex = &FolderMap.Add(Folder, OutResult.Folders.Num());
+			OutResult.Folders.AddDefaulted_GetRef().Name = Folder;
+		}
+		AddToGroup(OutResult.Folders[*FolderIndex], Entry);
+
+		int32* ClassIndex = ClassMap.Find(Entry.Class);
+		if (!ClassIndex)
+		{
+			ClassIndex = &ClassMap.Add(Entry.Class, OutResult.Classes.Num());
+			OutResult.Classes.AddDefaulted_GetRef().Name = Entry.Class.ToString();
+		}
+		AddToGroup(OutResult.Classes[*ClassIndex], Entry);
+	}
+
+	auto ByCompressedSizeDelta = [](const FPakDiffGroup& A, const FPakDiffGroup& B) { return FMath::Abs(A.CompressedSizeDelta) > FMath::Abs(B.CompressedSizeDelta); };
+	OutResult.Folders.Sort(ByCompressedSizeDelta);
+	OutResult.Classes.Sort(ByCompressedSizeDelta);
+
+	UE_LOG(LogPakAnalyzer, Log, TEXT("Diff pak files, old count: %d, new count: %d, changed count: %d, cost: %.2fms."), OldRecords.Num(), NewRecords.Num(), OutResult.Entries.Num(), (FPlatformTime::Seconds() - StartTime) * 1000.0);
+}
+
+void FPakDiff::BuildPathMap(const TArray<FPakDiffRecord>& InRecords, TMap<FString, int32>& OutPathMap, TArray<int32>& OutUnique)
+{
+	OutPathMap.Empty(InRecords.Num());
+	for (int32 i = 0; i < InRecords.Num(); ++i)
+	{
+		OutPathMap.Add(InRecords[i].Path, i);
+	}
+
+	OutPathMap.GenerateValueArray(OutUnique);
+	OutUnique.Sort();
+}
+
+void FPakDiff::AddToGroup(FPakDiffGroup& InOutGroup, const FPakDiffEntry& InEntry)
+{
+	++InOutGroup.Counts[(int32)InEntry.Type];
+	InOutGroup.SizeDelta += InEntry.NewSize - InEntry.OldSize;
+	InOutGroup.CompressedSizeDelta += InEntry.NewCompressedSize - InEntry.OldCompressedSize;
+}
@@ -0,0 +1,17 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+#include "PakFileEntry.h"
+
+/** Hash join of two flat file tables by path, then by content for the leftovers. */
+class FPakDiff
+{
+public:
+	/** Later records override earlier ones of the same path, like patch paks do. */
+	static void Diff(const TArray<FPakDiffRecord>& InOld, const TArray<FPakDiffRecord>& InNew, FPakDiffResult& OutResult);
+
+protected:
+	static void BuildPathMap(const TArray<FPakDiffRecord>& InRecords, TMap<FString, int32>& OutPathMap, TArray<int32>& OutUnique);
+	static void AddToGroup(FPakDiffGroup& InOutGroup, const FPakDiffEntry& InEntry);
+};
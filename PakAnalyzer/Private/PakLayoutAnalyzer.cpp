@@ -0,0 +1,125 @@
+#include "PakLayoutAnalyzer.h"
+
+#include "HAL/PlatformTime.h"
+#include "Misc/Paths.h"
+
+#include "CommonDefines.h"
+#include "LoadSimulator.h"
+
+void FPakLayoutAnalyzer::Analyze(const FPakFileSumary& InSummary, int32 InPakIndex, const TArray<FPakFileEntryPtr>& InFiles, FPakLayout& OutLayout)
+{
+	const double StartTime = FPlatformTime::Seconds();
+
+	OutLayout = FPakLayout();
+	OutLayout.PakIndex = InPakIndex;
+	OutLayout.PakSize = InSummary.PakFileSize;
+	OutLayout.IndexOffset = InSummary.PakInfo.IndexOffset;
+	OutLayout.Files = InFiles;
+
+	OutLayout.Files.Sort([](const FPakFileEntryPtr& A, const FPakFileEntryPtr& B) { return A->PakEntry.Offset < B->PakEntry.Offset; });
+
+	// Secondary indices of newer pak versions sit between the primary index and the footer
+	const int64 FooterOffset = FMath::Max<int64>(0, InSummary.PakFileSize - InSummary.PakInfo.GetSerializedSize(InSummary.PakInfo.Version));
+	const int64 DataEnd = OutLayout.IndexOffset > 0 ? FMath::Min(OutLayout.IndexOffset, FooterOffset) : FooterOffset;
+	OutLayout.IndexSize = FooterOffset - DataEnd;
+
+	auto AddHole = [&OutLayout](int64 InOffset, int64 InEnd)
+	{
+		if (InEnd <= InOffset)
+		{
+			return;
+		}
+
+		FPakLayoutSpan& Span = OutLayout.Spans.AddDefaulted_GetRef();
+		Span.Offset = InOffset;
+		Span.Size = InEnd - InOffset;
+
+		if (Span.Size < GetAlignment(InEnd))
+		{
+			Span.Type = EPakLayoutSpanType::Padding;
+			++OutLayout.PaddingCount;
+			OutLayout.PaddingSize += Span.Size;
+		}
+		else
+		{
+			Span.Type = EPakLayoutSpanType::Gap;
+			++OutLayout.GapCount;
+			OutLayout.GapSize += Span.Size;
+			OutLayout.LargestGap = FMath::Max(OutLayout.LargestGap, Span.Size);
+		}
+	};
+
+	TSet<FString> Directories;
+	TSet<FName> Classes;
+	FString LastDirectory;
+	FName LastClass;
+
+	OutLayout.Spans.Reserve(OutLayout.Files.Num() * 2 + 2);
+
+	int64 Cursor = 0;
+	for (int32 i = 0; i < OutLayout.Files.Num(); ++i)
+	{
+		const FPakFileEntry& File = *OutLayout.Files[i];
+		const FLoadRead Read = FLoadSimulator::MakeRead(File, InSummary.PakInfo.Version);
+
+		if (Read.Offset < Cursor)
+		{
+			++OutLayout.OverlapCount;
+		}
+		else
+		{
+			AddHole(Cursor, Read.Offset);
+		}
+
+		FPakLayoutSpan& Span = OutLayout.Spans.AddDefaulted_GetRef();
+		Span.Type = EPakLayoutSpanType::Entry;
+		Span.Offset = Read.Offset;
+		Span.Size = Read.Size;
+		Span.FileIndex = i;
+
+		OutLayout.EntrySize += Read.Size;
+		Cursor = FMath::Max(Cursor, Read.Offset + Read.Size);
+
+		FString Directory = FPaths::GetPath(File.Path);
+		if (i > 0)
+		{
+			OutLayout.DirectoryChanges += Directory != LastDirectory ? 1 : 0;
+			OutLayout.ClassChanges += File.Class != LastClass ? 1 : 0;
+		}
+		Directories.Add(Directory);
+		Classes.Add(File.Class);
+		LastDirectory = MoveTemp(Directory);
+		LastClass = File.Class;
+	}
+
+	AddHole(Cursor, DataEnd);
+
+	if (OutLayout.IndexSize > 0)
+	{
+		FPakLayoutSpan& Span = OutLayout.Spans.AddDefaulted_GetRef();
+		Span.Type = EPakLayoutSpanType::Index;
+		Span.Offset = DataEnd;
+		Span.Size = OutLayout.IndexSize;
+	}
+
+	if (OutLayout.PakSize > FooterOffset)
+	{
+		FPakLayoutSpan& Span = OutLayout.Spans.AddDefaulted_GetRef();
+		Span.Type = EPakLayoutSpanType::Footer;
+		Span.Offset = FooterOffset;
+		Span.Size = OutLayout.PakSize - FooterOffset;
+	}
+
+	OutLayout.DirectoryCount = Directories.Num();
+	OutLayout.ClassCount = Classes.Num();
+
+	UE_LOG(LogPakAnalyzer, Log, TEXT("Analyze pak layout: %s, entry count: %d, gap count: %d, gap size: %lld, padding count: %d, padding size: %lld, cost: %.2fms."),
+		*InSummary.PakFilePath, OutLayout.Files.Num(), OutLayout.GapCount, OutLayout.GapSize, OutLayout.PaddingCount, OutLayout.PaddingSize, (FPlatformTime::Seconds() - StartTime) * 1000.0);
+}
+
+int64 FPakLayoutAnalyzer::GetAlignment(int64 InOffset)
+{
+	static const int64 MaxAlignment = 64 * 1024;
+
+	return InOffset > 0 ? FMath::Min(InOffset & -InOffset, MaxAlignment) : MaxAlignment;
+}
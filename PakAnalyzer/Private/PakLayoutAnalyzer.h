@@ -0,0 +1,15 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+#include "PakFileEntry.h"
+
+/** Walks the entries of one pak in offset order and accounts for every byte. */
+class FPakLayoutAnalyzer
+{
+public:
+	static void Analyze(const FPakFileSumary& InSummary, int32 InPakIndex, const TArray<FPakFileEntryPtr>& InFiles, FPakLayout& OutLayout);
+
+	/** Largest power of two the offset is aligned to, capped to a sane pak alignment. */
+	static int64 GetAlignment(int64 InOffset);
+};
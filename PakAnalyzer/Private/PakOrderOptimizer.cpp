@@ -0,0 +1,215 @@
+#include "PakOrderOptimizer.h"
+
+#include "Async/ParallelFor.h"
+
+namespace PakOrderOptimizerPrivate
+{
+	// Closures of this many roots are computed in parallel before they are merged in root order
+	static const int32 RootBatchSize = 16;
+
+	struct FPackageRank
+	{
+		int32 RootCount = 0;
+		int32 FirstVisit = INDEX_NONE;
+		uint64 RootSetHash = 0;
+	};
+}
+
+FPakOrderOptimizer::FPakOrderOptimizer(const FDependencyGraph& InGraph, const TArray<FPakFileEntryPtr>& InFiles, const TArray<FLoadRead>& InReads)
+	: Graph(InGraph)
+	, Files(InFiles)
+	, Reads(InReads)
+{
+	TMap<const FPakFileEntry*, int32> FileIndexMap;
+	FileIndexMap.Reserve(Files.Num());
+	for (int32 i = 0; i < Files.Num(); ++i)
+	{
+		FileIndexMap.Add(Files[i].Get(), i);
+	}
+
+	PackageFileOffsets.SetNumUninitialized(Graph.Num() + 1);
+	PackageFiles.Reserve(Files.Num());
+	for (int32 PackageId = 0; PackageId < Graph.Num(); ++PackageId)
+	{
+		PackageFileOffsets[PackageId] = PackageFiles.Num();
+		for (const FPakFileEntryPtr& File : Graph.GetFiles(PackageId))
+		{
+			const int32* FileIndex = FileIndexMap.Find(File.Get());
+			if (FileIndex)
+			{
+				PackageFiles.Add(*FileIndex);
+			}
+		}
+
+		TArrayView<int32> Row(PackageFiles.GetData() + PackageFileOffsets[PackageId], PackageFiles.Num() - PackageFileOffsets[PackageId]);
+		Row.Sort([this](int32 A, int32 B) { return Reads[A].Offset < Reads[B].Offset; });
+	}
+	PackageFileOffsets[Graph.Num()] = PackageFiles.Num();
+}
+
+void FPakOrderOptimizer::Optimize(const TArray<int32>& InRoots, TArray<int32>& OutFileOrder) const
+{
+	using namespace PakOrderOptimizerPrivate;
+
+	TArray<FPackageRank> Ranks;
+	Ranks.SetNum(Graph.Num());
+	int32 NextVisit = 0;
+
+	for (int32 BatchStart = 0; BatchStart < InRoots.Num(); BatchStart += RootBatchSize)
+	{
+		const int32 BatchNum = FMath::Min(RootBatchSize, InRoots.Num() - BatchStart);
+
+		TArray<TArray<int32>> Closures;
+		Closures.SetNum(BatchNum);
+		ParallelFor(BatchNum, [this, &InRoots, &Closures, BatchStart](int32 InIndex)
+			{
+				Graph.GetClosure({ InRoots[BatchStart + InIndex] }, false, Closures[InIndex]);
+			});
+
+		for (int32 i = 0; i < BatchNum; ++i)
+		{
+			const uint64 RootKey = (uint64)(BatchStart + i) + 1;
+			for (const int32 PackageId : Closures[i])
+			{
+				FPackageRank& Rank = Ranks[PackageId];
+				if (Rank.FirstVisit == INDEX_NONE)
+				{
+					Rank.FirstVisit = NextVisit++;
+				}
+				++Rank.RootCount;
+				Rank.RootSetHash = (Rank.RootSetHash ^ RootKey) * 1099511628211ull;
+			}
+		}
+	}
+
+	// Packages reached by the same roots form a group, a group is placed where its first package was visited
+	TMap<uint64, int32> GroupFirstVisits;
+	TArray<int32> PackageIds;
+	for (int32 PackageId = 0; PackageId < Ranks.Num(); ++PackageId)
+	{
+		const FPackageRank& Rank = Ranks[PackageId];
+		if (Rank.RootCount > 0)
+		{
+			PackageIds.Add(PackageId);
+
+			int32& GroupFirstVisit = GroupFirstVisits.FindOrAdd(Rank.RootSetHash, MAX_int32);
+			GroupFirstVisit = FMath::Min(GroupFirstVisit, Rank.FirstVisit);
+		}
+	}
+
+	PackageIds.Sort([&Ranks, &GroupFirstVisits](int32 A, int32 B)
+		{
+			const FPackageRank& RankA = Ranks[A];
+			const FPackageRank& RankB = Ranks[B];
+			if (RankA.RootCount != RankB.RootCount)
+			{
+				return RankA.RootCount > RankB.RootCount;
+			}
+
+			const int32 GroupA = GroupFirstVisits[RankA.RootSetHash];
+			const int32 GroupB = GroupFirstVisits[RankB.RootSetHash];
+			return GroupA != GroupB ? GroupA < GroupB : RankA.FirstVisit < RankB.FirstVisit;
+		});
+
+	OutFileOrder.Reset(Files.Num());
+
+	TBitArray<> Placed(false, Files.Num());
+	for (const int32 PackageId : PackageIds)
+	{
+		for (const int32 FileIndex : GetPackageFiles(PackageId))
+		{
+			OutFileOrder.Add(FileIndex);
+			Placed[FileIndex] = true;
+		}
+	}
+
+	// Everything no root loads keeps its current relative order at the end
+	TArray<int32> CurrentOrder;
+	GetCurrentOrder(CurrentOrder);
+	for (const int32 FileIndex : CurrentOrder)
+	{
+		if (!Placed[FileIndex])
+		{
+			OutFileOrder.Add(FileIndex);
+		}
+	}
+}
+
+void FPakOrderOptimizer::GetOffsets(const TArray<int32>& InFileOrder, TArray<int64>& OutOffsets) const
+{
+	// Every pak is rebuilt from where its first entry starts now
+	TMap<int32, int64> Cursors;
+	for (const FLoadRead& Read : Reads)
+	{
+		int64& Cursor = Cursors.FindOrAdd(Read.PakIndex, MAX_int64);
+		Cursor = FMath::Min(Cursor, Read.Offset);
+	}
+
+	OutOffsets.SetNumUninitialized(Files.Num());
+	for (const int32 FileIndex : InFileOrder)
+	{
+		int64& Cursor = Cursors[Reads[FileIndex].PakIndex];
+		OutOffsets[FileIndex] = Cursor;
+		Cursor += Reads[FileIndex].Size;
+	}
+}
+
+void FPakOrderOptimizer::Simulate(const TArray<int32>& InRoots, const TArray<int64>& InOffsets, const FLoadDeviceModel& InDevice, FLoadSimulation& OutTotal) const
+{
+	TArray<FLoadSimulation> Simulations;
+	Simulations.SetNum(InRoots.Num());
+
+	ParallelFor(InRoots.Num(), [this, &InRoots, &InOffsets, &InDevice, &Simulations](int32 InIndex)
+		{
+			TArray<int32> PackageIds;
+			Graph.GetClosure({ InRoots[InIndex] }, false, PackageIds);
+
+			TArray<FLoadRead> RootReads;
+			for (const int32 PackageId : PackageIds)
+			{
+				for (const int32 FileIndex : GetPackageFiles(PackageId))
+				{
+					FLoadRead& Read = RootReads.Add_GetRef(Reads[FileIndex]);
+					Read.Offset = InOffsets[FileIndex];
+				}
+			}
+
+			Simulations[InIndex].PackageCount = PackageIds.Num();
+			FLoadSimulator::Simulate(RootReads, InDevice, Simulations[InIndex]);
+		});
+
+	OutTotal = FLoadSimulation();
+	for (const FLoadSimulation& Simulation : Simulations)
+	{
+		OutTotal.PackageCount += Simulation.PackageCount;
+		OutTotal.FileCount += Simulation.FileCount;
+		OutTotal.BlockCount += Simulation.BlockCount;
+		OutTotal.ReadCount += Simulation.ReadCount;
+		OutTotal.ReadSize += Simulation.ReadSize;
+		OutTotal.SeekDistance += Simulation.SeekDistance;
+		OutTotal.EstimatedTime += Simulation.EstimatedTime;
+	}
+}
+
+void FPakOrderOptimizer::GetCurrentOffsets(TArray<int64>& OutOffsets) const
+{
+	OutOffsets.SetNumUninitialized(Files.Num());
+	for (int32 i = 0; i < Files.Num(); ++i)
+	{
+		OutOffsets[i] = Reads[i].Offset;
+	}
+}
+
+void FPakOrderOptimizer::GetCurrentOrder(TArray<int32>& OutFileOrder) const
+{
+	OutFileOrder.SetNumUninitialized(Files.Num());
+	for (int32 i = 0; i < Files.Num(); ++i)
+	{
+		OutFileOrder[i] = i;
+	}
+
+	OutFileOrder.Sort([this](int32 A, int32 B)
+		{
+			return Reads[A].PakIndex != Reads[B].PakIndex ? Reads[A].PakIndex < Reads[B].PakIndex : Reads[A].Offset < Reads[B].Offset;
+		});
+}
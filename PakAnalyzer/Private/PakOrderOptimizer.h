@@ -0,0 +1,48 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+#include "DependencyGraph.h"
+#include "LoadSimulator.h"
+#include "PakFileEntry.h"
+
+/**
+ * Recommends a file order that keeps the dependency closure of every root contiguous.
+ * Packages are grouped by the set of roots that reach them, groups shared by more roots come first.
+ */
+class FPakOrderOptimizer
+{
+public:
+	/** InReads holds the current pak range of every file in InFiles. */
+	FPakOrderOptimizer(const FDependencyGraph& InGraph, const TArray<FPakFileEntryPtr>& InFiles, const TArray<FLoadRead>& InReads);
+
+	/** Fills the recommended order as indices into the files, every file is listed once. */
+	void Optimize(const TArray<int32>& InRoots, TArray<int32>& OutFileOrder) const;
+
+	/** Offsets every file would get if the paks were rebuilt in the given order. */
+	void GetOffsets(const TArray<int32>& InFileOrder, TArray<int64>& OutOffsets) const;
+
+	/** Sum of the simulated loads of all roots, with the files at the given offsets. */
+	void Simulate(const TArray<int32>& InRoots, const TArray<int64>& InOffsets, const FLoadDeviceModel& InDevice, FLoadSimulation& OutTotal) const;
+
+	/** Offsets of the current layout. */
+	void GetCurrentOffsets(TArray<int64>& OutOffsets) const;
+
+protected:
+	TArrayView<const int32> GetPackageFiles(int32 InPackageId) const
+	{
+		return TArrayView<const int32>(PackageFiles.GetData() + PackageFileOffsets[InPackageId], PackageFileOffsets[InPackageId + 1] - PackageFileOffsets[InPackageId]);
+	}
+
+	/** Files sorted by pak and current offset. */
+	void GetCurrentOrder(TArray<int32>& OutFileOrder) const;
+
+protected:
+	const FDependencyGraph& Graph;
+	const TArray<FPakFileEntryPtr>& Files;
+	const TArray<FLoadRead>& Reads;
+
+	/** File indices of every package, sorted by current offset. */
+	TArray<int32> PackageFileOffsets;
+	TArray<int32> PackageFiles;
+};
@@ -0,0 +1,339 @@
+#include "PakVerifier.h"
+
+#include "Async/Async.h"
+#include "Async/ParallelFor.h"
+#include "Async/TaskGraphInterfaces.h"
+#include "HAL/FileManager.h"
+#include "HAL/PlatformTime.h"
+#include "Misc/Compression.h"
+#include "Misc/SecureHash.h"
+#include "Serialization/BufferReader.h"
+
+#include "CommonDefines.h"
+#include "PakAnalyzerTrace.h"
+
+namespace PakVerifierPrivate
+{
+	/** Bytes read at once, the next window is read while the previous one is checked. */
+	static const int64 WindowSize = 32 * 1024 * 1024;
+
+	/** A hole bigger than this ends the window, so it is seeked over instead of read. */
+	static const int64 MaxWindowGap = 1024 * 1024;
+
+	/** FSHA1::Update takes 32 bit sizes. */
+	static const int64 MaxHashChunk = 1024 * 1024 * 1024;
+
+	struct FVerifyEntry
+	{
+		FPakFileEntryPtr File;
+		int64 Offset = 0;
+		int64 End = 0;
+		EPakVerifyError Errors = EPakVerifyError::None;
+		bool bDecompress = false;
+	};
+
+	/** Consecutive entries read with one request, an entry bigger than the window size gets a window of its own. */
+	struct FVerifyWindow
+	{
+		int64 Offset = 0;
+		int64 Size = 0;
+		int32 EntryBegin = 0;
+		int32 EntryEnd = 0;
+	};
+}
+
+bool FPakVerifier::Verify(const FPakFileSumary& InSummary, const TArray<FPakFileEntryPtr>& InFiles, FPakVerifyResult& OutResult)
+{
+	using namespace PakVerifierPrivate;
+
+	PAK_ANALYZER_TRACE_SCOPE(PakVerifier_Verify);
+	const double StartTime = FPlatformTime::Seconds();
+
+	TUniquePtr<FArchive> Reader(IFileManager::Get().CreateFileReader(*InSummary.PakFilePath));
+	if (!Reader)
+	{
+		UE_LOG(LogPakAnalyzer, Error, TEXT("Verify pak failed! Can't open %s."), *InSummary.PakFilePath);
+		return false;
+	}
+
+	const int32 PakVersion = InSummary.PakInfo.Version;
+	const bool bRelativeOffsets = PakVersion >= FPakInfo::PakFile_Version_RelativeChunkOffsets;
+	const bool bHasKey = !InSummary.DecryptAESKeyStr.IsEmpty();
+
+	// Same data end as the layout view, secondary indices sit between the primary index and the footer
+	const int64 FooterOffset = FMath::Max<int64>(0, InSummary.PakFileSize - InSummary.PakInfo.GetSerializedSize(PakVersion));
+	const int64 DataEnd = InSummary.PakInfo.IndexOffset > 0 ? FMath::Min(InSummary.PakInfo.IndexOffset, FooterOffset) : FooterOffset;
+
+	TArray<FVerifyEntry> Entries;
+	Entries.Reserve(InFiles.Num());
+	for (const FPakFileEntryPtr& File : InFiles)
+	{
+		const FPakEntry& PakEntry = File->PakEntry;
+		const int64 HeaderSize = PakEntry.GetSerializedSize(PakVersion);
+		const int64 StoredSize = PakEntry.IsEncrypted() ? Align(PakEntry.Size, FAES::AESBlockSize) : PakEntry.Size;
+
+		FVerifyEntry& Entry = Entries.AddDefaulted_GetRef();
+		Entry.File = File;
+		Entry.Offset = PakEntry.Offset;
+		Entry.End = PakEntry.Offset + HeaderSize + StoredSize;
+
+		if (Entry.Offset < 0 || PakEntry.Size < 0 || Entry.End > DataEnd)
+		{
+			Entry.Errors |= EPakVerifyError::OutOfBounds;
+			continue;
+		}
+
+		Entry.Errors |= CheckBlocks(PakEntry, HeaderSize, StoredSize, bRelativeOffsets);
+
+		if (PakEntry.CompressionMethodIndex != 0 && !EnumHasAnyFlags(Entry.Errors, EPakVerifyError::BadBlocks))
+		{
+			Entry.bDecompress = (!PakEntry.IsEncrypted() || bHasKey) && FCompression::IsFormatValid(File->CompressionMethod);
+			if (!Entry.bDecompress)
+			{
+				++OutResult.UncheckedCount;
+			}
+		}
+	}
+
+	Entries.Sort([](const FVerifyEntry& A, const FVerifyEntry& B) { return A.Offset < B.Offset; });
+
+	// Both sides of an overlap are reported, entries out of bounds are left out as their end is garbage
+	int32 FurthestIndex = INDEX_NONE;
+	for (int32 i = 0; i < Entries.Num(); ++i)
+	{
+		FVerifyEntry& Entry = Entries[i];
+		if (EnumHasAnyFlags(Entry.Errors, EPakVerifyError::OutOfBounds))
+		{
+			continue;
+		}
+
+		if (FurthestIndex != INDEX_NONE && Entry.Offset < Entries[FurthestIndex].End)
+		{
+			Entry.Errors |= EPakVerifyError::Overlap;
+			Entries[FurthestIndex].Errors |= EPakVerifyError::Overlap;
+		}
+
+		if (FurthestIndex == INDEX_NONE || Entry.End > Entries[FurthestIndex].End)
+		{
+			FurthestIndex = i;
+		}
+	}
+
+	TArray<FVerifyWindow> Windows;
+	for (int32 i = 0; i < Entries.Num(); ++i)
+	{
+		const FVerifyEntry& Entry = Entries[i];
+		if (EnumHasAnyFlags(Entry.Errors, EPakVerifyError::OutOfBounds))
+		{
+			continue;
+		}
+
+		FVerifyWindow* Window = Windows.Num() > 0 ? &Windows.Last() : nullptr;
+		const int64 WindowEnd = Window ? Window->Offset + Window->Size : 0;
+		if (!Window || Entry.Offset > WindowEnd + MaxWindowGap || FMath::Max(WindowEnd, Entry.End) - Window->Offset > WindowSize)
+		{
+			Window = &Windows.AddDefaulted_GetRef();
+			Window->Offset = Entry.Offset;
+			Window->EntryBegin = i;
+		}
+
+		Window->Size = FMath::Max(Window->Offset + Window->Size, Entry.End) - Window->Offset;
+		Window->EntryEnd = i + 1;
+	}
+
+	uint8* Buffers[2] = { nullptr, nullptr };
+	int64 BufferSizes[2] = { 0, 0 };
+	int64 ReadSize = 0;
+
+	auto ReadWindow = [&](int32 InWindow, int32 InBuffer)
+	{
+		const FVerifyWindow& Window = Windows[InWindow];
+		if (BufferSizes[InBuffer] < Window.Size)
+		{
+			Buffers[InBuffer] = (uint8*)FMemory::Realloc(Buffers[InBuffer], Window.Size);
+			BufferSizes[InBuffer] = Window.Size;
+		}
+
+		Reader->Seek(Window.Offset);
+		Reader->Serialize(Buffers[InBuffer], Window.Size);
+		FPakAnalyzerTrace::CountRead(Window.Size);
+		ReadSize += Window.Size;
+
+		return !Reader->IsError();
+	};
+
+	auto CheckWindow = [&Entries, &Windows, &InSummary](int32 InWindow, const uint8* InBuffer)
+	{
+		const FVerifyWindow& Window = Windows[InWindow];
+		const int32 EntryCount = Window.EntryEnd - Window.EntryBegin;
+		const int32 BatchCount = FMath::Min(EntryCount, FMath::Max(1, FTaskGraphInterface::Get().GetNumWorkerThreads() * 4));
+
+		ParallelFor(BatchCount, [&](int32 InBatch)
+			{
+				TArray<uint8> Compressed;
+				TArray<uint8> Uncompressed;
+
+				const int32 Begin = Window.EntryBegin + (int32)((int64)EntryCount * InBatch / BatchCount);
+				const int32 End = Window.EntryBegin + (int32)((int64)EntryCount * (InBatch + 1) / BatchCount);
+				for (int32 i = Begin; i < End; ++i)
+				{
+					FVerifyEntry& Entry = Entries[i];
+					if (!EnumHasAnyFlags(Entry.Errors, EPakVerifyError::OutOfBounds))
+					{
+						Entry.Errors |= CheckData(*Entry.File, InBuffer + (Entry.Offset - Window.Offset), InSummary, Entry.bDecompress, Compressed, Uncompressed);
+					}
+				}
+			});
+	};
+
+	bool bReadResult = Windows.Num() <= 0 || ReadWindow(0, 0);
+	for (int32 WindowIndex = 0; bReadResult && WindowIndex < Windows.Num(); ++WindowIndex)
+	{
+		const int32 Current = WindowIndex % 2;
+		const uint8* Buffer = Buffers[Current];
+		TFuture<void> Check = Async(EAsyncExecution::TaskGraph, [&CheckWindow, WindowIndex, Buffer]() { CheckWindow(WindowIndex, Buffer); });
+
+		// The disk stays busy with the next window while this one is hashed and decompressed
+		if (WindowIndex + 1 < Windows.Num())
+		{
+			bReadResult = ReadWindow(WindowIndex + 1, 1 - Current);
+		}
+
+		Check.Wait();
+	}
+
+	FMemory::Free(Buffers[0]);
+	FMemory::Free(Buffers[1]);
+
+	if (!bReadResult)
+	{
+		UE_LOG(LogPakAnalyzer, Error, TEXT("Verify pak failed! Read error in %s."), *InSummary.PakFilePath);
+		return false;
+	}
+
+	const int32 IssueCount = OutResult.Issues.Num();
+	for (const FVerifyEntry& Entry : Entries)
+	{
+		if (Entry.Errors != EPakVerifyError::None)
+		{
+			FPakVerifyIssue& Issue = OutResult.Issues.AddDefaulted_GetRef();
+			Issue.File = Entry.File;
+			Issue.Errors = Entry.Errors;
+		}
+	}
+
+	++OutResult.PakCount;
+	OutResult.FileCount += InFiles.Num();
+	OutResult.ReadSize += ReadSize;
+
+	const double Seconds = FPlatformTime::Seconds() - StartTime;
+	UE_LOG(LogPakAnalyzer, Log, TEXT("Verify pak: %s, file count: %d, corrupt count: %d, read: %lld bytes, cost: %.2fms, %.1fMB/s."),
+		*InSummary.PakFilePath, InFiles.Num(), OutResult.Issues.Num() - IssueCount, ReadSize, Seconds * 1000.0, Seconds > 0.0 ? ReadSize / Seconds / (1024.0 * 1024.0) : 0.0);
+
+	return true;
+}
+
+EPakVerifyError FPakVerifier::CheckBlocks(const FPakEntry& InEntry, int64 InHeaderSize, int64 InStoredSize, bool bInRelativeOffsets)
+{
+	if (InEntry.CompressionMethodIndex == 0)
+	{
+		return EPakVerifyError::None;
+	}
+
+	if (InEntry.UncompressedSize < 0 || (InEntry.UncompressedSize > 0 && InEntry.CompressionBlockSize <= 0))
+	{
+		return EPakVerifyError::BadBlocks;
+	}
+
+	const int64 BlockCount = InEntry.UncompressedSize > 0 ? FMath::DivideAndRoundUp<int64>(InEntry.UncompressedSize, InEntry.CompressionBlockSize) : 0;
+	if (InEntry.CompressionBlocks.Num() != BlockCount)
+	{
+		return EPakVerifyError::BadBlocks;
+	}
+
+	// Block offsets are relative to the entry since RelativeChunkOffsets, absolute before
+	const int64 Base = bInRelativeOffsets ? 0 : InEntry.Offset;
+	const int64 DataEnd = InHeaderSize + InStoredSize;
+
+	int64 Cursor = InHeaderSize;
+	for (const FPakCompressedBlock& Block : InEntry.CompressionBlocks)
+	{
+		const int64 Start = Block.CompressedStart - Base;
+		const int64 Size = Block.CompressedEnd - Block.CompressedStart;
+		const int64 End = Start + (InEntry.IsEncrypted() ? Align(Size, FAES::AESBlockSize) : Size);
+		if (Size <= 0 || Start < Cursor || End > DataEnd)
+		{
+			return EPakVerifyError::BadBlocks;
+		}
+
+		Cursor = End;
+	}
+
+	return EPakVerifyError::None;
+}
+
+EPakVerifyError FPakVerifier::CheckData(const FPakFileEntry& InFile, const uint8* InData, const FPakFileSumary& InSummary, bool bInDecompress, TArray<uint8>& InOutCompressed, TArray<uint8>& InOutUncompressed)
+{
+	using namespace PakVerifierPrivate;
+
+	const FPakEntry& PakEntry = InFile.PakEntry;
+	const int32 PakVersion = InSummary.PakInfo.Version;
+	const int64 HeaderSize = PakEntry.GetSerializedSize(PakVersion);
+
+	EPakVerifyError Errors = EPakVerifyError::None;
+
+	FBufferReader HeaderReader((void*)InData, HeaderSize, false);
+	FPakEntry Header;
+	Header.Serialize(HeaderReader, PakVersion);
+	if (HeaderReader.IsError() || !Header.IndexDataEquals(PakEntry))
+	{
+		Errors |= EPakVerifyError::HeaderMismatch;
+	}
+
+	// Same bytes as the engine's pak check, the stored data after the header
+	FSHA1 Sha;
+	for (int64 Offset = 0; Offset < PakEntry.Size; Offset += MaxHashChunk)
+	{
+		Sha.Update(InData + HeaderSize + Offset, (uint32)FMath::Min(MaxHashChunk, PakEntry.Size - Offset));
+	}
+	Sha.Final();
+
+	uint8 Hash[sizeof(PakEntry.Hash)];
+	Sha.GetHash(Hash);
+	if (FMemory::Memcmp(Hash, PakEntry.Hash, sizeof(Hash)) != 0)
+	{
+		Errors |= EPakVerifyError::HashMismatch;
+	}
+
+	if (!bInDecompress)
+	{
+		return Errors;
+	}
+
+	const int64 Base = PakVersion >= FPakInfo::PakFile_Version_RelativeChunkOffsets ? 0 : PakEntry.Offset;
+	for (int32 BlockIndex = 0; BlockIndex < PakEntry.CompressionBlocks.Num(); ++BlockIndex)
+	{
+		const FPakCompressedBlock& Block = PakEntry.CompressionBlocks[BlockIndex];
+		const int32 CompressedSize = (int32)(Block.CompressedEnd - Block.CompressedStart);
+		const int32 UncompressedSize = (int32)FMath::Min<int64>(PakEntry.UncompressedSize - (int64)PakEntry.CompressionBlockSize * BlockIndex, PakEntry.CompressionBlockSize);
+
+		const uint8* BlockData = InData + (Block.CompressedStart - Base);
+		if (PakEntry.IsEncrypted())
+		{
+			const int32 StoredSize = Align(CompressedSize, FAES::AESBlockSize);
+			InOutCompressed.SetNumUninitialized(StoredSize, false);
+			FMemory::Memcpy(InOutCompressed.GetData(), BlockData, StoredSize);
+			FAES::DecryptData(InOutCompressed.GetData(), StoredSize, InSummary.DecryptAESKey);
+			BlockData = InOutCompressed.GetData();
+		}
+
+		InOutUncompressed.SetNumUninitialized(UncompressedSize, false);
+		if (!FCompression::UncompressMemory(InFile.CompressionMethod, InOutUncompressed.GetData(), UncompressedSize, BlockData, CompressedSize))
+		{
+			Errors |= EPakVerifyError::DecompressFailed;
+			break;
+		}
+	}
+
+	return Errors;
+}
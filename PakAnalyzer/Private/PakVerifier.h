@@ -0,0 +1,19 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+#include "PakFileEntry.h"
+
+/** Reads a pak front to back and checks the bounds, hash and compressed data of every entry. */
+class FPakVerifier
+{
+public:
+	/** Adds the corrupt entries of one pak to the result, false only when the pak can't be read. */
+	static bool Verify(const FPakFileSumary& InSummary, const TArray<FPakFileEntryPtr>& InFiles, FPakVerifyResult& OutResult);
+
+protected:
+	static EPakVerifyError CheckBlocks(const FPakEntry& InEntry, int64 InHeaderSize, int64 InStoredSize, bool bInRelativeOffsets);
+
+	/** InData starts at the entry header and holds the whole entry. */
+	static EPakVerifyError CheckData(const FPakFileEntry& InFile, const uint8* InData, const FPakFileSumary& InSummary, bool bInDecompress, TArray<uint8>& InOutCompressed, TArray<uint8>& InOutUncompressed);
+};
@@ -0,0 +1,261 @@
+#include "RecompressionEstimator.h"
+
+#include "Async/ParallelFor.h"
+#include "Async/TaskGraphInterfaces.h"
+#include "HAL/PlatformTime.h"
+#include "Misc/Compression.h"
+#include "Misc/Paths.h"
+
+#include "CommonDefines.h"
+
+FFileReadContext::~FFileReadContext()
+{
+	if (Reader)
+	{
+		Reader->Close();
+	}
+
+	FMemory::Free(CopyBuffer);
+	FMemory::Free(CompressionBuffer);
+}
+
+bool FRecompressionEstimator::Estimate(const TArray<FPakFileEntryPtr>& InFiles, const FRecompressionOptions& InOptions, FReadContent InReadContent, const FThreadSafeCounter* InStopCounter, FRecompressionResult& OutResult)
+{
+	const double StartTime = FPlatformTime::Seconds();
+
+	OutResult = FRecompressionResult();
+	OutResult.FileCount = InFiles.Num();
+
+	TArray<FName> Methods;
+	for (const FName& Method : InOptions.Methods)
+	{
+		if (FCompression::IsFormatValid(Method))
+		{
+			Methods.AddUnique(Method);
+		}
+		else
+		{
+			UE_LOG(LogPakAnalyzer, Warning, TEXT("Estimate recompression, compression method %s is not available, skipped."), *Method.ToString());
+		}
+	}
+
+	if (InOptions.Methods.Num() <= 0)
+	{
+		GetAvailableMethods(Methods);
+	}
+
+	TArray<int32> BlockSizes;
+	for (const int32 BlockSize : InOptions.BlockSizes)
+	{
+		if (BlockSize > 0)
+		{
+			BlockSizes.AddUnique(BlockSize);
+		}
+	}
+	BlockSizes.Sort();
+
+	if (Methods.Num() <= 0 || BlockSizes.Num() <= 0)
+	{
+		UE_LOG(LogPakAnalyzer, Error, TEXT("Estimate recompression failed! No compression method or block size to try!"));
+		return false;
+	}
+
+	TArray<FRecompressionEstimate> Template;
+	for (const FName& Method : Methods)
+	{
+		for (const int32 BlockSize : BlockSizes)
+		{
+			FRecompressionEstimate& Estimate = Template.AddDefaulted_GetRef();
+			Estimate.Method = Method;
+			Estimate.BlockSize = BlockSize;
+		}
+	}
+	const int32 ConfigCount = Template.Num();
+
+	// Stride sampling keeps the result stable between runs, then sort so every batch reads forward
+	TArray<FPakFileEntryPtr> Samples;
+	const float SampleRatio = FMath::Clamp(InOptions.SampleRatio, 0.f, 1.f);
+	float Accumulated = 1.f - SampleRatio;
+	for (const FPakFileEntryPtr& File : InFiles)
+	{
+		if (!File.IsValid() || File->PakEntry.UncompressedSize <= 0)
+		{
+			continue;
+		}
+
+		Accumulated += SampleRatio;
+		if (Accumulated >= 1.f)
+		{
+			Accumulated -= 1.f;
+			Samples.Add(File);
+		}
+	}
+
+	Samples.Sort([](const FPakFileEntryPtr& A, const FPakFileEntryPtr& B)
+		{
+			return A->OwnerPakIndex != B->OwnerPakIndex ? A->OwnerPakIndex < B->OwnerPakIndex : A->PakEntry.Offset < B->PakEntry.Offset;
+		});
+
+	TArray<FRecompressionEstimate> FileEstimates;
+	FileEstimates.SetNum(Samples.Num() * ConfigCount);
+	TArray<uint8> Succeeded;
+	Succeeded.SetNumZeroed(Samples.Num());
+
+	const int32 BatchCount = FMath::Min(Samples.Num(), FMath::Max(1, FTaskGraphInterface::Get().GetNumWorkerThreads() * 4));
+	ParallelFor(BatchCount, [&](int32 InBatch)
+		{
+			FFileReadContext Context;
+			TArray<uint8> Content;
+			TArray<uint8> Compressed;
+			TArray<uint8> Uncompressed;
+
+			const int32 Begin = (int32)((int64)Samples.Num() * InBatch / BatchCount);
+			const int32 End = (int32)((int64)Samples.Num() * (InBatch + 1) / BatchCount);
+			for (int32 i = Begin; i < End; ++i)
+			{
+				if (InStopCounter && InStopCounter->GetValue() > 0)
+				{
+					break;
+				}
+
+				Content.Reset();
+				if (!InReadContent(*Samples[i], Context, Content) || Content.Num() <= 0)
+				{
+					continue;
+				}
+
+				for (int32 Config = 0; Config < ConfigCount; ++Config)
+				{
+					CompressContent(Template[Config].Method, Template[Config].BlockSize, Content, Compressed, Uncompressed, FileEstimates[i * ConfigCount + Config]);
+				}
+				Succeeded[i] = 1;
+			}
+		});
+
+	if (InStopCounter && InStopCounter->GetValue() > 0)
+	{
+		UE_LOG(LogPakAnalyzer, Warning, TEXT("Estimate recompression canceled, file count: %d."), OutResult.FileCount);
+		return false;
+	}
+
+	OutResult.Total.Name = TEXT("Total");
+	OutResult.Total.Estimates = Template;
+
+	TMap<FString, int32> FolderMap;
+	TMap<FString, int32> ClassMap;
+	for (int32 i = 0; i < Samples.Num(); ++i)
+	{
+		if (!Succeeded[i])
+		{
+			++OutResult.FailedFileCount;
+			continue;
+		}
+
+		++OutResult.SampledFileCount;
+
+		const FPakFileEntry& File = *Samples[i];
+		const FRecompressionEstimate* Estimates = &FileEstimates[i * ConfigCount];
+		AddToGroup(OutResult.Total, File, Estimates);
+		AddToGroup(FindOrAddGroup(OutResult.Folders, FolderMap, FPaths::GetPath(File.Path), Template), File, Estimates);
+		AddToGroup(FindOrAddGroup(OutResult.Classes, ClassMap, File.Class.ToString(), Template), File, Estimates);
+	}
+
+	auto ByCurrentCompressedSize = [](const FRecompressionGroup& A, const FRecompressionGroup& B) { return A.CurrentCompressedSize > B.CurrentCompressedSize; };
+	OutResult.Folders.Sort(ByCurrentCompressedSize);
+	OutResult.Classes.Sort(ByCurrentCompressedSize);
+
+	UE_LOG(LogPakAnalyzer, Log, TEXT("Estimate recompression, file count: %d, sampled count: %d, failed count: %d, method count: %d, block size count: %d, cost: %.2fms."),
+		OutResult.FileCount, OutResult.SampledFileCount, OutResult.FailedFileCount, Methods.Num(), BlockSizes.Num(), (FPlatformTime::Seconds() - StartTime) * 1000.0);
+
+	return true;
+}
+
+void FRecompressionEstimator::GetAvailableMethods(TArray<FName>& OutMethods)
+{
+	// Oodle is a plugin format and only shows up when the engine ships it
+	static const FName Candidates[] = { NAME_Zlib, NAME_Gzip, NAME_LZ4, TEXT("Oodle") };
+
+	for (const FName& Method : Candidates)
+	{
+		if (FCompression::IsFormatValid(Method))
+		{
+			OutMethods.AddUnique(Method);
+		}
+	}
+}
+
+void FRecompressionEstimator::CompressContent(FName InMethod, int32 InBlockSize, const TArray<uint8>& InContent, TArray<uint8>& InOutCompressed, TArray<uint8>& InOutUncompressed, FRecompressionEstimate& OutEstimate)
+{
+	int64 CompressedSize = 0;
+	int64 BlockCount = 0;
+	double DecompressTime = 0.0;
+
+	for (int32 Offset = 0; Offset < InContent.Num(); Offset += InBlockSize)
+	{
+		const int32 UncompressedBlockSize = FMath::Min(InBlockSize, InContent.Num() - Offset);
+		const int32 Bound = FCompression::CompressMemoryBound(InMethod, UncompressedBlockSize);
+		InOutCompressed.SetNumUninitialized(Bound, false);
+		InOutUncompressed.SetNumUninitialized(UncompressedBlockSize, false);
+
+		int32 CompressedBlockSize = Bound;
+		if (!FCompression::CompressMemory(InMethod, InOutCompressed.GetData(), CompressedBlockSize, InContent.GetData() + Offset, UncompressedBlockSize))
+		{
+			// Same as UnrealPak, a file that can't be compressed is stored as is
+			CompressedSize = InContent.Num();
+			DecompressTime = 0.0;
+			BlockCount = 0;
+			break;
+		}
+
+		const uint64 StartCycles = FPlatformTime::Cycles64();
+		FCompression::UncompressMemory(InMethod, InOutUncompressed.GetData(), UncompressedBlockSize, InOutCompressed.GetData(), CompressedBlockSize);
+		DecompressTime += FPlatformTime::ToSeconds64(FPlatformTime::Cycles64() - StartCycles);
+
+		CompressedSize += CompressedBlockSize;
+		++BlockCount;
+	}
+
+	if (CompressedSize >= InContent.Num())
+	{
+		CompressedSize = InContent.Num();
+		DecompressTime = 0.0;
+		BlockCount = 0;
+	}
+
+	OutEstimate.Method = InMethod;
+	OutEstimate.BlockSize = InBlockSize;
+	OutEstimate.CompressedSize = CompressedSize;
+	OutEstimate.BlockCount = BlockCount;
+	OutEstimate.DecompressTime = DecompressTime;
+}
+
+FRecompressionGroup& FRecompressionEstimator::FindOrAddGroup(TArray<FRecompressionGroup>& InOutGroups, TMap<FString, int32>& InOutGroupMap, const FString& InName, const TArray<FRecompressionEstimate>& InTemplate)
+{
+	const int32* GroupIndex = InOutGroupMap.Find(InName);
+	if (GroupIndex)
+	{
+		return InOutGroups[*GroupIndex];
+	}
+
+	InOutGroupMap.Add(InName, InOutGroups.Num());
+
+	FRecompressionGroup& Group = InOutGroups.AddDefaulted_GetRef();
+	Group.Name = InName;
+	Group.Estimates = InTemplate;
+
+	return Group;
+}
+
+void FRecompressionEstimator::AddToGroup(FRecompressionGroup& InOutGroup, const FPakFileEntry& InFile, const FRecompressionEstimate* InEstimates)
+{
+	++InOutGroup.FileCount;
+	InOutGroup.Size += InFile.PakEntry.UncompressedSize;
+	InOutGroup.CurrentCompressedSize += InFile.PakEntry.Size;
+
+	for (int32 i = 0; i < InOutGroup.Estimates.Num(); ++i)
+	{
+		InOutGroup.Estimates[i].CompressedSize += InEstimates[i].CompressedSize;
+		InOutGroup.Estimates[i].BlockCount += InEstimates[i].BlockCount;
+		InOutGroup.Estimates[i].DecompressTime += InEstimates[i].DecompressTime;
+	}
+}
@@ -0,0 +1,36 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HAL/ThreadSafeCounter.h"
+#include "Templates/Function.h"
+
+#include "PakFileEntry.h"
+
+/** Reader and scratch buffers of one thread, reused between the files it reads. */
+struct FFileReadContext
+{
+	~FFileReadContext();
+
+	TUniquePtr<FArchive> Reader;
+	int32 ReaderPakIndex = INDEX_NONE;
+
+	void* CopyBuffer = nullptr;
+	uint8* CompressionBuffer = nullptr;
+	int64 CompressionBufferSize = 0;
+};
+
+/** Recompresses file content with other methods and block sizes to estimate what they would cost. */
+class FRecompressionEstimator
+{
+public:
+	typedef TFunctionRef<bool(const FPakFileEntry& /*InFile*/, FFileReadContext& /*InContext*/, TArray<uint8>& /*OutContent*/)> FReadContent;
+
+	/** A stop counter above zero cancels the estimate between files, it then fails. */
+	static bool Estimate(const TArray<FPakFileEntryPtr>& InFiles, const FRecompressionOptions& InOptions, FReadContent InReadContent, const FThreadSafeCounter* InStopCounter, FRecompressionResult& OutResult);
+	static void GetAvailableMethods(TArray<FName>& OutMethods);
+
+protected:
+	static void CompressContent(FName InMethod, int32 InBlockSize, const TArray<uint8>& InContent, TArray<uint8>& InOutCompressed, TArray<uint8>& InOutUncompressed, FRecompressionEstimate& OutEstimate);
+	static FRecompressionGroup& FindOrAddGroup(TArray<FRecompressionGroup>& InOutGroups, TMap<FString, int32>& InOutGroupMap, const FString& InName, const TArray<FRecompressionEstimate>& InTemplate);
+	static void AddToGroup(FRecompressionGroup& InOutGroup, const FPakFileEntry& InFile, const FRecompressionEstimate* InEstimates);
+};
@@ -0,0 +1,215 @@
+#include "SqlExporter.h"
+
+#include "Misc/Paths.h"
+
+#include "CommonDefines.h"
+#include "DependencyGraph.h"
+#include "ExportWriter.h"
+
+namespace SqlExporterPrivate
+{
+	// Rows per INSERT statement, keeps statements small enough for any sqlite build
+	static const int32 InsertBatchSize = 256;
+
+	static const ANSICHAR* Schema =
+		"PRAGMA journal_mode = OFF;\n"
+		"PRAGMA synchronous = OFF;\n"
+		"BEGIN TRANSACTION;\n"
+		"CREATE TABLE paks (id INTEGER PRIMARY KEY, name TEXT, path TEXT, size INTEGER, version INTEGER, mount_point TEXT, file_count INTEGER, compression_methods TEXT, encrypted_index INTEGER);\n"
+		"CREATE TABLE classes (id INTEGER PRIMARY KEY, name TEXT);\n"
+		"CREATE TABLE packages (id INTEGER PRIMARY KEY, name TEXT);\n"
+		"CREATE TABLE files (id INTEGER PRIMARY KEY, pak_id INTEGER, path TEXT, name TEXT, class_id INTEGER, package_id INTEGER, offset INTEGER, size INTEGER, compressed_size INTEGER, compression_method TEXT, block_count INTEGER, block_size INTEGER, sha1 TEXT, encrypted INTEGER);\n"
+		"CREATE TABLE exports (file_id INTEGER, export_index INTEGER, object_name TEXT, object_path TEXT, class_name TEXT, super TEXT, template TEXT, serial_offset INTEGER, serial_size INTEGER, is_asset INTEGER);\n"
+		"CREATE TABLE imports (file_id INTEGER, import_index INTEGER, object_name TEXT, object_path TEXT, class_package TEXT, class_name TEXT);\n"
+		"CREATE TABLE dependencies (from_package_id INTEGER, to_package_id INTEGER);\n";
+
+	// Created after the inserts, building them once is much faster than updating them per row
+	static const ANSICHAR* Indexes =
+		"CREATE INDEX files_path ON files (path);\n"
+		"CREATE INDEX files_pak ON files (pak_id);\n"
+		"CREATE INDEX files_class ON files (class_id);\n"
+		"CREATE INDEX files_package ON files (package_id);\n"
+		"CREATE INDEX exports_file ON exports (file_id);\n"
+		"CREATE INDEX exports_class ON exports (class_name);\n"
+		"CREATE INDEX imports_file ON imports (file_id);\n"
+		"CREATE INDEX imports_object ON imports (object_path);\n"
+		"CREATE INDEX dependencies_from ON dependencies (from_package_id);\n"
+		"CREATE INDEX dependencies_to ON dependencies (to_package_id);\n"
+		"COMMIT;\n";
+
+	void BeginRow(FExportBuffer& OutBuffer, const ANSICHAR* InTable, int32 InRow)
+	{
+		if (InRow % InsertBatchSize == 0)
+		{
+			OutBuffer.Append("INSERT INTO ").Append(InTable).Append(" VALUES\n(");
+		}
+		else
+		{
+			OutBuffer.Append(",\n(");
+		}
+	}
+
+	void EndRow(FExportBuffer& OutBuffer, int32 InRow, int32 InRowCount)
+	{
+		OutBuffer.Append((InRow + 1) % InsertBatchSize == 0 || InRow + 1 == InRowCount ? ");\n" : ")");
+	}
+}
+
+bool FSqlExporter::Export(const FString& InOutputPath, const TArray<FPakFileEntryPtr>& InFiles, const TArray<FPakFileSumaryPtr>& InPaks, const FDependencyGraph& InGraph, FExportProgress* InProgress)
+{
+	using namespace SqlExporterPrivate;
+
+	FExportWriter Writer(InOutputPath, InProgress);
+	if (!Writer.IsValid())
+	{
+		UE_LOG(LogPakAnalyzer, Error, TEXT("Export to sql: %s failed, can't open file for writing."), *InOutputPath);
+		return false;
+	}
+
+	FExportBuffer Buffer;
+	Buffer.Append(Schema);
+
+	for (int32 i = 0; i < InPaks.Num(); ++i)
+	{
+		const FPakFileSumary& Pak = *InPaks[i];
+
+		BeginRow(Buffer, "paks", i);
+		Buffer.AppendInt(i).Append(", ").AppendSqlString(FPaths::GetCleanFilename(Pak.PakFilePath)).Append(", ").AppendSqlString(Pak.PakFilePath);
+		Buffer.Append(", ").AppendInt(Pak.PakFileSize).Append(", ").AppendInt(Pak.PakInfo.Version).Append(", ").AppendSqlString(Pak.MountPoint);
+		Buffer.Append(", ").AppendInt(Pak.FileCount).Append(", ").AppendSqlString(Pak.CompressionMethods).Append(", ").AppendInt(Pak.PakInfo.bEncryptedIndex ? 1 : 0);
+		EndRow(Buffer, i, InPaks.Num());
+	}
+
+	// Class and package ids are resolved before the parallel passes, which only read them
+	TMap<FName, int32> ClassIds;
+	TArray<FName> Classes;
+	TArray<int32> PackageIds;
+	PackageIds.SetNumUninitialized(InFiles.Num());
+	TBitArray<> ExportedPackages(false, InGraph.Num());
+
+	for (int32 i = 0; i < InFiles.Num(); ++i)
+	{
+		const FPakFileEntry& File = *InFiles[i];
+		if (!ClassIds.Contains(File.Class))
+		{
+			ClassIds.Add(File.Class, Classes.Add(File.Class));
+		}
+
+		PackageIds[i] = File.PackagePath.IsNone() ? INDEX_NONE : InGraph.FindPackageId(File.PackagePath);
+		if (PackageIds[i] != INDEX_NONE)
+		{
+			ExportedPackages[PackageIds[i]] = true;
+		}
+	}
+
+	// Edges whose source package has a file in the export
+	TArray<int32> SourcePackages;
+	for (TConstSetBitIterator<> It(ExportedPackages); It; ++It)
+	{
+		SourcePackages.Add(It.GetIndex());
+	}
+
+	if (InProgress)
+	{
+		InProgress->TotalRows = InGraph.Num() + InFiles.Num() * 2 + SourcePackages.Num();
+	}
+
+	for (int32 i = 0; i < Classes.Num(); ++i)
+	{
+		BeginRow(Buffer, "classes", i);
+		Buffer.AppendInt(i).Append(", ").AppendSqlString(Classes[i]);
+		EndRow(Buffer, i, Classes.Num());
+	}
+	Writer.Write(Buffer);
+
+	Writer.WriteRows(InGraph.Num(), [&InGraph](int32 InRow, FExportBuffer& OutBuffer)
+		{
+			BeginRow(OutBuffer, "packages", InRow);
+			OutBuffer.AppendInt(InRow).Append(", ").AppendSqlString(InGraph.GetPackageName(InRow));
+			EndRow(OutBuffer, InRow, InGraph.Num());
+		});
+
+	Writer.WriteRows(InFiles.Num(), [&InFiles, &InPaks, &ClassIds, &PackageIds](int32 InRow, FExportBuffer& OutBuffer)
+		{
+			const FPakFileEntry& File = *InFiles[InRow];
+			const FPakEntry& PakEntry = File.PakEntry;
+
+			BeginRow(OutBuffer, "files", InRow);
+			OutBuffer.AppendInt(InRow).Append(", ");
+			if (InPaks.IsValidIndex(File.OwnerPakIndex))
+			{
+				OutBuffer.AppendInt(File.OwnerPakIndex);
+			}
+			else
+			{
+				OutBuffer.Append("NULL");
+			}
+			OutBuffer.Append(", ").AppendSqlString(File.Path).Append(", ").AppendSqlString(File.Filename);
+			OutBuffer.Append(", ").AppendInt(ClassIds.FindChecked(File.Class)).Append(", ");
+			if (PackageIds[InRow] != INDEX_NONE)
+			{
+				OutBuffer.AppendInt(PackageIds[InRow]);
+			}
+			else
+			{
+				OutBuffer.Append("NULL");
+			}
+			OutBuffer.Append(", ").AppendInt(PakEntry.Offset).Append(", ").AppendInt(PakEntry.UncompressedSize).Append(", ").AppendInt(PakEntry.Size);
+			OutBuffer.Append(", ").AppendSqlString(File.CompressionMethod).Append(", ").AppendInt(PakEntry.CompressionBlocks.Num()).Append(", ").AppendInt(PakEntry.CompressionBlockSize);
+			OutBuffer.Append(", '").AppendHex(PakEntry.Hash, sizeof(PakEntry.Hash)).Append("', ").AppendInt(PakEntry.IsEncrypted() ? 1 : 0);
+			EndRow(OutBuffer, InRow, InFiles.Num());
+		});
+
+	// One statement per file, summaries are missing until the asset parse reaches the file
+	Writer.WriteRows(InFiles.Num(), [&InFiles](int32 InRow, FExportBuffer& OutBuffer)
+		{
+			const FAssetSummary* Summary = InFiles[InRow]->AssetSummary.Get();
+			if (!Summary)
+			{
+				return;
+			}
+
+			const FObjectExportTable& Exports = Summary->ObjectExports;
+			for (int32 i = 0; i < Exports.Num(); ++i)
+			{
+				BeginRow(OutBuffer, "exports", i);
+				OutBuffer.AppendInt(InRow).Append(", ").AppendInt(i);
+				OutBuffer.Append(", ").AppendSqlString(Exports.ObjectNames[i]).Append(", ").AppendSqlString(Exports.ObjectPaths[i]).Append(", ").AppendSqlString(Exports.ClassNames[i]);
+				OutBuffer.Append(", ").AppendSqlString(Exports.Supers[i]).Append(", ").AppendSqlString(Exports.TemplateObjects[i]);
+				OutBuffer.Append(", ").AppendInt((int64)Exports.SerialOffsets[i]).Append(", ").AppendInt((int64)Exports.SerialSizes[i]).Append(", ").AppendInt(Exports.HasFlag(i, EObjectExportFlags::IsAsset) ? 1 : 0);
+				EndRow(OutBuffer, i, Exports.Num());
+			}
+
+			const TArray<FObjectImportEx>& Imports = Summary->ObjectImports;
+			for (int32 i = 0; i < Imports.Num(); ++i)
+			{
+				BeginRow(OutBuffer, "imports", i);
+				OutBuffer.AppendInt(InRow).Append(", ").AppendInt(i);
+				OutBuffer.Append(", ").AppendSqlString(Imports[i].ObjectName).Append(", ").AppendSqlString(Imports[i].ObjectPath);
+				OutBuffer.Append(", ").AppendSqlString(Imports[i].ClassPackage).Append(", ").AppendSqlString(Imports[i].ClassName);
+				EndRow(OutBuffer, i, Imports.Num());
+			}
+		});
+
+	Writer.WriteRows(SourcePackages.Num(), [&InGraph, &SourcePackages](int32 InRow, FExportBuffer& OutBuffer)
+		{
+			const TArrayView<const int32> Dependencies = InGraph.GetDependencies(SourcePackages[InRow]);
+			for (int32 i = 0; i < Dependencies.Num(); ++i)
+			{
+				BeginRow(OutBuffer, "dependencies", i);
+				OutBuffer.AppendInt(SourcePackages[InRow]).Append(", ").AppendInt(Dependencies[i]);
+				EndRow(OutBuffer, i, Dependencies.Num());
+			}
+		});
+
+	Buffer.Reset();
+	Buffer.Append(Indexes);
+	Writer.Write(Buffer);
+
+	const int64 WrittenSize = Writer.GetWrittenSize();
+	const bool bSuccess = Writer.Close();
+
+	UE_LOG(LogPakAnalyzer, Log, TEXT("Export to sql: %s finished, file count: %d, size: %lld, result: %d."), *InOutputPath, InFiles.Num(), WrittenSize, bSuccess);
+
+	return bSuccess;
+}
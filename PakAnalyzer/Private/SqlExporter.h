@@ -0,0 +1,18 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+#include "PakFileEntry.h"
+
+class FDependencyGraph;
+struct FExportProgress;
+
+/**
+ * Writes the session as a SQLite script: schema, bulk inserts in one transaction, then the indexes.
+ * `sqlite3 build.db < build.sql` turns it into a database that can be queried without loading the paks again.
+ */
+class FSqlExporter
+{
+public:
+	static bool Export(const FString& InOutputPath, const TArray<FPakFileEntryPtr>& InFiles, const TArray<FPakFileSumaryPtr>& InPaks, const FDependencyGraph& InGraph, FExportProgress* InProgress = nullptr);
+};
@@ -17,14 +17,31 @@ public:
 	DECLARE_DELEGATE_OneParam(FOnLoadPakFailed, const FString&)
 	DECLARE_DELEGATE_ThreeParams(FOnUpdateExtractProgress, int32 /*CompleteCount*/, int32 /*ErrorCount*/, int32 /*TotalCount*/);
 	DECLARE_DELEGATE(FOnExtractStart);
+	DECLARE_DELEGATE(FOnExportStart);
+	DECLARE_MULTICAST_DELEGATE_OneParam(FOnPackagesParsed, const TArray<TSharedPtr<struct FPakFileEntry>>& /*InFiles*/);
 	DECLARE_MULTICAST_DELEGATE(FOnAssetParseFinish);
 	DECLARE_MULTICAST_DELEGATE(FOnPakLoadFinish);
+	DECLARE_MULTICAST_DELEGATE_OneParam(FOnAssetRegistryLoadProgress, float /*Progress*/);
+	DECLARE_MULTICAST_DELEGATE_OneParam(FOnAssetRegistryLoadFinish, bool /*bSuccess*/);
+	DECLARE_MULTICAST_DELEGATE_TwoParams(FOnExportFileOrderFinish, bool /*bSuccess*/, const struct FPakOrderEstimate& /*Estimate*/);
+	DECLARE_MULTICAST_DELEGATE_TwoParams(FOnPakDiffFinish, TSharedPtr<struct FPakDiffResult> /*Result, null if canceled or failed*/, const TArray<FString>& /*Keys resolved for the compared paks*/);
+	DECLARE_MULTICAST_DELEGATE_OneParam(FOnLoadSimulationFinish, const TArray<struct FLoadSimulation>& /*Simulations*/);
+	DECLARE_MULTICAST_DELEGATE_OneParam(FOnRecompressionEstimateFinish, TSharedPtr<struct FRecompressionResult> /*Result, null if canceled or failed*/);
 
 public:
 	static FOnGetAESKey OnGetAESKey;
 	static FOnLoadPakFailed OnLoadPakFailed;
 	static FOnUpdateExtractProgress OnUpdateExtractProgress;
 	static FOnExtractStart OnExtractStart;
+	static FOnUpdateExtractProgress OnUpdateExportProgress;
+	static FOnExportStart OnExportStart;
+	static FOnPackagesParsed OnPackagesParsed;
 	static FOnAssetParseFinish OnAssetParseFinish;
 	static FOnPakLoadFinish OnPakLoadFinish;
+	static FOnAssetRegistryLoadProgress OnAssetRegistryLoadProgress;
+	static FOnAssetRegistryLoadFinish OnAssetRegistryLoadFinish;
+	static FOnExportFileOrderFinish OnExportFileOrderFinish;
+	static FOnPakDiffFinish OnPakDiffFinish;
+	static FOnLoadSimulationFinish OnLoadSimulationFinish;
+	static FOnRecompressionEstimateFinish OnRecompressionEstimateFinish;
 };
@@ -21,10 +21,42 @@ public:
 	virtual const TArray<FPakFileSumaryPtr>& GetPakFileSumary() const = 0;
 	virtual const TArray<FPakTreeEntryPtr>& GetPakTreeRootNode() const = 0;
 	virtual void ExtractFiles(const FString& InOutputPath, TArray<FPakFileEntryPtr>& InFiles) = 0;
+	virtual void ExtractFilesWithDependencies(const FString& InOutputPath, const TArray<FPakFileEntryPtr>& InFiles) = 0;
 	virtual void CancelExtract() = 0;
 	virtual bool ExportToJson(const FString& InOutputPath, const TArray<FPakFileEntryPtr>& InFiles) = 0;
 	virtual bool ExportToCsv(const FString& InOutputPath, const TArray<FPakFileEntryPtr>& InFiles) = 0;
+	virtual bool ExportToColumnar(const FString& InOutputPath, const TArray<FPakFileEntryPtr>& InFiles) = 0;
+	virtual bool ExportToSql(const FString& InOutputPath, const TArray<FPakFileEntryPtr>& InFiles) = 0;
+	virtual void StartExport(EPakExportFormat InFormat, const FString& InOutputPath, const TArray<FPakFileEntryPtr>& InFiles) = 0;
+	virtual void CancelExport() = 0;
+	virtual bool IsExporting() const = 0;
 	virtual void SetExtractThreadCount(int32 InThreadCount) = 0;
-	virtual bool LoadAssetRegistry(const FString& InRegristryPath) = 0;
+	/** Loads in the background, false only when the file is missing. OnAssetRegistryLoadFinish reports the result. */
+	virtual bool StartLoadAssetRegistry(const FString& InRegristryPath) = 0;
 	virtual FString GetAssetRegistryPath() const = 0;
+	virtual void PrioritizeAssetParse(const TArray<FPakFileEntryPtr>& InFiles) = 0;
+	virtual bool GetDependencyClosure(const TArray<FName>& InPackageNames, bool bReverse, FDependencyClosure& OutClosure) = 0;
+	virtual bool GetShortestDependencyChain(FName InFrom, FName InTo, TArray<FName>& OutChain) = 0;
+	virtual void GetDependencyCycles(TArray<FDependencyCyclePtr>& OutCycles) = 0;
+	virtual void GetUnreferencedPackages(const FUnreferencedPackageOptions& InOptions, TArray<FUnreferencedPackagePtr>& OutPackages) = 0;
+	virtual void GetDuplicateFiles(TArray<FDuplicateGroupPtr>& OutGroups) = 0;
+	virtual void SimulateLoad(const TArray<FName>& InRootPackages, const FLoadDeviceModel& InDevice, TArray<FLoadSimulation>& OutSimulations) = 0;
+	/** Simulates in background and replaces a running simulation, OnLoadSimulationFinish reports the result. */
+	virtual void StartSimulateLoad(const TArray<FName>& InRootPackages, const FLoadDeviceModel& InDevice) = 0;
+	virtual void CancelSimulateLoad() = 0;
+	virtual bool IsSimulatingLoad() const = 0;
+	virtual bool GetPakLayout(int32 InPakIndex, FPakLayout& OutLayout) = 0;
+	virtual bool EstimateRecompression(const TArray<FPakFileEntryPtr>& InFiles, const FRecompressionOptions& InOptions, FRecompressionResult& OutResult) = 0;
+	virtual void StartEstimateRecompression(const TArray<FPakFileEntryPtr>& InFiles, const FRecompressionOptions& InOptions) = 0;
+	virtual void CancelEstimateRecompression() = 0;
+	virtual bool IsEstimatingRecompression() const = 0;
+	virtual bool DiffPakFiles(const TArray<FString>& InPakPaths, const TArray<FString>& InDefaultAESKeys, FPakDiffResult& OutResult) = 0;
+	/** Asks for missing keys, then diffs in background and replaces a running diff. The file table of the same paks is read once. OnPakDiffFinish reports the result. */
+	virtual void StartDiffPakFiles(const TArray<FString>& InPakPaths, const TArray<FString>& InDefaultAESKeys) = 0;
+	virtual void CancelDiffPakFiles() = 0;
+	virtual bool IsDiffingPakFiles() const = 0;
+	virtual bool VerifyPakFiles(FPakVerifyResult& OutResult) = 0;
+	virtual bool ExportFileOrder(const FString& InOutputPath, const TArray<FName>& InRootPackages, const FLoadDeviceModel& InDevice, FPakOrderEstimate& OutEstimate) = 0;
+	virtual void StartExportFileOrder(const FString& InOutputPath, const TArray<FName>& InRootPackages, const FLoadDeviceModel& InDevice) = 0;
+	virtual void GetSessionStats(FPakSessionStats& OutStats) const = 0;
 };
@@ -0,0 +1,77 @@
+// Copyright 1998-2019 Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Launch/Resources/Version.h"
+
+#if ENGINE_MAJOR_VERSION >= 5 || ENGINE_MINOR_VERSION >= 25
+#include "ProfilingDebugging/CpuProfilerTrace.h"
+#define PAK_ANALYZER_CPU_TRACE_SCOPE(Name) TRACE_CPUPROFILER_EVENT_SCOPE(Name)
+#else
+#define PAK_ANALYZER_CPU_TRACE_SCOPE(Name)
+#endif
+
+/**
+ * Times a named stage in Unreal Insights and in the analyzer's own stage stats.
+ * The stage id is registered once per call site, closing a scope only touches the calling thread's stats.
+ */
+#define PAK_ANALYZER_TRACE_SCOPE(Name) \
+	PAK_ANALYZER_CPU_TRACE_SCOPE(Name); \
+	static const int32 PREPROCESSOR_JOIN(PakAnalyzerTraceStage, __LINE__) = FPakAnalyzerTrace::RegisterStage(TEXT(#Name)); \
+	FPakAnalyzerTraceScope PREPROCESSOR_JOIN(PakAnalyzerTraceScope, __LINE__)(PREPROCESSOR_JOIN(PakAnalyzerTraceStage, __LINE__))
+
+/** Accumulated cost of one named stage, nested stages are included in their parents. */
+struct FPakAnalyzerStageStat
+{
+	FName Name;
+	int32 CallCount = 0;
+	double TotalSeconds = 0.0;
+	double LastSeconds = 0.0;
+	int64 BytesRead = 0;
+	int64 BytesWritten = 0;
+
+	/** Heap allocations made on the stage's thread while it ran. */
+	int64 AllocCount = 0;
+};
+
+class FPakAnalyzerTrace
+{
+public:
+	/** Wraps the global allocator to count allocations per thread, call once at startup. */
+	static void Initialize();
+
+	/** Records every scope from now on, StopFileTrace writes them as a chrome trace json. */
+	static void StartFileTrace(const FString& InPath);
+	static bool StopFileTrace();
+	static bool IsFileTracing();
+
+	/** Counters are charged to the innermost open scope of the calling thread. */
+	static void CountRead(int64 InBytes);
+	static void CountWrite(int64 InBytes);
+
+	/** Returns the id of a stage name, the same name always gets the same id. */
+	static int32 RegisterStage(const TCHAR* InName);
+
+	/** Merges the stats of every thread. */
+	static void GetStageStats(TArray<FPakAnalyzerStageStat>& OutStats);
+	static void ResetStageStats();
+};
+
+class FPakAnalyzerTraceScope
+{
+public:
+	explicit FPakAnalyzerTraceScope(int32 InStageId);
+	~FPakAnalyzerTraceScope();
+
+protected:
+	friend class FPakAnalyzerTrace;
+
+	int32 StageId;
+	uint64 StartCycles;
+	int64 StartAllocCount;
+	FPakAnalyzerTraceScope* Parent;
+
+	int64 BytesRead = 0;
+	int64 BytesWritten = 0;
+};
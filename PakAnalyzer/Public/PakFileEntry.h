@@ -3,17 +3,14 @@
 #include "CoreMinimal.h"
 #include "IPlatformFilePak.h"
 #include "Misc/AES.h"
+#include "Misc/SecureHash.h"
 #include "UObject/ObjectResource.h"
 #include "UObject/PackageFileSummary.h"
 
 typedef TSharedPtr<struct FPakClassEntry> FPakClassEntryPtr;
-typedef TSharedPtr<FName> FNamePtrType;
-typedef TSharedPtr<struct FObjectExportEx> FObjectExportPtrType;
-typedef TSharedPtr<struct FObjectImportEx> FObjectImportPtrType;
 typedef TSharedPtr<struct FAssetSummary> FAssetSummaryPtr;
 typedef TSharedPtr<struct FPakFileEntry> FPakFileEntryPtr;
 typedef TSharedPtr<struct FPakTreeEntry> FPakTreeEntryPtr;
-typedef TSharedPtr<struct FPackageInfo> FPackageInfoPtr;
 typedef TSharedPtr<struct FPakFileSumary> FPakFileSumaryPtr;
 
 struct FPakClassEntry
@@ -37,45 +34,161 @@ struct FPakClassEntry
 	float PercentOfParent;
 };
 
-struct FObjectExportEx
+struct FPackageInfo
 {
-	FName ObjectName;
-	uint64 SerialSize = 0;
-	uint64 SerialOffset = 0;
-	bool bIsAsset = false;
-	bool bNotForClient = false;
-	bool bNotForServer = false;
-	int32 Index = 0;
-	FName ObjectPath;
-	FName ClassName;
-	FName TemplateObject;
-	FName Super;
-	TArray<FPackageInfoPtr> DependencyList;
+	FPackageInfo()
+	{
+
+	}
+
+	FPackageInfo(FName InPackageName, FName InExtraInfo = NAME_None)
+		: PackageName(InPackageName)
+		, ExtraInfo(InExtraInfo)
+	{
+
+	}
+
+	FName PackageName;
+	FName ExtraInfo;
+};
+
+/** A contiguous range of edges in FAssetSummary::PackageEdges. */
+struct FPackageInfoSpan
+{
+	int32 Start = 0;
+	int32 Num = 0;
 };
 
 struct FObjectImportEx
 {
-	int32 Index = 0;
 	FName ClassPackage;
 	FName ClassName;
 	FName ObjectName;
 	FName ObjectPath;
 };
 
-struct FPackageInfo
+enum class EObjectExportFlags : uint8
 {
-	FName PackageName;
-	FName ExtraInfo;
+	None = 0,
+
+	IsAsset = (1 << 0),
+	NotForClient = (1 << 1),
+	NotForServer = (1 << 2),
+};
+ENUM_CLASS_FLAGS(EObjectExportFlags);
+
+/** Export table stored as one array per field, every array has one slot per export. */
+struct FObjectExportTable
+{
+	TArray<FName> ObjectNames;
+	TArray<FName> ObjectPaths;
+	TArray<FName> ClassNames;
+	TArray<FName> TemplateObjects;
+	TArray<FName> Supers;
+	TArray<uint64> SerialSizes;
+	TArray<uint64> SerialOffsets;
+	TArray<EObjectExportFlags> Flags;
+	TArray<FPackageInfoSpan> DependencySpans;
+
+	FORCEINLINE int32 Num() const { return ObjectNames.Num(); }
+	FORCEINLINE bool IsValidIndex(int32 Index) const { return ObjectNames.IsValidIndex(Index); }
+	FORCEINLINE bool HasFlag(int32 Index, EObjectExportFlags InFlag) const { return EnumHasAnyFlags(Flags[Index], InFlag); }
+
+	void SetNum(int32 InNum)
+	{
+		ObjectNames.SetNum(InNum);
+		ObjectPaths.SetNum(InNum);
+		ClassNames.SetNum(InNum);
+		TemplateObjects.SetNum(InNum);
+		Supers.SetNum(InNum);
+		SerialSizes.SetNumZeroed(InNum);
+		SerialOffsets.SetNumZeroed(InNum);
+		Flags.SetNumZeroed(InNum);
+		DependencySpans.SetNumZeroed(InNum);
+	}
 };
 
 struct FAssetSummary
 {
 	FPackageFileSummary PackageSummary;
-	TArray<FNamePtrType> Names;
-	TArray<FObjectExportPtrType> ObjectExports;
-	TArray<FObjectImportPtrType> ObjectImports;
-	TArray<FPackageInfoPtr> DependencyList; // this asset depends on
-	TArray<FPackageInfoPtr> DependentList; // assets depends on this
+	TArray<FName> Names;
+	TArray<FObjectImportEx> ObjectImports;
+	FObjectExportTable ObjectExports;
+
+	/** Edge pool shared by the package dependency lists and the export preload dependencies. */
+	TArray<FPackageInfo> PackageEdges;
+	FPackageInfoSpan DependencySpan; // this asset depends on
+	FPackageInfoSpan DependentSpan; // assets depends on this
+
+	FORCEINLINE TArrayView<const FPackageInfo> GetEdges(const FPackageInfoSpan& InSpan) const { return TArrayView<const FPackageInfo>(PackageEdges.GetData() + InSpan.Start, InSpan.Num); }
+	FORCEINLINE TArrayView<const FPackageInfo> GetDependencies() const { return GetEdges(DependencySpan); }
+	FORCEINLINE TArrayView<const FPackageInfo> GetDependents() const { return GetEdges(DependentSpan); }
+	FORCEINLINE TArrayView<const FPackageInfo> GetExportDependencies(int32 ExportIndex) const { return GetEdges(ObjectExports.DependencySpans[ExportIndex]); }
+	FORCEINLINE int32 GetDependencyCount() const { return DependencySpan.Num; }
+	FORCEINLINE int32 GetDependentCount() const { return DependentSpan.Num; }
+
+	FPackageInfoSpan AppendEdges(TArrayView<const FPackageInfo> InEdges)
+	{
+		FPackageInfoSpan Span;
+		Span.Start = PackageEdges.Num();
+		Span.Num = InEdges.Num();
+		PackageEdges.Append(InEdges.GetData(), InEdges.Num());
+		return Span;
+	}
+
+	void SetDependencies(TArrayView<const FPackageInfo> InEdges) { ReplaceEdges(DependencySpan, InEdges); }
+	void SetDependents(TArrayView<const FPackageInfo> InEdges) { ReplaceEdges(DependentSpan, InEdges); }
+
+protected:
+	void ReplaceEdges(FPackageInfoSpan& InOutSpan, TArrayView<const FPackageInfo> InEdges)
+	{
+		if (InEdges.Num() <= InOutSpan.Num)
+		{
+			// Reuse the old slots, the tail is left unreferenced until the pool is rebuilt
+			for (int32 i = 0; i < InEdges.Num(); ++i)
+			{
+				PackageEdges[InOutSpan.Start + i] = InEdges[i];
+			}
+			InOutSpan.Num = InEdges.Num();
+			return;
+		}
+
+		// Rebuild the pool so the replaced list and dropped tails leave no dead slots behind
+		int32 EdgeCount = InEdges.Num() - InOutSpan.Num + DependencySpan.Num + DependentSpan.Num;
+		for (const FPackageInfoSpan& Span : ObjectExports.DependencySpans)
+		{
+			EdgeCount += Span.Num;
+		}
+
+		TArray<FPackageInfo> Edges;
+		Edges.Reserve(EdgeCount);
+
+		auto CopyEdges = [&Edges](FPackageInfoSpan& InOutCopySpan, TArrayView<const FPackageInfo> InCopyEdges)
+		{
+			InOutCopySpan.Start = Edges.Num();
+			InOutCopySpan.Num = InCopyEdges.Num();
+			Edges.Append(InCopyEdges.GetData(), InCopyEdges.Num());
+		};
+
+		// Spans still point into the old pool while copying, InEdges may too
+		FPackageInfoSpan NewSpan;
+		CopyEdges(NewSpan, InEdges);
+		if (&InOutSpan != &DependencySpan)
+		{
+			CopyEdges(DependencySpan, GetEdges(DependencySpan));
+		}
+		if (&InOutSpan != &DependentSpan)
+		{
+			CopyEdges(DependentSpan, GetEdges(DependentSpan));
+		}
+		for (FPackageInfoSpan& Span : ObjectExports.DependencySpans)
+		{
+			CopyEdges(Span, GetEdges(Span));
+		}
+
+		InOutSpan = NewSpan;
+		PackageEdges = MoveTemp(Edges);
+	}
 };
 
 struct FPakFileEntry : TSharedFromThis<FPakFileEntry>
@@ -133,3 +246,342 @@ struct FPakFileSumary
 	FAES::FAESKey DecryptAESKey;
 	int32 FileCount = 0;
 };
+
+/** Packages reachable from a set of root packages, the roots included. */
+struct FDependencyClosure
+{
+	TArray<FName> Packages;
+
+	/** Files of the closure packages found in the loaded paks, .uexp and .ubulk companions included. */
+	TArray<FPakFileEntryPtr> Files;
+
+	int64 Size = 0;
+	int64 CompressedSize = 0;
+};
+
+/** Packages that depend on each other in a loop, a strongly connected component of the dependency graph. */
+struct FDependencyCycle
+{
+	TArray<FName> Packages;
+	TArray<FPakFileEntryPtr> Files;
+
+	int64 Size = 0;
+	int64 CompressedSize = 0;
+};
+
+typedef TSharedPtr<FDependencyCycle> FDependencyCyclePtr;
+
+/** Root set and scope of the unreferenced package search. */
+struct FUnreferencedPackageOptions
+{
+	/** Packages of these classes are always referenced, maps are roots regardless. */
+	TArray<FName> RootClasses;
+
+	/** Packages under these package paths are always referenced. */
+	TArray<FString> RootPaths;
+
+	/** Only files of this pak are reported, INDEX_NONE for all paks. */
+	int32 PakIndex = INDEX_NONE;
+
+	/** Only files under this folder are reported, empty for all folders. */
+	FString Folder;
+};
+
+/** A package that no other package depends on. */
+struct FUnreferencedPackage
+{
+	FName PackageName;
+	FName Class;
+	TArray<FPakFileEntryPtr> Files;
+
+	int64 Size = 0;
+	int64 CompressedSize = 0;
+};
+
+typedef TSharedPtr<FUnreferencedPackage> FUnreferencedPackagePtr;
+
+/** Entries with the same content hash and size, stored more than once across the loaded paks. */
+struct FDuplicateGroup
+{
+	TArray<FPakFileEntryPtr> Files;
+
+	int64 Size = 0;
+
+	/** Compressed bytes of every copy except the smallest one. */
+	int64 WastedSize = 0;
+};
+
+typedef TSharedPtr<FDuplicateGroup> FDuplicateGroupPtr;
+
+/** Storage cost model used to estimate read time. */
+struct FLoadDeviceModel
+{
+	FName Name;
+
+	/** Fixed cost of every discontiguous read, in seconds. */
+	double SeekLatency = 0.0;
+
+	/** Extra seek cost per GiB of head travel, in seconds. Zero for flash storage. */
+	double SeekTimePerGB = 0.0;
+
+	/** Sustained read bandwidth, in bytes per second. */
+	double ReadBandwidth = 1.0;
+
+	static FLoadDeviceModel HDD() { return { TEXT("HDD"), 0.008, 0.004, 120.0 * 1024 * 1024 }; }
+	static FLoadDeviceModel SSD() { return { TEXT("SSD"), 0.0001, 0.0, 500.0 * 1024 * 1024 }; }
+	static FLoadDeviceModel Optical() { return { TEXT("Optical"), 0.1, 0.05, 20.0 * 1024 * 1024 }; }
+};
+
+/** Simulated I/O of loading a root package and its dependency closure. */
+struct FLoadSimulation
+{
+	FName RootPackage;
+	int32 PackageCount = 0;
+	int32 FileCount = 0;
+
+	/** Compression blocks touched, a stored file counts as one block. */
+	int32 BlockCount = 0;
+
+	/** Discontiguous reads, reads continuing where the last one stopped are merged. */
+	int32 ReadCount = 0;
+	int64 ReadSize = 0;
+
+	/** Head travel between reads of the same pak, switching pak counts as a read only. */
+	int64 SeekDistance = 0;
+	double EstimatedTime = 0.0;
+};
+
+/** Simulated cost of the root packages before and after reordering. */
+struct FPakOrderEstimate
+{
+	int32 RootCount = 0;
+	int32 FileCount = 0;
+
+	FLoadSimulation Before;
+	FLoadSimulation After;
+};
+
+/** One file of a pak set as the diff sees it. */
+struct FPakDiffRecord
+{
+	FString Path;
+	FName Class;
+	int64 Size = 0;
+	int64 CompressedSize = 0;
+	FSHAHash Hash;
+};
+
+enum class EPakExportFormat : uint8
+{
+	Json,
+	Csv,
+	Columnar,
+	Sql,
+};
+
+enum class EPakDiffType : uint8
+{
+	Unchanged,
+	Added,
+	Removed,
+	Modified,
+
+	/** Same content found under another path. */
+	Moved,
+
+	Count,
+};
+
+struct FPakDiffEntry
+{
+	EPakDiffType Type = EPakDiffType::Unchanged;
+	FString Path;
+
+	/** Path in the old set, only set for moved entries. */
+	FString OldPath;
+	FName Class;
+
+	int64 OldSize = 0;
+	int64 NewSize = 0;
+	int64 OldCompressedSize = 0;
+	int64 NewCompressedSize = 0;
+};
+
+/** Changes summed over a folder or a class. */
+struct FPakDiffGroup
+{
+	FString Name;
+	int32 Counts[(int32)EPakDiffType::Count] = {};
+
+	int64 SizeDelta = 0;
+	int64 CompressedSizeDelta = 0;
+};
+
+struct FPakDiffResult
+{
+	/** Changed files, unchanged ones are only counted. */
+	TArray<FPakDiffEntry> Entries;
+	TArray<FPakDiffGroup> Folders;
+	TArray<FPakDiffGroup> Classes;
+	FPakDiffGroup Total;
+};
+
+/** Compression settings to try on the content of loaded files. */
+struct FRecompressionOptions
+{
+	/** Compression methods to try, empty for every available one. */
+	TArray<FName> Methods;
+	TArray<int32> BlockSizes = { 64 * 1024, 128 * 1024, 256 * 1024 };
+
+	/** Part of the files to recompress, 1 for all of them. */
+	float SampleRatio = 1.f;
+};
+
+/** Size and decompression cost of one method and block size. */
+struct FRecompressionEstimate
+{
+	FName Method;
+	int32 BlockSize = 0;
+
+	int64 CompressedSize = 0;
+	int64 BlockCount = 0;
+	double DecompressTime = 0.0;
+};
+
+struct FRecompressionGroup
+{
+	FString Name;
+	int32 FileCount = 0;
+	int64 Size = 0;
+
+	/** Compressed size as stored in the paks now. */
+	int64 CurrentCompressedSize = 0;
+
+	/** One estimate per method and block size, in the same order for every group. */
+	TArray<FRecompressionEstimate> Estimates;
+};
+
+struct FRecompressionResult
+{
+	int32 FileCount = 0;
+	int32 SampledFileCount = 0;
+	int32 FailedFileCount = 0;
+
+	/** Sampled files only, scale by FileCount for the whole selection. */
+	FRecompressionGroup Total;
+	TArray<FRecompressionGroup> Folders;
+	TArray<FRecompressionGroup> Classes;
+};
+
+enum class EPakLayoutSpanType : uint8
+{
+	Entry,
+
+	/** Hole that only brings the next entry to an aligned offset. */
+	Padding,
+	Gap,
+	Index,
+	Footer,
+};
+
+/** A run of bytes in a pak. */
+struct FPakLayoutSpan
+{
+	EPakLayoutSpanType Type = EPakLayoutSpanType::Entry;
+	int64 Offset = 0;
+	int64 Size = 0;
+
+	/** Index into FPakLayout::Files for entries, INDEX_NONE otherwise. */
+	int32 FileIndex = INDEX_NONE;
+};
+
+/** How a pak is laid out on disk, entries sorted by offset. */
+struct FPakLayout
+{
+	int32 PakIndex = INDEX_NONE;
+	int64 PakSize = 0;
+
+	TArray<FPakFileEntryPtr> Files;
+	TArray<FPakLayoutSpan> Spans;
+
+	int64 EntrySize = 0;
+	int32 GapCount = 0;
+	int64 GapSize = 0;
+	int64 LargestGap = 0;
+	int32 PaddingCount = 0;
+	int64 PaddingSize = 0;
+	int32 OverlapCount = 0;
+
+	int64 IndexOffset = 0;
+	int64 IndexSize = 0;
+
+	/** Directory and class changes between neighbouring entries, against the distinct count as the best case. */
+	int32 DirectoryCount = 0;
+	int32 DirectoryChanges = 0;
+	int32 ClassCount = 0;
+	int32 ClassChanges = 0;
+};
+
+enum class EPakVerifyError : uint8
+{
+	None = 0,
+
+	/** Entry data runs past the end of the data section. */
+	OutOfBounds = (1 << 0),
+	Overlap = (1 << 1),
+
+	/** Compression blocks overlap, leave the entry or don't cover its size. */
+	BadBlocks = (1 << 2),
+
+	/** Entry header in front of the data differs from the index. */
+	HeaderMismatch = (1 << 3),
+	HashMismatch = (1 << 4),
+	DecompressFailed = (1 << 5),
+};
+ENUM_CLASS_FLAGS(EPakVerifyError);
+
+struct FPakVerifyIssue
+{
+	FPakFileEntryPtr File;
+	EPakVerifyError Errors = EPakVerifyError::None;
+};
+
+struct FPakVerifyResult
+{
+	int32 PakCount = 0;
+	int32 FileCount = 0;
+	int64 ReadSize = 0;
+
+	/** Entries that can't be decompressed here, encrypted without a key or an unavailable method. Only their hash is checked. */
+	int32 UncheckedCount = 0;
+	double Seconds = 0.0;
+
+	/** Corrupt entries in pak and offset order. */
+	TArray<FPakVerifyIssue> Issues;
+};
+
+/** Counters of the loaded session, memory values estimate the heap owned by each structure. */
+struct FPakSessionStats
+{
+	int32 TreeNodeCount = 0;
+	int32 DirectoryCount = 0;
+	int32 FileCount = 0;
+	int32 AssetSummaryCount = 0;
+	int32 RegistryPackageCount = 0;
+	int32 GraphPackageCount = 0;
+
+	int64 TreeNodeMemory = 0;
+	int64 PathMemory = 0;
+	int64 CompressionBlockMemory = 0;
+	int64 AssetSummaryMemory = 0;
+	int64 NameMemory = 0;
+	int64 ImportMemory = 0;
+	int64 ExportMemory = 0;
+	int64 EdgeMemory = 0;
+	int64 RegistryMemory = 0;
+	int64 GraphMemory = 0;
+
+	int32 LastExtractFileCount = 0;
+	int64 LastExtractSize = 0;
+	double LastExtractSeconds = 0.0;
+};
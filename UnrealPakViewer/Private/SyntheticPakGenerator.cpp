@@ -0,0 +1,372 @@
+#include "SyntheticPakGenerator.h"
+
+#include "Async/ParallelFor.h"
+#include "HAL/FileManager.h"
+#include "HAL/PlatformTime.h"
+#include "IPlatformFilePak.h"
+#include "Math/RandomStream.h"
+#include "Misc/AES.h"
+#include "Misc/Base64.h"
+#include "Misc/Compression.h"
+#include "Misc/SecureHash.h"
+#include "Serialization/MemoryWriter.h"
+#include "UObject/ObjectResource.h"
+#include "UObject/ObjectVersion.h"
+#include "UObject/PackageFileSummary.h"
+
+#include "CommonDefines.h"
+
+/** Writes names as indices into its own name table, the way the parse worker reads them back. */
+class FSyntheticAssetWriter : public FMemoryWriter
+{
+public:
+	FSyntheticAssetWriter(TArray<uint8>& InBytes, TArray<FString>& InNames)
+		: FMemoryWriter(InBytes)
+		, Names(InNames)
+	{
+	}
+
+	FArchive& operator<<(FName& InName)
+	{
+		FArchive& Ar = *this;
+		int32 NameIndex = Names.AddUnique(InName.GetPlainNameString());
+		int32 Number = InName.GetNumber();
+		Ar << NameIndex;
+		Ar << Number;
+
+		return Ar;
+	}
+
+protected:
+	TArray<FString>& Names;
+};
+
+struct FSyntheticFile
+{
+	FString Path;
+	int32 PackageIndex = 0;
+	bool bAsset = false;
+	int64 PayloadSize = 0;
+};
+
+struct FSyntheticEntry
+{
+	FPakEntry Entry;
+	TArray<uint8> Data;
+};
+
+static const int32 SyntheticPakVersion = FPakInfo::PakFile_Version_FNameBasedCompressionMethod;
+static const int32 SyntheticBlockSize = 64 * 1024;
+
+static FString MakePackageRelativePath(int32 InPackageIndex, ESyntheticPakShape InShape)
+{
+	FString Directory;
+	if (InShape == ESyntheticPakShape::Wide)
+	{
+		Directory = FString::Printf(TEXT("Folder_%02d"), InPackageIndex % 16);
+	}
+	else
+	{
+		// Every 4 packages share a leaf, each level fans out by 4
+		int32 Folder = InPackageIndex / 4;
+		for (int32 Level = 0; Level < 10; ++Level)
+		{
+			Directory /= FString::Printf(TEXT("Level%d_%d"), Level, Folder % 4);
+			Folder /= 4;
+		}
+	}
+
+	return Directory / FString::Printf(TEXT("Asset_%07d"), InPackageIndex);
+}
+
+static bool IsMapPackage(int32 InPackageIndex)
+{
+	return InPackageIndex % 50 == 0;
+}
+
+bool FSyntheticPakGenerator::Generate(const FString& InPakPath, const FSyntheticPakOptions& InOptions, FString& OutKey)
+{
+	const double StartTime = FPlatformTime::Seconds();
+
+	// Packages come as .uasset/.umap with a .uexp, every 8th one has a .ubulk
+	TArray<FSyntheticFile> Files;
+	Files.Reserve(InOptions.EntryCount);
+
+	int32 PackageCount = 0;
+	while (Files.Num() < InOptions.EntryCount)
+	{
+		const int32 PackageIndex = PackageCount++;
+
+		FSyntheticFile& Header = Files.AddDefaulted_GetRef();
+		Header.Path = MakeFilePath(PackageIndex, IsMapPackage(PackageIndex) ? TEXT(".umap") : TEXT(".uasset"), InOptions.Shape);
+		Header.PackageIndex = PackageIndex;
+		Header.bAsset = true;
+
+		if (Files.Num() < InOptions.EntryCount)
+		{
+			FSyntheticFile& Exports = Files.AddDefaulted_GetRef();
+			Exports.Path = MakeFilePath(PackageIndex, TEXT(".uexp"), InOptions.Shape);
+			Exports.PackageIndex = PackageIndex;
+		}
+
+		if (PackageIndex % 8 == 0 && Files.Num() < InOptions.EntryCount)
+		{
+			FSyntheticFile& Bulk = Files.AddDefaulted_GetRef();
+			Bulk.Path = MakeFilePath(PackageIndex, TEXT(".ubulk"), InOptions.Shape);
+			Bulk.PackageIndex = PackageIndex;
+		}
+	}
+
+	TUniquePtr<FArchive> Writer(IFileManager::Get().CreateFileWriter(*InPakPath));
+	if (!Writer)
+	{
+		UE_LOG(LogPakAnalyzer, Error, TEXT("Generate synthetic pak failed! Can't open %s to write."), *InPakPath);
+		return false;
+	}
+
+	FPakInfo Info;
+	const uint32 CompressionMethodIndex = InOptions.bCompress ? Info.GetCompressionMethodIndex(NAME_Zlib) : 0;
+
+	TArray<FPakEntry> IndexEntries;
+	IndexEntries.Reserve(Files.Num());
+
+	// Content is built in parallel and written in order, so the output does not depend on scheduling
+	static const int32 BatchSize = 1024;
+	TArray<FSyntheticEntry> Batch;
+	for (int32 BatchStart = 0; BatchStart < Files.Num(); BatchStart += BatchSize)
+	{
+		const int32 BatchCount = FMath::Min(BatchSize, Files.Num() - BatchStart);
+		Batch.Reset();
+		Batch.SetNum(BatchCount);
+
+		ParallelFor(BatchCount, [&](int32 InIndex)
+			{
+				const int32 FileIndex = BatchStart + InIndex;
+				FSyntheticFile& File = Files[FileIndex];
+				FSyntheticEntry& Output = Batch[InIndex];
+
+				FRandomStream Stream(InOptions.Seed * 7919 + FileIndex);
+				File.PayloadSize = Stream.RandRange(0, FMath::Max(InOptions.MaxFileSize, 0));
+
+				TArray<uint8> Raw;
+				if (File.bAsset && InOptions.bFakeAssetHeaders)
+				{
+					MakeAssetHeader(File.PackageIndex, InOptions.Shape, File.PayloadSize, Raw);
+				}
+				else
+				{
+					MakePayload(Stream, File.PayloadSize, Raw);
+				}
+
+				FPakEntry& Entry = Output.Entry;
+				Entry.UncompressedSize = Raw.Num();
+
+				if (CompressionMethodIndex != 0 && Raw.Num() > 0)
+				{
+					const int32 BlockCount = FMath::DivideAndRoundUp(Raw.Num(), SyntheticBlockSize);
+					Entry.CompressionMethodIndex = CompressionMethodIndex;
+					Entry.CompressionBlockSize = FMath::Min(Raw.Num(), SyntheticBlockSize);
+					Entry.CompressionBlocks.SetNum(BlockCount);
+
+					// Block offsets are relative to the entry header, whose size depends on the block count only
+					int64 BlockStart = Entry.GetSerializedSize(SyntheticPakVersion);
+					TArray<uint8> Block;
+					for (int32 i = 0; i < BlockCount; ++i)
+					{
+						const int32 RawOffset = i * SyntheticBlockSize;
+						const int32 RawSize = FMath::Min(SyntheticBlockSize, Raw.Num() - RawOffset);
+
+						int32 CompressedSize = FCompression::CompressMemoryBound(NAME_Zlib, RawSize);
+						Block.SetNumUninitialized(CompressedSize);
+						FCompression::CompressMemory(NAME_Zlib, Block.GetData(), CompressedSize, Raw.GetData() + RawOffset, RawSize);
+
+						Output.Data.Append(Block.GetData(), CompressedSize);
+						Entry.CompressionBlocks[i].CompressedStart = BlockStart;
+						Entry.CompressionBlocks[i].CompressedEnd = BlockStart + CompressedSize;
+						BlockStart += CompressedSize;
+					}
+				}
+				else
+				{
+					Output.Data = MoveTemp(Raw);
+				}
+
+				Entry.Size = Output.Data.Num();
+				FSHA1::HashBuffer(Output.Data.GetData(), Output.Data.Num(), Entry.Hash);
+			});
+
+		for (FSyntheticEntry& Output : Batch)
+		{
+			// The header in front of the data is written with a zero offset, like UnrealPak does
+			FPakEntry Header = Output.Entry;
+			Header.Offset = 0;
+
+			Output.Entry.Offset = Writer->Tell();
+			Header.Serialize(*Writer, SyntheticPakVersion);
+			Writer->Serialize(Output.Data.GetData(), Output.Data.Num());
+
+			IndexEntries.Add(Output.Entry);
+		}
+	}
+
+	// Legacy index: mount point, entry count, then filename and entry pairs
+	TArray<uint8> IndexData;
+	FMemoryWriter IndexWriter(IndexData);
+
+	FString MountPoint = TEXT("../../../");
+	int32 EntryCount = Files.Num();
+	IndexWriter << MountPoint;
+	IndexWriter << EntryCount;
+	for (int32 i = 0; i < Files.Num(); ++i)
+	{
+		IndexWriter << Files[i].Path;
+		IndexEntries[i].Serialize(IndexWriter, SyntheticPakVersion);
+	}
+
+	OutKey.Empty();
+	if (InOptions.bEncryptIndex)
+	{
+		FRandomStream KeyStream(InOptions.Seed);
+		FAES::FAESKey Key;
+		for (int32 i = 0; i < FAES::FAESKey::KeySize; ++i)
+		{
+			Key.Key[i] = (uint8)KeyStream.RandHelper(256);
+		}
+		OutKey = FBase64::Encode(Key.Key, FAES::FAESKey::KeySize);
+
+		// The hash covers the padded plain index, it is checked after decryption
+		IndexData.SetNumZeroed(Align(IndexData.Num(), FAES::AESBlockSize));
+		FSHA1::HashBuffer(IndexData.GetData(), IndexData.Num(), Info.IndexHash.Hash);
+		FAES::EncryptData(IndexData.GetData(), IndexData.Num(), Key);
+
+		Info.bEncryptedIndex = true;
+	}
+	else
+	{
+		FSHA1::HashBuffer(IndexData.GetData(), IndexData.Num(), Info.IndexHash.Hash);
+	}
+
+	Info.Version = SyntheticPakVersion;
+	Info.IndexOffset = Writer->Tell();
+	Info.IndexSize = IndexData.Num();
+	Writer->Serialize(IndexData.GetData(), IndexData.Num());
+	Info.Serialize(*Writer, SyntheticPakVersion);
+
+	const bool bResult = Writer->Close() && !Writer->IsError();
+
+	UE_LOG(LogPakAnalyzer, Display, TEXT("Generated %s: %d entries, %d packages, %lld bytes in %.3fs."), *InPakPath, Files.Num(), PackageCount, Info.IndexOffset + Info.IndexSize, FPlatformTime::Seconds() - StartTime);
+
+	return bResult;
+}
+
+FString FSyntheticPakGenerator::MakeFilePath(int32 InPackageIndex, const FString& InExtension, ESyntheticPakShape InShape)
+{
+	return TEXT("Synthetic/Content") / MakePackageRelativePath(InPackageIndex, InShape) + InExtension;
+}
+
+void FSyntheticPakGenerator::MakeAssetHeader(int32 InPackageIndex, ESyntheticPakShape InShape, int64 InPayloadSize, TArray<uint8>& OutData)
+{
+	static const FName ClassNames[] = { TEXT("StaticMesh"), TEXT("Texture2D"), TEXT("Material"), TEXT("SoundWave"), TEXT("SkeletalMesh") };
+	static const FName CoreUObjectName(TEXT("/Script/CoreUObject"));
+	static const FName EngineName(TEXT("/Script/Engine"));
+	static const FName ClassName(TEXT("Class"));
+	static const FName WorldName(TEXT("World"));
+
+	TArray<FString> Names;
+	TArray<FObjectImport> Imports;
+
+	FObjectImport& EnginePackage = Imports.AddDefaulted_GetRef();
+	EnginePackage.ClassPackage = CoreUObjectName;
+	EnginePackage.ClassName = NAME_Package;
+	EnginePackage.ObjectName = EngineName;
+
+	FObjectImport& Class = Imports.AddDefaulted_GetRef();
+	Class.ClassPackage = CoreUObjectName;
+	Class.ClassName = ClassName;
+	Class.OuterIndex = FPackageIndex::FromImport(0);
+	Class.ObjectName = IsMapPackage(InPackageIndex) ? WorldName : ClassNames[InPackageIndex % UE_ARRAY_COUNT(ClassNames)];
+
+	// A few earlier packages as dependencies, so the graph has edges
+	for (int32 i = 1; i <= 3 && InPackageIndex > 0; ++i)
+	{
+		const int32 Dependency = (InPackageIndex * 31 + i * 17) % InPackageIndex;
+
+		FObjectImport& Package = Imports.AddDefaulted_GetRef();
+		Package.ClassPackage = CoreUObjectName;
+		Package.ClassName = NAME_Package;
+		Package.ObjectName = *(TEXT("/Game") / MakePackageRelativePath(Dependency, InShape));
+	}
+
+	FObjectExport Export;
+	Export.ClassIndex = FPackageIndex::FromImport(1);
+	Export.ObjectName = *FString::Printf(TEXT("Asset_%07d"), InPackageIndex);
+	Export.ObjectFlags = RF_Public | RF_Standalone;
+	Export.bIsAsset = true;
+	Export.SerialSize = InPayloadSize;
+
+	// Tables first to collect the names, their size does not depend on the offsets
+	TArray<uint8> ImportData;
+	FSyntheticAssetWriter ImportWriter(ImportData, Names);
+	for (FObjectImport& Import : Imports)
+	{
+		ImportWriter << Import;
+	}
+
+	TArray<uint8> ExportData;
+	{
+		FSyntheticAssetWriter ExportWriter(ExportData, Names);
+		ExportWriter << Export;
+	}
+
+	TArray<uint8> NameData;
+	FMemoryWriter NameWriter(NameData);
+	for (FString& Name : Names)
+	{
+		uint16 NonCasePreservingHash = 0;
+		uint16 CasePreservingHash = 0;
+		NameWriter << Name;
+		NameWriter << NonCasePreservingHash;
+		NameWriter << CasePreservingHash;
+	}
+
+	FPackageFileSummary Summary;
+	Summary.Tag = PACKAGE_FILE_TAG;
+	Summary.NameCount = Names.Num();
+	Summary.ImportCount = Imports.Num();
+	Summary.ExportCount = 1;
+
+	TArray<uint8> SummaryData;
+	{
+		FMemoryWriter SummaryWriter(SummaryData);
+		SummaryWriter << Summary;
+	}
+
+	Summary.NameOffset = SummaryData.Num();
+	Summary.ImportOffset = Summary.NameOffset + NameData.Num();
+	Summary.ExportOffset = Summary.ImportOffset + ImportData.Num();
+	Summary.TotalHeaderSize = Summary.ExportOffset + ExportData.Num();
+
+	Export.SerialOffset = Summary.TotalHeaderSize;
+	ExportData.Reset();
+	{
+		FSyntheticAssetWriter ExportWriter(ExportData, Names);
+		ExportWriter << Export;
+	}
+
+	OutData.Reset();
+	FMemoryWriter Writer(OutData);
+	Writer << Summary;
+	Writer.Serialize(NameData.GetData(), NameData.Num());
+	Writer.Serialize(ImportData.GetData(), ImportData.Num());
+	Writer.Serialize(ExportData.GetData(), ExportData.Num());
+}
+
+void FSyntheticPakGenerator::MakePayload(FRandomStream& InStream, int64 InSize, TArray<uint8>& OutData)
+{
+	// A small alphabet keeps the data about as compressible as cooked content
+	OutData.SetNumUninitialized((int32)InSize);
+	for (int32 i = 0; i < OutData.Num(); ++i)
+	{
+		OutData[i] = (uint8)InStream.RandHelper(16);
+	}
+}
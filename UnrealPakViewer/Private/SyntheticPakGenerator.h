@@ -0,0 +1,39 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+enum class ESyntheticPakShape : uint8
+{
+	/** Few directories with many files each. */
+	Wide,
+
+	/** Many nested directories with few files each. */
+	Deep,
+};
+
+struct FSyntheticPakOptions
+{
+	int32 EntryCount = 10000;
+	ESyntheticPakShape Shape = ESyntheticPakShape::Wide;
+	bool bCompress = true;
+	bool bEncryptIndex = false;
+
+	/** Write parseable package summaries into .uasset and .umap files. */
+	bool bFakeAssetHeaders = true;
+
+	int32 MaxFileSize = 16 * 1024;
+	int32 Seed = 0;
+};
+
+/** Writes deterministic paks for benchmarking, the same options always give the same bytes. */
+class FSyntheticPakGenerator
+{
+public:
+	/** Writes the pak, OutKey is the base64 AES key when the index is encrypted. */
+	static bool Generate(const FString& InPakPath, const FSyntheticPakOptions& InOptions, FString& OutKey);
+
+protected:
+	static FString MakeFilePath(int32 InPackageIndex, const FString& InExtension, ESyntheticPakShape InShape);
+	static void MakeAssetHeader(int32 InPackageIndex, ESyntheticPakShape InShape, int64 InPayloadSize, TArray<uint8>& OutData);
+	static void MakePayload(struct FRandomStream& InStream, int64 InSize, TArray<uint8>& OutData);
+};
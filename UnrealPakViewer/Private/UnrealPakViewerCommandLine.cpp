@@ -0,0 +1,723 @@
+#include "UnrealPakViewerCommandLine.h"
+
+#include "Async/TaskGraphInterfaces.h"
+#include "HAL/FileManager.h"
+#include "HAL/PlatformMemory.h"
+#include "HAL/PlatformMisc.h"
+#include "HAL/PlatformProcess.h"
+#include "HAL/PlatformTime.h"
+#include "Json.h"
+#include "Misc/EngineVersion.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Parse.h"
+#include "Misc/Paths.h"
+
+#include "CommonDefines.h"
+#include "PakAnalyzerModule.h"
+#include "PakAnalyzerTrace.h"
+#include "SyntheticPakGenerator.h"
+#include "ViewModels/FileColumn.h"
+
+#include <stdio.h>
+
+TMap<FGuid, FString> FUnrealPakViewerCommandLine::GuidKeys;
+TArray<FString> FUnrealPakViewerCommandLine::DefaultKeys;
+TMap<FString, int32> FUnrealPakViewerCommandLine::KeyAttempts;
+
+bool FUnrealPakViewerCommandLine::IsRequested(const TCHAR* CommandLine)
+{
+	FString Command;
+	return FParse::Value(CommandLine, TEXT("-Cmd="), Command) && !Command.IsEmpty();
+}
+
+int32 FUnrealPakViewerCommandLine::Exec(const TCHAR* CommandLine)
+{
+	const double StartTime = FPlatformTime::Seconds();
+
+	FString Command;
+	FString PakValue;
+	FParse::Value(CommandLine, TEXT("-Cmd="), Command);
+	FParse::Value(CommandLine, TEXT("-Pak="), PakValue, false);
+
+	// Benchmark makes its own paks
+	if (Command == TEXT("benchmark"))
+	{
+		return ExecBenchmark(CommandLine);
+	}
+
+	const TArray<FString> PakPaths = ParsePaths(PakValue);
+	if (PakPaths.Num() <= 0)
+	{
+		UE_LOG(LogPakAnalyzer, Error, TEXT("No pak file given! Use -Pak=<a.pak+b.pak>."));
+		return InvalidArguments;
+	}
+
+	FString KeyFilePath;
+	if (FParse::Value(CommandLine, TEXT("-KeyFile="), KeyFilePath, false) && !LoadKeyFile(KeyFilePath))
+	{
+		return InvalidArguments;
+	}
+
+	FString Filter;
+	FString OutputPath;
+	FString AgainstValue;
+	int32 ThreadCount = FPlatformMisc::NumberOfCoresIncludingHyperthreads();
+	FParse::Value(CommandLine, TEXT("-Filter="), Filter, false);
+	FParse::Value(CommandLine, TEXT("-Output="), OutputPath, false);
+	FParse::Value(CommandLine, TEXT("-Against="), AgainstValue, false);
+	FParse::Value(CommandLine, TEXT("-Threads="), ThreadCount);
+
+	const bool bNeedOutput = Command.StartsWith(TEXT("export-")) || Command == TEXT("extract");
+	if (bNeedOutput && OutputPath.IsEmpty())
+	{
+		UE_LOG(LogPakAnalyzer, Error, TEXT("%s needs -Output=<path>."), *Command);
+		return InvalidArguments;
+	}
+
+	if (Command == TEXT("diff") && AgainstValue.IsEmpty())
+	{
+		UE_LOG(LogPakAnalyzer, Error, TEXT("diff needs -Against=<c.pak+d.pak>."));
+		return InvalidArguments;
+	}
+
+	if (!OutputPath.IsEmpty())
+	{
+		OutputPath = FPaths::ConvertRelativePathToFull(OutputPath);
+	}
+
+	if (!LoadPaks(PakPaths))
+	{
+		return LoadFailed;
+	}
+
+	UE_LOG(LogPakAnalyzer, Display, TEXT("Loaded %d pak(s) in %.3fs."), IPakAnalyzerModule::Get().GetPakAnalyzer()->GetPakFileSumary().Num(), FPlatformTime::Seconds() - StartTime);
+
+	// Classes and dependencies come from the asset parse, the file table alone does not need it
+	if (FParse::Param(CommandLine, TEXT("WaitParse")))
+	{
+		WaitForAssetParse();
+	}
+
+	int32 ExitCode = InvalidArguments;
+	if (Command == TEXT("list"))
+	{
+		ExitCode = ExecList(Filter, OutputPath);
+	}
+	else if (Command == TEXT("export-json") || Command == TEXT("export-csv") || Command == TEXT("export-columnar") || Command == TEXT("export-sql"))
+	{
+		ExitCode = ExecExport(Filter, OutputPath, Command.RightChop(7));
+	}
+	else if (Command == TEXT("extract"))
+	{
+		ExitCode = ExecExtract(Filter, OutputPath, ThreadCount);
+	}
+	else if (Command == TEXT("diff"))
+	{
+		ExitCode = ExecDiff(ParsePaths(AgainstValue), OutputPath);
+	}
+	else if (Command == TEXT("stats"))
+	{
+		ExitCode = ExecStats(Filter);
+	}
+	else if (Command == TEXT("verify"))
+	{
+		ExitCode = ExecVerify(OutputPath);
+	}
+	else
+	{
+		UE_LOG(LogPakAnalyzer, Error, TEXT("Unknown command: %s. Use list, export-json, export-csv, export-columnar, export-sql, extract, diff, stats or verify."), *Command);
+	}
+
+	UE_LOG(LogPakAnalyzer, Display, TEXT("%s finished in %.3fs, exit code %d."), *Command, FPlatformTime::Seconds() - StartTime, ExitCode);
+
+	return ExitCode;
+}
+
+bool FUnrealPakViewerCommandLine::LoadKeyFile(const FString& InKeyFilePath)
+{
+	TArray<FString> Lines;
+	if (!FFileHelper::LoadFileToStringArray(Lines, *InKeyFilePath))
+	{
+		UE_LOG(LogPakAnalyzer, Error, TEXT("Load key file failed! Path: %s."), *InKeyFilePath);
+		return false;
+	}
+
+	// One base64 key per line, optionally prefixed with the encryption key guid: [<Guid>=]<Key>
+	for (const FString& RawLine : Lines)
+	{
+		const FString Line = RawLine.TrimStartAndEnd();
+		if (Line.IsEmpty() || Line.StartsWith(TEXT("#")))
+		{
+			continue;
+		}
+
+		FString GuidString;
+		FString Key;
+		FGuid Guid;
+		if (Line.Split(TEXT("="), &GuidString, &Key) && FGuid::Parse(GuidString.TrimEnd(), Guid))
+		{
+			GuidKeys.Add(Guid, Key.TrimStart());
+		}
+		else
+		{
+			DefaultKeys.Add(Line);
+		}
+	}
+
+	UE_LOG(LogPakAnalyzer, Display, TEXT("Loaded %d key(s) from %s."), GuidKeys.Num() + DefaultKeys.Num(), *InKeyFilePath);
+
+	return true;
+}
+
+FString FUnrealPakViewerCommandLine::GetAESKey(const FString& InPakPath, const FGuid& InGuid, bool& bCancel)
+{
+	// Called again for each failed key until the candidates run out
+	TArray<FString> Candidates;
+	if (const FString* GuidKey = GuidKeys.Find(InGuid))
+	{
+		Candidates.Add(*GuidKey);
+	}
+	Candidates.Append(DefaultKeys);
+
+	int32& Attempt = KeyAttempts.FindOrAdd(InPakPath + InGuid.ToString());
+	bCancel = !Candidates.IsValidIndex(Attempt);
+
+	return bCancel ? FString() : Candidates[Attempt++];
+}
+
+bool FUnrealPakViewerCommandLine::LoadPaks(const TArray<FString>& InPakPaths)
+{
+	TArray<FString> FullPaths;
+	for (const FString& PakPath : InPakPaths)
+	{
+		FullPaths.Add(FPaths::ConvertRelativePathToFull(PakPath));
+	}
+
+	KeyAttempts.Empty();
+	FPakAnalyzerDelegates::OnGetAESKey.BindStatic(&FUnrealPakViewerCommandLine::GetAESKey);
+
+	FPakAnalyzerDelegates::OnLoadPakFailed.BindLambda([](const FString& InReason)
+		{
+			UE_LOG(LogPakAnalyzer, Error, TEXT("%s"), *InReason);
+		});
+
+	IPakAnalyzerModule::Get().InitializeAnalyzerBackend(FullPaths[0]);
+	const bool bResult = IPakAnalyzerModule::Get().GetPakAnalyzer()->LoadPakFiles(FullPaths, TArray<FString>());
+
+	FPakAnalyzerDelegates::OnGetAESKey.Unbind();
+
+	return bResult && IPakAnalyzerModule::Get().GetPakAnalyzer()->GetPakFileSumary().Num() > 0;
+}
+
+void FUnrealPakViewerCommandLine::WaitForAssetParse()
+{
+	TArray<TSharedPtr<FPakFileEntry>> Files;
+	GetFiles(TEXT(""), Files);
+
+	// The parse worker only starts when there is something to parse
+	const bool bHasAssets = Files.ContainsByPredicate([](const TSharedPtr<FPakFileEntry>& File)
+		{
+			const FString Filename = File->Filename.ToString();
+			return Filename.EndsWith(TEXT(".uasset")) || Filename.EndsWith(TEXT(".umap"));
+		});
+
+	if (!bHasAssets)
+	{
+		return;
+	}
+
+	bool bFinished = false;
+	const FDelegateHandle Handle = FPakAnalyzerDelegates::OnAssetParseFinish.AddLambda([&bFinished]() { bFinished = true; });
+
+	// Parse results are published to the game thread
+	while (!bFinished && !IsEngineExitRequested())
+	{
+		FTaskGraphInterface::Get().ProcessThreadUntilIdle(ENamedThreads::GameThread);
+		FPlatformProcess::Sleep(0.01f);
+	}
+
+	FPakAnalyzerDelegates::OnAssetParseFinish.Remove(Handle);
+}
+
+void FUnrealPakViewerCommandLine::GetFiles(const FString& InFilter, TArray<TSharedPtr<FPakFileEntry>>& OutFiles)
+{
+	IPakAnalyzerModule::Get().GetPakAnalyzer()->GetFiles(InFilter, TMap<FName, bool>(), TMap<int32, bool>(), OutFiles);
+}
+
+int32 FUnrealPakViewerCommandLine::ExecList(const FString& InFilter, const FString& InOutputPath)
+{
+	TArray<FPakFileEntryPtr> Files;
+	GetFiles(InFilter, Files);
+
+	Files.Sort([](const FPakFileEntryPtr& A, const FPakFileEntryPtr& B) { return A->Path < B->Path; });
+
+	const TArray<FPakFileSumaryPtr>& Summaries = IPakAnalyzerModule::Get().GetPakAnalyzer()->GetPakFileSumary();
+
+	FString Text;
+	Text.Reserve(Files.Num() * 128);
+	for (const FPakFileEntryPtr& File : Files)
+	{
+		const FString PakName = Summaries.IsValidIndex(File->OwnerPakIndex) ? FPaths::GetCleanFilename(Summaries[File->OwnerPakIndex]->PakFilePath) : FString();
+		Text += FString::Printf(TEXT("%s\t%lld\t%lld\t%s\t%s\t%s"), *File->Path, File->PakEntry.UncompressedSize, File->PakEntry.Size, *File->CompressionMethod.ToString(), *File->Class.ToString(), *PakName);
+		Text += LINE_TERMINATOR;
+	}
+
+	if (!InOutputPath.IsEmpty())
+	{
+		if (!FFileHelper::SaveStringToFile(Text, *InOutputPath, FFileHelper::EEncodingOptions::ForceUTF8WithoutBOM))
+		{
+			UE_LOG(LogPakAnalyzer, Error, TEXT("Write file list failed! Path: %s."), *InOutputPath);
+			return OperationFailed;
+		}
+	}
+	else
+	{
+		Print(Text);
+	}
+
+	return Success;
+}
+
+int32 FUnrealPakViewerCommandLine::ExecExport(const FString& InFilter, const FString& InOutputPath, const FString& InFormat)
+{
+	TArray<FPakFileEntryPtr> Files;
+	GetFiles(InFilter, Files);
+
+	IPakAnalyzer* PakAnalyzer = IPakAnalyzerModule::Get().GetPakAnalyzer();
+
+	bool bResult = false;
+	if (InFormat == TEXT("json"))
+	{
+		bResult = PakAnalyzer->ExportToJson(InOutputPath, Files);
+	}
+	else if (InFormat == TEXT("csv"))
+	{
+		bResult = PakAnalyzer->ExportToCsv(InOutputPath, Files);
+	}
+	else if (InFormat == TEXT("columnar"))
+	{
+		bResult = PakAnalyzer->ExportToColumnar(InOutputPath, Files);
+	}
+	else
+	{
+		bResult = PakAnalyzer->ExportToSql(InOutputPath, Files);
+	}
+
+	return bResult ? Success : OperationFailed;
+}
+
+int32 FUnrealPakViewerCommandLine::ExecExtract(const FString& InFilter, const FString& InOutputPath, int32 InThreadCount)
+{
+	const TArray<FPakFileSumaryPtr>& Summaries = IPakAnalyzerModule::Get().GetPakAnalyzer()->GetPakFileSumary();
+	if (Summaries.Num() > 0 && IFileManager::Get().DirectoryExists(*Summaries[0]->PakFilePath))
+	{
+		UE_LOG(LogPakAnalyzer, Error, TEXT("Extract is not supported for folders."));
+		return InvalidArguments;
+	}
+
+	TArray<FPakFileEntryPtr> Files;
+	GetFiles(InFilter, Files);
+	if (Files.Num() <= 0)
+	{
+		return Success;
+	}
+
+	int32 ErrorCount = 0;
+	const bool bResult = ExtractFiles(Files, InOutputPath, InThreadCount, ErrorCount);
+
+	UE_LOG(LogPakAnalyzer, Display, TEXT("Extracted %d file(s) to %s, %d error(s)."), Files.Num(), *InOutputPath, ErrorCount);
+
+	return bResult && ErrorCount <= 0 ? Success : OperationFailed;
+}
+
+bool FUnrealPakViewerCommandLine::ExtractFiles(TArray<TSharedPtr<FPakFileEntry>>& InFiles, const FString& InOutputPath, int32 InThreadCount, int32& OutErrorCount)
+{
+	int32 CompleteCount = 0;
+	OutErrorCount = 0;
+	FPakAnalyzerDelegates::OnUpdateExtractProgress.BindLambda([&CompleteCount, &OutErrorCount](int32 InCompleteCount, int32 InErrorCount, int32 InTotalCount)
+		{
+			CompleteCount = InCompleteCount;
+			OutErrorCount = InErrorCount;
+		});
+
+	const int32 FileCount = InFiles.Num();
+
+	IPakAnalyzer* PakAnalyzer = IPakAnalyzerModule::Get().GetPakAnalyzer();
+	PakAnalyzer->SetExtractThreadCount(InThreadCount);
+	PakAnalyzer->ExtractFiles(InOutputPath, InFiles);
+
+	// Worker progress is published to the game thread
+	double LastReportTime = FPlatformTime::Seconds();
+	while (CompleteCount < FileCount)
+	{
+		FTaskGraphInterface::Get().ProcessThreadUntilIdle(ENamedThreads::GameThread);
+
+		if (IsEngineExitRequested())
+		{
+			PakAnalyzer->CancelExtract();
+			break;
+		}
+
+		const double CurrentTime = FPlatformTime::Seconds();
+		if (CurrentTime - LastReportTime >= 1.0)
+		{
+			UE_LOG(LogPakAnalyzer, Display, TEXT("Extracted %d / %d, %d error(s)."), CompleteCount, FileCount, OutErrorCount);
+			LastReportTime = CurrentTime;
+		}
+
+		FPlatformProcess::Sleep(0.01f);
+	}
+
+	FPakAnalyzerDelegates::OnUpdateExtractProgress.Unbind();
+
+	return CompleteCount >= FileCount;
+}
+
+int32 FUnrealPakViewerCommandLine::ExecDiff(const TArray<FString>& InAgainstPaths, const FString& InOutputPath)
+{
+	TArray<FString> FullPaths;
+	for (const FString& PakPath : InAgainstPaths)
+	{
+		FullPaths.Add(FPaths::ConvertRelativePathToFull(PakPath));
+	}
+
+	KeyAttempts.Empty();
+	FPakAnalyzerDelegates::OnGetAESKey.BindStatic(&FUnrealPakViewerCommandLine::GetAESKey);
+
+	FPakDiffResult Result;
+	const bool bResult = IPakAnalyzerModule::Get().GetPakAnalyzer()->DiffPakFiles(FullPaths, TArray<FString>(), Result);
+
+	FPakAnalyzerDelegates::OnGetAESKey.Unbind();
+
+	if (!bResult)
+	{
+		return LoadFailed;
+	}
+
+	static const TCHAR* TypeNames[] = { TEXT("Unchanged"), TEXT("Added"), TEXT("Removed"), TEXT("Modified"), TEXT("Moved") };
+	static_assert(UE_ARRAY_COUNT(TypeNames) == (int32)EPakDiffType::Count, "Diff type names out of date");
+
+	FString Text;
+	for (const FPakDiffEntry& Entry : Result.Entries)
+	{
+		Text += FString::Printf(TEXT("%s\t%s\t%lld\t%lld\t%s"), TypeNames[(int32)Entry.Type], *Entry.Path, Entry.OldCompressedSize, Entry.NewCompressedSize, *Entry.OldPath);
+		Text += LINE_TERMINATOR;
+	}
+
+	if (!InOutputPath.IsEmpty())
+	{
+		if (!FFileHelper::SaveStringToFile(Text, *InOutputPath, FFileHelper::EEncodingOptions::ForceUTF8WithoutBOM))
+		{
+			UE_LOG(LogPakAnalyzer, Error, TEXT("Write diff failed! Path: %s."), *InOutputPath);
+			return OperationFailed;
+		}
+	}
+	else
+	{
+		Print(Text);
+	}
+
+	const FPakDiffGroup& Total = Result.Total;
+	Print(FString::Printf(TEXT("Unchanged %d, added %d, removed %d, modified %d, moved %d. Size delta %lld, compressed size delta %lld.") LINE_TERMINATOR,
+		Total.Counts[(int32)EPakDiffType::Unchanged], Total.Counts[(int32)EPakDiffType::Added], Total.Counts[(int32)EPakDiffType::Removed],
+		Total.Counts[(int32)EPakDiffType::Modified], Total.Counts[(int32)EPakDiffType::Moved], Total.SizeDelta, Total.CompressedSizeDelta));
+
+	return Result.Entries.Num() > 0 ? DifferencesFound : Success;
+}
+
+int32 FUnrealPakViewerCommandLine::ExecStats(const FString& InFilter)
+{
+	static const int32 MaxClassCount = 20;
+
+	FString Text;
+	for (const FPakFileSumaryPtr& Summary : IPakAnalyzerModule::Get().GetPakAnalyzer()->GetPakFileSumary())
+	{
+		Text += FString::Printf(TEXT("%s: version %d, %d files, %lld bytes, mount point %s, compression %s, encrypted index %s") LINE_TERMINATOR,
+			*FPaths::GetCleanFilename(Summary->PakFilePath), Summary->PakInfo.Version, Summary->FileCount, Summary->PakFileSize, *Summary->MountPoint,
+			Summary->CompressionMethods.IsEmpty() ? TEXT("None") : *Summary->CompressionMethods, Summary->PakInfo.bEncryptedIndex ? TEXT("yes") : TEXT("no"));
+	}
+
+	TArray<FPakFileEntryPtr> Files;
+	GetFiles(InFilter, Files);
+
+	int64 TotalSize = 0;
+	int64 TotalCompressedSize = 0;
+	TMap<FName, FPakClassEntry> Classes;
+	for (const FPakFileEntryPtr& File : Files)
+	{
+		TotalSize += File->PakEntry.UncompressedSize;
+		TotalCompressedSize += File->PakEntry.Size;
+
+		FPakClassEntry* ClassEntry = Classes.Find(File->Class);
+		if (!ClassEntry)
+		{
+			ClassEntry = &Classes.Add(File->Class, FPakClassEntry(File->Class, 0, 0, 0));
+		}
+
+		ClassEntry->Size += File->PakEntry.UncompressedSize;
+		ClassEntry->CompressedSize += File->PakEntry.Size;
+		++ClassEntry->FileCount;
+	}
+
+	Text += FString::Printf(TEXT("Total: %d files, %lld bytes, %lld bytes compressed.") LINE_TERMINATOR, Files.Num(), TotalSize, TotalCompressedSize);
+
+	Classes.ValueSort([](const FPakClassEntry& A, const FPakClassEntry& B) { return A.CompressedSize > B.CompressedSize; });
+
+	int32 ClassIndex = 0;
+	for (const auto& Pair : Classes)
+	{
+		if (ClassIndex++ >= MaxClassCount)
+		{
+			break;
+		}
+
+		Text += FString::Printf(TEXT("\t%s\t%d\t%lld\t%lld") LINE_TERMINATOR, *Pair.Value.Class.ToString(), Pair.Value.FileCount, Pair.Value.Size, Pair.Value.CompressedSize);
+	}
+
+	Print(Text);
+
+	return Success;
+}
+
+int32 FUnrealPakViewerCommandLine::ExecVerify(const FString& InOutputPath)
+{
+	IPakAnalyzer* PakAnalyzer = IPakAnalyzerModule::Get().GetPakAnalyzer();
+
+	FPakVerifyResult Result;
+	if (!PakAnalyzer->VerifyPakFiles(Result))
+	{
+		UE_LOG(LogPakAnalyzer, Error, TEXT("Verify failed! Only pak files can be verified and every pak must be readable."));
+		return OperationFailed;
+	}
+
+	static const TCHAR* ErrorNames[] = { TEXT("OutOfBounds"), TEXT("Overlap"), TEXT("BadBlocks"), TEXT("HeaderMismatch"), TEXT("HashMismatch"), TEXT("DecompressFailed") };
+
+	const TArray<FPakFileSumaryPtr>& Summaries = PakAnalyzer->GetPakFileSumary();
+
+	FString Text;
+	for (const FPakVerifyIssue& Issue : Result.Issues)
+	{
+		FString Errors;
+		for (int32 i = 0; i < (int32)UE_ARRAY_COUNT(ErrorNames); ++i)
+		{
+			if (EnumHasAnyFlags(Issue.Errors, (EPakVerifyError)(1 << i)))
+			{
+				if (!Errors.IsEmpty())
+				{
+					Errors += TEXT(",");
+				}
+				Errors += ErrorNames[i];
+			}
+		}
+
+		const FString PakName = Summaries.IsValidIndex(Issue.File->OwnerPakIndex) ? FPaths::GetCleanFilename(Summaries[Issue.File->OwnerPakIndex]->PakFilePath) : FString();
+		Text += FString::Printf(TEXT("%s\t%s\t%s\t%lld"), *Errors, *PakName, *Issue.File->Path, Issue.File->PakEntry.Offset);
+		Text += LINE_TERMINATOR;
+	}
+
+	if (!InOutputPath.IsEmpty())
+	{
+		if (!FFileHelper::SaveStringToFile(Text, *InOutputPath, FFileHelper::EEncodingOptions::ForceUTF8WithoutBOM))
+		{
+			UE_LOG(LogPakAnalyzer, Error, TEXT("Write verify result failed! Path: %s."), *InOutputPath);
+			return OperationFailed;
+		}
+	}
+	else
+	{
+		Print(Text);
+	}
+
+	Print(FString::Printf(TEXT("Verified %d pak(s), %d files, %lld bytes read in %.3fs. Corrupt %d, decompression not checked %d.") LINE_TERMINATOR,
+		Result.PakCount, Result.FileCount, Result.ReadSize, Result.Seconds, Result.Issues.Num(), Result.UncheckedCount));
+
+	return Result.Issues.Num() > 0 ? CorruptFilesFound : Success;
+}
+
+int32 FUnrealPakViewerCommandLine::ExecBenchmark(const TCHAR* CommandLine)
+{
+	FSyntheticPakOptions Options;
+	FString Shape;
+	FString Label;
+	FString OutputPath;
+	FString WorkDir = FPaths::ProjectSavedDir();
+	int32 ThreadCount = FPlatformMisc::NumberOfCoresIncludingHyperthreads();
+
+	FParse::Value(CommandLine, TEXT("-Entries="), Options.EntryCount);
+	FParse::Value(CommandLine, TEXT("-Shape="), Shape);
+	FParse::Value(CommandLine, TEXT("-MaxFileSize="), Options.MaxFileSize);
+	FParse::Value(CommandLine, TEXT("-Seed="), Options.Seed);
+	FParse::Value(CommandLine, TEXT("-Threads="), ThreadCount);
+	FParse::Value(CommandLine, TEXT("-Label="), Label);
+	FParse::Value(CommandLine, TEXT("-Output="), OutputPath, false);
+	FParse::Value(CommandLine, TEXT("-WorkDir="), WorkDir, false);
+	Options.Shape = Shape == TEXT("deep") ? ESyntheticPakShape::Deep : ESyntheticPakShape::Wide;
+	Options.bCompress = !FParse::Param(CommandLine, TEXT("NoCompress"));
+	Options.bEncryptIndex = FParse::Param(CommandLine, TEXT("EncryptIndex"));
+	Options.bFakeAssetHeaders = !FParse::Param(CommandLine, TEXT("NoAssetHeaders"));
+
+	if (Options.EntryCount <= 0 || OutputPath.IsEmpty())
+	{
+		UE_LOG(LogPakAnalyzer, Error, TEXT("benchmark needs -Entries=<count> and -Output=<results.json>."));
+		return InvalidArguments;
+	}
+
+	// Only a directory of our own is cleared, -WorkDir may point at anything
+	WorkDir = FPaths::ConvertRelativePathToFull(WorkDir) / TEXT("UnrealPakViewerBenchmark");
+	IFileManager::Get().DeleteDirectory(*WorkDir, false, true);
+	IFileManager::Get().MakeDirectory(*WorkDir, true);
+
+	TArray<TSharedPtr<FJsonValue>> Timings;
+	auto AddTiming = [&Timings](const FString& InName, double InSeconds, int64 InCount)
+	{
+		TSharedRef<FJsonObject> Timing = MakeShareable(new FJsonObject);
+		Timing->SetStringField(TEXT("Name"), InName);
+		Timing->SetNumberField(TEXT("Seconds"), InSeconds);
+		Timing->SetNumberField(TEXT("Count"), InCount);
+		Timings.Add(MakeShareable(new FJsonValueObject(Timing)));
+
+		Print(FString::Printf(TEXT("%-32s %10.3fs %12lld") LINE_TERMINATOR, *InName, InSeconds, InCount));
+	};
+
+	const FString PakPath = WorkDir / TEXT("Synthetic.pak");
+	FString Key;
+
+	double StartTime = FPlatformTime::Seconds();
+	if (!FSyntheticPakGenerator::Generate(PakPath, Options, Key))
+	{
+		return OperationFailed;
+	}
+	AddTiming(TEXT("Generate"), FPlatformTime::Seconds() - StartTime, Options.EntryCount);
+
+	if (!Key.IsEmpty())
+	{
+		DefaultKeys.Add(Key);
+	}
+
+	const double LoadStartTime = FPlatformTime::Seconds();
+	if (!LoadPaks({ PakPath }))
+	{
+		return LoadFailed;
+	}
+	AddTiming(TEXT("LoadPakFiles"), FPlatformTime::Seconds() - LoadStartTime, Options.EntryCount);
+
+	// The parse worker starts inside LoadPakFiles and overlaps it, so parsing is timed from the start of the load
+	WaitForAssetParse();
+	AddTiming(TEXT("AssetParse"), FPlatformTime::Seconds() - LoadStartTime, Options.EntryCount);
+
+	TArray<FPakFileEntryPtr> Files;
+	StartTime = FPlatformTime::Seconds();
+	GetFiles(TEXT(""), Files);
+	AddTiming(TEXT("GetFiles"), FPlatformTime::Seconds() - StartTime, Files.Num());
+
+	TArray<FPakFileEntryPtr> FilteredFiles;
+	StartTime = FPlatformTime::Seconds();
+	GetFiles(TEXT("Asset_00"), FilteredFiles);
+	AddTiming(TEXT("GetFiles.Filter"), FPlatformTime::Seconds() - StartTime, FilteredFiles.Num());
+
+	TMap<FName, FFileColumn> Columns;
+	FFileColumn::CreateColumns(Columns);
+	for (const auto& Pair : Columns)
+	{
+		if (!Pair.Value.CanBeSorted())
+		{
+			continue;
+		}
+
+		TArray<FPakFileEntryPtr> SortedFiles = Files;
+		StartTime = FPlatformTime::Seconds();
+		SortedFiles.Sort(Pair.Value.GetAscendingCompareDelegate());
+		AddTiming(FString::Printf(TEXT("Sort.%s.Ascending"), *Pair.Key.ToString()), FPlatformTime::Seconds() - StartTime, SortedFiles.Num());
+
+		StartTime = FPlatformTime::Seconds();
+		SortedFiles.Sort(Pair.Value.GetDescendingCompareDelegate());
+		AddTiming(FString::Printf(TEXT("Sort.%s.Descending"), *Pair.Key.ToString()), FPlatformTime::Seconds() - StartTime, SortedFiles.Num());
+	}
+
+	IPakAnalyzer* PakAnalyzer = IPakAnalyzerModule::Get().GetPakAnalyzer();
+
+	StartTime = FPlatformTime::Seconds();
+	const bool bJsonResult = PakAnalyzer->ExportToJson(WorkDir / TEXT("Export.json"), Files);
+	AddTiming(TEXT("ExportToJson"), FPlatformTime::Seconds() - StartTime, Files.Num());
+
+	StartTime = FPlatformTime::Seconds();
+	const bool bCsvResult = PakAnalyzer->ExportToCsv(WorkDir / TEXT("Export.csv"), Files);
+	AddTiming(TEXT("ExportToCsv"), FPlatformTime::Seconds() - StartTime, Files.Num());
+
+	int32 ErrorCount = 0;
+	StartTime = FPlatformTime::Seconds();
+	const bool bExtractResult = ExtractFiles(Files, WorkDir / TEXT("Extract"), ThreadCount, ErrorCount);
+	AddTiming(TEXT("ExtractFiles"), FPlatformTime::Seconds() - StartTime, Files.Num());
+
+	TSharedRef<FJsonObject> OptionsObject = MakeShareable(new FJsonObject);
+	OptionsObject->SetNumberField(TEXT("Entries"), Options.EntryCount);
+	OptionsObject->SetStringField(TEXT("Shape"), Options.Shape == ESyntheticPakShape::Deep ? TEXT("deep") : TEXT("wide"));
+	OptionsObject->SetBoolField(TEXT("Compress"), Options.bCompress);
+	OptionsObject->SetBoolField(TEXT("EncryptIndex"), Options.bEncryptIndex);
+	OptionsObject->SetBoolField(TEXT("AssetHeaders"), Options.bFakeAssetHeaders);
+	OptionsObject->SetNumberField(TEXT("MaxFileSize"), Options.MaxFileSize);
+	OptionsObject->SetNumberField(TEXT("Seed"), Options.Seed);
+	OptionsObject->SetNumberField(TEXT("Threads"), ThreadCount);
+
+	TSharedRef<FJsonObject> RootObject = MakeShareable(new FJsonObject);
+	RootObject->SetStringField(TEXT("Label"), Label);
+	RootObject->SetStringField(TEXT("Engine"), FEngineVersion::Current().ToString());
+	RootObject->SetNumberField(TEXT("Cores"), FPlatformMisc::NumberOfCoresIncludingHyperthreads());
+	RootObject->SetNumberField(TEXT("PeakMemory"), FPlatformMemory::GetStats().PeakUsedPhysical);
+	RootObject->SetObjectField(TEXT("Options"), OptionsObject);
+	RootObject->SetArrayField(TEXT("Timings"), Timings);
+
+	// Analyzer stages seen while the steps above ran
+	TArray<FPakAnalyzerStageStat> StageStats;
+	FPakAnalyzerTrace::GetStageStats(StageStats);
+
+	TArray<TSharedPtr<FJsonValue>> Stages;
+	for (const FPakAnalyzerStageStat& Stat : StageStats)
+	{
+		TSharedRef<FJsonObject> Stage = MakeShareable(new FJsonObject);
+		Stage->SetStringField(TEXT("Name"), Stat.Name.ToString());
+		Stage->SetNumberField(TEXT("Calls"), Stat.CallCount);
+		Stage->SetNumberField(TEXT("Seconds"), Stat.TotalSeconds);
+		Stage->SetNumberField(TEXT("BytesRead"), Stat.BytesRead);
+		Stage->SetNumberField(TEXT("BytesWritten"), Stat.BytesWritten);
+		Stage->SetNumberField(TEXT("Allocs"), Stat.AllocCount);
+		Stages.Add(MakeShareable(new FJsonValueObject(Stage)));
+	}
+	RootObject->SetArrayField(TEXT("Stages"), Stages);
+
+	FString FileContents;
+	TSharedRef<TJsonWriter<>> JsonWriter = TJsonWriterFactory<>::Create(&FileContents);
+	if (!FJsonSerializer::Serialize(RootObject, JsonWriter) || !FFileHelper::SaveStringToFile(FileContents, *FPaths::ConvertRelativePathToFull(OutputPath)))
+	{
+		UE_LOG(LogPakAnalyzer, Error, TEXT("Write benchmark results failed! Path: %s."), *OutputPath);
+		return OperationFailed;
+	}
+
+	if (!FParse::Param(CommandLine, TEXT("KeepFiles")))
+	{
+		IFileManager::Get().DeleteDirectory(*WorkDir, false, true);
+	}
+
+	return bJsonResult && bCsvResult && bExtractResult && ErrorCount <= 0 ? Success : OperationFailed;
+}
+
+void FUnrealPakViewerCommandLine::Print(const FString& InText)
+{
+	// Straight to stdout, the log is for diagnostics
+	fputs(TCHAR_TO_UTF8(*InText), stdout);
+	fflush(stdout);
+}
+
+TArray<FString> FUnrealPakViewerCommandLine::ParsePaths(const FString& InValue)
+{
+	TArray<FString> Paths;
+	InValue.ParseIntoArray(Paths, TEXT("+"));
+
+	for (FString& Path : Paths)
+	{
+		Path.TrimStartAndEndInline();
+	}
+	Paths.RemoveAll([](const FString& Path) { return Path.IsEmpty(); });
+
+	return Paths;
+}
@@ -0,0 +1,60 @@
+// Copyright 1998-2019 Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * Runs the analyzer without Slate, for build machines.
+ *
+ * UnrealPakViewer -Cmd=<list|export-json|export-csv|export-columnar|export-sql|extract|diff|stats|verify> -Pak=<a.pak+b.pak> [-KeyFile=<keys.txt>] [-Filter=<text>] [-Output=<path>] [-Against=<c.pak+d.pak>] [-Threads=<count>] [-WaitParse]
+ * UnrealPakViewer -Cmd=benchmark -Entries=<count> -Output=<results.json> [-Shape=<wide|deep>] [-NoCompress] [-EncryptIndex] [-NoAssetHeaders] [-MaxFileSize=<bytes>] [-Seed=<seed>] [-Label=<commit>] [-WorkDir=<path>] [-KeepFiles]
+ */
+class FUnrealPakViewerCommandLine
+{
+public:
+	enum EExitCode
+	{
+		Success = 0,
+		InvalidArguments = 1,
+		LoadFailed = 2,
+		OperationFailed = 3,
+
+		/** Diff ran fine and found changes. */
+		DifferencesFound = 4,
+
+		/** Verify ran fine and found corrupt entries. */
+		CorruptFilesFound = 5,
+	};
+
+	/** Whether the command line asks for a headless run. */
+	static bool IsRequested(const TCHAR* CommandLine);
+
+	/** Executes the command and returns the process exit code. */
+	static int32 Exec(const TCHAR* CommandLine);
+
+protected:
+	static bool LoadKeyFile(const FString& InKeyFilePath);
+	static FString GetAESKey(const FString& InPakPath, const FGuid& InGuid, bool& bCancel);
+	static bool LoadPaks(const TArray<FString>& InPakPaths);
+	static void WaitForAssetParse();
+	static bool ExtractFiles(TArray<TSharedPtr<struct FPakFileEntry>>& InFiles, const FString& InOutputPath, int32 InThreadCount, int32& OutErrorCount);
+	static void GetFiles(const FString& InFilter, TArray<TSharedPtr<struct FPakFileEntry>>& OutFiles);
+
+	static int32 ExecList(const FString& InFilter, const FString& InOutputPath);
+	static int32 ExecExport(const FString& InFilter, const FString& InOutputPath, const FString& InFormat);
+	static int32 ExecExtract(const FString& InFilter, const FString& InOutputPath, int32 InThreadCount);
+	static int32 ExecDiff(const TArray<FString>& InAgainstPaths, const FString& InOutputPath);
+	static int32 ExecStats(const FString& InFilter);
+	static int32 ExecVerify(const FString& InOutputPath);
+	static int32 ExecBenchmark(const TCHAR* CommandLine);
+
+	static void Print(const FString& InText);
+	static TArray<FString> ParsePaths(const FString& InValue);
+
+protected:
+	/** Keys from the key file, by encryption key guid. Keys without a guid are tried on every pak. */
+	static TMap<FGuid, FString> GuidKeys;
+	static TArray<FString> DefaultKeys;
+	static TMap<FString, int32> KeyAttempts;
+};
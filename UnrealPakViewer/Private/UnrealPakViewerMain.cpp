@@ -5,6 +5,7 @@
 #include "RequiredProgramMainCPPInclude.h"
 
 #include "UnrealPakViewerApplication.h"
+#include "UnrealPakViewerCommandLine.h"
 
 IMPLEMENT_APPLICATION(UnrealPakViewer, "UnrealPakViewer");
 
@@ -30,13 +31,21 @@ int32 UnrealPakViewerMain(const TCHAR* CommandLine)
 	// Tell the module manager it may now process newly-loaded UObjects when new C++ modules are loaded.
 	FModuleManager::Get().StartProcessingNewlyLoadedObjects();
 
-	// Run application
-	FUnrealPakViewerApplication::Exec();
+	// Run application, headless when a command is given
+	int32 ExitCode = 0;
+	if (FUnrealPakViewerCommandLine::IsRequested(CommandLine))
+	{
+		ExitCode = FUnrealPakViewerCommandLine::Exec(CommandLine);
+	}
+	else
+	{
+		FUnrealPakViewerApplication::Exec();
+	}
 
 	// Shut down.
 	FEngineLoop::AppPreExit(); //im: ???
 
 	FModuleManager::Get().UnloadModulesAtShutdown();
 
-	return 0;
+	return ExitCode;
 }
@@ -14,3 +14,205 @@ const FName FFileColumn::IsEncryptedColumnName(TEXT("IsEncrypted"));
 const FName FFileColumn::OwnerPakColumnName(TEXT("OwnerPak"));
 const FName FFileColumn::DependencyCountColumnName(TEXT("DependencyCount"));
 const FName FFileColumn::DependentCountColumnName(TEXT("DependentCount"));
+
+// Keys stay in the file view namespace, the columns used to be built there
+#define LOCTEXT_NAMESPACE "SPakFileView"
+
+void FFileColumn::CreateColumns(TMap<FName, FFileColumn>& OutColumns)
+{
+	// Name Column
+	FFileColumn& NameColumn = OutColumns.Emplace(FFileColumn::NameColumnName, FFileColumn(0, FFileColumn::NameColumnName, LOCTEXT("NameColumn", "Name"), LOCTEXT("NameColumnTip", "File name"), 2.f, EFileColumnFlags::ShouldBeVisible | EFileColumnFlags::CanBeFiltered));
+	NameColumn.SetAscendingCompareDelegate(
+		[](const FPakFileEntryPtr& A, const FPakFileEntryPtr& B) -> bool
+		{
+			return A->Filename.LexicalLess(B->Filename);
+		}
+	);
+	NameColumn.SetDescendingCompareDelegate(
+		[](const FPakFileEntryPtr& A, const FPakFileEntryPtr& B) -> bool
+		{
+			return B->Filename.LexicalLess(A->Filename);
+		}
+	);
+
+	// Path Column
+	FFileColumn& PathColumn = OutColumns.Emplace(FFileColumn::PathColumnName, FFileColumn(1, FFileColumn::PathColumnName, LOCTEXT("PathColumn", "Path"), LOCTEXT("PathColumnTip", "File path in pak"), 3.f, EFileColumnFlags::ShouldBeVisible | EFileColumnFlags::CanBeFiltered | EFileColumnFlags::CanBeHidden));
+	PathColumn.SetAscendingCompareDelegate(
+		[](const FPakFileEntryPtr& A, const FPakFileEntryPtr& B) -> bool
+		{
+			return A->Path < B->Path;
+		}
+	);
+	PathColumn.SetDescendingCompareDelegate(
+		[](const FPakFileEntryPtr& A, const FPakFileEntryPtr& B) -> bool
+		{
+			return B->Path < A->Path;
+		}
+	);
+
+	// Class Column
+	FFileColumn& ClassColumn = OutColumns.Emplace(FFileColumn::ClassColumnName, FFileColumn(2, FFileColumn::ClassColumnName, LOCTEXT("ClassColumn", "Class"), LOCTEXT("ClassColumnTip", "Class name in asset registry or file extension if not found"), 1.f, EFileColumnFlags::ShouldBeVisible | EFileColumnFlags::CanBeFiltered | EFileColumnFlags::CanBeHidden));
+	ClassColumn.SetAscendingCompareDelegate(
+		[](const FPakFileEntryPtr& A, const FPakFileEntryPtr& B) -> bool
+		{
+			return A->Class.LexicalLess(B->Class);
+		}
+	);
+	ClassColumn.SetDescendingCompareDelegate(
+		[](const FPakFileEntryPtr& A, const FPakFileEntryPtr& B) -> bool
+		{
+			return B->Class.LexicalLess(A->Class);
+		}
+	);
+
+	// Dependency Count Column
+	FFileColumn& DependencyCountColumn = OutColumns.Emplace(FFileColumn::DependencyCountColumnName, FFileColumn(3, FFileColumn::DependencyCountColumnName, LOCTEXT("DependencyCountColumn", "Dependency Count"), LOCTEXT("DependencyCountColumnTip", "Packages this package depends on"), 1.f, EFileColumnFlags::ShouldBeVisible | EFileColumnFlags::CanBeFiltered | EFileColumnFlags::CanBeHidden));
+	DependencyCountColumn.SetAscendingCompareDelegate(
+		[](const FPakFileEntryPtr& A, const FPakFileEntryPtr& B) -> bool
+		{
+			const int32 ACount = A->AssetSummary.IsValid() ? A->AssetSummary->GetDependencyCount() : 0;
+			const int32 BCount = B->AssetSummary.IsValid() ? B->AssetSummary->GetDependencyCount() : 0;
+			return ACount < BCount;
+		}
+	);
+	DependencyCountColumn.SetDescendingCompareDelegate(
+		[](const FPakFileEntryPtr& A, const FPakFileEntryPtr& B) -> bool
+		{
+			const int32 ACount = A->AssetSummary.IsValid() ? A->AssetSummary->GetDependencyCount() : 0;
+			const int32 BCount = B->AssetSummary.IsValid() ? B->AssetSummary->GetDependencyCount() : 0;
+			return BCount < ACount;
+		}
+	);
+
+	// Dependent Count Column
+	FFileColumn& DependentCountColumn = OutColumns.Emplace(FFileColumn::DependentCountColumnName, FFileColumn(4, FFileColumn::DependentCountColumnName, LOCTEXT("DependentCountColumn", "Dependent Count"), LOCTEXT("DependentCountColumnTip", "Packages depend on this package"), 1.f, EFileColumnFlags::ShouldBeVisible | EFileColumnFlags::CanBeFiltered | EFileColumnFlags::CanBeHidden));
+	DependentCountColumn.SetAscendingCompareDelegate(
+		[](const FPakFileEntryPtr& A, const FPakFileEntryPtr& B) -> bool
+		{
+			const int32 ACount = A->AssetSummary.IsValid() ? A->AssetSummary->GetDependentCount() : 0;
+			const int32 BCount = B->AssetSummary.IsValid() ? B->AssetSummary->GetDependentCount() : 0;
+			return ACount < BCount;
+		}
+	);
+	DependentCountColumn.SetDescendingCompareDelegate(
+		[](const FPakFileEntryPtr& A, const FPakFileEntryPtr& B) -> bool
+		{
+			const int32 ACount = A->AssetSummary.IsValid() ? A->AssetSummary->GetDependentCount() : 0;
+			const int32 BCount = B->AssetSummary.IsValid() ? B->AssetSummary->GetDependentCount() : 0;
+			return BCount < ACount;
+		}
+	);
+
+	// Offset Column
+	FFileColumn& OffsetColumn = OutColumns.Emplace(FFileColumn::OffsetColumnName, FFileColumn(5, FFileColumn::OffsetColumnName, LOCTEXT("OffsetColumn", "Offset"), LOCTEXT("OffsetColumnTip", "File offset in pak"), 1.f, EFileColumnFlags::ShouldBeVisible | EFileColumnFlags::CanBeFiltered | EFileColumnFlags::CanBeHidden));
+	OffsetColumn.SetAscendingCompareDelegate(
+		[](const FPakFileEntryPtr& A, const FPakFileEntryPtr& B) -> bool
+		{
+			return A->PakEntry.Offset < B->PakEntry.Offset;
+		}
+	);
+	OffsetColumn.SetDescendingCompareDelegate(
+		[](const FPakFileEntryPtr& A, const FPakFileEntryPtr& B) -> bool
+		{
+			return B->PakEntry.Offset < A->PakEntry.Offset;
+		}
+	);
+
+	// Size Column
+	FFileColumn& SizeColumn = OutColumns.Emplace(FFileColumn::SizeColumnName, FFileColumn(6, FFileColumn::SizeColumnName, LOCTEXT("SizeColumn", "Size"), LOCTEXT("SizeColumnTip", "File original size"), 1.f, EFileColumnFlags::ShouldBeVisible | EFileColumnFlags::CanBeFiltered | EFileColumnFlags::CanBeHidden));
+	SizeColumn.SetAscendingCompareDelegate(
+		[](const FPakFileEntryPtr& A, const FPakFileEntryPtr& B) -> bool
+		{
+			return A->PakEntry.UncompressedSize < B->PakEntry.UncompressedSize;
+		}
+	);
+	SizeColumn.SetDescendingCompareDelegate(
+		[](const FPakFileEntryPtr& A, const FPakFileEntryPtr& B) -> bool
+		{
+			return B->PakEntry.UncompressedSize < A->PakEntry.UncompressedSize;
+		}
+	);
+	
+	// Compressed Size Column
+	FFileColumn& CompressedSizeColumn = OutColumns.Emplace(FFileColumn::CompressedSizeColumnName, FFileColumn(7, FFileColumn::CompressedSizeColumnName, LOCTEXT("CompressedSizeColumn", "Compressed Size"), LOCTEXT("CompressedSizeColumnTip", "File compressed size"), 1.f, EFileColumnFlags::ShouldBeVisible | EFileColumnFlags::CanBeFiltered | EFileColumnFlags::CanBeHidden));
+	CompressedSizeColumn.SetAscendingCompareDelegate(
+		[](const FPakFileEntryPtr& A, const FPakFileEntryPtr& B) -> bool
+		{
+			return A->PakEntry.Size < B->PakEntry.Size;
+		}
+	);
+	CompressedSizeColumn.SetDescendingCompareDelegate(
+		[](const FPakFileEntryPtr& A, const FPakFileEntryPtr& B) -> bool
+		{
+			return B->PakEntry.Size < A->PakEntry.Size;
+		}
+	);
+	
+	// Compressed Block Count
+	FFileColumn& CompressionBlockCountColumn = OutColumns.Emplace(FFileColumn::CompressionBlockCountColumnName, FFileColumn(8, FFileColumn::CompressionBlockCountColumnName, LOCTEXT("CompressionBlockCountColumn", "Compression Block Count"), LOCTEXT("CompressionBlockCountColumnTip", "File compression block count"), 1.f, EFileColumnFlags::ShouldBeVisible | EFileColumnFlags::CanBeFiltered | EFileColumnFlags::CanBeHidden));
+	CompressionBlockCountColumn.SetAscendingCompareDelegate(
+		[](const FPakFileEntryPtr& A, const FPakFileEntryPtr& B) -> bool
+		{
+			return A->PakEntry.CompressionBlocks.Num() < B->PakEntry.CompressionBlocks.Num();
+		}
+	);
+	CompressionBlockCountColumn.SetDescendingCompareDelegate(
+		[](const FPakFileEntryPtr& A, const FPakFileEntryPtr& B) -> bool
+		{
+			return B->PakEntry.CompressionBlocks.Num() < A->PakEntry.CompressionBlocks.Num();
+		}
+	);
+	
+	// Compressed Block Size
+	OutColumns.Emplace(FFileColumn::CompressionBlockSizeColumnName, FFileColumn(9, FFileColumn::CompressionBlockSizeColumnName, LOCTEXT("CompressionBlockSizeColumn", "Compression Block Size"), LOCTEXT("CompressionBlockSizeColumnTip", "File compression block size"), 1.f, EFileColumnFlags::ShouldBeVisible | EFileColumnFlags::CanBeHidden));
+	
+	// Compression Method
+	FFileColumn& CompressionMethodColumn = OutColumns.Emplace(FFileColumn::CompressionMethodColumnName, FFileColumn(10, FFileColumn::CompressionMethodColumnName, LOCTEXT("CompressionMethod", "Compression Method"), LOCTEXT("CompressionMethodTip", "Compression method name used to compress this file"), 1.f, EFileColumnFlags::ShouldBeVisible | EFileColumnFlags::CanBeHidden));
+	CompressionMethodColumn.SetAscendingCompareDelegate(
+		[](const FPakFileEntryPtr& A, const FPakFileEntryPtr& B) -> bool
+		{
+			return A->CompressionMethod.LexicalLess(B->CompressionMethod);
+		}
+	);
+	CompressionMethodColumn.SetDescendingCompareDelegate(
+		[](const FPakFileEntryPtr& A, const FPakFileEntryPtr& B) -> bool
+		{
+			return B->CompressionMethod.LexicalLess(A->CompressionMethod);
+		}
+	);
+	
+	// Owner Pak
+	FFileColumn& OwnerPakColumn = OutColumns.Emplace(FFileColumn::OwnerPakColumnName, FFileColumn(11, FFileColumn::OwnerPakColumnName, LOCTEXT("OwnerPakColumn", "Onwer Pak"), LOCTEXT("OnwerPakColumnTip", "Owner Pak Name"), 2.f, EFileColumnFlags::ShouldBeVisible | EFileColumnFlags::CanBeHidden | EFileColumnFlags::CanBeFiltered));
+	OwnerPakColumn.SetAscendingCompareDelegate(
+		[](const FPakFileEntryPtr& A, const FPakFileEntryPtr& B) -> bool
+		{
+			return A->OwnerPakIndex < B->OwnerPakIndex;
+		}
+	);
+	OwnerPakColumn.SetDescendingCompareDelegate(
+		[](const FPakFileEntryPtr& A, const FPakFileEntryPtr& B) -> bool
+		{
+			return B->OwnerPakIndex < A->OwnerPakIndex;
+		}
+	);
+
+	// SHA1
+	OutColumns.Emplace(FFileColumn::SHA1ColumnName, FFileColumn(12, FFileColumn::SHA1ColumnName, LOCTEXT("SHA1Column", "SHA1"), LOCTEXT("SHA1ColumnTip", "File sha1"), 1.f, EFileColumnFlags::ShouldBeVisible | EFileColumnFlags::CanBeHidden));
+	
+	// IsEncrypted
+	FFileColumn& IsEncryptedColumn = OutColumns.Emplace(FFileColumn::IsEncryptedColumnName, FFileColumn(13, FFileColumn::IsEncryptedColumnName, LOCTEXT("IsEncryptedColumn", "IsEncrypted"), LOCTEXT("IsEncryptedColumnTip", "Is file encrypted in pak?"), 1.f, EFileColumnFlags::ShouldBeVisible | EFileColumnFlags::CanBeHidden));
+	IsEncryptedColumn.SetAscendingCompareDelegate(
+		[](const FPakFileEntryPtr& A, const FPakFileEntryPtr& B) -> bool
+		{
+			return A->PakEntry.IsEncrypted() < B->PakEntry.IsEncrypted();
+		}
+	);
+	IsEncryptedColumn.SetDescendingCompareDelegate(
+		[](const FPakFileEntryPtr& A, const FPakFileEntryPtr& B) -> bool
+		{
+			return B->PakEntry.IsEncrypted() < A->PakEntry.IsEncrypted();
+		}
+	);
+}
+
+#undef LOCTEXT_NAMESPACE
@@ -34,6 +34,9 @@ public:
 	static const FName DependencyCountColumnName;
 	static const FName DependentCountColumnName;
 
+	/** Builds every file list column with its compare functions. */
+	static void CreateColumns(TMap<FName, FFileColumn>& OutColumns);
+
 	FFileColumn() = delete;
 	FFileColumn(int32 InIndex, const FName InId, const FText& InTitleName, const FText& InDescription, float InFillWidth, const EFileColumnFlags& InFlags, FFileCompareFunc InAscendingCompareDelegate = nullptr, FFileCompareFunc InDescendingCompareDelegate = nullptr)
 		: Index(InIndex)
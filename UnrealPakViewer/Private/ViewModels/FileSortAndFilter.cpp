@@ -2,6 +2,7 @@
 
 #include "Misc/ScopeLock.h"
 #include "PakAnalyzerModule.h"
+#include "PakAnalyzerTrace.h"
 #include "ViewModels/FileColumn.h"
 #include "Widgets/SPakFileView.h"
 
@@ -13,6 +14,8 @@ void FFileSortAndFilterTask::DoWork()
 		return;
 	}
 
+	PAK_ANALYZER_TRACE_SCOPE(FileView_SortAndFilter);
+
 	TArray<FPakFileEntryPtr> FilterResult;
 	IPakAnalyzerModule::Get().GetPakAnalyzer()->GetFiles(CurrentSearchText, ClassFilterMap, IndexFilterMap, FilterResult);
 
@@ -27,13 +30,17 @@ void FFileSortAndFilterTask::DoWork()
 		return;
 	}
 
-	if (CurrentSortMode == EColumnSortMode::Ascending)
-	{
-		FilterResult.Sort(Column->GetAscendingCompareDelegate());
-	}
-	else
 	{
-		FilterResult.Sort(Column->GetDescendingCompareDelegate());
+		PAK_ANALYZER_TRACE_SCOPE(FileView_Sort);
+
+		if (CurrentSortMode == EColumnSortMode::Ascending)
+		{
+			FilterResult.Sort(Column->GetAscendingCompareDelegate());
+		}
+		else
+		{
+			FilterResult.Sort(Column->GetDescendingCompareDelegate());
+		}
 	}
 
 	{
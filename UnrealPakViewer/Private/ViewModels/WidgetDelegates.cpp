@@ -16,4 +16,10 @@ FOnLoadAssetRegistryFinished& FWidgetDelegates::GetOnLoadAssetRegistryFinishedDe
 {
 	static FOnLoadAssetRegistryFinished Delegate;
 	return Delegate;
+}
+
+FOnEstimateRecompression& FWidgetDelegates::GetOnEstimateRecompressionDelegate()
+{
+	static FOnEstimateRecompression Delegate;
+	return Delegate;
 }
\ No newline at end of file
@@ -2,9 +2,12 @@
 
 #include "CoreMinimal.h"
 
+#include "PakFileEntry.h"
+
 DECLARE_MULTICAST_DELEGATE_TwoParams(FOnSwitchToTreeView, const FString&, int32);
 DECLARE_MULTICAST_DELEGATE_TwoParams(FOnSwitchToFileView, const FString&, int32);
 DECLARE_MULTICAST_DELEGATE(FOnLoadAssetRegistryFinished);
+DECLARE_MULTICAST_DELEGATE_OneParam(FOnEstimateRecompression, const TArray<FPakFileEntryPtr>&);
 
 class FWidgetDelegates
 {
@@ -12,4 +15,5 @@ public:
 	static FOnSwitchToTreeView& GetOnSwitchToTreeViewDelegate();
 	static FOnSwitchToFileView& GetOnSwitchToFileViewDelegate();
 	static FOnLoadAssetRegistryFinished& GetOnLoadAssetRegistryFinishedDelegate();
+	static FOnEstimateRecompression& GetOnEstimateRecompressionDelegate();
 };
\ No newline at end of file
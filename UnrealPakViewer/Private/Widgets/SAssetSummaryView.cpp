@@ -12,6 +12,7 @@
 #include "Widgets/Views/STableRow.h"
 #include "Widgets/Views/STableViewBase.h"
 
+#include "PakAnalyzerModule.h"
 #include "SKeyValueRow.h"
 
 #include "UnrealPakViewerStyle.h"
@@ -21,60 +22,62 @@
 #define DEFINE_GET_MEMBER_FUNCTION_NUMBER(MemberName) \
 	FORCEINLINE FText SAssetSummaryView::Get##MemberName() const \
 	{ \
-		return ViewingPackage.IsValid() ? FText::AsNumber(ViewingPackage->AssetSummary->PackageSummary.MemberName) : FText(); \
+		return ViewingSummary.IsValid() ? FText::AsNumber(ViewingSummary->PackageSummary.MemberName) : FText(); \
 	}
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 // SImportObjectRow
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 
-class SImportObjectRow : public SMultiColumnTableRow<FObjectImportPtrType>
+class SImportObjectRow : public SMultiColumnTableRow<FSummaryRowPtr>
 {
 	SLATE_BEGIN_ARGS(SImportObjectRow) {}
 	SLATE_END_ARGS()
 
 public:
-	void Construct(const FArguments& InArgs, FObjectImportPtrType InObject, const TSharedRef<STableViewBase>& InOwnerTableView)
+	void Construct(const FArguments& InArgs, FSummaryRowPtr InRow, FAssetSummaryPtr InSummary, const TSharedRef<STableViewBase>& InOwnerTableView)
 	{
-		if (!InObject.IsValid())
+		if (!InRow.IsValid() || !InSummary.IsValid())
 		{
 			return;
 		}
 
-		WeakObject = MoveTemp(InObject);
+		Index = *InRow;
+		WeakSummary = MoveTemp(InSummary);
 
-		SMultiColumnTableRow<FObjectImportPtrType>::Construct(FSuperRowType::FArguments().Padding(FMargin(0.f, 2.f)), InOwnerTableView);
+		SMultiColumnTableRow<FSummaryRowPtr>::Construct(FSuperRowType::FArguments().Padding(FMargin(0.f, 2.f)), InOwnerTableView);
 	}
 
 	virtual TSharedRef<SWidget> GenerateWidgetForColumn(const FName& ColumnName) override
 	{
 		static const float LeftMargin = 4.f;
 
-		FObjectImportPtrType Object = WeakObject.Pin();
-		if (!Object.IsValid())
+		FAssetSummaryPtr Summary = WeakSummary.Pin();
+		if (!Summary.IsValid() || !Summary->ObjectImports.IsValidIndex(Index))
 		{
 			return SNew(STextBlock).Text(LOCTEXT("NullColumn", "Null")).Margin(FMargin(LeftMargin, 0.f, 0.f, 0.f));
 		}
 
+		const FObjectImportEx& Object = Summary->ObjectImports[Index];
 		if (ColumnName == "Index")
 		{
-			return SNew(STextBlock).Text(FText::AsNumber(Object->Index));
+			return SNew(STextBlock).Text(FText::AsNumber(Index));
 		}
 		else if (ColumnName == "ClassPackage")
 		{
-			return SNew(STextBlock).Text(FText::FromName(Object->ClassPackage)).ToolTipText(FText::FromName(Object->ClassPackage)).Margin(FMargin(LeftMargin, 0.f, 0.f, 0.f));
+			return SNew(STextBlock).Text(FText::FromName(Object.ClassPackage)).ToolTipText(FText::FromName(Object.ClassPackage)).Margin(FMargin(LeftMargin, 0.f, 0.f, 0.f));
 		}
 		else if (ColumnName == "ClassName")
 		{
-			return SNew(STextBlock).Text(FText::FromName(Object->ClassName)).ToolTipText(FText::FromName(Object->ClassName)).Margin(FMargin(LeftMargin, 0.f, 0.f, 0.f));
+			return SNew(STextBlock).Text(FText::FromName(Object.ClassName)).ToolTipText(FText::FromName(Object.ClassName)).Margin(FMargin(LeftMargin, 0.f, 0.f, 0.f));
 		}
 		else if (ColumnName == "ObjectName")
 		{
-			return SNew(STextBlock).Text(FText::FromName(Object->ObjectName)).ToolTipText(FText::FromName(Object->ObjectName)).Margin(FMargin(LeftMargin, 0.f, 0.f, 0.f));
+			return SNew(STextBlock).Text(FText::FromName(Object.ObjectName)).ToolTipText(FText::FromName(Object.ObjectName)).Margin(FMargin(LeftMargin, 0.f, 0.f, 0.f));
 		}
 		else if (ColumnName == "FullPath")
 		{
-			return SNew(STextBlock).Text(FText::FromName(Object->ObjectPath)).ToolTipText(FText::FromName(Object->ObjectPath)).Margin(FMargin(LeftMargin, 0.f, 0.f, 0.f));
+			return SNew(STextBlock).Text(FText::FromName(Object.ObjectPath)).ToolTipText(FText::FromName(Object.ObjectPath)).Margin(FMargin(LeftMargin, 0.f, 0.f, 0.f));
 		}
 		else
 		{
@@ -83,87 +86,90 @@ public:
 	}
 
 protected:
-	TWeakPtr<FObjectImportEx> WeakObject;
+	int32 Index = INDEX_NONE;
+	TWeakPtr<FAssetSummary> WeakSummary;
 };
 
-class SExportObjectRow : public SMultiColumnTableRow<FObjectExportPtrType>
+class SExportObjectRow : public SMultiColumnTableRow<FSummaryRowPtr>
 {
 	SLATE_BEGIN_ARGS(SExportObjectRow) {}
 	SLATE_END_ARGS()
 
 public:
-	void Construct(const FArguments& InArgs, FObjectExportPtrType InObject, const TSharedRef<STableViewBase>& InOwnerTableView)
+	void Construct(const FArguments& InArgs, FSummaryRowPtr InRow, FAssetSummaryPtr InSummary, const TSharedRef<STableViewBase>& InOwnerTableView)
 	{
-		if (!InObject.IsValid())
+		if (!InRow.IsValid() || !InSummary.IsValid() || !InSummary->ObjectExports.IsValidIndex(*InRow))
 		{
 			return;
 		}
 
-		for (FPackageInfoPtr Dependency : InObject->DependencyList)
+		Index = *InRow;
+		for (const FPackageInfo& Dependency : InSummary->GetExportDependencies(Index))
 		{
-			Dependencies.Add(MakeShared<FName>(*FString::Printf(TEXT("%s: %s"), *Dependency->ExtraInfo.ToString(), *Dependency->PackageName.ToString())));
+			Dependencies.Add(MakeShared<FName>(*FString::Printf(TEXT("%s: %s"), *Dependency.ExtraInfo.ToString(), *Dependency.PackageName.ToString())));
 		}
 
-		WeakObject = MoveTemp(InObject);
+		WeakSummary = MoveTemp(InSummary);
 
-		SMultiColumnTableRow<FObjectExportPtrType>::Construct(FSuperRowType::FArguments().Padding(FMargin(0.f, 2.f)), InOwnerTableView);
+		SMultiColumnTableRow<FSummaryRowPtr>::Construct(FSuperRowType::FArguments().Padding(FMargin(0.f, 2.f)), InOwnerTableView);
 	}
 
 	virtual TSharedRef<SWidget> GenerateWidgetForColumn(const FName& ColumnName) override
 	{
 		static const float LeftMargin = 4.f;
 
-		FObjectExportPtrType Object = WeakObject.Pin();
-		if (!Object.IsValid())
+		FAssetSummaryPtr Summary = WeakSummary.Pin();
+		if (!Summary.IsValid() || !Summary->ObjectExports.IsValidIndex(Index))
 		{
 			return SNew(STextBlock).Text(LOCTEXT("NullColumn", "Null")).Margin(FMargin(LeftMargin, 0.f, 0.f, 0.f));
 		}
 
+		const FObjectExportTable& Exports = Summary->ObjectExports;
 		TSharedRef<SWidget> RowContent = SNullWidget::NullWidget;
 
 		if (ColumnName == "Index")
 		{
-			RowContent = SNew(STextBlock).Text(FText::AsNumber(Object->Index));
+			RowContent = SNew(STextBlock).Text(FText::AsNumber(Index));
 		}
 		else if (ColumnName == "ObjectName")
 		{
-			RowContent = SNew(STextBlock).Text(FText::FromName(Object->ObjectName)).ToolTipText(FText::FromName(Object->ObjectName)).Margin(FMargin(LeftMargin, 0.f, 0.f, 0.f));
+			RowContent = SNew(STextBlock).Text(FText::FromName(Exports.ObjectNames[Index])).ToolTipText(FText::FromName(Exports.ObjectNames[Index])).Margin(FMargin(LeftMargin, 0.f, 0.f, 0.f));
 		}
 		else if (ColumnName == "SerialSize")
 		{
-			RowContent = SNew(STextBlock).Text(FText::AsMemory(Object->SerialSize, EMemoryUnitStandard::IEC)).ToolTipText(FText::AsNumber(Object->SerialSize)).Justification(ETextJustify::Center);
+			RowContent = SNew(STextBlock).Text(FText::AsMemory(Exports.SerialSizes[Index], EMemoryUnitStandard::IEC)).ToolTipText(FText::AsNumber(Exports.SerialSizes[Index])).Justification(ETextJustify::Center);
 		}
 		else if (ColumnName == "SerialOffset")
 		{
-			RowContent = SNew(STextBlock).Text(FText::AsNumber(Object->SerialOffset)).Justification(ETextJustify::Center);
+			RowContent = SNew(STextBlock).Text(FText::AsNumber(Exports.SerialOffsets[Index])).Justification(ETextJustify::Center);
 		}
 		else if (ColumnName == "bIsAsset")
 		{
-			RowContent = SNew(STextBlock).Text(FText::FromString(Object->bIsAsset ? TEXT("true") : TEXT("false"))).Justification(ETextJustify::Center);
+			RowContent = SNew(STextBlock).Text(FText::FromString(Exports.HasFlag(Index, EObjectExportFlags::IsAsset) ? TEXT("true") : TEXT("false"))).Justification(ETextJustify::Center);
 		}
 		else if (ColumnName == "bNotForClient")
 		{
-			RowContent = SNew(STextBlock).Text(FText::FromString(Object->bNotForClient ? TEXT("true") : TEXT("false"))).Justification(ETextJustify::Center);
+			RowContent = SNew(STextBlock).Text(FText::FromString(Exports.HasFlag(Index, EObjectExportFlags::NotForClient) ? TEXT("true") : TEXT("false"))).Justification(ETextJustify::Center);
 		}
 		else if (ColumnName == "bNotForServer")
 		{
-			RowContent = SNew(STextBlock).Text(FText::FromString(Object->bNotForServer ? TEXT("true") : TEXT("false"))).Justification(ETextJustify::Center);
+			RowContent = SNew(STextBlock).Text(FText::FromString(Exports.HasFlag(Index, EObjectExportFlags::NotForServer) ? TEXT("true") : TEXT("false"))).Justification(ETextJustify::Center);
 		}
 		else if (ColumnName == "ClassIndex")
 		{
-			RowContent = SNew(STextBlock).Text(FText::FromName(Object->ClassName)).ToolTipText(FText::FromName(Object->ClassName)).Margin(FMargin(LeftMargin, 0.f, 0.f, 0.f));
+			RowContent = SNew(STextBlock).Text(FText::FromName(Exports.ClassNames[Index])).ToolTipText(FText::FromName(Exports.ClassNames[Index])).Margin(FMargin(LeftMargin, 0.f, 0.f, 0.f));
 		}
 		else if (ColumnName == "SuperIndex")
 		{
-			RowContent = SNew(STextBlock).Text(FText::FromName(Object->Super)).ToolTipText(FText::FromName(Object->Super)).Justification(ETextJustify::Right).Margin(FMargin(LeftMargin, 0.f, 0.f, 0.f));
+			RowContent = SNew(STextBlock).Text(FText::FromName(Exports.Supers[Index])).ToolTipText(FText::FromName(Exports.Supers[Index])).Justification(ETextJustify::Right).Margin(FMargin(LeftMargin, 0.f, 0.f, 0.f));
 		}
 		else if (ColumnName == "TemplateIndex")
 		{
-			RowContent = SNew(STextBlock).Text(FText::FromName(Object->TemplateObject)).ToolTipText(FText::FromName(Object->TemplateObject)).Margin(FMargin(LeftMargin, 0.f, 0.f, 0.f));
+			RowContent = SNew(STextBlock).Text(FText::FromName(Exports.TemplateObjects[Index])).ToolTipText(FText::FromName(Exports.TemplateObjects[Index])).Margin(FMargin(LeftMargin, 0.f, 0.f, 0.f));
 		}
 		else if (ColumnName == "FullPath")
 		{
-			RowContent = SNew(STextBlock).Text(FText::FromName(Object->ObjectPath)).ToolTipText(FText::FromName(Object->ObjectPath)).Margin(FMargin(LeftMargin, 0.f, 0.f, 0.f));
+			RowContent = SNew(STextBlock).Text(FText::FromName(Exports.ObjectPaths[Index])).ToolTipText(FText::FromName(Exports.ObjectPaths[Index])).Margin(FMargin(LeftMargin, 0.f, 0.f, 0.f));
 		}
 		else if (ColumnName == "Dependencies")
 		{
@@ -191,7 +197,8 @@ public:
 	}
 
 protected:
-	TWeakPtr<FObjectExportEx> WeakObject;
+	int32 Index = INDEX_NONE;
+	TWeakPtr<FAssetSummary> WeakSummary;
 
 	TArray<TSharedPtr<FName>> Dependencies;
 };
@@ -367,7 +374,7 @@ void SAssetSummaryView::Construct(const FArguments& InArgs)
 			]
 			.BodyContent()
 			[
-				SAssignNew(ImportObjectListView, SListView<FObjectImportPtrType>)
+				SAssignNew(ImportObjectListView, SListView<FSummaryRowPtr>)
 				.ItemHeight(25.f)
 				.SelectionMode(ESelectionMode::Multi)
 				.ListItemsSource(&ImportObjects)
@@ -413,7 +420,7 @@ void SAssetSummaryView::Construct(const FArguments& InArgs)
 			]
 			.BodyContent()
 			[
-				SAssignNew(ExportObjectListView, SListView<FObjectExportPtrType>)
+				SAssignNew(ExportObjectListView, SListView<FSummaryRowPtr>)
 				.ItemHeight(25.f)
 				.SelectionMode(ESelectionMode::Multi)
 				.ListItemsSource(&ExportObjects)
@@ -443,15 +450,21 @@ void SAssetSummaryView::Construct(const FArguments& InArgs)
 					[
 						SNew(SKeyValueRow).KeyText(LOCTEXT("Tree_View_Summary_Count", "Count:")).ValueText(this, &SAssetSummaryView::GetDependencyCount)
 					]
+
+					+ SHorizontalBox::Slot()
+					.FillWidth(1.f)
+					[
+						SNew(SKeyValueRow).KeyText(LOCTEXT("Tree_View_Summary_Closure", "Closure:")).KeyToolTipText(LOCTEXT("Tree_View_Summary_DependencyClosureTip", "All packages this package pulls in, itself included, and their compressed size")).ValueText(this, &SAssetSummaryView::GetDependencyClosure)
+					]
 				]
 			]
 			.BodyContent()
 			[
-				SAssignNew(DependencyListView, SListView<FPackageInfoPtr>)
+				SAssignNew(DependencyListView, SListView<FSummaryRowPtr>)
 				.ItemHeight(25.f)
 				.SelectionMode(ESelectionMode::Multi)
 				.ListItemsSource(&DependencyList)
-				.OnGenerateRow(this, &SAssetSummaryView::OnGenerateDependsRow)
+				.OnGenerateRow(this, &SAssetSummaryView::OnGenerateDependencyRow)
 				.HeaderRow
 				(
 					SNew(SHeaderRow).Visibility(EVisibility::Visible)
@@ -481,15 +494,21 @@ void SAssetSummaryView::Construct(const FArguments& InArgs)
 					[
 						SNew(SKeyValueRow).KeyText(LOCTEXT("Tree_View_Summary_Count", "Count:")).ValueText(this, &SAssetSummaryView::GetDependentCount)
 					]
+
+					+ SHorizontalBox::Slot()
+					.FillWidth(1.f)
+					[
+						SNew(SKeyValueRow).KeyText(LOCTEXT("Tree_View_Summary_Closure", "Closure:")).KeyToolTipText(LOCTEXT("Tree_View_Summary_DependentClosureTip", "All packages invalidated when this package changes, itself included, and their compressed size")).ValueText(this, &SAssetSummaryView::GetDependentClosure)
+					]
 				]
 			]
 			.BodyContent()
 			[
-				SAssignNew(DependentListView, SListView<FPackageInfoPtr>)
+				SAssignNew(DependentListView, SListView<FSummaryRowPtr>)
 				.ItemHeight(25.f)
 				.SelectionMode(ESelectionMode::Multi)
 				.ListItemsSource(&DependentList)
-				.OnGenerateRow(this, &SAssetSummaryView::OnGenerateDependsRow)
+				.OnGenerateRow(this, &SAssetSummaryView::OnGenerateDependentRow)
 				.HeaderRow
 				(
 					SNew(SHeaderRow).Visibility(EVisibility::Visible)
@@ -529,7 +548,7 @@ void SAssetSummaryView::Construct(const FArguments& InArgs)
 			]
 			.BodyContent()
 			[
-				SAssignNew(NamesListView, SListView<FNamePtrType>)
+				SAssignNew(NamesListView, SListView<FSummaryRowPtr>)
 				.ItemHeight(25.f)
 				.SelectionMode(ESelectionMode::Multi)
 				.ListItemsSource(&PackageNames)
@@ -569,23 +588,53 @@ void SAssetSummaryView::Construct(const FArguments& InArgs)
 void SAssetSummaryView::SetViewingPackage(FPakFileEntryPtr InPackage)
 {
 	ViewingPackage = InPackage;
+	ViewingSummary = InPackage->AssetSummary;
 
-	PackageNames = InPackage->AssetSummary->Names;
-	ImportObjects = InPackage->AssetSummary->ObjectImports;
-	ExportObjects = InPackage->AssetSummary->ObjectExports;
-	//PreloadDependency = InPackage->AssetSummary->PreloadDependency;
-	DependencyList = InPackage->AssetSummary->DependencyList;
-	DependentList = InPackage->AssetSummary->DependentList;
+	const FAssetSummary& Summary = *ViewingSummary;
+	const int32 MaxRowCount = FMath::Max(FMath::Max3(Summary.Names.Num(), Summary.ObjectImports.Num(), Summary.ObjectExports.Num()), FMath::Max(Summary.GetDependencyCount(), Summary.GetDependentCount()));
+	if (!RowIndices.IsValid() || RowIndices->Num() < MaxRowCount)
+	{
+		// Rows of the previous package may still reference the old sequence, so allocate a new one
+		RowIndices = MakeShared<TArray<int32>>();
+		RowIndices->SetNumUninitialized(MaxRowCount);
+		for (int32 i = 0; i < MaxRowCount; ++i)
+		{
+			(*RowIndices)[i] = i;
+		}
+	}
 
-	TotalExportSize = 0;
-	for (FObjectExportPtrType ExportObject : ExportObjects)
+	FillRows(PackageNames, Summary.Names.Num());
+	FillRows(ImportObjects, Summary.ObjectImports.Num());
+	FillRows(ExportObjects, Summary.ObjectExports.Num());
+	FillRows(DependencyList, Summary.GetDependencyCount());
+	FillRows(DependentList, Summary.GetDependentCount());
+
+	DependencyClosure = FText();
+	DependentClosure = FText();
+
+	IPakAnalyzer* PakAnalyzer = IPakAnalyzerModule::Get().GetPakAnalyzer();
+	if (PakAnalyzer && !InPackage->PackagePath.IsNone())
 	{
-		if (ExportObject.IsValid())
+		const FText ClosureFormat = LOCTEXT("Tree_View_Summary_ClosureFormat", "{0} packages, {1}");
+
+		FDependencyClosure Closure;
+		if (PakAnalyzer->GetDependencyClosure({ InPackage->PackagePath }, false, Closure))
+		{
+			DependencyClosure = FText::Format(ClosureFormat, FText::AsNumber(Closure.Packages.Num()), FText::AsMemory(Closure.CompressedSize, EMemoryUnitStandard::IEC));
+		}
+
+		if (PakAnalyzer->GetDependencyClosure({ InPackage->PackagePath }, true, Closure))
 		{
-			TotalExportSize += ExportObject->SerialSize;
+			DependentClosure = FText::Format(ClosureFormat, FText::AsNumber(Closure.Packages.Num()), FText::AsMemory(Closure.CompressedSize, EMemoryUnitStandard::IEC));
 		}
 	}
 
+	TotalExportSize = 0;
+	for (uint64 SerialSize : Summary.ObjectExports.SerialSizes)
+	{
+		TotalExportSize += SerialSize;
+	}
+
 	OnSortExportObjects();
 
 	NamesListView->RebuildList();
@@ -596,29 +645,50 @@ void SAssetSummaryView::SetViewingPackage(FPakFileEntryPtr InPackage)
 	DependentListView->RebuildList();
 }
 
-TSharedRef<ITableRow> SAssetSummaryView::OnGenerateNameRow(FNamePtrType InName, const TSharedRef<class STableViewBase>& OwnerTable)
+void SAssetSummaryView::FillRows(TArray<FSummaryRowPtr>& OutRows, int32 InCount)
 {
-	return SNew(STableRow<FNamePtrType>, OwnerTable).Padding(FMargin(0.f, 2.f))
+	OutRows.Reset(InCount);
+	for (int32 i = 0; i < InCount; ++i)
+	{
+		OutRows.Emplace(RowIndices, RowIndices->GetData() + i);
+	}
+}
+
+TSharedRef<ITableRow> SAssetSummaryView::OnGenerateNameRow(FSummaryRowPtr InRow, const TSharedRef<class STableViewBase>& OwnerTable)
+{
+	const FName Name = ViewingSummary.IsValid() && ViewingSummary->Names.IsValidIndex(*InRow) ? ViewingSummary->Names[*InRow] : NAME_None;
+
+	return SNew(STableRow<FSummaryRowPtr>, OwnerTable).Padding(FMargin(0.f, 2.f))
 		[
-			SNew(STextBlock).Text(FText::FromName(*InName))
+			SNew(STextBlock).Text(FText::FromName(Name))
 		];
 }
 
-TSharedRef<ITableRow> SAssetSummaryView::OnGenerateImportObjectRow(FObjectImportPtrType InObject, const TSharedRef<class STableViewBase>& OwnerTable)
+TSharedRef<ITableRow> SAssetSummaryView::OnGenerateImportObjectRow(FSummaryRowPtr InRow, const TSharedRef<class STableViewBase>& OwnerTable)
+{
+	return SNew(SImportObjectRow, InRow, ViewingSummary, OwnerTable);
+}
+
+TSharedRef<ITableRow> SAssetSummaryView::OnGenerateExportObjectRow(FSummaryRowPtr InRow, const TSharedRef<class STableViewBase>& OwnerTable)
+{
+	return SNew(SExportObjectRow, InRow, ViewingSummary, OwnerTable);
+}
+
+TSharedRef<ITableRow> SAssetSummaryView::OnGenerateDependencyRow(FSummaryRowPtr InRow, const TSharedRef<class STableViewBase>& OwnerTable)
 {
-	return SNew(SImportObjectRow, InObject, OwnerTable);
+	return GenerateDependsRow(ViewingSummary->GetDependencies()[*InRow], OwnerTable);
 }
 
-TSharedRef<ITableRow> SAssetSummaryView::OnGenerateExportObjectRow(FObjectExportPtrType InObject, const TSharedRef<class STableViewBase>& OwnerTable)
+TSharedRef<ITableRow> SAssetSummaryView::OnGenerateDependentRow(FSummaryRowPtr InRow, const TSharedRef<class STableViewBase>& OwnerTable)
 {
-	return SNew(SExportObjectRow, InObject, OwnerTable);
+	return GenerateDependsRow(ViewingSummary->GetDependents()[*InRow], OwnerTable);
 }
 
-TSharedRef<ITableRow> SAssetSummaryView::OnGenerateDependsRow(FPackageInfoPtr InDepends, const TSharedRef<class STableViewBase>& OwnerTable)
+TSharedRef<ITableRow> SAssetSummaryView::GenerateDependsRow(const FPackageInfo& InDepends, const TSharedRef<class STableViewBase>& OwnerTable)
 {
-	return SNew(STableRow<FPackageInfoPtr>, OwnerTable).Padding(FMargin(0.f, 2.f))
+	return SNew(STableRow<FSummaryRowPtr>, OwnerTable).Padding(FMargin(0.f, 2.f))
 		[
-			SNew(STextBlock).Text(FText::FromName(InDepends->PackageName)).ToolTipText(FText::FromName(InDepends->PackageName))
+			SNew(STextBlock).Text(FText::FromName(InDepends.PackageName)).ToolTipText(FText::FromName(InDepends.PackageName))
 		];
 }
 
@@ -684,61 +754,46 @@ void SAssetSummaryView::OnSortExportObjects()
 		return;
 	}
 
-	if (LastSortColumn == "SerialSize")
+	if (LastSortColumn != "SerialSize" && LastSortColumn != "SerialOffset")
 	{
-		ExportObjects.Sort([this](const FObjectExportPtrType& Lhs, const FObjectExportPtrType& Rhs) -> bool
-		{
-			if (LastSortMode == EColumnSortMode::Ascending)
-			{
-				return Lhs->SerialSize < Rhs->SerialSize;
-			}
-			else
-			{
-				return Lhs->SerialSize > Rhs->SerialSize;
-			}
-		});
+		return;
 	}
-	else if (LastSortColumn == "SerialOffset")
+
+	const FObjectExportTable& Exports = ViewingSummary->ObjectExports;
+	const TArray<uint64>& SortKeys = LastSortColumn == "SerialSize" ? Exports.SerialSizes : Exports.SerialOffsets;
+
+	const bool bAscending = LastSortMode == EColumnSortMode::Ascending;
+	ExportObjects.Sort([&SortKeys, bAscending](const FSummaryRowPtr& Lhs, const FSummaryRowPtr& Rhs) -> bool
 	{
-		ExportObjects.Sort([this](const FObjectExportPtrType& Lhs, const FObjectExportPtrType& Rhs) -> bool
-		{
-			if (LastSortMode == EColumnSortMode::Ascending)
-			{
-				return Lhs->SerialOffset < Rhs->SerialOffset;
-			}
-			else
-			{
-				return Lhs->SerialOffset > Rhs->SerialOffset;
-			}
-		});
-	}
+		return bAscending ? SortKeys[*Lhs] < SortKeys[*Rhs] : SortKeys[*Lhs] > SortKeys[*Rhs];
+	});
 }
 
 FORCEINLINE FText SAssetSummaryView::GetGuid() const
 {
 PRAGMA_DISABLE_DEPRECATION_WARNINGS
-	return ViewingPackage.IsValid() ? FText::FromString(ViewingPackage->AssetSummary->PackageSummary.Guid.ToString()) : FText();
+	return ViewingSummary.IsValid() ? FText::FromString(ViewingSummary->PackageSummary.Guid.ToString()) : FText();
 PRAGMA_ENABLE_DEPRECATION_WARNINGS
 }
 
 FORCEINLINE FText SAssetSummaryView::GetIsUnversioned() const
 {
-	return ViewingPackage.IsValid() ? FText::FromString(ViewingPackage->AssetSummary->PackageSummary.bUnversioned ? TEXT("true") : TEXT("false")) : FText();
+	return ViewingSummary.IsValid() ? FText::FromString(ViewingSummary->PackageSummary.bUnversioned ? TEXT("true") : TEXT("false")) : FText();
 }
 
 FORCEINLINE FText SAssetSummaryView::GetFileVersionUE4() const
 {
 #if ENGINE_MAJOR_VERSION >= 5
-	return ViewingPackage.IsValid() ? FText::AsNumber(ViewingPackage->AssetSummary->PackageSummary.GetFileVersionUE().FileVersionUE4) : FText();
+	return ViewingSummary.IsValid() ? FText::AsNumber(ViewingSummary->PackageSummary.GetFileVersionUE().FileVersionUE4) : FText();
 #else
-	return ViewingPackage.IsValid() ? FText::AsNumber(ViewingPackage->AssetSummary->PackageSummary.GetFileVersionUE4()) : FText();
+	return ViewingSummary.IsValid() ? FText::AsNumber(ViewingSummary->PackageSummary.GetFileVersionUE4()) : FText();
 #endif
 }
 
 FORCEINLINE FText SAssetSummaryView::GetFileVersionUE5() const
 {
 #if ENGINE_MAJOR_VERSION >= 5
-	return ViewingPackage.IsValid() ? FText::AsNumber(ViewingPackage->AssetSummary->PackageSummary.GetFileVersionUE().FileVersionUE5) : FText();
+	return ViewingSummary.IsValid() ? FText::AsNumber(ViewingSummary->PackageSummary.GetFileVersionUE().FileVersionUE5) : FText();
 #else
 	return FText();
 #endif
@@ -747,18 +802,18 @@ FORCEINLINE FText SAssetSummaryView::GetFileVersionUE5() const
 FORCEINLINE FText SAssetSummaryView::GetFileVersionLicenseeUE() const
 {
 #if ENGINE_MAJOR_VERSION >= 5
-	return ViewingPackage.IsValid() ? FText::AsNumber(ViewingPackage->AssetSummary->PackageSummary.GetFileVersionLicenseeUE()) : FText();
+	return ViewingSummary.IsValid() ? FText::AsNumber(ViewingSummary->PackageSummary.GetFileVersionLicenseeUE()) : FText();
 #else
-	return ViewingPackage.IsValid() ? FText::AsNumber(ViewingPackage->AssetSummary->PackageSummary.GetFileVersionLicenseeUE4()) : FText();
+	return ViewingSummary.IsValid() ? FText::AsNumber(ViewingSummary->PackageSummary.GetFileVersionLicenseeUE4()) : FText();
 #endif
 }
 
 FORCEINLINE FText SAssetSummaryView::GetPackageFlags() const
 {
 #if ENGINE_MAJOR_VERSION >= 5
-	return ViewingPackage.IsValid() ? FText::FromString(FString::Printf(TEXT("0x%X"), ViewingPackage->AssetSummary->PackageSummary.GetPackageFlags())) : FText();
+	return ViewingSummary.IsValid() ? FText::FromString(FString::Printf(TEXT("0x%X"), ViewingSummary->PackageSummary.GetPackageFlags())) : FText();
 #else
-	return ViewingPackage.IsValid() ? FText::FromString(FString::Printf(TEXT("0x%X"), ViewingPackage->AssetSummary->PackageSummary.PackageFlags)) : FText();
+	return ViewingSummary.IsValid() ? FText::FromString(FString::Printf(TEXT("0x%X"), ViewingSummary->PackageSummary.PackageFlags)) : FText();
 #endif
 }
 
@@ -774,12 +829,22 @@ FORCEINLINE FText SAssetSummaryView::GetExportSizeTooltip() const
 
 FORCEINLINE FText SAssetSummaryView::GetDependencyCount() const
 {
-	return ViewingPackage.IsValid() ? FText::AsNumber(ViewingPackage->AssetSummary->DependencyList.Num()) : FText();
+	return ViewingSummary.IsValid() ? FText::AsNumber(ViewingSummary->GetDependencyCount()) : FText();
 }
 
 FORCEINLINE FText SAssetSummaryView::GetDependentCount() const
 {
-	return ViewingPackage.IsValid() ? FText::AsNumber(ViewingPackage->AssetSummary->DependentList.Num()) : FText();
+	return ViewingSummary.IsValid() ? FText::AsNumber(ViewingSummary->GetDependentCount()) : FText();
+}
+
+FORCEINLINE FText SAssetSummaryView::GetDependencyClosure() const
+{
+	return DependencyClosure;
+}
+
+FORCEINLINE FText SAssetSummaryView::GetDependentClosure() const
+{
+	return DependentClosure;
 }
 
 DEFINE_GET_MEMBER_FUNCTION_NUMBER(TotalHeaderSize)
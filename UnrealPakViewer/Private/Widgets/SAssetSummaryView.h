@@ -10,6 +10,9 @@
 
 class SHeaderRow;
 
+/** Rows of the summary lists are indices into the flat arrays of the viewing summary. */
+typedef TSharedPtr<const int32> FSummaryRowPtr;
+
 /** Implements the Pak Info window. */
 class SAssetSummaryView : public SCompoundWidget
 {
@@ -58,11 +61,17 @@ protected:
 	DECLARE_GET_MEMBER_FUNCTION(PreloadDependencyOffset);
 	DECLARE_GET_MEMBER_FUNCTION(DependencyCount);
 	DECLARE_GET_MEMBER_FUNCTION(DependentCount);
+	DECLARE_GET_MEMBER_FUNCTION(DependencyClosure);
+	DECLARE_GET_MEMBER_FUNCTION(DependentClosure);
+
+	TSharedRef<ITableRow> OnGenerateNameRow(FSummaryRowPtr InRow, const TSharedRef<class STableViewBase>& OwnerTable);
+	TSharedRef<ITableRow> OnGenerateImportObjectRow(FSummaryRowPtr InRow, const TSharedRef<class STableViewBase>& OwnerTable);
+	TSharedRef<ITableRow> OnGenerateExportObjectRow(FSummaryRowPtr InRow, const TSharedRef<class STableViewBase>& OwnerTable);
+	TSharedRef<ITableRow> OnGenerateDependencyRow(FSummaryRowPtr InRow, const TSharedRef<class STableViewBase>& OwnerTable);
+	TSharedRef<ITableRow> OnGenerateDependentRow(FSummaryRowPtr InRow, const TSharedRef<class STableViewBase>& OwnerTable);
+	TSharedRef<ITableRow> GenerateDependsRow(const FPackageInfo& InDepends, const TSharedRef<class STableViewBase>& OwnerTable);
 
-	TSharedRef<ITableRow> OnGenerateNameRow(FNamePtrType InName, const TSharedRef<class STableViewBase>& OwnerTable);
-	TSharedRef<ITableRow> OnGenerateImportObjectRow(FObjectImportPtrType InObject, const TSharedRef<class STableViewBase>& OwnerTable);
-	TSharedRef<ITableRow> OnGenerateExportObjectRow(FObjectExportPtrType InObject, const TSharedRef<class STableViewBase>& OwnerTable);
-	TSharedRef<ITableRow> OnGenerateDependsRow(FPackageInfoPtr InDepends, const TSharedRef<class STableViewBase>& OwnerTable);
+	void FillRows(TArray<FSummaryRowPtr>& OutRows, int32 InCount);
 
 	void InsertColumn(TSharedPtr<SHeaderRow> InHeader, FName InId, const FString& InCloumnName = TEXT(""));
 	void InsertSortableColumn(TSharedPtr<SHeaderRow> InHeader, FName InId, const FString& InCloumnName = TEXT(""));
@@ -72,17 +81,21 @@ protected:
 
 protected:
 	FPakFileEntryPtr ViewingPackage;
+	FAssetSummaryPtr ViewingSummary;
 
-	TSharedPtr<SListView<FNamePtrType>> NamesListView;
-	TArray<FNamePtrType> PackageNames;
+	/** Shared 0..N-1 sequence, row items alias into it instead of allocating one by one. */
+	TSharedPtr<TArray<int32>> RowIndices;
+
+	TSharedPtr<SListView<FSummaryRowPtr>> NamesListView;
+	TArray<FSummaryRowPtr> PackageNames;
 
 	TSharedPtr<SHeaderRow> ImportObjectHeaderRow;
-	TSharedPtr<SListView<FObjectImportPtrType>> ImportObjectListView;
-	TArray<FObjectImportPtrType> ImportObjects;
+	TSharedPtr<SListView<FSummaryRowPtr>> ImportObjectListView;
+	TArray<FSummaryRowPtr> ImportObjects;
 
 	TSharedPtr<SHeaderRow> ExportObjectHeaderRow;
-	TSharedPtr<SListView<FObjectExportPtrType>> ExportObjectListView;
-	TArray<FObjectExportPtrType> ExportObjects;
+	TSharedPtr<SListView<FSummaryRowPtr>> ExportObjectListView;
+	TArray<FSummaryRowPtr> ExportObjects;
 	int64 TotalExportSize;
 	
 	FName LastSortColumn = "SerialOffset";
@@ -91,8 +104,11 @@ protected:
 	//TSharedPtr<SListView<FPackageIndexPtrType>> PreloadDependencyListView;
 	//TArray<FPackageIndexPtrType> PreloadDependency;
 
-	TSharedPtr<SListView<FPackageInfoPtr>> DependencyListView;
-	TSharedPtr<SListView<FPackageInfoPtr>> DependentListView;
-	TArray<FPackageInfoPtr> DependencyList;
-	TArray<FPackageInfoPtr> DependentList;
+	TSharedPtr<SListView<FSummaryRowPtr>> DependencyListView;
+	TSharedPtr<SListView<FSummaryRowPtr>> DependentListView;
+	TArray<FSummaryRowPtr> DependencyList;
+	TArray<FSummaryRowPtr> DependentList;
+
+	FText DependencyClosure;
+	FText DependentClosure;
 };
@@ -16,13 +16,18 @@ SExtractProgressWindow::SExtractProgressWindow()
 	, TotalCount(0)
 	, ErrorCount(0)
 	, bExtractFinished(false)
+	, bExport(false)
 {
-	FPakAnalyzerDelegates::OnUpdateExtractProgress.BindRaw(this, &SExtractProgressWindow::OnUpdateExtractProgress);
+
 }
 
 SExtractProgressWindow::~SExtractProgressWindow()
 {
-
+	FPakAnalyzerDelegates::FOnUpdateExtractProgress& ProgressDelegate = bExport ? FPakAnalyzerDelegates::OnUpdateExportProgress : FPakAnalyzerDelegates::OnUpdateExtractProgress;
+	if (ProgressDelegate.IsBoundToObject(this))
+	{
+		ProgressDelegate.Unbind();
+	}
 }
 
 void SExtractProgressWindow::Construct(const FArguments& Args)
@@ -30,8 +35,18 @@ void SExtractProgressWindow::Construct(const FArguments& Args)
 	const float DPIScaleFactor = FPlatformApplicationMisc::GetDPIScaleFactorAtPoint(10.0f, 10.0f);
 	const FVector2D InitialWindowDimensions(600, 60);
 
+	bExport = Args._Export;
+	if (bExport)
+	{
+		FPakAnalyzerDelegates::OnUpdateExportProgress.BindRaw(this, &SExtractProgressWindow::OnUpdateExtractProgress);
+	}
+	else
+	{
+		FPakAnalyzerDelegates::OnUpdateExtractProgress.BindRaw(this, &SExtractProgressWindow::OnUpdateExtractProgress);
+	}
+
 	SWindow::Construct(SWindow::FArguments()
-		.Title(LOCTEXT("WindowTitle", "Extracting..."))
+		.Title(bExport ? LOCTEXT("ExportWindowTitle", "Exporting...") : LOCTEXT("WindowTitle", "Extracting..."))
 		.HasCloseButton(true)
 		.SupportsMaximize(false)
 		.SupportsMinimize(false)
@@ -55,7 +70,7 @@ void SExtractProgressWindow::Construct(const FArguments& Args)
 					.VAlign(EVerticalAlignment::VAlign_Center)
 					.Padding(FMargin(0.f, 0.f, 5.f, 0.f))
 					[
-						SNew(STextBlock).Text(LOCTEXT("ExtractText", "Extract progress:"))
+						SNew(STextBlock).Text(bExport ? LOCTEXT("ExportText", "Export progress:") : LOCTEXT("ExtractText", "Extract progress:"))
 					]
 
 					+ SHorizontalBox::Slot()
@@ -166,7 +181,14 @@ FORCEINLINE FText SExtractProgressWindow::GetTimeElapsed() const
 
 void SExtractProgressWindow::OnExit(const TSharedRef<SWindow>& InWindow)
 {
-	IPakAnalyzerModule::Get().GetPakAnalyzer()->CancelExtract();
+	if (bExport)
+	{
+		IPakAnalyzerModule::Get().GetPakAnalyzer()->CancelExport();
+	}
+	else
+	{
+		IPakAnalyzerModule::Get().GetPakAnalyzer()->CancelExtract();
+	}
 }
 
 void SExtractProgressWindow::OnUpdateExtractProgress(int32 InCompleteCount, int32 InErrorCount, int32 InTotalCount)
@@ -8,9 +8,12 @@ class SExtractProgressWindow : public SWindow
 {
 public:
 	SLATE_BEGIN_ARGS(SExtractProgressWindow)
+		: _Export(false)
 	{
 	}
 	SLATE_ATTRIBUTE(FDateTime, StartTime)
+	/** Follows a running export instead of an extract. */
+	SLATE_ARGUMENT(bool, Export)
 	SLATE_END_ARGS()
 
 	SExtractProgressWindow();
@@ -46,4 +49,5 @@ protected:
 	TAttribute<FDateTime> StartTime;
 	FDateTime LastTime;
 	bool bExtractFinished;
+	bool bExport;
 };
\ No newline at end of file
@@ -21,9 +21,17 @@
 #include "SExtractProgressWindow.h"
 #include "SKeyInputWindow.h"
 #include "SOptionsWindow.h"
+#include "SPakCycleView.h"
+#include "SPakDiffView.h"
+#include "SPakDuplicateView.h"
 #include "SPakFileView.h"
+#include "SPakLayoutView.h"
+#include "SPakLoadView.h"
+#include "SPakPerformanceView.h"
+#include "SPakRecompressionView.h"
 #include "SPakSummaryView.h"
 #include "SPakTreeView.h"
+#include "SPakUnreferencedView.h"
 #include "UnrealPakViewerStyle.h"
 #include "ViewModels/WidgetDelegates.h"
 
@@ -32,18 +40,29 @@
 static const FName SummaryViewTabId("UnrealPakViewerSummaryView");
 static const FName TreeViewTabId("UnrealPakViewerTreeView");
 static const FName FileViewTabId("UnrealPakViewerFileView");
+static const FName CycleViewTabId("UnrealPakViewerCycleView");
+static const FName UnreferencedViewTabId("UnrealPakViewerUnreferencedView");
+static const FName LoadViewTabId("UnrealPakViewerLoadView");
+static const FName DiffViewTabId("UnrealPakViewerDiffView");
+static const FName DuplicateViewTabId("UnrealPakViewerDuplicateView");
+static const FName RecompressionViewTabId("UnrealPakViewerRecompressionView");
+static const FName LayoutViewTabId("UnrealPakViewerLayoutView");
+static const FName PerformanceViewTabId("UnrealPakViewerPerformanceView");
 
 SMainWindow::SMainWindow()
 {
 	FWidgetDelegates::GetOnSwitchToFileViewDelegate().AddRaw(this, &SMainWindow::OnSwitchToFileView);
 	FWidgetDelegates::GetOnSwitchToTreeViewDelegate().AddRaw(this, &SMainWindow::OnSwitchToTreeView);
+	FWidgetDelegates::GetOnEstimateRecompressionDelegate().AddRaw(this, &SMainWindow::OnEstimateRecompression);
 	FPakAnalyzerDelegates::OnExtractStart.BindRaw(this, &SMainWindow::OnExtractStart);
+	FPakAnalyzerDelegates::OnExportStart.BindRaw(this, &SMainWindow::OnExportStart);
 }
 
 SMainWindow::~SMainWindow()
 {
 	FWidgetDelegates::GetOnSwitchToFileViewDelegate().RemoveAll(this);
 	FWidgetDelegates::GetOnSwitchToTreeViewDelegate().RemoveAll(this);
+	FWidgetDelegates::GetOnEstimateRecompressionDelegate().RemoveAll(this);
 }
 
 void SMainWindow::Construct(const FArguments& Args)
@@ -72,6 +91,46 @@ void SMainWindow::Construct(const FArguments& Args)
 		.SetIcon(FSlateIcon(FUnrealPakViewerStyle::GetStyleSetName(), "Tab.File"))
 		.SetGroup(AppMenuGroup);
 
+	TabManager->RegisterTabSpawner(CycleViewTabId, FOnSpawnTab::CreateRaw(this, &SMainWindow::OnSpawnTab_CycleView))
+		.SetDisplayName(LOCTEXT("CycleViewTabTitle", "Cycle View"))
+		.SetIcon(FSlateIcon(FUnrealPakViewerStyle::GetStyleSetName(), "Tab.Tree"))
+		.SetGroup(AppMenuGroup);
+
+	TabManager->RegisterTabSpawner(UnreferencedViewTabId, FOnSpawnTab::CreateRaw(this, &SMainWindow::OnSpawnTab_UnreferencedView))
+		.SetDisplayName(LOCTEXT("UnreferencedViewTabTitle", "Unreferenced View"))
+		.SetIcon(FSlateIcon(FUnrealPakViewerStyle::GetStyleSetName(), "Tab.File"))
+		.SetGroup(AppMenuGroup);
+
+	TabManager->RegisterTabSpawner(LoadViewTabId, FOnSpawnTab::CreateRaw(this, &SMainWindow::OnSpawnTab_LoadView))
+		.SetDisplayName(LOCTEXT("LoadViewTabTitle", "Load View"))
+		.SetIcon(FSlateIcon(FUnrealPakViewerStyle::GetStyleSetName(), "Tab.Summary"))
+		.SetGroup(AppMenuGroup);
+
+	TabManager->RegisterTabSpawner(DiffViewTabId, FOnSpawnTab::CreateRaw(this, &SMainWindow::OnSpawnTab_DiffView))
+		.SetDisplayName(LOCTEXT("DiffViewTabTitle", "Diff View"))
+		.SetIcon(FSlateIcon(FUnrealPakViewerStyle::GetStyleSetName(), "Tab.File"))
+		.SetGroup(AppMenuGroup);
+
+	TabManager->RegisterTabSpawner(DuplicateViewTabId, FOnSpawnTab::CreateRaw(this, &SMainWindow::OnSpawnTab_DuplicateView))
+		.SetDisplayName(LOCTEXT("DuplicateViewTabTitle", "Duplicate View"))
+		.SetIcon(FSlateIcon(FUnrealPakViewerStyle::GetStyleSetName(), "Tab.File"))
+		.SetGroup(AppMenuGroup);
+
+	TabManager->RegisterTabSpawner(RecompressionViewTabId, FOnSpawnTab::CreateRaw(this, &SMainWindow::OnSpawnTab_RecompressionView))
+		.SetDisplayName(LOCTEXT("RecompressionViewTabTitle", "Recompression View"))
+		.SetIcon(FSlateIcon(FUnrealPakViewerStyle::GetStyleSetName(), "Tab.Summary"))
+		.SetGroup(AppMenuGroup);
+
+	TabManager->RegisterTabSpawner(LayoutViewTabId, FOnSpawnTab::CreateRaw(this, &SMainWindow::OnSpawnTab_LayoutView))
+		.SetDisplayName(LOCTEXT("LayoutViewTabTitle", "Layout View"))
+		.SetIcon(FSlateIcon(FUnrealPakViewerStyle::GetStyleSetName(), "Tab.Summary"))
+		.SetGroup(AppMenuGroup);
+
+	TabManager->RegisterTabSpawner(PerformanceViewTabId, FOnSpawnTab::CreateRaw(this, &SMainWindow::OnSpawnTab_PerformanceView))
+		.SetDisplayName(LOCTEXT("PerformanceViewTabTitle", "Performance View"))
+		.SetIcon(FSlateIcon(FUnrealPakViewerStyle::GetStyleSetName(), "Tab.Summary"))
+		.SetGroup(AppMenuGroup);
+
 	const TSharedRef<FTabManager::FLayout> Layout = FTabManager::NewLayout("UnrealPakViewer_v1.0")
 		->AddArea
 		(
@@ -88,6 +147,14 @@ void SMainWindow::Construct(const FArguments& Args)
 				FTabManager::NewStack()
 				->AddTab(TreeViewTabId, ETabState::OpenedTab)
 				->AddTab(FileViewTabId, ETabState::OpenedTab)
+				->AddTab(CycleViewTabId, ETabState::OpenedTab)
+				->AddTab(UnreferencedViewTabId, ETabState::OpenedTab)
+				->AddTab(LoadViewTabId, ETabState::OpenedTab)
+				->AddTab(DiffViewTabId, ETabState::OpenedTab)
+				->AddTab(DuplicateViewTabId, ETabState::OpenedTab)
+				->AddTab(RecompressionViewTabId, ETabState::OpenedTab)
+				->AddTab(LayoutViewTabId, ETabState::OpenedTab)
+				->AddTab(PerformanceViewTabId, ETabState::OpenedTab)
 				->SetForegroundTab(FTabId(TreeViewTabId))
 			)
 		);
@@ -275,6 +342,117 @@ TSharedRef<class SDockTab> SMainWindow::OnSpawnTab_FileView(const FSpawnTabArgs&
 	return DockTab;
 }
 
+TSharedRef<class SDockTab> SMainWindow::OnSpawnTab_CycleView(const FSpawnTabArgs& Args)
+{
+	TSharedRef<SPakCycleView> CycleView = SNew(SPakCycleView);
+	CycleView->Reload();
+
+	const TSharedRef<SDockTab> DockTab = SNew(SDockTab)
+		.ShouldAutosize(false)
+		.TabRole(ETabRole::PanelTab)
+		[
+			CycleView
+		];
+
+	return DockTab;
+}
+
+TSharedRef<class SDockTab> SMainWindow::OnSpawnTab_UnreferencedView(const FSpawnTabArgs& Args)
+{
+	TSharedRef<SPakUnreferencedView> UnreferencedView = SNew(SPakUnreferencedView);
+	UnreferencedView->Reload();
+
+	const TSharedRef<SDockTab> DockTab = SNew(SDockTab)
+		.ShouldAutosize(false)
+		.TabRole(ETabRole::PanelTab)
+		[
+			UnreferencedView
+		];
+
+	return DockTab;
+}
+
+TSharedRef<class SDockTab> SMainWindow::OnSpawnTab_LoadView(const FSpawnTabArgs& Args)
+{
+	TSharedRef<SPakLoadView> LoadView = SNew(SPakLoadView);
+	LoadView->Reload();
+
+	const TSharedRef<SDockTab> DockTab = SNew(SDockTab)
+		.ShouldAutosize(false)
+		.TabRole(ETabRole::PanelTab)
+		[
+			LoadView
+		];
+
+	return DockTab;
+}
+
+TSharedRef<class SDockTab> SMainWindow::OnSpawnTab_DiffView(const FSpawnTabArgs& Args)
+{
+	TSharedRef<SPakDiffView> DiffView = SNew(SPakDiffView);
+	DiffView->Reload();
+
+	const TSharedRef<SDockTab> DockTab = SNew(SDockTab)
+		.ShouldAutosize(false)
+		.TabRole(ETabRole::PanelTab)
+		[
+			DiffView
+		];
+
+	return DockTab;
+}
+
+TSharedRef<class SDockTab> SMainWindow::OnSpawnTab_DuplicateView(const FSpawnTabArgs& Args)
+{
+	TSharedRef<SPakDuplicateView> DuplicateView = SNew(SPakDuplicateView);
+	DuplicateView->Reload();
+
+	const TSharedRef<SDockTab> DockTab = SNew(SDockTab)
+		.ShouldAutosize(false)
+		.TabRole(ETabRole::PanelTab)
+		[
+			DuplicateView
+		];
+
+	return DockTab;
+}
+
+TSharedRef<class SDockTab> SMainWindow::OnSpawnTab_RecompressionView(const FSpawnTabArgs& Args)
+{
+	const TSharedRef<SDockTab> DockTab = SNew(SDockTab)
+		.ShouldAutosize(false)
+		.TabRole(ETabRole::PanelTab)
+		[
+			SNew(SPakRecompressionView)
+		];
+
+	return DockTab;
+}
+
+TSharedRef<class SDockTab> SMainWindow::OnSpawnTab_LayoutView(const FSpawnTabArgs& Args)
+{
+	const TSharedRef<SDockTab> DockTab = SNew(SDockTab)
+		.ShouldAutosize(false)
+		.TabRole(ETabRole::PanelTab)
+		[
+			SNew(SPakLayoutView)
+		];
+
+	return DockTab;
+}
+
+TSharedRef<class SDockTab> SMainWindow::OnSpawnTab_PerformanceView(const FSpawnTabArgs& Args)
+{
+	const TSharedRef<SDockTab> DockTab = SNew(SDockTab)
+		.ShouldAutosize(false)
+		.TabRole(ETabRole::PanelTab)
+		[
+			SNew(SPakPerformanceView)
+		];
+
+	return DockTab;
+}
+
 void SMainWindow::OnExit(const TSharedRef<SWindow>& InWindow)
 {
 }
@@ -386,6 +564,20 @@ void SMainWindow::OnSwitchToFileView(const FString& InPath, int32 PakIndex)
 	}
 }
 
+void SMainWindow::OnEstimateRecompression(const TArray<FPakFileEntryPtr>& InFiles)
+{
+#if ENGINE_MAJOR_VERSION >= 5 || ENGINE_MINOR_VERSION >= 26
+	TSharedPtr<SDockTab> RecompressionViewTab = TabManager->TryInvokeTab(RecompressionViewTabId);
+#else
+	TSharedPtr<SDockTab> RecompressionViewTab = TabManager->InvokeTab(RecompressionViewTabId);
+#endif
+	if (RecompressionViewTab.IsValid())
+	{
+		TSharedRef<SPakRecompressionView> RecompressionView = StaticCastSharedRef<SPakRecompressionView>(RecompressionViewTab->GetContent());
+		RecompressionView->StartEstimate(InFiles);
+	}
+}
+
 void SMainWindow::OnExtractStart()
 {
 	FFunctionGraphTask::CreateAndDispatchWhenReady([this]()
@@ -398,6 +590,14 @@ void SMainWindow::OnExtractStart()
 		TStatId(), nullptr, ENamedThreads::GameThread);
 }
 
+void SMainWindow::OnExportStart()
+{
+	// Not modal, the views stay usable while the export thread runs
+	TSharedPtr<SExtractProgressWindow> ExportProgressWindow = SNew(SExtractProgressWindow).StartTime(FDateTime::Now()).Export(true);
+
+	FSlateApplication::Get().AddWindowAsNativeChild(ExportProgressWindow.ToSharedRef(), SharedThis(this), true);
+}
+
 void SMainWindow::OnLoadRecentFile(int32 InIndex)
 {
 	if (RecentFiles.IsValidIndex(InIndex))
@@ -3,6 +3,8 @@
 #include "CoreMinimal.h"
 #include "Widgets/SWindow.h"
 
+#include "PakFileEntry.h"
+
 class SMainWindow : public SWindow
 {
 public:
@@ -25,6 +27,14 @@ protected:
 	TSharedRef<class SDockTab> OnSpawnTab_SummaryView(const FSpawnTabArgs& Args);
 	TSharedRef<class SDockTab> OnSpawnTab_TreeView(const FSpawnTabArgs& Args);
 	TSharedRef<class SDockTab> OnSpawnTab_FileView(const FSpawnTabArgs& Args);
+	TSharedRef<class SDockTab> OnSpawnTab_CycleView(const FSpawnTabArgs& Args);
+	TSharedRef<class SDockTab> OnSpawnTab_UnreferencedView(const FSpawnTabArgs& Args);
+	TSharedRef<class SDockTab> OnSpawnTab_LoadView(const FSpawnTabArgs& Args);
+	TSharedRef<class SDockTab> OnSpawnTab_DiffView(const FSpawnTabArgs& Args);
+	TSharedRef<class SDockTab> OnSpawnTab_DuplicateView(const FSpawnTabArgs& Args);
+	TSharedRef<class SDockTab> OnSpawnTab_RecompressionView(const FSpawnTabArgs& Args);
+	TSharedRef<class SDockTab> OnSpawnTab_LayoutView(const FSpawnTabArgs& Args);
+	TSharedRef<class SDockTab> OnSpawnTab_PerformanceView(const FSpawnTabArgs& Args);
 
 	void OnExit(const TSharedRef<SWindow>& InWindow);
 	void OnLoadPakFile();
@@ -33,7 +43,9 @@ protected:
 	FString OnGetAESKey(const FString& InPakPath, const FGuid& PakGuid, bool& bCancel);
 	void OnSwitchToTreeView(const FString& InPath, int32 PakIndex);
 	void OnSwitchToFileView(const FString& InPath, int32 PakIndex);
+	void OnEstimateRecompression(const TArray<FPakFileEntryPtr>& InFiles);
 	void OnExtractStart();
+	void OnExportStart();
 	void OnLoadRecentFile(int32 InIndex);
 	bool OnLoadRecentFileCanExecute(int32 InIndex) const;
 
@@ -0,0 +1,239 @@
+#include "SPakByteMap.h"
+
+#include "Algo/BinarySearch.h"
+#include "Rendering/DrawElements.h"
+#include "Styling/CoreStyle.h"
+
+#include "ViewModels/ClassColumn.h"
+
+#define LOCTEXT_NAMESPACE "SPakByteMap"
+
+const int32 SPakByteMap::ColumnCount = 128;
+const float SPakByteMap::CellSize = 6.f;
+
+void SPakByteMap::Construct(const FArguments& InArgs)
+{
+	BytesPerCell = InArgs._BytesPerCell;
+	OnSpanDoubleClicked = InArgs._OnSpanDoubleClicked;
+
+	SetToolTipText(TAttribute<FText>::Create(TAttribute<FText>::FGetter::CreateSP(this, &SPakByteMap::GetHoveredText)));
+}
+
+void SPakByteMap::SetLayout(TSharedPtr<FPakLayout> InLayout)
+{
+	Layout = InLayout;
+	HoveredSpan = INDEX_NONE;
+
+	// Class colors are hashed from the name, do it once instead of every paint
+	FileColors.Empty();
+	if (Layout.IsValid())
+	{
+		FileColors.Reserve(Layout->Files.Num());
+		for (const FPakFileEntryPtr& File : Layout->Files)
+		{
+			FileColors.Add(FClassColumn::GetColorByClass(*File->Class.ToString()));
+		}
+	}
+}
+
+int32 SPakByteMap::OnPaint(const FPaintArgs& Args, const FGeometry& AllottedGeometry, const FSlateRect& MyCullingRect, FSlateWindowElementList& OutDrawElements, int32 LayerId, const FWidgetStyle& InWidgetStyle, bool bParentEnabled) const
+{
+	if (!Layout.IsValid() || Layout->PakSize <= 0)
+	{
+		return LayerId;
+	}
+
+	const FSlateBrush* Brush = FCoreStyle::Get().GetBrush("GenericWhiteBox");
+	const int64 CellBytes = GetCellBytes();
+	const int64 CellCount = FMath::DivideAndRoundUp(Layout->PakSize, CellBytes);
+	const int64 RowCount = FMath::DivideAndRoundUp(CellCount, (int64)ColumnCount);
+
+	// Only rows inside the culling rect are painted, a big pak at a small cell size has a lot of rows
+	const float VisibleTop = AllottedGeometry.AbsoluteToLocal(MyCullingRect.GetTopLeft()).Y;
+	const float VisibleBottom = AllottedGeometry.AbsoluteToLocal(MyCullingRect.GetBottomRight()).Y;
+	const int64 FirstRow = FMath::Clamp<int64>(FMath::FloorToInt(VisibleTop / CellSize), 0, RowCount);
+	const int64 LastRow = FMath::Clamp<int64>(FMath::CeilToInt(VisibleBottom / CellSize), 0, RowCount);
+
+	for (int64 Row = FirstRow; Row < LastRow; ++Row)
+	{
+		for (int32 Column = 0; Column < ColumnCount; ++Column)
+		{
+			const int64 Cell = Row * ColumnCount + Column;
+			if (Cell >= CellCount)
+			{
+				break;
+			}
+
+			const int64 Start = Cell * CellBytes;
+			const int64 End = FMath::Min(Start + CellBytes, Layout->PakSize);
+
+			FSlateDrawElement::MakeBox(
+				OutDrawElements,
+				LayerId,
+				AllottedGeometry.ToPaintGeometry(FVector2D(Column * CellSize, Row * CellSize), FVector2D(CellSize - 1.f, CellSize - 1.f)),
+				Brush,
+				ESlateDrawEffect::None,
+				GetCellColor(Start, End) * InWidgetStyle.GetColorAndOpacityTint());
+		}
+	}
+
+	return LayerId + 1;
+}
+
+FVector2D SPakByteMap::ComputeDesiredSize(float LayoutScaleMultiplier) const
+{
+	if (!Layout.IsValid())
+	{
+		return FVector2D(ColumnCount * CellSize, CellSize);
+	}
+
+	const int64 CellCount = FMath::DivideAndRoundUp(Layout->PakSize, GetCellBytes());
+	const int64 RowCount = FMath::Max<int64>(FMath::DivideAndRoundUp(CellCount, (int64)ColumnCount), 1);
+
+	return FVector2D(ColumnCount * CellSize, RowCount * CellSize);
+}
+
+FReply SPakByteMap::OnMouseMove(const FGeometry& MyGeometry, const FPointerEvent& MouseEvent)
+{
+	HoveredSpan = FindSpanAtPosition(MyGeometry, MouseEvent.GetScreenSpacePosition());
+
+	return FReply::Unhandled();
+}
+
+void SPakByteMap::OnMouseLeave(const FPointerEvent& MouseEvent)
+{
+	HoveredSpan = INDEX_NONE;
+
+	SLeafWidget::OnMouseLeave(MouseEvent);
+}
+
+FReply SPakByteMap::OnMouseButtonDoubleClick(const FGeometry& MyGeometry, const FPointerEvent& MouseEvent)
+{
+	const int32 SpanIndex = FindSpanAtPosition(MyGeometry, MouseEvent.GetScreenSpacePosition());
+	if (SpanIndex != INDEX_NONE)
+	{
+		OnSpanDoubleClicked.ExecuteIfBound(Layout->Spans[SpanIndex]);
+		return FReply::Handled();
+	}
+
+	return FReply::Unhandled();
+}
+
+FLinearColor SPakByteMap::GetSpanTypeColor(EPakLayoutSpanType InType)
+{
+	switch (InType)
+	{
+	case EPakLayoutSpanType::Padding: return FLinearColor::Yellow;
+	case EPakLayoutSpanType::Gap: return FLinearColor::Red;
+	case EPakLayoutSpanType::Index: return FLinearColor(0.2f, 0.4f, 1.f);
+	case EPakLayoutSpanType::Footer: return FLinearColor::Gray;
+	default: return FLinearColor::White;
+	}
+}
+
+int64 SPakByteMap::GetCellBytes() const
+{
+	return FMath::Max<int64>(BytesPerCell.Get(), 1);
+}
+
+int32 SPakByteMap::FindSpan(int64 InOffset) const
+{
+	// Last span that starts at or before the offset
+	const int32 Index = Algo::UpperBoundBy(Layout->Spans, InOffset, &FPakLayoutSpan::Offset) - 1;
+	return Layout->Spans.IsValidIndex(Index) ? Index : INDEX_NONE;
+}
+
+int32 SPakByteMap::FindSpanAtPosition(const FGeometry& MyGeometry, const FVector2D& InScreenPosition) const
+{
+	if (!Layout.IsValid())
+	{
+		return INDEX_NONE;
+	}
+
+	const FVector2D LocalPosition = MyGeometry.AbsoluteToLocal(InScreenPosition);
+	const int32 Column = FMath::FloorToInt(LocalPosition.X / CellSize);
+	const int64 Row = FMath::FloorToInt(LocalPosition.Y / CellSize);
+	if (Column < 0 || Column >= ColumnCount || Row < 0)
+	{
+		return INDEX_NONE;
+	}
+
+	const int64 Offset = (Row * ColumnCount + Column) * GetCellBytes();
+	return Offset < Layout->PakSize ? FindSpan(Offset) : INDEX_NONE;
+}
+
+FLinearColor SPakByteMap::GetCellColor(int64 InStart, int64 InEnd) const
+{
+	// Holes win over entries so a single gap stays visible at any cell size
+	int32 SpanIndex = FindSpan(InStart);
+	if (SpanIndex == INDEX_NONE)
+	{
+		return FLinearColor::Black;
+	}
+
+	FLinearColor EntryColor = FLinearColor::Black;
+	bool bHasEntry = false;
+	bool bHasPadding = false;
+	EPakLayoutSpanType OtherType = EPakLayoutSpanType::Entry;
+	for (; Layout->Spans.IsValidIndex(SpanIndex) && Layout->Spans[SpanIndex].Offset < InEnd; ++SpanIndex)
+	{
+		const FPakLayoutSpan& Span = Layout->Spans[SpanIndex];
+		if (Span.Offset + Span.Size <= InStart)
+		{
+			continue;
+		}
+
+		switch (Span.Type)
+		{
+		case EPakLayoutSpanType::Gap:
+			return GetSpanTypeColor(EPakLayoutSpanType::Gap);
+		case EPakLayoutSpanType::Padding:
+			bHasPadding = true;
+			break;
+		case EPakLayoutSpanType::Entry:
+			if (!bHasEntry && FileColors.IsValidIndex(Span.FileIndex))
+			{
+				EntryColor = FileColors[Span.FileIndex];
+				bHasEntry = true;
+			}
+			break;
+		default:
+			OtherType = Span.Type;
+			break;
+		}
+	}
+
+	if (bHasPadding)
+	{
+		return GetSpanTypeColor(EPakLayoutSpanType::Padding);
+	}
+
+	return bHasEntry ? EntryColor : GetSpanTypeColor(OtherType);
+}
+
+FText SPakByteMap::GetHoveredText() const
+{
+	if (!Layout.IsValid() || !Layout->Spans.IsValidIndex(HoveredSpan))
+	{
+		return FText();
+	}
+
+	const FPakLayoutSpan& Span = Layout->Spans[HoveredSpan];
+	const FText Range = FText::Format(LOCTEXT("SpanRange", "Offset {0}, {1}"), FText::AsNumber(Span.Offset), FText::AsMemory(Span.Size, EMemoryUnitStandard::IEC));
+
+	switch (Span.Type)
+	{
+	case EPakLayoutSpanType::Entry:
+		return Layout->Files.IsValidIndex(Span.FileIndex) ? FText::Format(LOCTEXT("EntrySpan", "{0}\n{1}\n{2}"), FText::FromString(Layout->Files[Span.FileIndex]->Path), FText::FromName(Layout->Files[Span.FileIndex]->Class), Range) : Range;
+	case EPakLayoutSpanType::Padding:
+		return FText::Format(LOCTEXT("PaddingSpan", "Padding\n{0}"), Range);
+	case EPakLayoutSpanType::Gap:
+		return FText::Format(LOCTEXT("GapSpan", "Gap\n{0}"), Range);
+	case EPakLayoutSpanType::Index:
+		return FText::Format(LOCTEXT("IndexSpan", "Index\n{0}"), Range);
+	default:
+		return FText::Format(LOCTEXT("FooterSpan", "Footer\n{0}"), Range);
+	}
+}
+
+#undef LOCTEXT_NAMESPACE
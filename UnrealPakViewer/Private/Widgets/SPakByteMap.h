@@ -0,0 +1,52 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Widgets/SLeafWidget.h"
+
+#include "PakFileEntry.h"
+
+DECLARE_DELEGATE_OneParam(FOnByteMapSpanDoubleClicked, const FPakLayoutSpan&);
+
+/** Draws a pak as a grid of cells, only the rows in view are painted. */
+class SPakByteMap : public SLeafWidget
+{
+public:
+	SLATE_BEGIN_ARGS(SPakByteMap)
+		: _BytesPerCell(64 * 1024)
+	{}
+		SLATE_ATTRIBUTE(int64, BytesPerCell)
+		SLATE_EVENT(FOnByteMapSpanDoubleClicked, OnSpanDoubleClicked)
+	SLATE_END_ARGS()
+
+	/** Constructs this widget. */
+	void Construct(const FArguments& InArgs);
+
+	void SetLayout(TSharedPtr<FPakLayout> InLayout);
+
+	virtual int32 OnPaint(const FPaintArgs& Args, const FGeometry& AllottedGeometry, const FSlateRect& MyCullingRect, FSlateWindowElementList& OutDrawElements, int32 LayerId, const FWidgetStyle& InWidgetStyle, bool bParentEnabled) const override;
+	virtual FVector2D ComputeDesiredSize(float LayoutScaleMultiplier) const override;
+	virtual FReply OnMouseMove(const FGeometry& MyGeometry, const FPointerEvent& MouseEvent) override;
+	virtual void OnMouseLeave(const FPointerEvent& MouseEvent) override;
+	virtual FReply OnMouseButtonDoubleClick(const FGeometry& MyGeometry, const FPointerEvent& MouseEvent) override;
+
+	static FLinearColor GetSpanTypeColor(EPakLayoutSpanType InType);
+
+	static const int32 ColumnCount;
+	static const float CellSize;
+
+protected:
+	int64 GetCellBytes() const;
+	int32 FindSpan(int64 InOffset) const;
+	int32 FindSpanAtPosition(const FGeometry& MyGeometry, const FVector2D& InScreenPosition) const;
+	FLinearColor GetCellColor(int64 InStart, int64 InEnd) const;
+	FText GetHoveredText() const;
+
+protected:
+	TSharedPtr<FPakLayout> Layout;
+	TArray<FLinearColor> FileColors;
+
+	TAttribute<int64> BytesPerCell;
+	FOnByteMapSpanDoubleClicked OnSpanDoubleClicked;
+
+	int32 HoveredSpan = INDEX_NONE;
+};
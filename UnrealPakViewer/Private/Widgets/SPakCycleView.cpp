@@ -0,0 +1,351 @@
+#include "SPakCycleView.h"
+
+#include "Framework/MultiBox/MultiBoxBuilder.h"
+#include "HAL/PlatformTime.h"
+#include "Widgets/Input/SButton.h"
+#include "Widgets/Layout/SBorder.h"
+#include "Widgets/Layout/SBox.h"
+#include "Widgets/Layout/SSplitter.h"
+#include "Widgets/SBoxPanel.h"
+#include "Widgets/Text/STextBlock.h"
+#include "Widgets/Views/STableRow.h"
+#include "Widgets/Views/STableViewBase.h"
+
+#include "CommonDefines.h"
+#include "PakAnalyzerModule.h"
+#include "UnrealPakViewerStyle.h"
+#include "ViewModels/ClassColumn.h"
+#include "ViewModels/WidgetDelegates.h"
+
+#define LOCTEXT_NAMESPACE "SPakCycleView"
+
+const FName SPakCycleView::PackagesColumnName(TEXT("Packages"));
+const FName SPakCycleView::NameColumnName(TEXT("Name"));
+const FName SPakCycleView::SizeColumnName(TEXT("Size"));
+const FName SPakCycleView::CompressedSizeColumnName(TEXT("CompressedSize"));
+const FName SPakCycleView::ClassColumnName(TEXT("Class"));
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+// SPakCycleRow
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+class SPakCycleRow : public SMultiColumnTableRow<FDependencyCyclePtr>
+{
+	SLATE_BEGIN_ARGS(SPakCycleRow) {}
+	SLATE_END_ARGS()
+
+public:
+	void Construct(const FArguments& InArgs, FDependencyCyclePtr InCycle, const TSharedRef<STableViewBase>& InOwnerTableView)
+	{
+		WeakCycle = MoveTemp(InCycle);
+
+		SMultiColumnTableRow<FDependencyCyclePtr>::Construct(FSuperRowType::FArguments(), InOwnerTableView);
+	}
+
+	virtual TSharedRef<SWidget> GenerateWidgetForColumn(const FName& ColumnName) override
+	{
+		FDependencyCyclePtr CyclePin = WeakCycle.Pin();
+
+		FText Text;
+		FText ToolTip;
+		if (CyclePin.IsValid())
+		{
+			if (ColumnName == SPakCycleView::PackagesColumnName)
+			{
+				Text = FText::AsNumber(CyclePin->Packages.Num());
+			}
+			else if (ColumnName == SPakCycleView::NameColumnName)
+			{
+				// Packages are listed in the order the cycle was closed, the first one is as good as any
+				Text = FText::FromName(CyclePin->Packages[0]);
+				ToolTip = Text;
+			}
+			else if (ColumnName == SPakCycleView::SizeColumnName)
+			{
+				Text = FText::AsMemory(CyclePin->Size, EMemoryUnitStandard::IEC);
+				ToolTip = FText::AsNumber(CyclePin->Size);
+			}
+			else if (ColumnName == SPakCycleView::CompressedSizeColumnName)
+			{
+				Text = FText::AsMemory(CyclePin->CompressedSize, EMemoryUnitStandard::IEC);
+				ToolTip = FText::AsNumber(CyclePin->CompressedSize);
+			}
+		}
+
+		return
+			SNew(SBox).Padding(FMargin(4.0, 0.0))
+			[
+				SNew(STextBlock).Text(Text).ToolTipText(ToolTip)
+			];
+	}
+
+protected:
+	TWeakPtr<FDependencyCycle> WeakCycle;
+};
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+// SPakCycleFileRow
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+class SPakCycleFileRow : public SMultiColumnTableRow<FPakFileEntryPtr>
+{
+	SLATE_BEGIN_ARGS(SPakCycleFileRow) {}
+	SLATE_END_ARGS()
+
+public:
+	void Construct(const FArguments& InArgs, FPakFileEntryPtr InFile, const TSharedRef<STableViewBase>& InOwnerTableView)
+	{
+		WeakFile = MoveTemp(InFile);
+
+		SMultiColumnTableRow<FPakFileEntryPtr>::Construct(FSuperRowType::FArguments(), InOwnerTableView);
+	}
+
+	virtual TSharedRef<SWidget> GenerateWidgetForColumn(const FName& ColumnName) override
+	{
+		FPakFileEntryPtr FilePin = WeakFile.Pin();
+
+		FText Text;
+		FText ToolTip;
+		FSlateColor Color = FLinearColor::White;
+		if (FilePin.IsValid())
+		{
+			if (ColumnName == SPakCycleView::NameColumnName)
+			{
+				Text = FText::FromString(FilePin->Path);
+				ToolTip = Text;
+			}
+			else if (ColumnName == SPakCycleView::ClassColumnName)
+			{
+				Text = FText::FromName(FilePin->Class);
+				Color = FClassColumn::GetColorByClass(*FilePin->Class.ToString());
+			}
+			else if (ColumnName == SPakCycleView::SizeColumnName)
+			{
+				Text = FText::AsMemory(FilePin->PakEntry.UncompressedSize, EMemoryUnitStandard::IEC);
+				ToolTip = FText::AsNumber(FilePin->PakEntry.UncompressedSize);
+			}
+			else if (ColumnName == SPakCycleView::CompressedSizeColumnName)
+			{
+				Text = FText::AsMemory(FilePin->PakEntry.Size, EMemoryUnitStandard::IEC);
+				ToolTip = FText::AsNumber(FilePin->PakEntry.Size);
+			}
+		}
+
+		return
+			SNew(SBox).Padding(FMargin(4.0, 0.0))
+			[
+				SNew(STextBlock).Text(Text).ToolTipText(ToolTip).ColorAndOpacity(Color)
+			];
+	}
+
+protected:
+	TWeakPtr<FPakFileEntry> WeakFile;
+};
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+// SPakCycleView
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+SPakCycleView::SPakCycleView()
+{
+	FWidgetDelegates::GetOnLoadAssetRegistryFinishedDelegate().AddRaw(this, &SPakCycleView::OnLoadAssetReigstryFinished);
+	FPakAnalyzerDelegates::OnPakLoadFinish.AddRaw(this, &SPakCycleView::OnLoadPakFinished);
+	FPakAnalyzerDelegates::OnAssetParseFinish.AddRaw(this, &SPakCycleView::OnParseAssetFinished);
+}
+
+SPakCycleView::~SPakCycleView()
+{
+	FWidgetDelegates::GetOnLoadAssetRegistryFinishedDelegate().RemoveAll(this);
+	FPakAnalyzerDelegates::OnPakLoadFinish.RemoveAll(this);
+	FPakAnalyzerDelegates::OnAssetParseFinish.RemoveAll(this);
+}
+
+void SPakCycleView::Construct(const FArguments& InArgs)
+{
+	ChildSlot
+	[
+		SNew(SVerticalBox)
+
+		+ SVerticalBox::Slot().AutoHeight().Padding(2.f)
+		[
+			SNew(SHorizontalBox)
+
+			+ SHorizontalBox::Slot().FillWidth(1.f).VAlign(VAlign_Center)
+			[
+				SNew(STextBlock).Text(this, &SPakCycleView::GetSummaryText)
+			]
+
+			+ SHorizontalBox::Slot().AutoWidth()
+			[
+				SNew(SButton)
+				.Text(LOCTEXT("Refresh", "Refresh"))
+				.ToolTipText(LOCTEXT("RefreshTip", "Find dependency cycles again"))
+				.OnClicked(this, &SPakCycleView::OnRefresh)
+			]
+		]
+
+		+ SVerticalBox::Slot().FillHeight(1.f)
+		[
+			SNew(SSplitter).Orientation(Orient_Vertical)
+
+			+ SSplitter::Slot().Value(0.5f)
+			[
+				SAssignNew(CycleListView, SListView<FDependencyCyclePtr>)
+				.ItemHeight(20.f)
+				.SelectionMode(ESelectionMode::Single)
+				.ListItemsSource(&Cycles)
+				.OnGenerateRow(this, &SPakCycleView::OnGenerateCycleRow)
+				.OnSelectionChanged(this, &SPakCycleView::OnCycleSelectionChanged)
+				.HeaderRow
+				(
+					SNew(SHeaderRow)
+					+ SHeaderRow::Column(PackagesColumnName).DefaultLabel(LOCTEXT("PackagesColumn", "Packages")).DefaultTooltip(LOCTEXT("PackagesColumnTip", "Package count of the cycle")).ManualWidth(80.f)
+					+ SHeaderRow::Column(SizeColumnName).DefaultLabel(LOCTEXT("SizeColumn", "Size")).DefaultTooltip(LOCTEXT("SizeColumnTip", "Total original size of all packages in the cycle")).ManualWidth(120.f)
+					+ SHeaderRow::Column(CompressedSizeColumnName).DefaultLabel(LOCTEXT("CompressedSizeColumn", "Compressed Size")).DefaultTooltip(LOCTEXT("CompressedSizeColumnTip", "Total compressed size of all packages in the cycle")).ManualWidth(120.f)
+					+ SHeaderRow::Column(NameColumnName).DefaultLabel(LOCTEXT("CycleNameColumn", "Package")).DefaultTooltip(LOCTEXT("CycleNameColumnTip", "One of the packages in the cycle")).FillWidth(1.f)
+				)
+			]
+
+			+ SSplitter::Slot().Value(0.5f)
+			[
+				SAssignNew(FileListView, SListView<FPakFileEntryPtr>)
+				.ItemHeight(20.f)
+				.SelectionMode(ESelectionMode::Single)
+				.ListItemsSource(&CycleFiles)
+				.OnGenerateRow(this, &SPakCycleView::OnGenerateFileRow)
+				.OnMouseButtonDoubleClick(this, &SPakCycleView::OnFileDoubleClicked)
+				.OnContextMenuOpening(this, &SPakCycleView::OnGenerateFileContextMenu)
+				.HeaderRow
+				(
+					SNew(SHeaderRow)
+					+ SHeaderRow::Column(NameColumnName).DefaultLabel(LOCTEXT("PathColumn", "Path")).DefaultTooltip(LOCTEXT("PathColumnTip", "File of the selected cycle, double click to show it in tree view")).FillWidth(1.f)
+					+ SHeaderRow::Column(ClassColumnName).DefaultLabel(LOCTEXT("ClassColumn", "Class")).ManualWidth(150.f)
+					+ SHeaderRow::Column(SizeColumnName).DefaultLabel(LOCTEXT("FileSizeColumn", "Size")).ManualWidth(120.f)
+					+ SHeaderRow::Column(CompressedSizeColumnName).DefaultLabel(LOCTEXT("FileCompressedSizeColumn", "Compressed Size")).ManualWidth(120.f)
+				)
+			]
+		]
+	];
+}
+
+void SPakCycleView::Reload()
+{
+	const double StartTime = FPlatformTime::Seconds();
+
+	Cycles.Empty();
+	CycleFiles.Empty();
+	CyclesSize = 0;
+
+	IPakAnalyzer* PakAnalyzer = IPakAnalyzerModule::Get().GetPakAnalyzer();
+	if (PakAnalyzer)
+	{
+		PakAnalyzer->GetDependencyCycles(Cycles);
+	}
+
+	for (const FDependencyCyclePtr& Cycle : Cycles)
+	{
+		CyclesSize += Cycle->Size;
+	}
+
+	ReloadCost = FPlatformTime::Seconds() - StartTime;
+
+	CycleListView->RebuildList();
+	FileListView->RebuildList();
+}
+
+TSharedRef<ITableRow> SPakCycleView::OnGenerateCycleRow(FDependencyCyclePtr InCycle, const TSharedRef<STableViewBase>& OwnerTable)
+{
+	return SNew(SPakCycleRow, InCycle, OwnerTable);
+}
+
+TSharedRef<ITableRow> SPakCycleView::OnGenerateFileRow(FPakFileEntryPtr InFile, const TSharedRef<STableViewBase>& OwnerTable)
+{
+	return SNew(SPakCycleFileRow, InFile, OwnerTable);
+}
+
+void SPakCycleView::OnCycleSelectionChanged(FDependencyCyclePtr InCycle, ESelectInfo::Type SelectInfo)
+{
+	CycleFiles.Empty();
+
+	if (InCycle.IsValid())
+	{
+		CycleFiles = InCycle->Files;
+		CycleFiles.Sort([](const FPakFileEntryPtr& A, const FPakFileEntryPtr& B) { return A->PakEntry.UncompressedSize > B->PakEntry.UncompressedSize; });
+	}
+
+	FileListView->RebuildList();
+}
+
+void SPakCycleView::OnFileDoubleClicked(FPakFileEntryPtr InFile)
+{
+	if (InFile.IsValid())
+	{
+		FWidgetDelegates::GetOnSwitchToTreeViewDelegate().Broadcast(InFile->Path, InFile->OwnerPakIndex);
+	}
+}
+
+TSharedPtr<SWidget> SPakCycleView::OnGenerateFileContextMenu()
+{
+	FMenuBuilder MenuBuilder(true, nullptr);
+
+	MenuBuilder.BeginSection("Operation", LOCTEXT("ContextMenu_Header_Operation", "Operation"));
+	{
+		FUIAction Action_JumpToTreeView
+		(
+			FExecuteAction::CreateSP(this, &SPakCycleView::OnJumpToTreeViewExecute),
+			FCanExecuteAction::CreateSP(this, &SPakCycleView::HasOneFileSelected)
+		);
+		MenuBuilder.AddMenuEntry
+		(
+			LOCTEXT("ContextMenu_Columns_JumpToTreeView", "Show In Tree View"),
+			LOCTEXT("ContextMenu_Columns_JumpToTreeView_Desc", "Show current selected file in tree view"),
+			FSlateIcon(FUnrealPakViewerStyle::GetStyleSetName(), "Find"), Action_JumpToTreeView, NAME_None, EUserInterfaceActionType::Button
+		);
+	}
+	MenuBuilder.EndSection();
+
+	return MenuBuilder.MakeWidget();
+}
+
+void SPakCycleView::OnJumpToTreeViewExecute()
+{
+	TArray<FPakFileEntryPtr> SelectedItems = FileListView->GetSelectedItems();
+	if (SelectedItems.Num() > 0)
+	{
+		OnFileDoubleClicked(SelectedItems[0]);
+	}
+}
+
+bool SPakCycleView::HasOneFileSelected() const
+{
+	return FileListView->GetNumItemsSelected() == 1;
+}
+
+FText SPakCycleView::GetSummaryText() const
+{
+	return FText::Format(LOCTEXT("CycleSummary", "{0} cycles, {1} in total, found in {2}ms."), FText::AsNumber(Cycles.Num()), FText::AsMemory(CyclesSize, EMemoryUnitStandard::IEC), FText::AsNumber(FMath::RoundToInt(ReloadCost * 1000.0)));
+}
+
+FReply SPakCycleView::OnRefresh()
+{
+	Reload();
+
+	return FReply::Handled();
+}
+
+void SPakCycleView::OnLoadPakFinished()
+{
+	Reload();
+}
+
+void SPakCycleView::OnParseAssetFinished()
+{
+	Reload();
+}
+
+void SPakCycleView::OnLoadAssetReigstryFinished()
+{
+	Reload();
+}
+
+#undef LOCTEXT_NAMESPACE
@@ -0,0 +1,57 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Widgets/SCompoundWidget.h"
+#include "Widgets/Views/SListView.h"
+
+#include "PakFileEntry.h"
+
+/** Lists package dependency cycles ranked by total size. */
+class SPakCycleView : public SCompoundWidget
+{
+public:
+	/** Default constructor. */
+	SPakCycleView();
+
+	/** Virtual destructor. */
+	virtual ~SPakCycleView();
+
+	SLATE_BEGIN_ARGS(SPakCycleView) {}
+	SLATE_END_ARGS()
+
+	/** Constructs this widget. */
+	void Construct(const FArguments& InArgs);
+
+	void Reload();
+
+	static const FName PackagesColumnName;
+	static const FName NameColumnName;
+	static const FName SizeColumnName;
+	static const FName CompressedSizeColumnName;
+	static const FName ClassColumnName;
+
+protected:
+	TSharedRef<ITableRow> OnGenerateCycleRow(FDependencyCyclePtr InCycle, const TSharedRef<class STableViewBase>& OwnerTable);
+	TSharedRef<ITableRow> OnGenerateFileRow(FPakFileEntryPtr InFile, const TSharedRef<class STableViewBase>& OwnerTable);
+	void OnCycleSelectionChanged(FDependencyCyclePtr InCycle, ESelectInfo::Type SelectInfo);
+	void OnFileDoubleClicked(FPakFileEntryPtr InFile);
+	TSharedPtr<SWidget> OnGenerateFileContextMenu();
+	void OnJumpToTreeViewExecute();
+	bool HasOneFileSelected() const;
+	FText GetSummaryText() const;
+	FReply OnRefresh();
+
+	void OnLoadPakFinished();
+	void OnParseAssetFinished();
+	void OnLoadAssetReigstryFinished();
+
+protected:
+	TSharedPtr<SListView<FDependencyCyclePtr>> CycleListView;
+	TSharedPtr<SListView<FPakFileEntryPtr>> FileListView;
+
+	TArray<FDependencyCyclePtr> Cycles;
+	TArray<FPakFileEntryPtr> CycleFiles;
+
+	int64 CyclesSize = 0;
+	double ReloadCost = 0.0;
+};
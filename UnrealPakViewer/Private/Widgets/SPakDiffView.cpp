@@ -0,0 +1,449 @@
+#include "SPakDiffView.h"
+
+#include "DesktopPlatformModule.h"
+#include "Framework/Application/SlateApplication.h"
+#include "Misc/Paths.h"
+#include "Widgets/Input/SButton.h"
+#include "Widgets/Input/SComboBox.h"
+#include "Widgets/Layout/SBox.h"
+#include "Widgets/SBoxPanel.h"
+#include "Widgets/Text/STextBlock.h"
+#include "Widgets/Views/STableRow.h"
+#include "Widgets/Views/STableViewBase.h"
+
+#include "CommonDefines.h"
+#include "PakAnalyzerModule.h"
+#include "ViewModels/ClassColumn.h"
+#include "ViewModels/WidgetDelegates.h"
+
+#define LOCTEXT_NAMESPACE "SPakDiffView"
+
+const FName SPakDiffView::TypeColumnName(TEXT("Type"));
+const FName SPakDiffView::NameColumnName(TEXT("Name"));
+const FName SPakDiffView::ClassColumnName(TEXT("Class"));
+const FName SPakDiffView::SizeDeltaColumnName(TEXT("SizeDelta"));
+const FName SPakDiffView::CompressedSizeDeltaColumnName(TEXT("CompressedSizeDelta"));
+
+static FText GetDiffTypeText(EPakDiffType InType)
+{
+	switch (InType)
+	{
+	case EPakDiffType::Added: return LOCTEXT("Added", "Added");
+	case EPakDiffType::Removed: return LOCTEXT("Removed", "Removed");
+	case EPakDiffType::Modified: return LOCTEXT("Modified", "Modified");
+	case EPakDiffType::Moved: return LOCTEXT("Moved", "Moved");
+	default: return LOCTEXT("Unchanged", "Unchanged");
+	}
+}
+
+static FLinearColor GetDiffTypeColor(EPakDiffType InType)
+{
+	switch (InType)
+	{
+	case EPakDiffType::Added: return FLinearColor::Green;
+	case EPakDiffType::Removed: return FLinearColor::Red;
+	case EPakDiffType::Modified: return FLinearColor::Yellow;
+	case EPakDiffType::Moved: return FLinearColor(0.f, 0.8f, 1.f);
+	default: return FLinearColor::White;
+	}
+}
+
+static FText GetSignedMemoryText(int64 InDelta)
+{
+	const FText Memory = FText::AsMemory(FMath::Abs(InDelta), EMemoryUnitStandard::IEC);
+	return InDelta > 0 ? FText::Format(LOCTEXT("PositiveDelta", "+{0}"), Memory) : (InDelta < 0 ? FText::Format(LOCTEXT("NegativeDelta", "-{0}"), Memory) : Memory);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+// SPakDiffRow
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+class SPakDiffRow : public SMultiColumnTableRow<FPakDiffItemPtr>
+{
+	SLATE_BEGIN_ARGS(SPakDiffRow) {}
+	SLATE_END_ARGS()
+
+public:
+	void Construct(const FArguments& InArgs, FPakDiffItemPtr InItem, const TSharedRef<STableViewBase>& InOwnerTableView)
+	{
+		WeakItem = MoveTemp(InItem);
+
+		SMultiColumnTableRow<FPakDiffItemPtr>::Construct(FSuperRowType::FArguments(), InOwnerTableView);
+	}
+
+	virtual TSharedRef<SWidget> GenerateWidgetForColumn(const FName& ColumnName) override
+	{
+		FPakDiffItemPtr ItemPin = WeakItem.Pin();
+
+		FText Text;
+		FText ToolTip;
+		FSlateColor Color = FLinearColor::White;
+		if (ItemPin.IsValid())
+		{
+			if (ColumnName == SPakDiffView::TypeColumnName)
+			{
+				Text = ItemPin->TypeText;
+				Color = ItemPin->TypeColor;
+			}
+			else if (ColumnName == SPakDiffView::NameColumnName)
+			{
+				Text = FText::FromString(ItemPin->Name);
+				ToolTip = FText::FromString(ItemPin->ToolTip);
+			}
+			else if (ColumnName == SPakDiffView::ClassColumnName)
+			{
+				if (!ItemPin->Class.IsNone())
+				{
+					Text = FText::FromName(ItemPin->Class);
+					Color = FClassColumn::GetColorByClass(*ItemPin->Class.ToString());
+				}
+			}
+			else if (ColumnName == SPakDiffView::SizeDeltaColumnName)
+			{
+				Text = GetSignedMemoryText(ItemPin->SizeDelta);
+				ToolTip = FText::AsNumber(ItemPin->SizeDelta);
+			}
+			else if (ColumnName == SPakDiffView::CompressedSizeDeltaColumnName)
+			{
+				Text = GetSignedMemoryText(ItemPin->CompressedSizeDelta);
+				ToolTip = FText::AsNumber(ItemPin->CompressedSizeDelta);
+			}
+		}
+
+		return
+			SNew(SBox).Padding(FMargin(4.0, 0.0))
+			[
+				SNew(STextBlock).Text(Text).ToolTipText(ToolTip).ColorAndOpacity(Color)
+			];
+	}
+
+protected:
+	TWeakPtr<FPakDiffItem> WeakItem;
+};
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+// SPakDiffView
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+SPakDiffView::SPakDiffView()
+{
+	FPakAnalyzerDelegates::OnPakLoadFinish.AddRaw(this, &SPakDiffView::OnLoadPakFinished);
+	FPakAnalyzerDelegates::OnPakDiffFinish.AddRaw(this, &SPakDiffView::OnDiffFinished);
+}
+
+SPakDiffView::~SPakDiffView()
+{
+	FPakAnalyzerDelegates::OnPakLoadFinish.RemoveAll(this);
+	FPakAnalyzerDelegates::OnPakDiffFinish.RemoveAll(this);
+}
+
+void SPakDiffView::Construct(const FArguments& InArgs)
+{
+	Groupings.Add(MakeShared<EDiffGrouping>(EDiffGrouping::Files));
+	Groupings.Add(MakeShared<EDiffGrouping>(EDiffGrouping::Folders));
+	Groupings.Add(MakeShared<EDiffGrouping>(EDiffGrouping::Classes));
+	SelectedGrouping = Groupings[0];
+
+	ChildSlot
+	[
+		SNew(SVerticalBox)
+
+		+ SVerticalBox::Slot().AutoHeight().Padding(2.f)
+		[
+			SNew(SHorizontalBox)
+
+			+ SHorizontalBox::Slot().AutoWidth().Padding(2.f, 0.f)
+			[
+				SNew(SButton)
+				.Text(LOCTEXT("Compare", "Compare With..."))
+				.ToolTipText(LOCTEXT("CompareTip", "Choose the paks of another build to compare the loaded paks with"))
+				.IsEnabled_Lambda([this]() { return !IsDiffing(); })
+				.OnClicked(this, &SPakDiffView::OnCompare)
+			]
+
+			+ SHorizontalBox::Slot().AutoWidth().Padding(2.f, 0.f)
+			[
+				SNew(SButton)
+				.Text(LOCTEXT("Cancel", "Cancel"))
+				.ToolTipText(LOCTEXT("CancelTip", "Stop the running comparison"))
+				.IsEnabled(this, &SPakDiffView::IsDiffing)
+				.OnClicked(this, &SPakDiffView::OnCancel)
+			]
+
+			+ SHorizontalBox::Slot().AutoWidth().VAlign(VAlign_Center).Padding(6.f, 0.f, 2.f, 0.f)
+			[
+				SNew(STextBlock).Text(LOCTEXT("GroupBy", "Group By:"))
+			]
+
+			+ SHorizontalBox::Slot().AutoWidth().Padding(2.f, 0.f)
+			[
+				SNew(SBox).WidthOverride(100.f)
+				[
+					SNew(SComboBox<TSharedPtr<EDiffGrouping>>)
+					.OptionsSource(&Groupings)
+					.OnGenerateWidget(this, &SPakDiffView::OnGenerateGroupingWidget)
+					.OnSelectionChanged(this, &SPakDiffView::OnGroupingSelectionChanged)
+					.InitiallySelectedItem(SelectedGrouping)
+					.Content()
+					[
+						SNew(STextBlock).Text(this, &SPakDiffView::GetSelectedGroupingText)
+					]
+				]
+			]
+		]
+
+		+ SVerticalBox::Slot().AutoHeight().Padding(4.f, 2.f)
+		[
+			SNew(STextBlock).Text(this, &SPakDiffView::GetSummaryText).AutoWrapText(true)
+		]
+
+		+ SVerticalBox::Slot().FillHeight(1.f)
+		[
+			SAssignNew(DiffListView, SListView<FPakDiffItemPtr>)
+			.ItemHeight(20.f)
+			.SelectionMode(ESelectionMode::Single)
+			.ListItemsSource(&Items)
+			.OnGenerateRow(this, &SPakDiffView::OnGenerateRow)
+			.OnMouseButtonDoubleClick(this, &SPakDiffView::OnItemDoubleClicked)
+			.HeaderRow
+			(
+				SNew(SHeaderRow)
+				+ SHeaderRow::Column(TypeColumnName).DefaultLabel(LOCTEXT("TypeColumn", "Type")).DefaultTooltip(LOCTEXT("TypeColumnTip", "Change of the file, or counts of added/removed/modified/moved files of the group")).ManualWidth(140.f)
+				+ SHeaderRow::Column(NameColumnName).DefaultLabel(LOCTEXT("NameColumn", "Name")).DefaultTooltip(LOCTEXT("NameColumnTip", "Double click a file in the loaded paks to show it in tree view")).FillWidth(1.f)
+				+ SHeaderRow::Column(ClassColumnName).DefaultLabel(LOCTEXT("ClassColumn", "Class")).ManualWidth(150.f)
+				+ SHeaderRow::Column(SizeDeltaColumnName).DefaultLabel(LOCTEXT("SizeDeltaColumn", "Size Delta")).ManualWidth(120.f)
+				+ SHeaderRow::Column(CompressedSizeDeltaColumnName).DefaultLabel(LOCTEXT("CompressedSizeDeltaColumn", "Compressed Size Delta")).ManualWidth(140.f)
+			)
+		]
+	];
+}
+
+void SPakDiffView::Reload()
+{
+	DiffResult.Reset();
+	LoadedFiles.Empty();
+
+	IPakAnalyzer* PakAnalyzer = IPakAnalyzerModule::Get().GetPakAnalyzer();
+	if (PakAnalyzer && ComparedPaks.Num() > 0)
+	{
+		PakAnalyzer->StartDiffPakFiles(ComparedPaks, ComparedKeys);
+	}
+
+	FillItems();
+}
+
+void SPakDiffView::OnDiffFinished(TSharedPtr<FPakDiffResult> InResult, const TArray<FString>& InKeys)
+{
+	DiffResult = InResult;
+	ComparedKeys = InKeys;
+	LoadedFiles.Empty();
+
+	IPakAnalyzer* PakAnalyzer = IPakAnalyzerModule::Get().GetPakAnalyzer();
+	if (PakAnalyzer && DiffResult.IsValid())
+	{
+		// Later paks override earlier ones, same as the diff does
+		TArray<FPakFileEntryPtr> Files;
+		PakAnalyzer->GetFiles(TEXT(""), TMap<FName, bool>(), TMap<int32, bool>(), Files);
+		for (const FPakFileEntryPtr& File : Files)
+		{
+			FPakFileEntryPtr& Existing = LoadedFiles.FindOrAdd(File->Path);
+			if (!Existing.IsValid() || Existing->OwnerPakIndex < File->OwnerPakIndex)
+			{
+				Existing = File;
+			}
+		}
+	}
+
+	FillItems();
+}
+
+void SPakDiffView::FillItems()
+{
+	Items.Empty();
+
+	if (DiffResult.IsValid())
+	{
+		if (*SelectedGrouping == EDiffGrouping::Files)
+		{
+			Items.Reserve(DiffResult->Entries.Num());
+			for (const FPakDiffEntry& Entry : DiffResult->Entries)
+			{
+				FPakDiffItemPtr Item = MakeShared<FPakDiffItem>();
+				Item->Name = Entry.Path;
+				Item->ToolTip = Entry.Type == EPakDiffType::Moved ? FString::Printf(TEXT("%s -> %s"), *Entry.OldPath, *Entry.Path) : Entry.Path;
+				Item->Class = Entry.Class;
+				Item->TypeText = GetDiffTypeText(Entry.Type);
+				Item->TypeColor = GetDiffTypeColor(Entry.Type);
+				Item->SizeDelta = Entry.NewSize - Entry.OldSize;
+				Item->CompressedSizeDelta = Entry.NewCompressedSize - Entry.OldCompressedSize;
+				if (Entry.Type != EPakDiffType::Added)
+				{
+					Item->LoadedPath = Entry.Type == EPakDiffType::Moved ? Entry.OldPath : Entry.Path;
+				}
+				Items.Add(Item);
+			}
+		}
+		else
+		{
+			const TArray<FPakDiffGroup>& Groups = *SelectedGrouping == EDiffGrouping::Folders ? DiffResult->Folders : DiffResult->Classes;
+			Items.Reserve(Groups.Num());
+			for (const FPakDiffGroup& Group : Groups)
+			{
+				FPakDiffItemPtr Item = MakeShared<FPakDiffItem>();
+				Item->Name = Group.Name;
+				Item->ToolTip = Group.Name;
+				if (*SelectedGrouping == EDiffGrouping::Classes)
+				{
+					Item->Class = *Group.Name;
+				}
+				Item->TypeText = FText::Format(LOCTEXT("GroupCounts", "+{0} -{1} ~{2} >{3}"),
+					FText::AsNumber(Group.Counts[(int32)EPakDiffType::Added]), FText::AsNumber(Group.Counts[(int32)EPakDiffType::Removed]),
+					FText::AsNumber(Group.Counts[(int32)EPakDiffType::Modified]), FText::AsNumber(Group.Counts[(int32)EPakDiffType::Moved]));
+				Item->SizeDelta = Group.SizeDelta;
+				Item->CompressedSizeDelta = Group.CompressedSizeDelta;
+				Items.Add(Item);
+			}
+		}
+	}
+
+	DiffListView->RebuildList();
+}
+
+TSharedRef<ITableRow> SPakDiffView::OnGenerateRow(FPakDiffItemPtr InItem, const TSharedRef<STableViewBase>& OwnerTable)
+{
+	return SNew(SPakDiffRow, InItem, OwnerTable);
+}
+
+void SPakDiffView::OnItemDoubleClicked(FPakDiffItemPtr InItem)
+{
+	if (!InItem.IsValid() || InItem->LoadedPath.IsEmpty())
+	{
+		return;
+	}
+
+	const FPakFileEntryPtr* File = LoadedFiles.Find(InItem->LoadedPath);
+	if (File && File->IsValid())
+	{
+		FWidgetDelegates::GetOnSwitchToTreeViewDelegate().Broadcast((*File)->Path, (*File)->OwnerPakIndex);
+	}
+}
+
+TSharedRef<SWidget> SPakDiffView::OnGenerateGroupingWidget(TSharedPtr<EDiffGrouping> InGrouping) const
+{
+	return SNew(STextBlock).Text(GetGroupingText(InGrouping));
+}
+
+void SPakDiffView::OnGroupingSelectionChanged(TSharedPtr<EDiffGrouping> InGrouping, ESelectInfo::Type SelectInfo)
+{
+	if (InGrouping.IsValid())
+	{
+		SelectedGrouping = InGrouping;
+		FillItems();
+	}
+}
+
+FText SPakDiffView::GetGroupingText(TSharedPtr<EDiffGrouping> InGrouping) const
+{
+	if (!InGrouping.IsValid())
+	{
+		return FText();
+	}
+
+	switch (*InGrouping)
+	{
+	case EDiffGrouping::Folders: return LOCTEXT("Folders", "Folders");
+	case EDiffGrouping::Classes: return LOCTEXT("Classes", "Classes");
+	default: return LOCTEXT("Files", "Files");
+	}
+}
+
+FText SPakDiffView::GetSelectedGroupingText() const
+{
+	return GetGroupingText(SelectedGrouping);
+}
+
+FText SPakDiffView::GetSummaryText() const
+{
+	if (IsDiffing())
+	{
+		return FText::Format(LOCTEXT("Diffing", "Comparing with {0} paks..."), FText::AsNumber(ComparedPaks.Num()));
+	}
+
+	if (!DiffResult.IsValid())
+	{
+		return LOCTEXT("NoDiff", "Compare the loaded paks with the paks of another build to list what changed.");
+	}
+
+	const FPakDiffGroup& Total = DiffResult->Total;
+	return FText::Format(LOCTEXT("DiffSummary", "Compared with {0} paks: {1} added, {2} removed, {3} modified, {4} moved, {5} unchanged. Size {6}, compressed size {7}."),
+		FText::AsNumber(ComparedPaks.Num()),
+		FText::AsNumber(Total.Counts[(int32)EPakDiffType::Added]),
+		FText::AsNumber(Total.Counts[(int32)EPakDiffType::Removed]),
+		FText::AsNumber(Total.Counts[(int32)EPakDiffType::Modified]),
+		FText::AsNumber(Total.Counts[(int32)EPakDiffType::Moved]),
+		FText::AsNumber(Total.Counts[(int32)EPakDiffType::Unchanged]),
+		GetSignedMemoryText(Total.SizeDelta),
+		GetSignedMemoryText(Total.CompressedSizeDelta));
+}
+
+FReply SPakDiffView::OnCompare()
+{
+	TArray<FString> OutFiles;
+	bool bOpened = false;
+
+	IDesktopPlatform* DesktopPlatform = FDesktopPlatformModule::Get();
+	if (DesktopPlatform)
+	{
+		FSlateApplication::Get().CloseToolTip();
+
+		bOpened = DesktopPlatform->OpenFileDialog
+		(
+			FSlateApplication::Get().FindBestParentWindowHandleForDialogs(nullptr),
+			LOCTEXT("ComparePak_FileDesc", "Open pak files to compare with...").ToString(),
+			TEXT(""),
+			TEXT(""),
+			LOCTEXT("ComparePak_FileFilter", "Pak files (*.pak)|*.pak|All files (*.*)|*.*").ToString(),
+			EFileDialogFlags::Multiple,
+			OutFiles
+		);
+	}
+
+	if (bOpened && OutFiles.Num() > 0)
+	{
+		ComparedPaks.Empty();
+		ComparedKeys.Empty();
+		for (const FString& File : OutFiles)
+		{
+			ComparedPaks.Add(FPaths::ConvertRelativePathToFull(File));
+		}
+
+		Reload();
+	}
+
+	return FReply::Handled();
+}
+
+FReply SPakDiffView::OnCancel()
+{
+	IPakAnalyzer* PakAnalyzer = IPakAnalyzerModule::Get().GetPakAnalyzer();
+	if (PakAnalyzer)
+	{
+		PakAnalyzer->CancelDiffPakFiles();
+	}
+
+	return FReply::Handled();
+}
+
+bool SPakDiffView::IsDiffing() const
+{
+	IPakAnalyzer* PakAnalyzer = IPakAnalyzerModule::Get().GetPakAnalyzer();
+	return PakAnalyzer && PakAnalyzer->IsDiffingPakFiles();
+}
+
+void SPakDiffView::OnLoadPakFinished()
+{
+	// The compared file table is cached in the analyzer, only the loaded side is joined again
+	Reload();
+}
+
+#undef LOCTEXT_NAMESPACE
@@ -0,0 +1,89 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Widgets/SCompoundWidget.h"
+#include "Widgets/Views/SListView.h"
+
+#include "PakFileEntry.h"
+
+/** One row of the diff list, a changed file or a folder/class group. */
+struct FPakDiffItem
+{
+	FString Name;
+	FString ToolTip;
+	FName Class;
+	FText TypeText;
+	FSlateColor TypeColor = FLinearColor::White;
+
+	int64 SizeDelta = 0;
+	int64 CompressedSizeDelta = 0;
+
+	/** Path in the loaded paks, empty if the file only exists in the compared set. */
+	FString LoadedPath;
+};
+
+typedef TSharedPtr<FPakDiffItem> FPakDiffItemPtr;
+
+/** Compares the loaded paks with another pak set. */
+class SPakDiffView : public SCompoundWidget
+{
+public:
+	enum class EDiffGrouping : uint8
+	{
+		Files,
+		Folders,
+		Classes,
+	};
+
+	/** Default constructor. */
+	SPakDiffView();
+
+	/** Virtual destructor. */
+	virtual ~SPakDiffView();
+
+	SLATE_BEGIN_ARGS(SPakDiffView) {}
+	SLATE_END_ARGS()
+
+	/** Constructs this widget. */
+	void Construct(const FArguments& InArgs);
+
+	/** Starts diffing in background, the list is filled when it finishes. */
+	void Reload();
+
+	static const FName TypeColumnName;
+	static const FName NameColumnName;
+	static const FName ClassColumnName;
+	static const FName SizeDeltaColumnName;
+	static const FName CompressedSizeDeltaColumnName;
+
+protected:
+	TSharedRef<ITableRow> OnGenerateRow(FPakDiffItemPtr InItem, const TSharedRef<class STableViewBase>& OwnerTable);
+	void OnItemDoubleClicked(FPakDiffItemPtr InItem);
+	TSharedRef<SWidget> OnGenerateGroupingWidget(TSharedPtr<EDiffGrouping> InGrouping) const;
+	void OnGroupingSelectionChanged(TSharedPtr<EDiffGrouping> InGrouping, ESelectInfo::Type SelectInfo);
+	FText GetGroupingText(TSharedPtr<EDiffGrouping> InGrouping) const;
+	FText GetSelectedGroupingText() const;
+	FText GetSummaryText() const;
+	FReply OnCompare();
+	FReply OnCancel();
+	bool IsDiffing() const;
+
+	void FillItems();
+
+	void OnLoadPakFinished();
+	void OnDiffFinished(TSharedPtr<FPakDiffResult> InResult, const TArray<FString>& InKeys);
+
+protected:
+	TSharedPtr<SListView<FPakDiffItemPtr>> DiffListView;
+
+	TArray<FPakDiffItemPtr> Items;
+	TArray<TSharedPtr<EDiffGrouping>> Groupings;
+	TSharedPtr<EDiffGrouping> SelectedGrouping;
+
+	TArray<FString> ComparedPaks;
+
+	/** Keys resolved for the compared paks, passed back so a reload doesn't ask again. */
+	TArray<FString> ComparedKeys;
+	TSharedPtr<FPakDiffResult> DiffResult;
+	TMap<FString, FPakFileEntryPtr> LoadedFiles;
+};
@@ -0,0 +1,350 @@
+#include "SPakDuplicateView.h"
+
+#include "Framework/MultiBox/MultiBoxBuilder.h"
+#include "HAL/PlatformTime.h"
+#include "Misc/Paths.h"
+#include "Widgets/Input/SButton.h"
+#include "Widgets/Layout/SBox.h"
+#include "Widgets/Layout/SSplitter.h"
+#include "Widgets/SBoxPanel.h"
+#include "Widgets/Text/STextBlock.h"
+#include "Widgets/Views/STableRow.h"
+#include "Widgets/Views/STableViewBase.h"
+
+#include "CommonDefines.h"
+#include "PakAnalyzerModule.h"
+#include "UnrealPakViewerStyle.h"
+#include "ViewModels/ClassColumn.h"
+#include "ViewModels/WidgetDelegates.h"
+
+#define LOCTEXT_NAMESPACE "SPakDuplicateView"
+
+const FName SPakDuplicateView::CopiesColumnName(TEXT("Copies"));
+const FName SPakDuplicateView::NameColumnName(TEXT("Name"));
+const FName SPakDuplicateView::PakColumnName(TEXT("Pak"));
+const FName SPakDuplicateView::ClassColumnName(TEXT("Class"));
+const FName SPakDuplicateView::SizeColumnName(TEXT("Size"));
+const FName SPakDuplicateView::CompressedSizeColumnName(TEXT("CompressedSize"));
+const FName SPakDuplicateView::WastedSizeColumnName(TEXT("WastedSize"));
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+// SPakDuplicateRow
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+class SPakDuplicateRow : public SMultiColumnTableRow<FDuplicateGroupPtr>
+{
+	SLATE_BEGIN_ARGS(SPakDuplicateRow) {}
+	SLATE_END_ARGS()
+
+public:
+	void Construct(const FArguments& InArgs, FDuplicateGroupPtr InGroup, const TSharedRef<STableViewBase>& InOwnerTableView)
+	{
+		WeakGroup = MoveTemp(InGroup);
+
+		SMultiColumnTableRow<FDuplicateGroupPtr>::Construct(FSuperRowType::FArguments(), InOwnerTableView);
+	}
+
+	virtual TSharedRef<SWidget> GenerateWidgetForColumn(const FName& ColumnName) override
+	{
+		FDuplicateGroupPtr GroupPin = WeakGroup.Pin();
+
+		FText Text;
+		FText ToolTip;
+		if (GroupPin.IsValid())
+		{
+			if (ColumnName == SPakDuplicateView::CopiesColumnName)
+			{
+				Text = FText::AsNumber(GroupPin->Files.Num());
+			}
+			else if (ColumnName == SPakDuplicateView::NameColumnName)
+			{
+				Text = FText::FromString(GroupPin->Files[0]->Path);
+				ToolTip = Text;
+			}
+			else if (ColumnName == SPakDuplicateView::SizeColumnName)
+			{
+				Text = FText::AsMemory(GroupPin->Size, EMemoryUnitStandard::IEC);
+				ToolTip = FText::AsNumber(GroupPin->Size);
+			}
+			else if (ColumnName == SPakDuplicateView::WastedSizeColumnName)
+			{
+				Text = FText::AsMemory(GroupPin->WastedSize, EMemoryUnitStandard::IEC);
+				ToolTip = FText::AsNumber(GroupPin->WastedSize);
+			}
+		}
+
+		return
+			SNew(SBox).Padding(FMargin(4.0, 0.0))
+			[
+				SNew(STextBlock).Text(Text).ToolTipText(ToolTip)
+			];
+	}
+
+protected:
+	TWeakPtr<FDuplicateGroup> WeakGroup;
+};
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+// SPakDuplicateFileRow
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+class SPakDuplicateFileRow : public SMultiColumnTableRow<FPakFileEntryPtr>
+{
+	SLATE_BEGIN_ARGS(SPakDuplicateFileRow) {}
+	SLATE_END_ARGS()
+
+public:
+	void Construct(const FArguments& InArgs, FPakFileEntryPtr InFile, const TSharedRef<STableViewBase>& InOwnerTableView)
+	{
+		WeakFile = MoveTemp(InFile);
+
+		SMultiColumnTableRow<FPakFileEntryPtr>::Construct(FSuperRowType::FArguments(), InOwnerTableView);
+	}
+
+	virtual TSharedRef<SWidget> GenerateWidgetForColumn(const FName& ColumnName) override
+	{
+		FPakFileEntryPtr FilePin = WeakFile.Pin();
+
+		FText Text;
+		FText ToolTip;
+		FSlateColor Color = FLinearColor::White;
+		if (FilePin.IsValid())
+		{
+			if (ColumnName == SPakDuplicateView::NameColumnName)
+			{
+				Text = FText::FromString(FilePin->Path);
+				ToolTip = Text;
+			}
+			else if (ColumnName == SPakDuplicateView::PakColumnName)
+			{
+				const TArray<FPakFileSumaryPtr>& Summaries = IPakAnalyzerModule::Get().GetPakAnalyzer()->GetPakFileSumary();
+				if (Summaries.IsValidIndex(FilePin->OwnerPakIndex))
+				{
+					Text = FText::FromString(FPaths::GetCleanFilename(Summaries[FilePin->OwnerPakIndex]->PakFilePath));
+					ToolTip = FText::FromString(Summaries[FilePin->OwnerPakIndex]->PakFilePath);
+				}
+			}
+			else if (ColumnName == SPakDuplicateView::ClassColumnName)
+			{
+				Text = FText::FromName(FilePin->Class);
+				Color = FClassColumn::GetColorByClass(*FilePin->Class.ToString());
+			}
+			else if (ColumnName == SPakDuplicateView::CompressedSizeColumnName)
+			{
+				Text = FText::AsMemory(FilePin->PakEntry.Size, EMemoryUnitStandard::IEC);
+				ToolTip = FText::AsNumber(FilePin->PakEntry.Size);
+			}
+		}
+
+		return
+			SNew(SBox).Padding(FMargin(4.0, 0.0))
+			[
+				SNew(STextBlock).Text(Text).ToolTipText(ToolTip).ColorAndOpacity(Color)
+			];
+	}
+
+protected:
+	TWeakPtr<FPakFileEntry> WeakFile;
+};
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+// SPakDuplicateView
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+SPakDuplicateView::SPakDuplicateView()
+{
+	FPakAnalyzerDelegates::OnPakLoadFinish.AddRaw(this, &SPakDuplicateView::OnLoadPakFinished);
+	FPakAnalyzerDelegates::OnAssetParseFinish.AddRaw(this, &SPakDuplicateView::OnParseAssetFinished);
+}
+
+SPakDuplicateView::~SPakDuplicateView()
+{
+	FPakAnalyzerDelegates::OnPakLoadFinish.RemoveAll(this);
+	FPakAnalyzerDelegates::OnAssetParseFinish.RemoveAll(this);
+}
+
+void SPakDuplicateView::Construct(const FArguments& InArgs)
+{
+	ChildSlot
+	[
+		SNew(SVerticalBox)
+
+		+ SVerticalBox::Slot().AutoHeight().Padding(2.f)
+		[
+			SNew(SHorizontalBox)
+
+			+ SHorizontalBox::Slot().FillWidth(1.f).VAlign(VAlign_Center)
+			[
+				SNew(STextBlock).Text(this, &SPakDuplicateView::GetSummaryText)
+			]
+
+			+ SHorizontalBox::Slot().AutoWidth()
+			[
+				SNew(SButton)
+				.Text(LOCTEXT("Refresh", "Refresh"))
+				.ToolTipText(LOCTEXT("RefreshTip", "Find duplicate files again"))
+				.OnClicked(this, &SPakDuplicateView::OnRefresh)
+			]
+		]
+
+		+ SVerticalBox::Slot().FillHeight(1.f)
+		[
+			SNew(SSplitter).Orientation(Orient_Vertical)
+
+			+ SSplitter::Slot().Value(0.5f)
+			[
+				SAssignNew(GroupListView, SListView<FDuplicateGroupPtr>)
+				.ItemHeight(20.f)
+				.SelectionMode(ESelectionMode::Single)
+				.ListItemsSource(&Groups)
+				.OnGenerateRow(this, &SPakDuplicateView::OnGenerateGroupRow)
+				.OnSelectionChanged(this, &SPakDuplicateView::OnGroupSelectionChanged)
+				.HeaderRow
+				(
+					SNew(SHeaderRow)
+					+ SHeaderRow::Column(CopiesColumnName).DefaultLabel(LOCTEXT("CopiesColumn", "Copies")).DefaultTooltip(LOCTEXT("CopiesColumnTip", "How many entries share the same content")).ManualWidth(80.f)
+					+ SHeaderRow::Column(SizeColumnName).DefaultLabel(LOCTEXT("SizeColumn", "Size")).DefaultTooltip(LOCTEXT("SizeColumnTip", "Original size of one copy")).ManualWidth(120.f)
+					+ SHeaderRow::Column(WastedSizeColumnName).DefaultLabel(LOCTEXT("WastedSizeColumn", "Wasted Size")).DefaultTooltip(LOCTEXT("WastedSizeColumnTip", "Compressed size of all copies but the smallest one")).ManualWidth(120.f)
+					+ SHeaderRow::Column(NameColumnName).DefaultLabel(LOCTEXT("GroupNameColumn", "File")).DefaultTooltip(LOCTEXT("GroupNameColumnTip", "One of the copies")).FillWidth(1.f)
+				)
+			]
+
+			+ SSplitter::Slot().Value(0.5f)
+			[
+				SAssignNew(FileListView, SListView<FPakFileEntryPtr>)
+				.ItemHeight(20.f)
+				.SelectionMode(ESelectionMode::Single)
+				.ListItemsSource(&GroupFiles)
+				.OnGenerateRow(this, &SPakDuplicateView::OnGenerateFileRow)
+				.OnMouseButtonDoubleClick(this, &SPakDuplicateView::OnFileDoubleClicked)
+				.OnContextMenuOpening(this, &SPakDuplicateView::OnGenerateFileContextMenu)
+				.HeaderRow
+				(
+					SNew(SHeaderRow)
+					+ SHeaderRow::Column(NameColumnName).DefaultLabel(LOCTEXT("PathColumn", "Path")).DefaultTooltip(LOCTEXT("PathColumnTip", "Copy of the selected content, double click to show it in tree view")).FillWidth(1.f)
+					+ SHeaderRow::Column(PakColumnName).DefaultLabel(LOCTEXT("PakColumn", "Pak")).ManualWidth(200.f)
+					+ SHeaderRow::Column(ClassColumnName).DefaultLabel(LOCTEXT("ClassColumn", "Class")).ManualWidth(150.f)
+					+ SHeaderRow::Column(CompressedSizeColumnName).DefaultLabel(LOCTEXT("CompressedSizeColumn", "Compressed Size")).ManualWidth(120.f)
+				)
+			]
+		]
+	];
+}
+
+void SPakDuplicateView::Reload()
+{
+	const double StartTime = FPlatformTime::Seconds();
+
+	Groups.Empty();
+	GroupFiles.Empty();
+	TotalWastedSize = 0;
+
+	IPakAnalyzer* PakAnalyzer = IPakAnalyzerModule::Get().GetPakAnalyzer();
+	if (PakAnalyzer)
+	{
+		PakAnalyzer->GetDuplicateFiles(Groups);
+	}
+
+	for (const FDuplicateGroupPtr& Group : Groups)
+	{
+		TotalWastedSize += Group->WastedSize;
+	}
+
+	ReloadCost = FPlatformTime::Seconds() - StartTime;
+
+	GroupListView->RebuildList();
+	FileListView->RebuildList();
+}
+
+TSharedRef<ITableRow> SPakDuplicateView::OnGenerateGroupRow(FDuplicateGroupPtr InGroup, const TSharedRef<STableViewBase>& OwnerTable)
+{
+	return SNew(SPakDuplicateRow, InGroup, OwnerTable);
+}
+
+TSharedRef<ITableRow> SPakDuplicateView::OnGenerateFileRow(FPakFileEntryPtr InFile, const TSharedRef<STableViewBase>& OwnerTable)
+{
+	return SNew(SPakDuplicateFileRow, InFile, OwnerTable);
+}
+
+void SPakDuplicateView::OnGroupSelectionChanged(FDuplicateGroupPtr InGroup, ESelectInfo::Type SelectInfo)
+{
+	GroupFiles.Empty();
+
+	if (InGroup.IsValid())
+	{
+		GroupFiles = InGroup->Files;
+	}
+
+	FileListView->RebuildList();
+}
+
+void SPakDuplicateView::OnFileDoubleClicked(FPakFileEntryPtr InFile)
+{
+	if (InFile.IsValid())
+	{
+		FWidgetDelegates::GetOnSwitchToTreeViewDelegate().Broadcast(InFile->Path, InFile->OwnerPakIndex);
+	}
+}
+
+TSharedPtr<SWidget> SPakDuplicateView::OnGenerateFileContextMenu()
+{
+	FMenuBuilder MenuBuilder(true, nullptr);
+
+	MenuBuilder.BeginSection("Operation", LOCTEXT("ContextMenu_Header_Operation", "Operation"));
+	{
+		FUIAction Action_JumpToTreeView
+		(
+			FExecuteAction::CreateSP(this, &SPakDuplicateView::OnJumpToTreeViewExecute),
+			FCanExecuteAction::CreateSP(this, &SPakDuplicateView::HasOneFileSelected)
+		);
+		MenuBuilder.AddMenuEntry
+		(
+			LOCTEXT("ContextMenu_Columns_JumpToTreeView", "Show In Tree View"),
+			LOCTEXT("ContextMenu_Columns_JumpToTreeView_Desc", "Show current selected file in tree view"),
+			FSlateIcon(FUnrealPakViewerStyle::GetStyleSetName(), "Find"), Action_JumpToTreeView, NAME_None, EUserInterfaceActionType::Button
+		);
+	}
+	MenuBuilder.EndSection();
+
+	return MenuBuilder.MakeWidget();
+}
+
+void SPakDuplicateView::OnJumpToTreeViewExecute()
+{
+	TArray<FPakFileEntryPtr> SelectedItems = FileListView->GetSelectedItems();
+	if (SelectedItems.Num() > 0)
+	{
+		OnFileDoubleClicked(SelectedItems[0]);
+	}
+}
+
+bool SPakDuplicateView::HasOneFileSelected() const
+{
+	return FileListView->GetNumItemsSelected() == 1;
+}
+
+FText SPakDuplicateView::GetSummaryText() const
+{
+	return FText::Format(LOCTEXT("DuplicateSummary", "{0} duplicate groups, {1} compressed wasted, found in {2}ms."), FText::AsNumber(Groups.Num()), FText::AsMemory(TotalWastedSize, EMemoryUnitStandard::IEC), FText::AsNumber(FMath::RoundToInt(ReloadCost * 1000.0)));
+}
+
+FReply SPakDuplicateView::OnRefresh()
+{
+	Reload();
+
+	return FReply::Handled();
+}
+
+void SPakDuplicateView::OnLoadPakFinished()
+{
+	Reload();
+}
+
+void SPakDuplicateView::OnParseAssetFinished()
+{
+	// Classes may have changed, the groups themselves don't
+	GroupListView->RebuildList();
+	FileListView->RebuildList();
+}
+
+#undef LOCTEXT_NAMESPACE
@@ -0,0 +1,58 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Widgets/SCompoundWidget.h"
+#include "Widgets/Views/SListView.h"
+
+#include "PakFileEntry.h"
+
+/** Lists content stored more than once across the loaded paks, ranked by wasted compressed size. */
+class SPakDuplicateView : public SCompoundWidget
+{
+public:
+	/** Default constructor. */
+	SPakDuplicateView();
+
+	/** Virtual destructor. */
+	virtual ~SPakDuplicateView();
+
+	SLATE_BEGIN_ARGS(SPakDuplicateView) {}
+	SLATE_END_ARGS()
+
+	/** Constructs this widget. */
+	void Construct(const FArguments& InArgs);
+
+	void Reload();
+
+	static const FName CopiesColumnName;
+	static const FName NameColumnName;
+	static const FName PakColumnName;
+	static const FName ClassColumnName;
+	static const FName SizeColumnName;
+	static const FName CompressedSizeColumnName;
+	static const FName WastedSizeColumnName;
+
+protected:
+	TSharedRef<ITableRow> OnGenerateGroupRow(FDuplicateGroupPtr InGroup, const TSharedRef<class STableViewBase>& OwnerTable);
+	TSharedRef<ITableRow> OnGenerateFileRow(FPakFileEntryPtr InFile, const TSharedRef<class STableViewBase>& OwnerTable);
+	void OnGroupSelectionChanged(FDuplicateGroupPtr InGroup, ESelectInfo::Type SelectInfo);
+	void OnFileDoubleClicked(FPakFileEntryPtr InFile);
+	TSharedPtr<SWidget> OnGenerateFileContextMenu();
+	void OnJumpToTreeViewExecute();
+	bool HasOneFileSelected() const;
+	FText GetSummaryText() const;
+	FReply OnRefresh();
+
+	void OnLoadPakFinished();
+	void OnParseAssetFinished();
+
+protected:
+	TSharedPtr<SListView<FDuplicateGroupPtr>> GroupListView;
+	TSharedPtr<SListView<FPakFileEntryPtr>> FileListView;
+
+	TArray<FDuplicateGroupPtr> Groups;
+	TArray<FPakFileEntryPtr> GroupFiles;
+
+	int64 TotalWastedSize = 0;
+	double ReloadCost = 0.0;
+};
@@ -421,7 +421,7 @@ protected:
 		FPakFileEntryPtr PakFileItemPin = WeakPakFileItem.Pin();
 		if (PakFileItemPin.IsValid() && PakFileItemPin->AssetSummary.IsValid())
 		{
-			return FText::AsNumber(PakFileItemPin->AssetSummary->DependencyList.Num());
+			return FText::AsNumber(PakFileItemPin->AssetSummary->GetDependencyCount());
 		}
 
 		return FText::AsNumber(0);
@@ -432,7 +432,7 @@ protected:
 		FPakFileEntryPtr PakFileItemPin = WeakPakFileItem.Pin();
 		if (PakFileItemPin.IsValid() && PakFileItemPin->AssetSummary.IsValid())
 		{
-			return FText::AsNumber(PakFileItemPin->AssetSummary->DependentList.Num());
+			return FText::AsNumber(PakFileItemPin->AssetSummary->GetDependentCount());
 		}
 
 		return FText::AsNumber(0);
@@ -451,6 +451,7 @@ SPakFileView::SPakFileView()
 	FWidgetDelegates::GetOnLoadAssetRegistryFinishedDelegate().AddRaw(this, &SPakFileView::OnLoadAssetReigstryFinished);
 	FPakAnalyzerDelegates::OnPakLoadFinish.AddRaw(this, &SPakFileView::OnLoadPakFinished);
 	FPakAnalyzerDelegates::OnAssetParseFinish.AddRaw(this, &SPakFileView::OnParseAssetFinished);
+	FPakAnalyzerDelegates::OnPackagesParsed.AddRaw(this, &SPakFileView::OnPackagesParsed);
 }
 
 SPakFileView::~SPakFileView()
@@ -458,6 +459,7 @@ SPakFileView::~SPakFileView()
 	FWidgetDelegates::GetOnLoadAssetRegistryFinishedDelegate().RemoveAll(this);
 	FPakAnalyzerDelegates::OnPakLoadFinish.RemoveAll(this);
 	FPakAnalyzerDelegates::OnAssetParseFinish.RemoveAll(this);
+	FPakAnalyzerDelegates::OnPackagesParsed.RemoveAll(this);
 
 	if (SortAndFilterTask.IsValid())
 	{
@@ -562,6 +564,7 @@ void SPakFileView::Construct(const FArguments& InArgs)
 				.SelectionMode(ESelectionMode::Multi)
 				//.OnMouseButtonClick()
 				//.OnSelectiongChanged()
+				.OnSelectionChanged(this, &SPakFileView::OnSelectionChanged)
 				.ListItemsSource(&FileCache)
 				.OnGenerateRow(this, &SPakFileView::OnGenerateFileRow)
 				.ConsumeMouseWheel(EConsumeMouseWheel::Always)
@@ -655,7 +658,20 @@ TSharedPtr<SWidget> SPakFileView::OnGenerateContextMenu()
 			FSlateIcon(FUnrealPakViewerStyle::GetStyleSetName(), "Extract"),
 			FUIAction
 			(
-				FExecuteAction::CreateSP(this, &SPakFileView::OnExtract),
+				FExecuteAction::CreateSP(this, &SPakFileView::OnExtract, false),
+				FCanExecuteAction::CreateSP(this, &SPakFileView::HasFileSelected)
+			),
+			NAME_None, EUserInterfaceActionType::Button
+		);
+
+		MenuBuilder.AddMenuEntry
+		(
+			LOCTEXT("ContextMenu_ExtractWithDependencies", "Extract With Dependencies..."),
+			LOCTEXT("ContextMenu_ExtractWithDependencies_Desc", "Extract selected files and all packages they depend on, from every loaded pak"),
+			FSlateIcon(FUnrealPakViewerStyle::GetStyleSetName(), "Extract"),
+			FUIAction
+			(
+				FExecuteAction::CreateSP(this, &SPakFileView::OnExtract, true),
 				FCanExecuteAction::CreateSP(this, &SPakFileView::HasFileSelected)
 			),
 			NAME_None, EUserInterfaceActionType::Button
@@ -674,7 +690,7 @@ TSharedPtr<SWidget> SPakFileView::OnGenerateContextMenu()
 			FUIAction
 			(
 				FExecuteAction::CreateSP(this, &SPakFileView::OnExportToJson),
-				FCanExecuteAction::CreateSP(this, &SPakFileView::HasFileSelected)
+				FCanExecuteAction::CreateSP(this, &SPakFileView::CanExport)
 			),
 			NAME_None, EUserInterfaceActionType::Button
 		);
@@ -687,7 +703,33 @@ TSharedPtr<SWidget> SPakFileView::OnGenerateContextMenu()
 			FUIAction
 			(
 				FExecuteAction::CreateSP(this, &SPakFileView::OnExportToCsv),
-				FCanExecuteAction::CreateSP(this, &SPakFileView::HasFileSelected)
+				FCanExecuteAction::CreateSP(this, &SPakFileView::CanExport)
+			),
+			NAME_None, EUserInterfaceActionType::Button
+		);
+
+		MenuBuilder.AddMenuEntry
+		(
+			LOCTEXT("ContextMenu_Export_To_Columnar", "Export To Columnar..."),
+			LOCTEXT("ContextMenu_Export_To_Columnar_Desc", "Export selected file(s) info and their dependency edges to columnar binary, for notebooks and data tools"),
+			FSlateIcon(FUnrealPakViewerStyle::GetStyleSetName(), "Export"),
+			FUIAction
+			(
+				FExecuteAction::CreateSP(this, &SPakFileView::OnExportToColumnar),
+				FCanExecuteAction::CreateSP(this, &SPakFileView::CanExport)
+			),
+			NAME_None, EUserInterfaceActionType::Button
+		);
+
+		MenuBuilder.AddMenuEntry
+		(
+			LOCTEXT("ContextMenu_Export_To_Sql", "Export To SQLite Script..."),
+			LOCTEXT("ContextMenu_Export_To_Sql_Desc", "Export selected file(s) with their exports, imports and dependencies as a sqlite script, load it with sqlite3 build.db < file.sql"),
+			FSlateIcon(FUnrealPakViewerStyle::GetStyleSetName(), "Export"),
+			FUIAction
+			(
+				FExecuteAction::CreateSP(this, &SPakFileView::OnExportToSql),
+				FCanExecuteAction::CreateSP(this, &SPakFileView::CanExport)
 			),
 			NAME_None, EUserInterfaceActionType::Button
 		);
@@ -709,6 +751,18 @@ TSharedPtr<SWidget> SPakFileView::OnGenerateContextMenu()
 			FSlateIcon(FUnrealPakViewerStyle::GetStyleSetName(), "Find"), Action_JumpToTreeView, NAME_None, EUserInterfaceActionType::Button
 		);
 
+		FUIAction Action_EstimateRecompression
+		(
+			FExecuteAction::CreateSP(this, &SPakFileView::OnEstimateRecompressionExecute),
+			FCanExecuteAction::CreateSP(this, &SPakFileView::HasFileSelected)
+		);
+		MenuBuilder.AddMenuEntry
+		(
+			LOCTEXT("ContextMenu_EstimateRecompression", "Estimate Recompression"),
+			LOCTEXT("ContextMenu_EstimateRecompression_Desc", "Recompress selected files with other methods and block sizes to compare their size"),
+			FSlateIcon(FUnrealPakViewerStyle::GetStyleSetName(), "View"), Action_EstimateRecompression, NAME_None, EUserInterfaceActionType::Button
+		);
+
 		MenuBuilder.AddSubMenu
 		(
 			LOCTEXT("ContextMenu_Header_Columns_Copy", "Copy Column(s)"),
@@ -1052,199 +1106,7 @@ void SPakFileView::InitializeAndShowHeaderColumns()
 {
 	FileColumns.Empty();
 
-	// Name Column
-	FFileColumn& NameColumn = FileColumns.Emplace(FFileColumn::NameColumnName, FFileColumn(0, FFileColumn::NameColumnName, LOCTEXT("NameColumn", "Name"), LOCTEXT("NameColumnTip", "File name"), 2.f, EFileColumnFlags::ShouldBeVisible | EFileColumnFlags::CanBeFiltered));
-	NameColumn.SetAscendingCompareDelegate(
-		[](const FPakFileEntryPtr& A, const FPakFileEntryPtr& B) -> bool
-		{
-			return A->Filename.LexicalLess(B->Filename);
-		}
-	);
-	NameColumn.SetDescendingCompareDelegate(
-		[](const FPakFileEntryPtr& A, const FPakFileEntryPtr& B) -> bool
-		{
-			return B->Filename.LexicalLess(A->Filename);
-		}
-	);
-
-	// Path Column
-	FFileColumn& PathColumn = FileColumns.Emplace(FFileColumn::PathColumnName, FFileColumn(1, FFileColumn::PathColumnName, LOCTEXT("PathColumn", "Path"), LOCTEXT("PathColumnTip", "File path in pak"), 3.f, EFileColumnFlags::ShouldBeVisible | EFileColumnFlags::CanBeFiltered | EFileColumnFlags::CanBeHidden));
-	PathColumn.SetAscendingCompareDelegate(
-		[](const FPakFileEntryPtr& A, const FPakFileEntryPtr& B) -> bool
-		{
-			return A->Path < B->Path;
-		}
-	);
-	PathColumn.SetDescendingCompareDelegate(
-		[](const FPakFileEntryPtr& A, const FPakFileEntryPtr& B) -> bool
-		{
-			return B->Path < A->Path;
-		}
-	);
-
-	// Class Column
-	FFileColumn& ClassColumn = FileColumns.Emplace(FFileColumn::ClassColumnName, FFileColumn(2, FFileColumn::ClassColumnName, LOCTEXT("ClassColumn", "Class"), LOCTEXT("ClassColumnTip", "Class name in asset registry or file extension if not found"), 1.f, EFileColumnFlags::ShouldBeVisible | EFileColumnFlags::CanBeFiltered | EFileColumnFlags::CanBeHidden));
-	ClassColumn.SetAscendingCompareDelegate(
-		[](const FPakFileEntryPtr& A, const FPakFileEntryPtr& B) -> bool
-		{
-			return A->Class.LexicalLess(B->Class);
-		}
-	);
-	ClassColumn.SetDescendingCompareDelegate(
-		[](const FPakFileEntryPtr& A, const FPakFileEntryPtr& B) -> bool
-		{
-			return B->Class.LexicalLess(A->Class);
-		}
-	);
-
-	// Dependency Count Column
-	FFileColumn& DependencyCountColumn = FileColumns.Emplace(FFileColumn::DependencyCountColumnName, FFileColumn(3, FFileColumn::DependencyCountColumnName, LOCTEXT("DependencyCountColumn", "Dependency Count"), LOCTEXT("DependencyCountColumnTip", "Packages this package depends on"), 1.f, EFileColumnFlags::ShouldBeVisible | EFileColumnFlags::CanBeFiltered | EFileColumnFlags::CanBeHidden));
-	DependencyCountColumn.SetAscendingCompareDelegate(
-		[](const FPakFileEntryPtr& A, const FPakFileEntryPtr& B) -> bool
-		{
-			const int32 ACount = A->AssetSummary.IsValid() ? A->AssetSummary->DependencyList.Num() : 0;
-			const int32 BCount = B->AssetSummary.IsValid() ? B->AssetSummary->DependencyList.Num() : 0;
-			return ACount < BCount;
-		}
-	);
-	DependencyCountColumn.SetDescendingCompareDelegate(
-		[](const FPakFileEntryPtr& A, const FPakFileEntryPtr& B) -> bool
-		{
-			const int32 ACount = A->AssetSummary.IsValid() ? A->AssetSummary->DependencyList.Num() : 0;
-			const int32 BCount = B->AssetSummary.IsValid() ? B->AssetSummary->DependencyList.Num() : 0;
-			return BCount < ACount;
-		}
-	);
-
-	// Dependent Count Column
-	FFileColumn& DependentCountColumn = FileColumns.Emplace(FFileColumn::DependentCountColumnName, FFileColumn(4, FFileColumn::DependentCountColumnName, LOCTEXT("DependentCountColumn", "Dependent Count"), LOCTEXT("DependentCountColumnTip", "Packages depend on this package"), 1.f, EFileColumnFlags::ShouldBeVisible | EFileColumnFlags::CanBeFiltered | EFileColumnFlags::CanBeHidden));
-	DependentCountColumn.SetAscendingCompareDelegate(
-		[](const FPakFileEntryPtr& A, const FPakFileEntryPtr& B) -> bool
-		{
-			const int32 ACount = A->AssetSummary.IsValid() ? A->AssetSummary->DependentList.Num() : 0;
-			const int32 BCount = B->AssetSummary.IsValid() ? B->AssetSummary->DependentList.Num() : 0;
-			return ACount < BCount;
-		}
-	);
-	DependentCountColumn.SetDescendingCompareDelegate(
-		[](const FPakFileEntryPtr& A, const FPakFileEntryPtr& B) -> bool
-		{
-			const int32 ACount = A->AssetSummary.IsValid() ? A->AssetSummary->DependentList.Num() : 0;
-			const int32 BCount = B->AssetSummary.IsValid() ? B->AssetSummary->DependentList.Num() : 0;
-			return BCount < ACount;
-		}
-	);
-
-	// Offset Column
-	FFileColumn& OffsetColumn = FileColumns.Emplace(FFileColumn::OffsetColumnName, FFileColumn(5, FFileColumn::OffsetColumnName, LOCTEXT("OffsetColumn", "Offset"), LOCTEXT("OffsetColumnTip", "File offset in pak"), 1.f, EFileColumnFlags::ShouldBeVisible | EFileColumnFlags::CanBeFiltered | EFileColumnFlags::CanBeHidden));
-	OffsetColumn.SetAscendingCompareDelegate(
-		[](const FPakFileEntryPtr& A, const FPakFileEntryPtr& B) -> bool
-		{
-			return A->PakEntry.Offset < B->PakEntry.Offset;
-		}
-	);
-	OffsetColumn.SetDescendingCompareDelegate(
-		[](const FPakFileEntryPtr& A, const FPakFileEntryPtr& B) -> bool
-		{
-			return B->PakEntry.Offset < A->PakEntry.Offset;
-		}
-	);
-
-	// Size Column
-	FFileColumn& SizeColumn = FileColumns.Emplace(FFileColumn::SizeColumnName, FFileColumn(6, FFileColumn::SizeColumnName, LOCTEXT("SizeColumn", "Size"), LOCTEXT("SizeColumnTip", "File original size"), 1.f, EFileColumnFlags::ShouldBeVisible | EFileColumnFlags::CanBeFiltered | EFileColumnFlags::CanBeHidden));
-	SizeColumn.SetAscendingCompareDelegate(
-		[](const FPakFileEntryPtr& A, const FPakFileEntryPtr& B) -> bool
-		{
-			return A->PakEntry.UncompressedSize < B->PakEntry.UncompressedSize;
-		}
-	);
-	SizeColumn.SetDescendingCompareDelegate(
-		[](const FPakFileEntryPtr& A, const FPakFileEntryPtr& B) -> bool
-		{
-			return B->PakEntry.UncompressedSize < A->PakEntry.UncompressedSize;
-		}
-	);
-	
-	// Compressed Size Column
-	FFileColumn& CompressedSizeColumn = FileColumns.Emplace(FFileColumn::CompressedSizeColumnName, FFileColumn(7, FFileColumn::CompressedSizeColumnName, LOCTEXT("CompressedSizeColumn", "Compressed Size"), LOCTEXT("CompressedSizeColumnTip", "File compressed size"), 1.f, EFileColumnFlags::ShouldBeVisible | EFileColumnFlags::CanBeFiltered | EFileColumnFlags::CanBeHidden));
-	CompressedSizeColumn.SetAscendingCompareDelegate(
-		[](const FPakFileEntryPtr& A, const FPakFileEntryPtr& B) -> bool
-		{
-			return A->PakEntry.Size < B->PakEntry.Size;
-		}
-	);
-	CompressedSizeColumn.SetDescendingCompareDelegate(
-		[](const FPakFileEntryPtr& A, const FPakFileEntryPtr& B) -> bool
-		{
-			return B->PakEntry.Size < A->PakEntry.Size;
-		}
-	);
-	
-	// Compressed Block Count
-	FFileColumn& CompressionBlockCountColumn = FileColumns.Emplace(FFileColumn::CompressionBlockCountColumnName, FFileColumn(8, FFileColumn::CompressionBlockCountColumnName, LOCTEXT("CompressionBlockCountColumn", "Compression Block Count"), LOCTEXT("CompressionBlockCountColumnTip", "File compression block count"), 1.f, EFileColumnFlags::ShouldBeVisible | EFileColumnFlags::CanBeFiltered | EFileColumnFlags::CanBeHidden));
-	CompressionBlockCountColumn.SetAscendingCompareDelegate(
-		[](const FPakFileEntryPtr& A, const FPakFileEntryPtr& B) -> bool
-		{
-			return A->PakEntry.CompressionBlocks.Num() < B->PakEntry.CompressionBlocks.Num();
-		}
-	);
-	CompressionBlockCountColumn.SetDescendingCompareDelegate(
-		[](const FPakFileEntryPtr& A, const FPakFileEntryPtr& B) -> bool
-		{
-			return B->PakEntry.CompressionBlocks.Num() < A->PakEntry.CompressionBlocks.Num();
-		}
-	);
-	
-	// Compressed Block Size
-	FileColumns.Emplace(FFileColumn::CompressionBlockSizeColumnName, FFileColumn(9, FFileColumn::CompressionBlockSizeColumnName, LOCTEXT("CompressionBlockSizeColumn", "Compression Block Size"), LOCTEXT("CompressionBlockSizeColumnTip", "File compression block size"), 1.f, EFileColumnFlags::ShouldBeVisible | EFileColumnFlags::CanBeHidden));
-	
-	// Compression Method
-	FFileColumn& CompressionMethodColumn = FileColumns.Emplace(FFileColumn::CompressionMethodColumnName, FFileColumn(10, FFileColumn::CompressionMethodColumnName, LOCTEXT("CompressionMethod", "Compression Method"), LOCTEXT("CompressionMethodTip", "Compression method name used to compress this file"), 1.f, EFileColumnFlags::ShouldBeVisible | EFileColumnFlags::CanBeHidden));
-	CompressionMethodColumn.SetAscendingCompareDelegate(
-		[](const FPakFileEntryPtr& A, const FPakFileEntryPtr& B) -> bool
-		{
-			return A->CompressionMethod.LexicalLess(B->CompressionMethod);
-		}
-	);
-	CompressionMethodColumn.SetDescendingCompareDelegate(
-		[](const FPakFileEntryPtr& A, const FPakFileEntryPtr& B) -> bool
-		{
-			return B->CompressionMethod.LexicalLess(A->CompressionMethod);
-		}
-	);
-	
-	// Owner Pak
-	FFileColumn& OwnerPakColumn = FileColumns.Emplace(FFileColumn::OwnerPakColumnName, FFileColumn(11, FFileColumn::OwnerPakColumnName, LOCTEXT("OwnerPakColumn", "Onwer Pak"), LOCTEXT("OnwerPakColumnTip", "Owner Pak Name"), 2.f, EFileColumnFlags::ShouldBeVisible | EFileColumnFlags::CanBeHidden | EFileColumnFlags::CanBeFiltered));
-	OwnerPakColumn.SetAscendingCompareDelegate(
-		[](const FPakFileEntryPtr& A, const FPakFileEntryPtr& B) -> bool
-		{
-			return A->OwnerPakIndex < B->OwnerPakIndex;
-		}
-	);
-	OwnerPakColumn.SetDescendingCompareDelegate(
-		[](const FPakFileEntryPtr& A, const FPakFileEntryPtr& B) -> bool
-		{
-			return B->OwnerPakIndex < A->OwnerPakIndex;
-		}
-	);
-
-	// SHA1
-	FileColumns.Emplace(FFileColumn::SHA1ColumnName, FFileColumn(12, FFileColumn::SHA1ColumnName, LOCTEXT("SHA1Column", "SHA1"), LOCTEXT("SHA1ColumnTip", "File sha1"), 1.f, EFileColumnFlags::ShouldBeVisible | EFileColumnFlags::CanBeHidden));
-	
-	// IsEncrypted
-	FFileColumn& IsEncryptedColumn = FileColumns.Emplace(FFileColumn::IsEncryptedColumnName, FFileColumn(13, FFileColumn::IsEncryptedColumnName, LOCTEXT("IsEncryptedColumn", "IsEncrypted"), LOCTEXT("IsEncryptedColumnTip", "Is file encrypted in pak?"), 1.f, EFileColumnFlags::ShouldBeVisible | EFileColumnFlags::CanBeHidden));
-	IsEncryptedColumn.SetAscendingCompareDelegate(
-		[](const FPakFileEntryPtr& A, const FPakFileEntryPtr& B) -> bool
-		{
-			return A->PakEntry.IsEncrypted() < B->PakEntry.IsEncrypted();
-		}
-	);
-	IsEncryptedColumn.SetDescendingCompareDelegate(
-		[](const FPakFileEntryPtr& A, const FPakFileEntryPtr& B) -> bool
-		{
-			return B->PakEntry.IsEncrypted() < A->PakEntry.IsEncrypted();
-		}
-	);
+	FFileColumn::CreateColumns(FileColumns);
 
 	// Show columns.
 	for (const auto& ColumnPair : FileColumns)
@@ -1437,6 +1299,11 @@ bool SPakFileView::HasFileSelected() const
 	return SelectedItems.Num() > 0;
 }
 
+bool SPakFileView::CanExport() const
+{
+	return HasFileSelected() && !IPakAnalyzerModule::Get().GetPakAnalyzer()->IsExporting();
+}
+
 void SPakFileView::OnCopyAllColumnsExecute()
 {
 	FString Value;
@@ -1468,8 +1335,8 @@ void SPakFileView::OnCopyAllColumnsExecute()
 				FileObject->SetStringField(TEXT("SHA1"), BytesToHex(PakEntry->Hash, sizeof(PakEntry->Hash)));
 				FileObject->SetStringField(TEXT("IsEncrypted"), PakEntry->IsEncrypted() ? TEXT("True") : TEXT("False"));
 				FileObject->SetStringField(TEXT("Class"), PakFileItem->Class.ToString());
-				FileObject->SetNumberField(TEXT("Dependency Count"), PakFileItem->AssetSummary.IsValid() ? PakFileItem->AssetSummary->DependencyList.Num() : 0);
-				FileObject->SetNumberField(TEXT("Dependent Count"), PakFileItem->AssetSummary.IsValid() ? PakFileItem->AssetSummary->DependentList.Num() : 0);
+				FileObject->SetNumberField(TEXT("Dependency Count"), PakFileItem->AssetSummary.IsValid() ? PakFileItem->AssetSummary->GetDependencyCount() : 0);
+				FileObject->SetNumberField(TEXT("Dependent Count"), PakFileItem->AssetSummary.IsValid() ? PakFileItem->AssetSummary->GetDependentCount() : 0);
 				FileObject->SetStringField(TEXT("OwnerPak"), PakAnalyzer && PakAnalyzer->GetPakFileSumary().IsValidIndex(PakFileItem->OwnerPakIndex) ? FPaths::GetCleanFilename(PakAnalyzer->GetPakFileSumary()[PakFileItem->OwnerPakIndex]->PakFilePath) : TEXT(""));
 
 				FileObjects.Add(MakeShareable(new FJsonValueObject(FileObject)));
@@ -1543,11 +1410,11 @@ void SPakFileView::OnCopyColumnExecute(const FName ColumnId)
 			}
 			else if (ColumnId == FFileColumn::DependencyCountColumnName)
 			{
-				Values.Add(FString::Printf(TEXT("%d"), PakFileItem->AssetSummary.IsValid() ? PakFileItem->AssetSummary->DependencyList.Num() : 0));
+				Values.Add(FString::Printf(TEXT("%d"), PakFileItem->AssetSummary.IsValid() ? PakFileItem->AssetSummary->GetDependencyCount() : 0));
 			}
 			else if (ColumnId == FFileColumn::DependentCountColumnName)
 			{
-				Values.Add(FString::Printf(TEXT("%d"), PakFileItem->AssetSummary.IsValid() ? PakFileItem->AssetSummary->DependentList.Num() : 0));
+				Values.Add(FString::Printf(TEXT("%d"), PakFileItem->AssetSummary.IsValid() ? PakFileItem->AssetSummary->GetDependentCount() : 0));
 			}
 			else if (ColumnId == FFileColumn::OwnerPakColumnName)
 			{
@@ -1646,7 +1513,7 @@ void SPakFileView::OnExportToJson()
 	TArray<FPakFileEntryPtr> SelectedItems;
 	GetSelectedItems(SelectedItems);
 
-	IPakAnalyzerModule::Get().GetPakAnalyzer()->ExportToJson(OutFileNames[0], SelectedItems);
+	IPakAnalyzerModule::Get().GetPakAnalyzer()->StartExport(EPakExportFormat::Json, OutFileNames[0], SelectedItems);
 }
 
 void SPakFileView::OnExportToCsv()
@@ -1677,10 +1544,80 @@ void SPakFileView::OnExportToCsv()
 	TArray<FPakFileEntryPtr> SelectedItems;
 	GetSelectedItems(SelectedItems);
 
-	IPakAnalyzerModule::Get().GetPakAnalyzer()->ExportToCsv(OutFileNames[0], SelectedItems);
+	IPakAnalyzerModule::Get().GetPakAnalyzer()->StartExport(EPakExportFormat::Csv, OutFileNames[0], SelectedItems);
+}
+
+void SPakFileView::OnExportToColumnar()
+{
+	bool bOpened = false;
+	TArray<FString> OutFileNames;
+
+	IDesktopPlatform* DesktopPlatform = FDesktopPlatformModule::Get();
+	if (DesktopPlatform)
+	{
+		FSlateApplication::Get().CloseToolTip();
+
+		bOpened = DesktopPlatform->SaveFileDialog(
+			FSlateApplication::Get().FindBestParentWindowHandleForDialogs(nullptr),
+			LOCTEXT("OpenExportDialogTitleText", "Select output columnar file path...").ToString(),
+			TEXT(""),
+			TEXT(""),
+			TEXT("Columnar Files (*.upvc)|*.upvc|All Files (*.*)|*.*"),
+			EFileDialogFlags::None,
+			OutFileNames);
+	}
+
+	if (!bOpened || OutFileNames.Num() <= 0)
+	{
+		return;
+	}
+
+	TArray<FPakFileEntryPtr> SelectedItems;
+	GetSelectedItems(SelectedItems);
+
+	IPakAnalyzerModule::Get().GetPakAnalyzer()->StartExport(EPakExportFormat::Columnar, OutFileNames[0], SelectedItems);
 }
 
-void SPakFileView::OnExtract()
+void SPakFileView::OnExportToSql()
+{
+	bool bOpened = false;
+	TArray<FString> OutFileNames;
+
+	IDesktopPlatform* DesktopPlatform = FDesktopPlatformModule::Get();
+	if (DesktopPlatform)
+	{
+		FSlateApplication::Get().CloseToolTip();
+
+		bOpened = DesktopPlatform->SaveFileDialog(
+			FSlateApplication::Get().FindBestParentWindowHandleForDialogs(nullptr),
+			LOCTEXT("OpenExportDialogTitleText", "Select output sql file path...").ToString(),
+			TEXT(""),
+			TEXT(""),
+			TEXT("SQL Files (*.sql)|*.sql|All Files (*.*)|*.*"),
+			EFileDialogFlags::None,
+			OutFileNames);
+	}
+
+	if (!bOpened || OutFileNames.Num() <= 0)
+	{
+		return;
+	}
+
+	TArray<FPakFileEntryPtr> SelectedItems;
+	GetSelectedItems(SelectedItems);
+
+	IPakAnalyzerModule::Get().GetPakAnalyzer()->StartExport(EPakExportFormat::Sql, OutFileNames[0], SelectedItems);
+}
+
+void SPakFileView::OnEstimateRecompressionExecute()
+{
+	TArray<FPakFileEntryPtr> SelectedItems;
+	GetSelectedItems(SelectedItems);
+
+	FWidgetDelegates::GetOnEstimateRecompressionDelegate().Broadcast(SelectedItems);
+}
+
+void SPakFileView::OnExtract(bool bWithDependencies)
 {
 	bool bOpened = false;
 	FString OutputPath;
@@ -1705,7 +1642,14 @@ void SPakFileView::OnExtract()
 	TArray<FPakFileEntryPtr> SelectedItems;
 	GetSelectedItems(SelectedItems);
 
-	IPakAnalyzerModule::Get().GetPakAnalyzer()->ExtractFiles(OutputPath, SelectedItems);
+	if (bWithDependencies)
+	{
+		IPakAnalyzerModule::Get().GetPakAnalyzer()->ExtractFilesWithDependencies(OutputPath, SelectedItems);
+	}
+	else
+	{
+		IPakAnalyzerModule::Get().GetPakAnalyzer()->ExtractFiles(OutputPath, SelectedItems);
+	}
 }
 
 void SPakFileView::ScrollToItem(const FString& InPath, int32 PakIndex)
@@ -1744,6 +1688,37 @@ void SPakFileView::OnParseAssetFinished()
 	MarkDirty(true);
 }
 
+void SPakFileView::OnPackagesParsed(const TArray<FPakFileEntryPtr>& InFiles)
+{
+	// Keep files of newly resolved classes visible, the filter is rebuilt when parsing finishes
+	if (ClassFilterMap.Num() > 0)
+	{
+		for (const FPakFileEntryPtr& File : InFiles)
+		{
+			if (!ClassFilterMap.Contains(File->Class))
+			{
+				ClassFilterMap.Add(File->Class, true);
+			}
+		}
+	}
+
+	MarkDirty(true);
+}
+
+void SPakFileView::OnSelectionChanged(FPakFileEntryPtr InSelectedItem, ESelectInfo::Type InSelectInfo)
+{
+	IPakAnalyzer* PakAnalyzer = IPakAnalyzerModule::Get().GetPakAnalyzer();
+	if (!PakAnalyzer)
+	{
+		return;
+	}
+
+	TArray<FPakFileEntryPtr> SelectedItems;
+	GetSelectedItems(SelectedItems);
+
+	PakAnalyzer->PrioritizeAssetParse(SelectedItems);
+}
+
 void SPakFileView::FillFilesSummary()
 {
 	FilesSummary->PakEntry.Offset = 0;
@@ -96,6 +96,7 @@ protected:
 	// CopyAllColumns (ContextMenu)
 	bool HasOneFileSelected() const;
 	bool HasFileSelected() const;
+	bool CanExport() const;
 	void OnCopyAllColumnsExecute();
 	void OnCopyColumnExecute(const FName ColumnId);
 
@@ -110,13 +111,18 @@ protected:
 	bool IsFileListEmpty() const;
 	void OnExportToJson();
 	void OnExportToCsv();
-	void OnExtract();
+	void OnExportToColumnar();
+	void OnExportToSql();
+	void OnExtract(bool bWithDependencies);
+	void OnEstimateRecompressionExecute();
 
 	void ScrollToItem(const FString& InPath, int32 PakIndex);
 
 	void OnLoadAssetReigstryFinished();
 	void OnLoadPakFinished();
 	void OnParseAssetFinished();
+	void OnPackagesParsed(const TArray<FPakFileEntryPtr>& InFiles);
+	void OnSelectionChanged(FPakFileEntryPtr InSelectedItem, ESelectInfo::Type InSelectInfo);
 
 	void FillFilesSummary();
 	bool GetSelectedItems(TArray<FPakFileEntryPtr>& OutSelectedItems) const;
@@ -0,0 +1,292 @@
+#include "SPakLayoutView.h"
+
+#include "Misc/Paths.h"
+#include "Styling/CoreStyle.h"
+#include "Widgets/Input/SComboBox.h"
+#include "Widgets/Layout/SBorder.h"
+#include "Widgets/Layout/SBox.h"
+#include "Widgets/Layout/SScrollBox.h"
+#include "Widgets/SBoxPanel.h"
+#include "Widgets/Text/STextBlock.h"
+
+#include "CommonDefines.h"
+#include "PakAnalyzerModule.h"
+#include "SPakByteMap.h"
+#include "ViewModels/WidgetDelegates.h"
+
+#define LOCTEXT_NAMESPACE "SPakLayoutView"
+
+SPakLayoutView::SPakLayoutView()
+{
+	FPakAnalyzerDelegates::OnPakLoadFinish.AddRaw(this, &SPakLayoutView::OnLoadPakFinished);
+}
+
+SPakLayoutView::~SPakLayoutView()
+{
+	FPakAnalyzerDelegates::OnPakLoadFinish.RemoveAll(this);
+}
+
+void SPakLayoutView::Construct(const FArguments& InArgs)
+{
+	CellSizeOptions.Add(MakeShared<int64>(4 * 1024));
+	CellSizeOptions.Add(MakeShared<int64>(64 * 1024));
+	CellSizeOptions.Add(MakeShared<int64>(1024 * 1024));
+	SelectedCellSize = CellSizeOptions[1];
+
+	ChildSlot
+	[
+		SNew(SVerticalBox)
+
+		+ SVerticalBox::Slot().AutoHeight().Padding(2.f)
+		[
+			SNew(SHorizontalBox)
+
+			+ SHorizontalBox::Slot().AutoWidth().VAlign(VAlign_Center).Padding(2.f, 0.f)
+			[
+				SNew(STextBlock).Text(LOCTEXT("Pak", "Pak:"))
+			]
+
+			+ SHorizontalBox::Slot().AutoWidth().Padding(2.f, 0.f)
+			[
+				SNew(SBox).WidthOverride(200.f)
+				[
+					SNew(SComboBox<TSharedPtr<int32>>)
+					.OptionsSource(&PakOptions)
+					.OnGenerateWidget(this, &SPakLayoutView::OnGeneratePakWidget)
+					.OnSelectionChanged(this, &SPakLayoutView::OnPakSelectionChanged)
+					.Content()
+					[
+						SNew(STextBlock).Text(this, &SPakLayoutView::GetSelectedPakText)
+					]
+				]
+			]
+
+			+ SHorizontalBox::Slot().AutoWidth().VAlign(VAlign_Center).Padding(8.f, 0.f, 2.f, 0.f)
+			[
+				SNew(STextBlock).Text(LOCTEXT("CellSize", "Cell:"))
+			]
+
+			+ SHorizontalBox::Slot().AutoWidth().Padding(2.f, 0.f)
+			[
+				SNew(SBox).WidthOverride(80.f)
+				[
+					SNew(SComboBox<TSharedPtr<int64>>)
+					.OptionsSource(&CellSizeOptions)
+					.InitiallySelectedItem(SelectedCellSize)
+					.OnGenerateWidget(this, &SPakLayoutView::OnGenerateCellSizeWidget)
+					.OnSelectionChanged(this, &SPakLayoutView::OnCellSizeSelectionChanged)
+					.Content()
+					[
+						SNew(STextBlock).Text(this, &SPakLayoutView::GetSelectedCellSizeText)
+					]
+				]
+			]
+
+			+ SHorizontalBox::Slot().AutoWidth().VAlign(VAlign_Center).Padding(8.f, 0.f, 2.f, 0.f)
+			[
+				MakeLegendItem(LOCTEXT("LegendGap", "Gap"), SPakByteMap::GetSpanTypeColor(EPakLayoutSpanType::Gap))
+			]
+
+			+ SHorizontalBox::Slot().AutoWidth().VAlign(VAlign_Center).Padding(2.f, 0.f)
+			[
+				MakeLegendItem(LOCTEXT("LegendPadding", "Padding"), SPakByteMap::GetSpanTypeColor(EPakLayoutSpanType::Padding))
+			]
+
+			+ SHorizontalBox::Slot().AutoWidth().VAlign(VAlign_Center).Padding(2.f, 0.f)
+			[
+				MakeLegendItem(LOCTEXT("LegendIndex", "Index"), SPakByteMap::GetSpanTypeColor(EPakLayoutSpanType::Index))
+			]
+
+			+ SHorizontalBox::Slot().AutoWidth().VAlign(VAlign_Center).Padding(2.f, 0.f)
+			[
+				MakeLegendItem(LOCTEXT("LegendFooter", "Footer"), SPakByteMap::GetSpanTypeColor(EPakLayoutSpanType::Footer))
+			]
+
+			+ SHorizontalBox::Slot().AutoWidth().VAlign(VAlign_Center).Padding(2.f, 0.f)
+			[
+				SNew(STextBlock).Text(LOCTEXT("LegendEntry", "Entries are colored by class"))
+			]
+		]
+
+		+ SVerticalBox::Slot().AutoHeight().Padding(4.f)
+		[
+			SNew(STextBlock).Text(this, &SPakLayoutView::GetStatsText)
+		]
+
+		+ SVerticalBox::Slot().FillHeight(1.f).Padding(2.f)
+		[
+			SNew(SScrollBox)
+
+			+ SScrollBox::Slot()
+			[
+				SAssignNew(ByteMap, SPakByteMap)
+				.BytesPerCell(this, &SPakLayoutView::GetBytesPerCell)
+				.OnSpanDoubleClicked(this, &SPakLayoutView::OnSpanDoubleClicked)
+			]
+		]
+	];
+
+	FillPakOptions();
+	Reload();
+}
+
+void SPakLayoutView::Reload()
+{
+	Layout.Reset();
+
+	IPakAnalyzer* PakAnalyzer = IPakAnalyzerModule::Get().GetPakAnalyzer();
+	if (PakAnalyzer && SelectedPak.IsValid())
+	{
+		TSharedPtr<FPakLayout> NewLayout = MakeShared<FPakLayout>();
+		if (PakAnalyzer->GetPakLayout(*SelectedPak, *NewLayout))
+		{
+			Layout = NewLayout;
+		}
+	}
+
+	ByteMap->SetLayout(Layout);
+}
+
+TSharedRef<SWidget> SPakLayoutView::OnGeneratePakWidget(TSharedPtr<int32> InPakIndex) const
+{
+	return SNew(STextBlock).Text(GetPakText(InPakIndex));
+}
+
+void SPakLayoutView::OnPakSelectionChanged(TSharedPtr<int32> InPakIndex, ESelectInfo::Type SelectInfo)
+{
+	SelectedPak = InPakIndex;
+
+	if (SelectInfo != ESelectInfo::Direct)
+	{
+		Reload();
+	}
+}
+
+FText SPakLayoutView::GetPakText(TSharedPtr<int32> InPakIndex) const
+{
+	if (!InPakIndex.IsValid())
+	{
+		return FText();
+	}
+
+	const TArray<FPakFileSumaryPtr>& Summaries = IPakAnalyzerModule::Get().GetPakAnalyzer()->GetPakFileSumary();
+	return Summaries.IsValidIndex(*InPakIndex) ? FText::FromString(FPaths::GetCleanFilename(Summaries[*InPakIndex]->PakFilePath)) : FText();
+}
+
+FText SPakLayoutView::GetSelectedPakText() const
+{
+	return GetPakText(SelectedPak);
+}
+
+TSharedRef<SWidget> SPakLayoutView::OnGenerateCellSizeWidget(TSharedPtr<int64> InCellSize) const
+{
+	return SNew(STextBlock).Text(GetCellSizeText(InCellSize));
+}
+
+void SPakLayoutView::OnCellSizeSelectionChanged(TSharedPtr<int64> InCellSize, ESelectInfo::Type SelectInfo)
+{
+	if (InCellSize.IsValid())
+	{
+		SelectedCellSize = InCellSize;
+	}
+}
+
+FText SPakLayoutView::GetCellSizeText(TSharedPtr<int64> InCellSize) const
+{
+	return InCellSize.IsValid() ? FText::AsMemory(*InCellSize, EMemoryUnitStandard::IEC) : FText();
+}
+
+FText SPakLayoutView::GetSelectedCellSizeText() const
+{
+	return GetCellSizeText(SelectedCellSize);
+}
+
+int64 SPakLayoutView::GetBytesPerCell() const
+{
+	return SelectedCellSize.IsValid() ? *SelectedCellSize : 64 * 1024;
+}
+
+FText SPakLayoutView::GetStatsText() const
+{
+	if (!Layout.IsValid())
+	{
+		return LOCTEXT("NoLayout", "No pak layout available.");
+	}
+
+	FFormatNamedArguments Args;
+	Args.Add(TEXT("EntryCount"), FText::AsNumber(Layout->Files.Num()));
+	Args.Add(TEXT("EntrySize"), FText::AsMemory(Layout->EntrySize, EMemoryUnitStandard::IEC));
+	Args.Add(TEXT("PakSize"), FText::AsMemory(Layout->PakSize, EMemoryUnitStandard::IEC));
+	Args.Add(TEXT("GapCount"), FText::AsNumber(Layout->GapCount));
+	Args.Add(TEXT("GapSize"), FText::AsMemory(Layout->GapSize, EMemoryUnitStandard::IEC));
+	Args.Add(TEXT("LargestGap"), FText::AsMemory(Layout->LargestGap, EMemoryUnitStandard::IEC));
+	Args.Add(TEXT("PaddingCount"), FText::AsNumber(Layout->PaddingCount));
+	Args.Add(TEXT("PaddingSize"), FText::AsMemory(Layout->PaddingSize, EMemoryUnitStandard::IEC));
+	Args.Add(TEXT("Wasted"), FText::AsMemory(Layout->GapSize + Layout->PaddingSize, EMemoryUnitStandard::IEC));
+	Args.Add(TEXT("WastedPercent"), FText::AsPercent(Layout->PakSize > 0 ? (double)(Layout->GapSize + Layout->PaddingSize) / Layout->PakSize : 0.0));
+	Args.Add(TEXT("OverlapCount"), FText::AsNumber(Layout->OverlapCount));
+	Args.Add(TEXT("IndexOffset"), FText::AsNumber(Layout->IndexOffset));
+	Args.Add(TEXT("IndexSize"), FText::AsMemory(Layout->IndexSize, EMemoryUnitStandard::IEC));
+	Args.Add(TEXT("DirectoryChanges"), FText::AsNumber(Layout->DirectoryChanges));
+	Args.Add(TEXT("DirectoryBest"), FText::AsNumber(FMath::Max(Layout->DirectoryCount - 1, 0)));
+	Args.Add(TEXT("ClassChanges"), FText::AsNumber(Layout->ClassChanges));
+	Args.Add(TEXT("ClassBest"), FText::AsNumber(FMath::Max(Layout->ClassCount - 1, 0)));
+
+	return FText::Format(LOCTEXT("LayoutStats",
+		"{EntryCount} entries, {EntrySize} of {PakSize}. Gaps: {GapCount}, {GapSize}, largest {LargestGap}. Padding: {PaddingCount}, {PaddingSize}. Wasted: {Wasted} ({WastedPercent}). Overlaps: {OverlapCount}.\n"
+		"Index at {IndexOffset}, {IndexSize}. Directory changes: {DirectoryChanges} (best {DirectoryBest}). Class changes: {ClassChanges} (best {ClassBest})."), Args);
+}
+
+TSharedRef<SWidget> SPakLayoutView::MakeLegendItem(const FText& InName, const FLinearColor& InColor) const
+{
+	return
+		SNew(SHorizontalBox)
+
+		+ SHorizontalBox::Slot().AutoWidth().VAlign(VAlign_Center).Padding(0.f, 0.f, 2.f, 0.f)
+		[
+			SNew(SBorder)
+			.BorderImage(FCoreStyle::Get().GetBrush("GenericWhiteBox"))
+			.BorderBackgroundColor(InColor)
+			[
+				SNew(SBox).WidthOverride(10.f).HeightOverride(10.f)
+			]
+		]
+
+		+ SHorizontalBox::Slot().AutoWidth().VAlign(VAlign_Center)
+		[
+			SNew(STextBlock).Text(InName)
+		];
+}
+
+void SPakLayoutView::OnSpanDoubleClicked(const FPakLayoutSpan& InSpan)
+{
+	if (Layout.IsValid() && InSpan.Type == EPakLayoutSpanType::Entry && Layout->Files.IsValidIndex(InSpan.FileIndex))
+	{
+		const FPakFileEntryPtr& File = Layout->Files[InSpan.FileIndex];
+		FWidgetDelegates::GetOnSwitchToTreeViewDelegate().Broadcast(File->Path, File->OwnerPakIndex);
+	}
+}
+
+void SPakLayoutView::FillPakOptions()
+{
+	PakOptions.Empty();
+
+	IPakAnalyzer* PakAnalyzer = IPakAnalyzerModule::Get().GetPakAnalyzer();
+	if (PakAnalyzer)
+	{
+		for (int32 i = 0; i < PakAnalyzer->GetPakFileSumary().Num(); ++i)
+		{
+			PakOptions.Add(MakeShared<int32>(i));
+		}
+	}
+
+	SelectedPak = PakOptions.Num() > 0 ? PakOptions[0] : nullptr;
+}
+
+void SPakLayoutView::OnLoadPakFinished()
+{
+	FillPakOptions();
+	Reload();
+}
+
+#undef LOCTEXT_NAMESPACE
@@ -0,0 +1,54 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Widgets/SCompoundWidget.h"
+
+#include "PakFileEntry.h"
+
+/** Shows how the entries of one pak sit on disk: gaps, padding and ordering. */
+class SPakLayoutView : public SCompoundWidget
+{
+public:
+	/** Default constructor. */
+	SPakLayoutView();
+
+	/** Virtual destructor. */
+	virtual ~SPakLayoutView();
+
+	SLATE_BEGIN_ARGS(SPakLayoutView) {}
+	SLATE_END_ARGS()
+
+	/** Constructs this widget. */
+	void Construct(const FArguments& InArgs);
+
+	void Reload();
+
+protected:
+	TSharedRef<SWidget> OnGeneratePakWidget(TSharedPtr<int32> InPakIndex) const;
+	void OnPakSelectionChanged(TSharedPtr<int32> InPakIndex, ESelectInfo::Type SelectInfo);
+	FText GetPakText(TSharedPtr<int32> InPakIndex) const;
+	FText GetSelectedPakText() const;
+
+	TSharedRef<SWidget> OnGenerateCellSizeWidget(TSharedPtr<int64> InCellSize) const;
+	void OnCellSizeSelectionChanged(TSharedPtr<int64> InCellSize, ESelectInfo::Type SelectInfo);
+	FText GetCellSizeText(TSharedPtr<int64> InCellSize) const;
+	FText GetSelectedCellSizeText() const;
+	int64 GetBytesPerCell() const;
+
+	FText GetStatsText() const;
+	TSharedRef<SWidget> MakeLegendItem(const FText& InName, const FLinearColor& InColor) const;
+	void OnSpanDoubleClicked(const FPakLayoutSpan& InSpan);
+
+	void FillPakOptions();
+	void OnLoadPakFinished();
+
+protected:
+	TSharedPtr<class SPakByteMap> ByteMap;
+	TSharedPtr<FPakLayout> Layout;
+
+	TArray<TSharedPtr<int32>> PakOptions;
+	TSharedPtr<int32> SelectedPak;
+
+	TArray<TSharedPtr<int64>> CellSizeOptions;
+	TSharedPtr<int64> SelectedCellSize;
+};
@@ -0,0 +1,377 @@
+#include "SPakLoadView.h"
+
+#include "DesktopPlatformModule.h"
+#include "Framework/Application/SlateApplication.h"
+#include "Misc/MessageDialog.h"
+#include "Widgets/Input/SButton.h"
+#include "Widgets/Input/SComboBox.h"
+#include "Widgets/Layout/SBox.h"
+#include "Widgets/SBoxPanel.h"
+#include "Widgets/Text/STextBlock.h"
+#include "Widgets/Views/STableRow.h"
+#include "Widgets/Views/STableViewBase.h"
+
+#include "CommonDefines.h"
+#include "PakAnalyzerModule.h"
+#include "ViewModels/WidgetDelegates.h"
+
+#define LOCTEXT_NAMESPACE "SPakLoadView"
+
+const FName SPakLoadView::MapColumnName(TEXT("Map"));
+const FName SPakLoadView::PackageCountColumnName(TEXT("PackageCount"));
+const FName SPakLoadView::BlockCountColumnName(TEXT("BlockCount"));
+const FName SPakLoadView::ReadCountColumnName(TEXT("ReadCount"));
+const FName SPakLoadView::ReadSizeColumnName(TEXT("ReadSize"));
+const FName SPakLoadView::SeekDistanceColumnName(TEXT("SeekDistance"));
+const FName SPakLoadView::EstimatedTimeColumnName(TEXT("EstimatedTime"));
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+// SPakLoadRow
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+class SPakLoadRow : public SMultiColumnTableRow<FLoadSimulationPtr>
+{
+	SLATE_BEGIN_ARGS(SPakLoadRow) {}
+	SLATE_END_ARGS()
+
+public:
+	void Construct(const FArguments& InArgs, FLoadSimulationPtr InSimulation, const TSharedRef<STableViewBase>& InOwnerTableView)
+	{
+		WeakSimulation = MoveTemp(InSimulation);
+
+		SMultiColumnTableRow<FLoadSimulationPtr>::Construct(FSuperRowType::FArguments(), InOwnerTableView);
+	}
+
+	virtual TSharedRef<SWidget> GenerateWidgetForColumn(const FName& ColumnName) override
+	{
+		FLoadSimulationPtr SimulationPin = WeakSimulation.Pin();
+
+		FText Text;
+		FText ToolTip;
+		if (SimulationPin.IsValid())
+		{
+			if (ColumnName == SPakLoadView::MapColumnName)
+			{
+				Text = FText::FromName(SimulationPin->RootPackage);
+				ToolTip = Text;
+			}
+			else if (ColumnName == SPakLoadView::PackageCountColumnName)
+			{
+				Text = FText::AsNumber(SimulationPin->PackageCount);
+				ToolTip = FText::Format(LOCTEXT("FileCountTip", "{0} files"), FText::AsNumber(SimulationPin->FileCount));
+			}
+			else if (ColumnName == SPakLoadView::BlockCountColumnName)
+			{
+				Text = FText::AsNumber(SimulationPin->BlockCount);
+			}
+			else if (ColumnName == SPakLoadView::ReadCountColumnName)
+			{
+				Text = FText::AsNumber(SimulationPin->ReadCount);
+			}
+			else if (ColumnName == SPakLoadView::ReadSizeColumnName)
+			{
+				Text = FText::AsMemory(SimulationPin->ReadSize, EMemoryUnitStandard::IEC);
+				ToolTip = FText::AsNumber(SimulationPin->ReadSize);
+			}
+			else if (ColumnName == SPakLoadView::SeekDistanceColumnName)
+			{
+				Text = FText::AsMemory(SimulationPin->SeekDistance, EMemoryUnitStandard::IEC);
+				ToolTip = FText::AsNumber(SimulationPin->SeekDistance);
+			}
+			else if (ColumnName == SPakLoadView::EstimatedTimeColumnName)
+			{
+				Text = FText::FromString(FString::Printf(TEXT("%.3fs"), SimulationPin->EstimatedTime));
+			}
+		}
+
+		return
+			SNew(SBox).Padding(FMargin(4.0, 0.0))
+			[
+				SNew(STextBlock).Text(Text).ToolTipText(ToolTip)
+			];
+	}
+
+protected:
+	TWeakPtr<FLoadSimulation> WeakSimulation;
+};
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+// SPakLoadView
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+SPakLoadView::SPakLoadView()
+{
+	FWidgetDelegates::GetOnLoadAssetRegistryFinishedDelegate().AddRaw(this, &SPakLoadView::OnLoadAssetReigstryFinished);
+	FPakAnalyzerDelegates::OnPakLoadFinish.AddRaw(this, &SPakLoadView::OnLoadPakFinished);
+	FPakAnalyzerDelegates::OnAssetParseFinish.AddRaw(this, &SPakLoadView::OnParseAssetFinished);
+	FPakAnalyzerDelegates::OnExportFileOrderFinish.AddRaw(this, &SPakLoadView::OnExportOrderFinished);
+	FPakAnalyzerDelegates::OnLoadSimulationFinish.AddRaw(this, &SPakLoadView::OnLoadSimulationFinished);
+}
+
+SPakLoadView::~SPakLoadView()
+{
+	FWidgetDelegates::GetOnLoadAssetRegistryFinishedDelegate().RemoveAll(this);
+	FPakAnalyzerDelegates::OnPakLoadFinish.RemoveAll(this);
+	FPakAnalyzerDelegates::OnAssetParseFinish.RemoveAll(this);
+	FPakAnalyzerDelegates::OnExportFileOrderFinish.RemoveAll(this);
+	FPakAnalyzerDelegates::OnLoadSimulationFinish.RemoveAll(this);
+}
+
+void SPakLoadView::Construct(const FArguments& InArgs)
+{
+	Devices.Add(MakeShared<FLoadDeviceModel>(FLoadDeviceModel::HDD()));
+	Devices.Add(MakeShared<FLoadDeviceModel>(FLoadDeviceModel::SSD()));
+	Devices.Add(MakeShared<FLoadDeviceModel>(FLoadDeviceModel::Optical()));
+	SelectedDevice = Devices[0];
+
+	ChildSlot
+	[
+		SNew(SVerticalBox)
+
+		+ SVerticalBox::Slot().AutoHeight().Padding(2.f)
+		[
+			SNew(SHorizontalBox)
+
+			+ SHorizontalBox::Slot().AutoWidth().VAlign(VAlign_Center).Padding(2.f, 0.f)
+			[
+				SNew(STextBlock).Text(LOCTEXT("Device", "Device:"))
+			]
+
+			+ SHorizontalBox::Slot().AutoWidth().Padding(2.f, 0.f)
+			[
+				SNew(SBox).WidthOverride(120.f)
+				[
+					SNew(SComboBox<TSharedPtr<FLoadDeviceModel>>)
+					.OptionsSource(&Devices)
+					.OnGenerateWidget(this, &SPakLoadView::OnGenerateDeviceWidget)
+					.OnSelectionChanged(this, &SPakLoadView::OnDeviceSelectionChanged)
+					.InitiallySelectedItem(SelectedDevice)
+					.Content()
+					[
+						SNew(STextBlock).Text(this, &SPakLoadView::GetSelectedDeviceText)
+					]
+				]
+			]
+
+			+ SHorizontalBox::Slot().FillWidth(1.f).VAlign(VAlign_Center).Padding(4.f, 0.f)
+			[
+				SNew(STextBlock).Text(this, &SPakLoadView::GetSummaryText)
+			]
+
+			+ SHorizontalBox::Slot().AutoWidth().Padding(2.f, 0.f)
+			[
+				SNew(SButton)
+				.Text(LOCTEXT("Refresh", "Refresh"))
+				.ToolTipText(LOCTEXT("RefreshTip", "Simulate loading every map again"))
+				.OnClicked(this, &SPakLoadView::OnRefresh)
+			]
+
+			+ SHorizontalBox::Slot().AutoWidth().Padding(2.f, 0.f)
+			[
+				SNew(SButton)
+				.Text(LOCTEXT("ExportOrder", "Export Order..."))
+				.ToolTipText(LOCTEXT("ExportOrderTip", "Write an UnrealPak order file that keeps the dependencies of the selected maps, or of all maps if none is selected, together"))
+				.IsEnabled(this, &SPakLoadView::CanExportOrder)
+				.OnClicked(this, &SPakLoadView::OnExportOrder)
+			]
+		]
+
+		+ SVerticalBox::Slot().FillHeight(1.f)
+		[
+			SAssignNew(SimulationListView, SListView<FLoadSimulationPtr>)
+			.ItemHeight(20.f)
+			.SelectionMode(ESelectionMode::Multi)
+			.ListItemsSource(&Simulations)
+			.OnGenerateRow(this, &SPakLoadView::OnGenerateRow)
+			.OnMouseButtonDoubleClick(this, &SPakLoadView::OnSimulationDoubleClicked)
+			.HeaderRow
+			(
+				SNew(SHeaderRow)
+				+ SHeaderRow::Column(MapColumnName).DefaultLabel(LOCTEXT("MapColumn", "Map")).DefaultTooltip(LOCTEXT("MapColumnTip", "Map package, double click to show it in tree view")).FillWidth(1.f)
+				+ SHeaderRow::Column(PackageCountColumnName).DefaultLabel(LOCTEXT("PackageCountColumn", "Packages")).DefaultTooltip(LOCTEXT("PackageCountColumnTip", "Packages in the dependency closure of the map")).ManualWidth(80.f)
+				+ SHeaderRow::Column(BlockCountColumnName).DefaultLabel(LOCTEXT("BlockCountColumn", "Blocks")).DefaultTooltip(LOCTEXT("BlockCountColumnTip", "Compression blocks touched")).ManualWidth(80.f)
+				+ SHeaderRow::Column(ReadCountColumnName).DefaultLabel(LOCTEXT("ReadCountColumn", "Reads")).DefaultTooltip(LOCTEXT("ReadCountColumnTip", "Discontiguous reads in load order")).ManualWidth(80.f)
+				+ SHeaderRow::Column(ReadSizeColumnName).DefaultLabel(LOCTEXT("ReadSizeColumn", "Read Size")).DefaultTooltip(LOCTEXT("ReadSizeColumnTip", "Bytes read from paks")).ManualWidth(100.f)
+				+ SHeaderRow::Column(SeekDistanceColumnName).DefaultLabel(LOCTEXT("SeekDistanceColumn", "Seek Distance")).DefaultTooltip(LOCTEXT("SeekDistanceColumnTip", "Total distance between reads of the same pak")).ManualWidth(100.f)
+				+ SHeaderRow::Column(EstimatedTimeColumnName).DefaultLabel(LOCTEXT("EstimatedTimeColumn", "Estimated Time")).DefaultTooltip(LOCTEXT("EstimatedTimeColumnTip", "Estimated read time on the selected device")).ManualWidth(100.f)
+			)
+		]
+	];
+}
+
+void SPakLoadView::Reload()
+{
+	Simulations.Empty();
+	MapFiles.Empty();
+	TotalEstimatedTime = 0.0;
+
+	IPakAnalyzer* PakAnalyzer = IPakAnalyzerModule::Get().GetPakAnalyzer();
+	if (PakAnalyzer && SelectedDevice.IsValid())
+	{
+		TArray<FPakFileEntryPtr> Files;
+		PakAnalyzer->GetFiles(TEXT(".umap"), TMap<FName, bool>(), TMap<int32, bool>(), Files);
+
+		TArray<FName> Maps;
+		for (const FPakFileEntryPtr& File : Files)
+		{
+			if (!File->PackagePath.IsNone() && !MapFiles.Contains(File->PackagePath))
+			{
+				MapFiles.Add(File->PackagePath, File);
+				Maps.Add(File->PackagePath);
+			}
+		}
+
+		PakAnalyzer->StartSimulateLoad(Maps, *SelectedDevice);
+	}
+
+	SimulationListView->RebuildList();
+}
+
+void SPakLoadView::OnLoadSimulationFinished(const TArray<FLoadSimulation>& InSimulations)
+{
+	Simulations.Empty(InSimulations.Num());
+	TotalEstimatedTime = 0.0;
+
+	for (const FLoadSimulation& Simulation : InSimulations)
+	{
+		TotalEstimatedTime += Simulation.EstimatedTime;
+		Simulations.Add(MakeShared<FLoadSimulation>(Simulation));
+	}
+
+	Simulations.Sort([](const FLoadSimulationPtr& A, const FLoadSimulationPtr& B) { return A->EstimatedTime > B->EstimatedTime; });
+
+	SimulationListView->RebuildList();
+}
+
+TSharedRef<ITableRow> SPakLoadView::OnGenerateRow(FLoadSimulationPtr InSimulation, const TSharedRef<STableViewBase>& OwnerTable)
+{
+	return SNew(SPakLoadRow, InSimulation, OwnerTable);
+}
+
+void SPakLoadView::OnSimulationDoubleClicked(FLoadSimulationPtr InSimulation)
+{
+	const FPakFileEntryPtr* File = InSimulation.IsValid() ? MapFiles.Find(InSimulation->RootPackage) : nullptr;
+	if (File)
+	{
+		FWidgetDelegates::GetOnSwitchToTreeViewDelegate().Broadcast((*File)->Path, (*File)->OwnerPakIndex);
+	}
+}
+
+TSharedRef<SWidget> SPakLoadView::OnGenerateDeviceWidget(TSharedPtr<FLoadDeviceModel> InDevice) const
+{
+	return SNew(STextBlock).Text(FText::FromName(InDevice->Name));
+}
+
+void SPakLoadView::OnDeviceSelectionChanged(TSharedPtr<FLoadDeviceModel> InDevice, ESelectInfo::Type SelectInfo)
+{
+	SelectedDevice = InDevice;
+
+	if (SelectInfo != ESelectInfo::Direct)
+	{
+		Reload();
+	}
+}
+
+FText SPakLoadView::GetSelectedDeviceText() const
+{
+	return SelectedDevice.IsValid() ? FText::FromName(SelectedDevice->Name) : FText();
+}
+
+FText SPakLoadView::GetSummaryText() const
+{
+	IPakAnalyzer* PakAnalyzer = IPakAnalyzerModule::Get().GetPakAnalyzer();
+	if (PakAnalyzer && PakAnalyzer->IsSimulatingLoad())
+	{
+		return FText::Format(LOCTEXT("Simulating", "Simulating {0} maps..."), FText::AsNumber(MapFiles.Num()));
+	}
+
+	return FText::Format(LOCTEXT("LoadSummary", "{0} maps, {1} seconds estimated in total."), FText::AsNumber(Simulations.Num()), FText::AsNumber(TotalEstimatedTime));
+}
+
+FReply SPakLoadView::OnRefresh()
+{
+	Reload();
+
+	return FReply::Handled();
+}
+
+bool SPakLoadView::CanExportOrder() const
+{
+	return Simulations.Num() > 0 && !IPakAnalyzerModule::Get().GetPakAnalyzer()->IsExporting();
+}
+
+FReply SPakLoadView::OnExportOrder()
+{
+	bool bOpened = false;
+	TArray<FString> OutFileNames;
+
+	IDesktopPlatform* DesktopPlatform = FDesktopPlatformModule::Get();
+	if (DesktopPlatform)
+	{
+		FSlateApplication::Get().CloseToolTip();
+
+		bOpened = DesktopPlatform->SaveFileDialog(
+			FSlateApplication::Get().FindBestParentWindowHandleForDialogs(nullptr),
+			LOCTEXT("OpenExportOrderDialogTitleText", "Select output order file path...").ToString(),
+			TEXT(""),
+			TEXT("PakOrder.txt"),
+			TEXT("Text Files (*.txt)|*.txt|All Files (*.*)|*.*"),
+			EFileDialogFlags::None,
+			OutFileNames);
+	}
+
+	if (!bOpened || OutFileNames.Num() <= 0 || !SelectedDevice.IsValid())
+	{
+		return FReply::Handled();
+	}
+
+	TArray<FLoadSimulationPtr> Roots = SimulationListView->GetSelectedItems();
+	if (Roots.Num() <= 0)
+	{
+		Roots = Simulations;
+	}
+
+	TArray<FName> RootPackages;
+	for (const FLoadSimulationPtr& Root : Roots)
+	{
+		RootPackages.Add(Root->RootPackage);
+	}
+
+	ExportDeviceName = SelectedDevice->Name;
+	IPakAnalyzerModule::Get().GetPakAnalyzer()->StartExportFileOrder(OutFileNames[0], RootPackages, *SelectedDevice);
+
+	return FReply::Handled();
+}
+
+void SPakLoadView::OnExportOrderFinished(bool bSuccess, const FPakOrderEstimate& InEstimate)
+{
+	if (!bSuccess)
+	{
+		return;
+	}
+
+	const FText Message = FText::Format(LOCTEXT("ExportOrderResult", "Order of {0} files written for {1} maps on {2}.\n\nReads: {3} -> {4}\nSeek distance: {5} -> {6}\nEstimated time: {7}s -> {8}s"),
+		FText::AsNumber(InEstimate.FileCount), FText::AsNumber(InEstimate.RootCount), FText::FromName(ExportDeviceName),
+		FText::AsNumber(InEstimate.Before.ReadCount), FText::AsNumber(InEstimate.After.ReadCount),
+		FText::AsMemory(InEstimate.Before.SeekDistance, EMemoryUnitStandard::IEC), FText::AsMemory(InEstimate.After.SeekDistance, EMemoryUnitStandard::IEC),
+		FText::AsNumber(InEstimate.Before.EstimatedTime), FText::AsNumber(InEstimate.After.EstimatedTime));
+
+	FMessageDialog::Open(EAppMsgType::Ok, Message);
+}
+
+void SPakLoadView::OnLoadPakFinished()
+{
+	Reload();
+}
+
+void SPakLoadView::OnParseAssetFinished()
+{
+	Reload();
+}
+
+void SPakLoadView::OnLoadAssetReigstryFinished()
+{
+	Reload();
+}
+
+#undef LOCTEXT_NAMESPACE
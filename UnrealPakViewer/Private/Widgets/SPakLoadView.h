@@ -0,0 +1,68 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Widgets/SCompoundWidget.h"
+#include "Widgets/Views/SListView.h"
+
+#include "PakFileEntry.h"
+
+typedef TSharedPtr<FLoadSimulation> FLoadSimulationPtr;
+
+/** Simulated load cost of every map in the loaded paks. */
+class SPakLoadView : public SCompoundWidget
+{
+public:
+	/** Default constructor. */
+	SPakLoadView();
+
+	/** Virtual destructor. */
+	virtual ~SPakLoadView();
+
+	SLATE_BEGIN_ARGS(SPakLoadView) {}
+	SLATE_END_ARGS()
+
+	/** Constructs this widget. */
+	void Construct(const FArguments& InArgs);
+
+	/** Starts simulating in background, the list is filled when it finishes. */
+	void Reload();
+
+	static const FName MapColumnName;
+	static const FName PackageCountColumnName;
+	static const FName BlockCountColumnName;
+	static const FName ReadCountColumnName;
+	static const FName ReadSizeColumnName;
+	static const FName SeekDistanceColumnName;
+	static const FName EstimatedTimeColumnName;
+
+protected:
+	TSharedRef<ITableRow> OnGenerateRow(FLoadSimulationPtr InSimulation, const TSharedRef<class STableViewBase>& OwnerTable);
+	void OnSimulationDoubleClicked(FLoadSimulationPtr InSimulation);
+	TSharedRef<SWidget> OnGenerateDeviceWidget(TSharedPtr<FLoadDeviceModel> InDevice) const;
+	void OnDeviceSelectionChanged(TSharedPtr<FLoadDeviceModel> InDevice, ESelectInfo::Type SelectInfo);
+	FText GetSelectedDeviceText() const;
+	FText GetSummaryText() const;
+	FReply OnRefresh();
+	FReply OnExportOrder();
+	bool CanExportOrder() const;
+	void OnExportOrderFinished(bool bSuccess, const FPakOrderEstimate& InEstimate);
+
+	void OnLoadPakFinished();
+	void OnParseAssetFinished();
+	void OnLoadAssetReigstryFinished();
+	void OnLoadSimulationFinished(const TArray<FLoadSimulation>& InSimulations);
+
+protected:
+	TSharedPtr<SListView<FLoadSimulationPtr>> SimulationListView;
+
+	TArray<FLoadSimulationPtr> Simulations;
+	TMap<FName, FPakFileEntryPtr> MapFiles;
+
+	TArray<TSharedPtr<FLoadDeviceModel>> Devices;
+	TSharedPtr<FLoadDeviceModel> SelectedDevice;
+
+	/** Device of the running order export, the selection may change before it finishes. */
+	FName ExportDeviceName;
+
+	double TotalEstimatedTime = 0.0;
+};
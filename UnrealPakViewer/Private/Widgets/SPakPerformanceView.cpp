@@ -0,0 +1,419 @@
+#include "SPakPerformanceView.h"
+
+#include "HAL/PlatformApplicationMisc.h"
+#include "HAL/PlatformMemory.h"
+#include "Widgets/Input/SButton.h"
+#include "Widgets/Layout/SBox.h"
+#include "Widgets/SBoxPanel.h"
+#include "Widgets/Text/STextBlock.h"
+#include "Widgets/Views/STableRow.h"
+#include "Widgets/Views/STableViewBase.h"
+
+#include "CommonDefines.h"
+#include "PakAnalyzerModule.h"
+#include "SKeyValueRow.h"
+#include "ViewModels/WidgetDelegates.h"
+
+#define LOCTEXT_NAMESPACE "SPakPerformanceView"
+
+const FName SPakPerformanceView::StageColumnName(TEXT("Stage"));
+const FName SPakPerformanceView::CallsColumnName(TEXT("Calls"));
+const FName SPakPerformanceView::TotalTimeColumnName(TEXT("TotalTime"));
+const FName SPakPerformanceView::LastTimeColumnName(TEXT("LastTime"));
+const FName SPakPerformanceView::BytesReadColumnName(TEXT("BytesRead"));
+const FName SPakPerformanceView::BytesWrittenColumnName(TEXT("BytesWritten"));
+const FName SPakPerformanceView::AllocsColumnName(TEXT("Allocs"));
+
+static FText AsMilliseconds(double InSeconds)
+{
+	FNumberFormattingOptions Options;
+	Options.MinimumFractionalDigits = 2;
+	Options.MaximumFractionalDigits = 2;
+
+	return FText::Format(LOCTEXT("Milliseconds", "{0} ms"), FText::AsNumber(InSeconds * 1000.0, &Options));
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+// SPakStageRow
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+class SPakStageRow : public SMultiColumnTableRow<FPakAnalyzerStageStatPtr>
+{
+	SLATE_BEGIN_ARGS(SPakStageRow) {}
+	SLATE_END_ARGS()
+
+public:
+	void Construct(const FArguments& InArgs, FPakAnalyzerStageStatPtr InStat, const TSharedRef<STableViewBase>& InOwnerTableView)
+	{
+		WeakStat = MoveTemp(InStat);
+
+		SMultiColumnTableRow<FPakAnalyzerStageStatPtr>::Construct(FSuperRowType::FArguments(), InOwnerTableView);
+	}
+
+	virtual TSharedRef<SWidget> GenerateWidgetForColumn(const FName& ColumnName) override
+	{
+		FPakAnalyzerStageStatPtr StatPin = WeakStat.Pin();
+
+		FText Text;
+		FText ToolTip;
+		if (StatPin.IsValid())
+		{
+			if (ColumnName == SPakPerformanceView::StageColumnName)
+			{
+				Text = FText::FromName(StatPin->Name);
+				ToolTip = Text;
+			}
+			else if (ColumnName == SPakPerformanceView::CallsColumnName)
+			{
+				Text = FText::AsNumber(StatPin->CallCount);
+			}
+			else if (ColumnName == SPakPerformanceView::TotalTimeColumnName)
+			{
+				Text = AsMilliseconds(StatPin->TotalSeconds);
+			}
+			else if (ColumnName == SPakPerformanceView::LastTimeColumnName)
+			{
+				Text = AsMilliseconds(StatPin->LastSeconds);
+			}
+			else if (ColumnName == SPakPerformanceView::BytesReadColumnName)
+			{
+				Text = FText::AsMemory(StatPin->BytesRead, EMemoryUnitStandard::IEC);
+				ToolTip = FText::AsNumber(StatPin->BytesRead);
+			}
+			else if (ColumnName == SPakPerformanceView::BytesWrittenColumnName)
+			{
+				Text = FText::AsMemory(StatPin->BytesWritten, EMemoryUnitStandard::IEC);
+				ToolTip = FText::AsNumber(StatPin->BytesWritten);
+			}
+			else if (ColumnName == SPakPerformanceView::AllocsColumnName)
+			{
+				Text = FText::AsNumber(StatPin->AllocCount);
+			}
+		}
+
+		return
+			SNew(SBox).Padding(FMargin(4.0, 0.0))
+			[
+				SNew(STextBlock).Text(Text).ToolTipText(ToolTip)
+			];
+	}
+
+protected:
+	TWeakPtr<FPakAnalyzerStageStat> WeakStat;
+};
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+// SPakPerformanceView
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+SPakPerformanceView::SPakPerformanceView()
+{
+	FWidgetDelegates::GetOnLoadAssetRegistryFinishedDelegate().AddRaw(this, &SPakPerformanceView::OnLoadAssetRegistryFinished);
+	FPakAnalyzerDelegates::OnPakLoadFinish.AddRaw(this, &SPakPerformanceView::OnLoadPakFinished);
+	FPakAnalyzerDelegates::OnAssetParseFinish.AddRaw(this, &SPakPerformanceView::OnParseAssetFinished);
+}
+
+SPakPerformanceView::~SPakPerformanceView()
+{
+	FWidgetDelegates::GetOnLoadAssetRegistryFinishedDelegate().RemoveAll(this);
+	FPakAnalyzerDelegates::OnPakLoadFinish.RemoveAll(this);
+	FPakAnalyzerDelegates::OnAssetParseFinish.RemoveAll(this);
+}
+
+void SPakPerformanceView::Construct(const FArguments& InArgs)
+{
+	ChildSlot
+	[
+		SNew(SVerticalBox)
+
+		+ SVerticalBox::Slot().AutoHeight().Padding(2.f)
+		[
+			SNew(SHorizontalBox)
+
+			+ SHorizontalBox::Slot().AutoWidth().Padding(2.f, 0.f)
+			[
+				SNew(SButton)
+				.Text(LOCTEXT("Refresh", "Refresh"))
+				.ToolTipText(LOCTEXT("RefreshTip", "Read counters and stage timings again"))
+				.OnClicked(this, &SPakPerformanceView::OnRefresh)
+			]
+
+			+ SHorizontalBox::Slot().AutoWidth().Padding(2.f, 0.f)
+			[
+				SNew(SButton)
+				.Text(LOCTEXT("ResetStages", "Reset Stages"))
+				.ToolTipText(LOCTEXT("ResetStagesTip", "Clear accumulated stage timings"))
+				.OnClicked(this, &SPakPerformanceView::OnResetStages)
+			]
+
+			+ SHorizontalBox::Slot().AutoWidth().Padding(2.f, 0.f)
+			[
+				SNew(SButton)
+				.Text(LOCTEXT("CopyReport", "Copy Report"))
+				.ToolTipText(LOCTEXT("CopyReportTip", "Copy all values to clipboard as text"))
+				.OnClicked(this, &SPakPerformanceView::OnCopyReport)
+			]
+		]
+
+		+ SVerticalBox::Slot().AutoHeight().Padding(4.f, 2.f)
+		[
+			SNew(SHorizontalBox)
+
+			+ SHorizontalBox::Slot().FillWidth(1.f).Padding(0.f, 0.f, 8.f, 0.f)
+			[
+				SNew(SVerticalBox)
+
+				+ SVerticalBox::Slot().AutoHeight()
+				[
+					MakeValueRow(LOCTEXT("TreeNodes", "Tree Nodes:"), [this]() { return FText::AsNumber(Stats.TreeNodeCount); })
+				]
+
+				+ SVerticalBox::Slot().AutoHeight()
+				[
+					MakeValueRow(LOCTEXT("Directories", "Directories:"), [this]() { return FText::AsNumber(Stats.DirectoryCount); })
+				]
+
+				+ SVerticalBox::Slot().AutoHeight()
+				[
+					MakeValueRow(LOCTEXT("Files", "Files:"), [this]() { return FText::AsNumber(Stats.FileCount); })
+				]
+
+				+ SVerticalBox::Slot().AutoHeight()
+				[
+					MakeValueRow(LOCTEXT("AssetSummaries", "Asset Summaries:"), [this]() { return FText::AsNumber(Stats.AssetSummaryCount); })
+				]
+
+				+ SVerticalBox::Slot().AutoHeight()
+				[
+					MakeValueRow(LOCTEXT("RegistryPackages", "Registry Packages:"), [this]() { return FText::AsNumber(Stats.RegistryPackageCount); })
+				]
+
+				+ SVerticalBox::Slot().AutoHeight()
+				[
+					MakeValueRow(LOCTEXT("GraphPackages", "Graph Packages:"), [this]() { return FText::AsNumber(Stats.GraphPackageCount); })
+				]
+
+				+ SVerticalBox::Slot().AutoHeight()
+				[
+					MakeValueRow(LOCTEXT("LastExtract", "Last Extract:"), [this]() { return GetExtractText(); })
+				]
+
+				+ SVerticalBox::Slot().AutoHeight()
+				[
+					MakeValueRow(LOCTEXT("ProcessMemory", "Process Memory:"), [this]() { return GetProcessMemoryText(); })
+				]
+			]
+
+			+ SHorizontalBox::Slot().FillWidth(1.f)
+			[
+				SNew(SVerticalBox)
+
+				+ SVerticalBox::Slot().AutoHeight()
+				[
+					MakeMemoryRow(LOCTEXT("TreeNodeMemory", "Tree Nodes:"), &FPakSessionStats::TreeNodeMemory)
+				]
+
+				+ SVerticalBox::Slot().AutoHeight()
+				[
+					MakeMemoryRow(LOCTEXT("PathMemory", "Paths:"), &FPakSessionStats::PathMemory)
+				]
+
+				+ SVerticalBox::Slot().AutoHeight()
+				[
+					MakeMemoryRow(LOCTEXT("CompressionBlockMemory", "Compression Blocks:"), &FPakSessionStats::CompressionBlockMemory)
+				]
+
+				+ SVerticalBox::Slot().AutoHeight()
+				[
+					MakeMemoryRow(LOCTEXT("AssetSummaryMemory", "Asset Summaries:"), &FPakSessionStats::AssetSummaryMemory)
+				]
+
+				+ SVerticalBox::Slot().AutoHeight()
+				[
+					MakeMemoryRow(LOCTEXT("NameMemory", "Name Maps:"), &FPakSessionStats::NameMemory)
+				]
+
+				+ SVerticalBox::Slot().AutoHeight()
+				[
+					MakeMemoryRow(LOCTEXT("ImportMemory", "Imports:"), &FPakSessionStats::ImportMemory)
+				]
+
+				+ SVerticalBox::Slot().AutoHeight()
+				[
+					MakeMemoryRow(LOCTEXT("ExportMemory", "Exports:"), &FPakSessionStats::ExportMemory)
+				]
+
+				+ SVerticalBox::Slot().AutoHeight()
+				[
+					MakeMemoryRow(LOCTEXT("EdgeMemory", "Dependency Edges:"), &FPakSessionStats::EdgeMemory)
+				]
+
+				+ SVerticalBox::Slot().AutoHeight()
+				[
+					MakeMemoryRow(LOCTEXT("RegistryMemory", "Asset Registry:"), &FPakSessionStats::RegistryMemory)
+				]
+
+				+ SVerticalBox::Slot().AutoHeight()
+				[
+					MakeMemoryRow(LOCTEXT("GraphMemory", "Dependency Graph:"), &FPakSessionStats::GraphMemory)
+				]
+
+				+ SVerticalBox::Slot().AutoHeight()
+				[
+					MakeValueRow(LOCTEXT("TotalMemory", "Estimated Total:"), [this]() { return FText::AsMemory(GetTotalMemory(), EMemoryUnitStandard::IEC); })
+				]
+			]
+		]
+
+		+ SVerticalBox::Slot().FillHeight(1.f)
+		[
+			SAssignNew(StageListView, SListView<FPakAnalyzerStageStatPtr>)
+			.ItemHeight(20.f)
+			.SelectionMode(ESelectionMode::Single)
+			.ListItemsSource(&Stages)
+			.OnGenerateRow(this, &SPakPerformanceView::OnGenerateRow)
+			.HeaderRow
+			(
+				SNew(SHeaderRow)
+				+ SHeaderRow::Column(StageColumnName).DefaultLabel(LOCTEXT("StageColumn", "Stage")).FillWidth(1.f)
+				+ SHeaderRow::Column(CallsColumnName).DefaultLabel(LOCTEXT("CallsColumn", "Calls")).ManualWidth(80.f)
+				+ SHeaderRow::Column(TotalTimeColumnName).DefaultLabel(LOCTEXT("TotalTimeColumn", "Total")).DefaultTooltip(LOCTEXT("TotalTimeColumnTip", "Accumulated wall time, nested stages are included in their parent")).ManualWidth(100.f)
+				+ SHeaderRow::Column(LastTimeColumnName).DefaultLabel(LOCTEXT("LastTimeColumn", "Last")).ManualWidth(100.f)
+				+ SHeaderRow::Column(BytesReadColumnName).DefaultLabel(LOCTEXT("BytesReadColumn", "Read")).ManualWidth(100.f)
+				+ SHeaderRow::Column(BytesWrittenColumnName).DefaultLabel(LOCTEXT("BytesWrittenColumn", "Written")).ManualWidth(100.f)
+				+ SHeaderRow::Column(AllocsColumnName).DefaultLabel(LOCTEXT("AllocsColumn", "Allocs")).DefaultTooltip(LOCTEXT("AllocsColumnTip", "Heap allocations made on the stage's thread while it ran, nested stages included")).ManualWidth(80.f)
+			)
+		]
+	];
+
+	Reload();
+}
+
+void SPakPerformanceView::Reload()
+{
+	Stats = FPakSessionStats();
+
+	IPakAnalyzer* PakAnalyzer = IPakAnalyzerModule::Get().GetPakAnalyzer();
+	if (PakAnalyzer)
+	{
+		PakAnalyzer->GetSessionStats(Stats);
+	}
+
+	TArray<FPakAnalyzerStageStat> StageStats;
+	FPakAnalyzerTrace::GetStageStats(StageStats);
+	StageStats.Sort([](const FPakAnalyzerStageStat& A, const FPakAnalyzerStageStat& B) { return A.TotalSeconds > B.TotalSeconds; });
+
+	Stages.Empty(StageStats.Num());
+	for (const FPakAnalyzerStageStat& StageStat : StageStats)
+	{
+		Stages.Add(MakeShared<FPakAnalyzerStageStat>(StageStat));
+	}
+
+	StageListView->RebuildList();
+}
+
+TSharedRef<ITableRow> SPakPerformanceView::OnGenerateRow(FPakAnalyzerStageStatPtr InStat, const TSharedRef<STableViewBase>& OwnerTable)
+{
+	return SNew(SPakStageRow, InStat, OwnerTable);
+}
+
+TSharedRef<SWidget> SPakPerformanceView::MakeValueRow(const FText& InKey, TFunction<FText()> InGetValue) const
+{
+	return SNew(SKeyValueRow).KeyText(InKey).ValueText_Lambda(MoveTemp(InGetValue));
+}
+
+TSharedRef<SWidget> SPakPerformanceView::MakeMemoryRow(const FText& InKey, const int64 FPakSessionStats::* InMember) const
+{
+	return SNew(SKeyValueRow).KeyText(InKey)
+		.ValueText_Lambda([this, InMember]() { return FText::AsMemory(Stats.*InMember, EMemoryUnitStandard::IEC); })
+		.ValueToolTipText_Lambda([this, InMember]() { return FText::AsNumber(Stats.*InMember); });
+}
+
+FText SPakPerformanceView::GetExtractText() const
+{
+	if (Stats.LastExtractFileCount <= 0)
+	{
+		return LOCTEXT("NoExtract", "None");
+	}
+
+	if (Stats.LastExtractSeconds <= 0.0)
+	{
+		return FText::Format(LOCTEXT("ExtractRunning", "{0} files, {1}, running"), FText::AsNumber(Stats.LastExtractFileCount), FText::AsMemory(Stats.LastExtractSize, EMemoryUnitStandard::IEC));
+	}
+
+	return FText::Format(LOCTEXT("ExtractFinished", "{0} files, {1} in {2}, {3}/s"),
+		FText::AsNumber(Stats.LastExtractFileCount),
+		FText::AsMemory(Stats.LastExtractSize, EMemoryUnitStandard::IEC),
+		AsMilliseconds(Stats.LastExtractSeconds),
+		FText::AsMemory((int64)(Stats.LastExtractSize / Stats.LastExtractSeconds), EMemoryUnitStandard::IEC));
+}
+
+FText SPakPerformanceView::GetProcessMemoryText() const
+{
+	const FPlatformMemoryStats MemoryStats = FPlatformMemory::GetStats();
+	return FText::Format(LOCTEXT("ProcessMemoryValue", "{0} used, {1} peak"), FText::AsMemory(MemoryStats.UsedPhysical, EMemoryUnitStandard::IEC), FText::AsMemory(MemoryStats.PeakUsedPhysical, EMemoryUnitStandard::IEC));
+}
+
+int64 SPakPerformanceView::GetTotalMemory() const
+{
+	return Stats.TreeNodeMemory + Stats.PathMemory + Stats.CompressionBlockMemory + Stats.AssetSummaryMemory + Stats.NameMemory
+		+ Stats.ImportMemory + Stats.ExportMemory + Stats.EdgeMemory + Stats.RegistryMemory + Stats.GraphMemory;
+}
+
+FReply SPakPerformanceView::OnRefresh()
+{
+	Reload();
+
+	return FReply::Handled();
+}
+
+FReply SPakPerformanceView::OnResetStages()
+{
+	FPakAnalyzerTrace::ResetStageStats();
+	Reload();
+
+	return FReply::Handled();
+}
+
+FReply SPakPerformanceView::OnCopyReport()
+{
+	Reload();
+
+	FString Report;
+	Report += FString::Printf(TEXT("Tree nodes\t%d\nDirectories\t%d\nFiles\t%d\nAsset summaries\t%d\nRegistry packages\t%d\nGraph packages\t%d\n"),
+		Stats.TreeNodeCount, Stats.DirectoryCount, Stats.FileCount, Stats.AssetSummaryCount, Stats.RegistryPackageCount, Stats.GraphPackageCount);
+	Report += FString::Printf(TEXT("Last extract\t%s\nProcess memory\t%s\n\n"), *GetExtractText().ToString(), *GetProcessMemoryText().ToString());
+
+	Report += FString::Printf(TEXT("Tree node memory\t%lld\nPath memory\t%lld\nCompression block memory\t%lld\nAsset summary memory\t%lld\nName map memory\t%lld\n"),
+		Stats.TreeNodeMemory, Stats.PathMemory, Stats.CompressionBlockMemory, Stats.AssetSummaryMemory, Stats.NameMemory);
+	Report += FString::Printf(TEXT("Import memory\t%lld\nExport memory\t%lld\nDependency edge memory\t%lld\nAsset registry memory\t%lld\nDependency graph memory\t%lld\nEstimated total\t%lld\n\n"),
+		Stats.ImportMemory, Stats.ExportMemory, Stats.EdgeMemory, Stats.RegistryMemory, Stats.GraphMemory, GetTotalMemory());
+
+	Report += TEXT("Stage\tCalls\tTotal(ms)\tLast(ms)\tRead\tWritten\tAllocs\n");
+	for (const FPakAnalyzerStageStatPtr& Stage : Stages)
+	{
+		Report += FString::Printf(TEXT("%s\t%d\t%.2f\t%.2f\t%lld\t%lld\t%lld\n"), *Stage->Name.ToString(), Stage->CallCount,
+			Stage->TotalSeconds * 1000.0, Stage->LastSeconds * 1000.0, Stage->BytesRead, Stage->BytesWritten, Stage->AllocCount);
+	}
+
+	FPlatformApplicationMisc::ClipboardCopy(*Report);
+
+	return FReply::Handled();
+}
+
+void SPakPerformanceView::OnLoadPakFinished()
+{
+	Reload();
+}
+
+void SPakPerformanceView::OnParseAssetFinished()
+{
+	Reload();
+}
+
+void SPakPerformanceView::OnLoadAssetRegistryFinished()
+{
+	Reload();
+}
+
+#undef LOCTEXT_NAMESPACE
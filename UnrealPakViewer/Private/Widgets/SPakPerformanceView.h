@@ -0,0 +1,60 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Widgets/SCompoundWidget.h"
+#include "Widgets/Views/SListView.h"
+
+#include "PakAnalyzerTrace.h"
+#include "PakFileEntry.h"
+
+typedef TSharedPtr<FPakAnalyzerStageStat> FPakAnalyzerStageStatPtr;
+
+/** Stage timings, live counts and estimated memory of the loaded session. */
+class SPakPerformanceView : public SCompoundWidget
+{
+public:
+	/** Default constructor. */
+	SPakPerformanceView();
+
+	/** Virtual destructor. */
+	virtual ~SPakPerformanceView();
+
+	SLATE_BEGIN_ARGS(SPakPerformanceView) {}
+	SLATE_END_ARGS()
+
+	/** Constructs this widget. */
+	void Construct(const FArguments& InArgs);
+
+	void Reload();
+
+	static const FName StageColumnName;
+	static const FName CallsColumnName;
+	static const FName TotalTimeColumnName;
+	static const FName LastTimeColumnName;
+	static const FName BytesReadColumnName;
+	static const FName BytesWrittenColumnName;
+	static const FName AllocsColumnName;
+
+protected:
+	TSharedRef<ITableRow> OnGenerateRow(FPakAnalyzerStageStatPtr InStat, const TSharedRef<class STableViewBase>& OwnerTable);
+	TSharedRef<SWidget> MakeValueRow(const FText& InKey, TFunction<FText()> InGetValue) const;
+	TSharedRef<SWidget> MakeMemoryRow(const FText& InKey, const int64 FPakSessionStats::* InMember) const;
+
+	FText GetExtractText() const;
+	FText GetProcessMemoryText() const;
+	int64 GetTotalMemory() const;
+
+	FReply OnRefresh();
+	FReply OnResetStages();
+	FReply OnCopyReport();
+
+	void OnLoadPakFinished();
+	void OnParseAssetFinished();
+	void OnLoadAssetRegistryFinished();
+
+protected:
+	TSharedPtr<SListView<FPakAnalyzerStageStatPtr>> StageListView;
+
+	TArray<FPakAnalyzerStageStatPtr> Stages;
+	FPakSessionStats Stats;
+};
@@ -0,0 +1,447 @@
+#include "SPakRecompressionView.h"
+
+#include "HAL/PlatformTime.h"
+#include "Misc/ConfigCacheIni.h"
+#include "Widgets/Input/SButton.h"
+#include "Widgets/Input/SComboBox.h"
+#include "Widgets/Input/SEditableTextBox.h"
+#include "Widgets/Layout/SBox.h"
+#include "Widgets/SBoxPanel.h"
+#include "Widgets/Text/STextBlock.h"
+#include "Widgets/Views/STableRow.h"
+#include "Widgets/Views/STableViewBase.h"
+
+#include "CommonDefines.h"
+#include "PakAnalyzerModule.h"
+
+#define LOCTEXT_NAMESPACE "SPakRecompressionView"
+
+const FName SPakRecompressionView::NameColumnName(TEXT("Name"));
+const FName SPakRecompressionView::MethodColumnName(TEXT("Method"));
+const FName SPakRecompressionView::BlockSizeColumnName(TEXT("BlockSize"));
+const FName SPakRecompressionView::FileCountColumnName(TEXT("FileCount"));
+const FName SPakRecompressionView::CurrentSizeColumnName(TEXT("CurrentSize"));
+const FName SPakRecompressionView::EstimatedSizeColumnName(TEXT("EstimatedSize"));
+const FName SPakRecompressionView::SavingColumnName(TEXT("Saving"));
+const FName SPakRecompressionView::DecompressSpeedColumnName(TEXT("DecompressSpeed"));
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+// SPakRecompressionRow
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+class SPakRecompressionRow : public SMultiColumnTableRow<FRecompressionItemPtr>
+{
+	SLATE_BEGIN_ARGS(SPakRecompressionRow) {}
+	SLATE_END_ARGS()
+
+public:
+	void Construct(const FArguments& InArgs, FRecompressionItemPtr InItem, const TSharedRef<STableViewBase>& InOwnerTableView)
+	{
+		WeakItem = MoveTemp(InItem);
+
+		SMultiColumnTableRow<FRecompressionItemPtr>::Construct(FSuperRowType::FArguments(), InOwnerTableView);
+	}
+
+	virtual TSharedRef<SWidget> GenerateWidgetForColumn(const FName& ColumnName) override
+	{
+		FRecompressionItemPtr ItemPin = WeakItem.Pin();
+
+		FText Text;
+		FText ToolTip;
+		FSlateColor Color = FLinearColor::White;
+		if (ItemPin.IsValid())
+		{
+			const FRecompressionEstimate& Estimate = ItemPin->Estimate;
+			if (ColumnName == SPakRecompressionView::NameColumnName)
+			{
+				Text = FText::FromString(ItemPin->Name);
+				ToolTip = Text;
+			}
+			else if (ColumnName == SPakRecompressionView::MethodColumnName)
+			{
+				Text = FText::FromName(Estimate.Method);
+			}
+			else if (ColumnName == SPakRecompressionView::BlockSizeColumnName)
+			{
+				Text = FText::AsMemory(Estimate.BlockSize, EMemoryUnitStandard::IEC);
+			}
+			else if (ColumnName == SPakRecompressionView::FileCountColumnName)
+			{
+				Text = FText::AsNumber(ItemPin->FileCount);
+			}
+			else if (ColumnName == SPakRecompressionView::CurrentSizeColumnName)
+			{
+				Text = FText::AsMemory(ItemPin->CurrentCompressedSize, EMemoryUnitStandard::IEC);
+				ToolTip = FText::AsNumber(ItemPin->CurrentCompressedSize);
+			}
+			else if (ColumnName == SPakRecompressionView::EstimatedSizeColumnName)
+			{
+				Text = FText::AsMemory(Estimate.CompressedSize, EMemoryUnitStandard::IEC);
+				ToolTip = FText::Format(LOCTEXT("EstimatedSizeTip", "{0} bytes, {1} blocks"), FText::AsNumber(Estimate.CompressedSize), FText::AsNumber(Estimate.BlockCount));
+			}
+			else if (ColumnName == SPakRecompressionView::SavingColumnName)
+			{
+				const int64 Saving = ItemPin->CurrentCompressedSize - Estimate.CompressedSize;
+				const FText Memory = FText::AsMemory(FMath::Abs(Saving), EMemoryUnitStandard::IEC);
+				Text = Saving >= 0 ? Memory : FText::Format(LOCTEXT("NegativeSaving", "-{0}"), Memory);
+				ToolTip = ItemPin->CurrentCompressedSize > 0 ? FText::AsPercent((double)Saving / ItemPin->CurrentCompressedSize) : FText();
+				Color = Saving > 0 ? FLinearColor::Green : (Saving < 0 ? FLinearColor::Red : FLinearColor::White);
+			}
+			else if (ColumnName == SPakRecompressionView::DecompressSpeedColumnName)
+			{
+				// Only compressed blocks are timed, stored files cost a copy
+				if (Estimate.DecompressTime > 0.0)
+				{
+					Text = FText::Format(LOCTEXT("DecompressSpeed", "{0}/s"), FText::AsMemory((int64)(ItemPin->Size / Estimate.DecompressTime), EMemoryUnitStandard::IEC));
+					ToolTip = FText::Format(LOCTEXT("DecompressTimeTip", "{0}ms to decompress on one thread"), FText::AsNumber(Estimate.DecompressTime * 1000.0));
+				}
+			}
+		}
+
+		return
+			SNew(SBox).Padding(FMargin(4.0, 0.0))
+			[
+				SNew(STextBlock).Text(Text).ToolTipText(ToolTip).ColorAndOpacity(Color)
+			];
+	}
+
+protected:
+	TWeakPtr<FRecompressionItem> WeakItem;
+};
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+// SPakRecompressionView
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+SPakRecompressionView::SPakRecompressionView()
+{
+	FPakAnalyzerDelegates::OnPakLoadFinish.AddRaw(this, &SPakRecompressionView::OnLoadPakFinished);
+	FPakAnalyzerDelegates::OnRecompressionEstimateFinish.AddRaw(this, &SPakRecompressionView::OnEstimateFinished);
+}
+
+SPakRecompressionView::~SPakRecompressionView()
+{
+	FPakAnalyzerDelegates::OnPakLoadFinish.RemoveAll(this);
+	FPakAnalyzerDelegates::OnRecompressionEstimateFinish.RemoveAll(this);
+}
+
+void SPakRecompressionView::Construct(const FArguments& InArgs)
+{
+	Groupings.Add(MakeShared<ERecompressionGrouping>(ERecompressionGrouping::Total));
+	Groupings.Add(MakeShared<ERecompressionGrouping>(ERecompressionGrouping::Folders));
+	Groupings.Add(MakeShared<ERecompressionGrouping>(ERecompressionGrouping::Classes));
+	SelectedGrouping = Groupings[0];
+
+	ChildSlot
+	[
+		SNew(SVerticalBox)
+
+		+ SVerticalBox::Slot().AutoHeight().Padding(2.f)
+		[
+			SNew(SHorizontalBox)
+
+			+ SHorizontalBox::Slot().AutoWidth().VAlign(VAlign_Center).Padding(2.f, 0.f)
+			[
+				SNew(STextBlock).Text(LOCTEXT("Sample", "Sample %:"))
+			]
+
+			+ SHorizontalBox::Slot().AutoWidth().Padding(2.f, 0.f)
+			[
+				SNew(SBox).WidthOverride(80.f)
+				[
+					SAssignNew(SampleBox, SSpinBox<float>)
+					.MinValue(1.f)
+					.MaxValue(100.f)
+					.Value(100.f)
+					.ToolTipText(LOCTEXT("SampleTip", "Percent of the selected files to recompress, every Nth file is taken"))
+				]
+			]
+
+			+ SHorizontalBox::Slot().FillWidth(1.f).Padding(2.f, 0.f)
+			[
+				SAssignNew(BlockSizesBox, SEditableTextBox)
+				.HintText(LOCTEXT("BlockSizesHint", "Block sizes in KB, comma separated"))
+				.ToolTipText(LOCTEXT("BlockSizesTip", "Compression block sizes to try, in KB"))
+			]
+
+			+ SHorizontalBox::Slot().FillWidth(1.f).Padding(2.f, 0.f)
+			[
+				SAssignNew(MethodsBox, SEditableTextBox)
+				.HintText(LOCTEXT("MethodsHint", "Methods, empty for all available"))
+				.ToolTipText(LOCTEXT("MethodsTip", "Compression methods to try, e.g. Zlib, Gzip, LZ4, Oodle"))
+			]
+
+			+ SHorizontalBox::Slot().AutoWidth().Padding(2.f, 0.f)
+			[
+				SNew(SButton)
+				.Text(LOCTEXT("Estimate", "Estimate"))
+				.ToolTipText(LOCTEXT("EstimateTip", "Estimate the last selected files again with these settings"))
+				.IsEnabled_Lambda([this]() { return !IsEstimating() && Files.Num() > 0; })
+				.OnClicked(this, &SPakRecompressionView::OnEstimate)
+			]
+
+			+ SHorizontalBox::Slot().AutoWidth().Padding(2.f, 0.f)
+			[
+				SNew(SButton)
+				.Text(LOCTEXT("Cancel", "Cancel"))
+				.ToolTipText(LOCTEXT("CancelTip", "Stop the running estimate"))
+				.IsEnabled(this, &SPakRecompressionView::IsEstimating)
+				.OnClicked(this, &SPakRecompressionView::OnCancel)
+			]
+
+			+ SHorizontalBox::Slot().AutoWidth().VAlign(VAlign_Center).Padding(6.f, 0.f, 2.f, 0.f)
+			[
+				SNew(STextBlock).Text(LOCTEXT("GroupBy", "Group By:"))
+			]
+
+			+ SHorizontalBox::Slot().AutoWidth().Padding(2.f, 0.f)
+			[
+				SNew(SBox).WidthOverride(100.f)
+				[
+					SNew(SComboBox<TSharedPtr<ERecompressionGrouping>>)
+					.OptionsSource(&Groupings)
+					.OnGenerateWidget(this, &SPakRecompressionView::OnGenerateGroupingWidget)
+					.OnSelectionChanged(this, &SPakRecompressionView::OnGroupingSelectionChanged)
+					.InitiallySelectedItem(SelectedGrouping)
+					.Content()
+					[
+						SNew(STextBlock).Text(this, &SPakRecompressionView::GetSelectedGroupingText)
+					]
+				]
+			]
+		]
+
+		+ SVerticalBox::Slot().AutoHeight().Padding(4.f, 2.f)
+		[
+			SNew(STextBlock).Text(this, &SPakRecompressionView::GetSummaryText).AutoWrapText(true)
+		]
+
+		+ SVerticalBox::Slot().FillHeight(1.f)
+		[
+			SAssignNew(ItemListView, SListView<FRecompressionItemPtr>)
+			.ItemHeight(20.f)
+			.SelectionMode(ESelectionMode::Single)
+			.ListItemsSource(&Items)
+			.OnGenerateRow(this, &SPakRecompressionView::OnGenerateRow)
+			.HeaderRow
+			(
+				SNew(SHeaderRow)
+				+ SHeaderRow::Column(NameColumnName).DefaultLabel(LOCTEXT("NameColumn", "Name")).FillWidth(1.f)
+				+ SHeaderRow::Column(MethodColumnName).DefaultLabel(LOCTEXT("MethodColumn", "Method")).ManualWidth(80.f)
+				+ SHeaderRow::Column(BlockSizeColumnName).DefaultLabel(LOCTEXT("BlockSizeColumn", "Block Size")).ManualWidth(80.f)
+				+ SHeaderRow::Column(FileCountColumnName).DefaultLabel(LOCTEXT("FileCountColumn", "Files")).DefaultTooltip(LOCTEXT("FileCountColumnTip", "Sampled file count")).ManualWidth(60.f)
+				+ SHeaderRow::Column(CurrentSizeColumnName).DefaultLabel(LOCTEXT("CurrentSizeColumn", "Current Size")).DefaultTooltip(LOCTEXT("CurrentSizeColumnTip", "Compressed size of the sampled files in the paks now")).ManualWidth(110.f)
+				+ SHeaderRow::Column(EstimatedSizeColumnName).DefaultLabel(LOCTEXT("EstimatedSizeColumn", "Estimated Size")).DefaultTooltip(LOCTEXT("EstimatedSizeColumnTip", "Compressed size of the sampled files with this method and block size")).ManualWidth(110.f)
+				+ SHeaderRow::Column(SavingColumnName).DefaultLabel(LOCTEXT("SavingColumn", "Saving")).ManualWidth(110.f)
+				+ SHeaderRow::Column(DecompressSpeedColumnName).DefaultLabel(LOCTEXT("DecompressSpeedColumn", "Decompress Speed")).DefaultTooltip(LOCTEXT("DecompressSpeedColumnTip", "Original bytes decompressed per second on one thread")).ManualWidth(120.f)
+			)
+		]
+	];
+
+	LoadConfig();
+}
+
+void SPakRecompressionView::StartEstimate(const TArray<FPakFileEntryPtr>& InFiles)
+{
+	IPakAnalyzer* PakAnalyzer = IPakAnalyzerModule::Get().GetPakAnalyzer();
+	if (!PakAnalyzer || IsEstimating())
+	{
+		return;
+	}
+
+	SaveConfig();
+
+	Files = InFiles;
+	Result.Reset();
+	FillItems();
+
+	FRecompressionOptions Options;
+	GetOptions(Options);
+
+	EstimateStartTime = FPlatformTime::Seconds();
+	PakAnalyzer->StartEstimateRecompression(InFiles, Options);
+}
+
+TSharedRef<ITableRow> SPakRecompressionView::OnGenerateRow(FRecompressionItemPtr InItem, const TSharedRef<STableViewBase>& OwnerTable)
+{
+	return SNew(SPakRecompressionRow, InItem, OwnerTable);
+}
+
+TSharedRef<SWidget> SPakRecompressionView::OnGenerateGroupingWidget(TSharedPtr<ERecompressionGrouping> InGrouping) const
+{
+	return SNew(STextBlock).Text(GetGroupingText(InGrouping));
+}
+
+void SPakRecompressionView::OnGroupingSelectionChanged(TSharedPtr<ERecompressionGrouping> InGrouping, ESelectInfo::Type SelectInfo)
+{
+	if (InGrouping.IsValid())
+	{
+		SelectedGrouping = InGrouping;
+		FillItems();
+	}
+}
+
+FText SPakRecompressionView::GetGroupingText(TSharedPtr<ERecompressionGrouping> InGrouping) const
+{
+	if (!InGrouping.IsValid())
+	{
+		return FText();
+	}
+
+	switch (*InGrouping)
+	{
+	case ERecompressionGrouping::Folders: return LOCTEXT("Folders", "Folders");
+	case ERecompressionGrouping::Classes: return LOCTEXT("Classes", "Classes");
+	default: return LOCTEXT("Total", "Total");
+	}
+}
+
+FText SPakRecompressionView::GetSelectedGroupingText() const
+{
+	return GetGroupingText(SelectedGrouping);
+}
+
+FText SPakRecompressionView::GetSummaryText() const
+{
+	if (IsEstimating())
+	{
+		return FText::Format(LOCTEXT("Estimating", "Recompressing {0} files, {1}s elapsed..."), FText::AsNumber(Files.Num()), FText::AsNumber(FMath::RoundToInt(FPlatformTime::Seconds() - EstimateStartTime)));
+	}
+
+	if (!Result.IsValid())
+	{
+		return LOCTEXT("NoEstimate", "Right click files in tree view or file view and choose \"Estimate Recompression\".");
+	}
+
+	return FText::Format(LOCTEXT("EstimateSummary", "{0} files selected, {1} sampled, {2} failed to read, estimated in {3}s. Sizes are of the sampled files only."),
+		FText::AsNumber(Result->FileCount), FText::AsNumber(Result->SampledFileCount), FText::AsNumber(Result->FailedFileCount), FText::AsNumber(EstimateCost));
+}
+
+FReply SPakRecompressionView::OnEstimate()
+{
+	StartEstimate(TArray<FPakFileEntryPtr>(Files));
+
+	return FReply::Handled();
+}
+
+FReply SPakRecompressionView::OnCancel()
+{
+	IPakAnalyzer* PakAnalyzer = IPakAnalyzerModule::Get().GetPakAnalyzer();
+	if (PakAnalyzer)
+	{
+		PakAnalyzer->CancelEstimateRecompression();
+	}
+
+	return FReply::Handled();
+}
+
+bool SPakRecompressionView::IsEstimating() const
+{
+	IPakAnalyzer* PakAnalyzer = IPakAnalyzerModule::Get().GetPakAnalyzer();
+	return PakAnalyzer && PakAnalyzer->IsEstimatingRecompression();
+}
+
+void SPakRecompressionView::FillItems()
+{
+	Items.Empty();
+
+	if (Result.IsValid())
+	{
+		TArray<const FRecompressionGroup*> Groups;
+		if (*SelectedGrouping == ERecompressionGrouping::Folders)
+		{
+			for (const FRecompressionGroup& Group : Result->Folders)
+			{
+				Groups.Add(&Group);
+			}
+		}
+		else if (*SelectedGrouping == ERecompressionGrouping::Classes)
+		{
+			for (const FRecompressionGroup& Group : Result->Classes)
+			{
+				Groups.Add(&Group);
+			}
+		}
+		else
+		{
+			Groups.Add(&Result->Total);
+		}
+
+		for (const FRecompressionGroup* Group : Groups)
+		{
+			for (const FRecompressionEstimate& Estimate : Group->Estimates)
+			{
+				FRecompressionItemPtr Item = MakeShared<FRecompressionItem>();
+				Item->Name = Group->Name;
+				Item->FileCount = Group->FileCount;
+				Item->Size = Group->Size;
+				Item->CurrentCompressedSize = Group->CurrentCompressedSize;
+				Item->Estimate = Estimate;
+				Items.Add(Item);
+			}
+		}
+	}
+
+	ItemListView->RebuildList();
+}
+
+void SPakRecompressionView::GetOptions(FRecompressionOptions& OutOptions) const
+{
+	OutOptions.SampleRatio = SampleBox->GetValue() / 100.f;
+
+	TArray<FString> Values;
+	BlockSizesBox->GetText().ToString().ParseIntoArray(Values, TEXT(","));
+	if (Values.Num() > 0)
+	{
+		OutOptions.BlockSizes.Empty();
+		for (const FString& Value : Values)
+		{
+			OutOptions.BlockSizes.Add(FCString::Atoi(*Value.TrimStartAndEnd()) * 1024);
+		}
+	}
+
+	MethodsBox->GetText().ToString().ParseIntoArray(Values, TEXT(","));
+	for (const FString& Value : Values)
+	{
+		OutOptions.Methods.Add(*Value.TrimStartAndEnd());
+	}
+}
+
+void SPakRecompressionView::LoadConfig()
+{
+	FString BlockSizes = TEXT("64, 128, 256");
+	FString Methods;
+
+	GConfig->GetString(TEXT("UnrealPakViewer"), TEXT("RecompressionBlockSizes"), BlockSizes, GGameIni);
+	GConfig->GetString(TEXT("UnrealPakViewer"), TEXT("RecompressionMethods"), Methods, GGameIni);
+
+	BlockSizesBox->SetText(FText::FromString(BlockSizes));
+	MethodsBox->SetText(FText::FromString(Methods));
+}
+
+void SPakRecompressionView::SaveConfig()
+{
+	GConfig->SetString(TEXT("UnrealPakViewer"), TEXT("RecompressionBlockSizes"), *BlockSizesBox->GetText().ToString(), GGameIni);
+	GConfig->SetString(TEXT("UnrealPakViewer"), TEXT("RecompressionMethods"), *MethodsBox->GetText().ToString(), GGameIni);
+
+	GConfig->Flush(false, GGameIni);
+}
+
+void SPakRecompressionView::OnLoadPakFinished()
+{
+	// Files of the old paks are gone, loading canceled any running estimate
+	Files.Empty();
+	Result.Reset();
+	FillItems();
+}
+
+void SPakRecompressionView::OnEstimateFinished(TSharedPtr<FRecompressionResult> InResult)
+{
+	// Null when canceled or failed, the log has the reason
+	Result = InResult;
+	EstimateCost = FPlatformTime::Seconds() - EstimateStartTime;
+
+	FillItems();
+}
+
+#undef LOCTEXT_NAMESPACE
@@ -0,0 +1,91 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Widgets/Input/SSpinBox.h"
+#include "Widgets/SCompoundWidget.h"
+#include "Widgets/Views/SListView.h"
+
+#include "PakFileEntry.h"
+
+/** One method and block size of a group. */
+struct FRecompressionItem
+{
+	FString Name;
+	int32 FileCount = 0;
+	int64 Size = 0;
+	int64 CurrentCompressedSize = 0;
+	FRecompressionEstimate Estimate;
+};
+
+typedef TSharedPtr<FRecompressionItem> FRecompressionItemPtr;
+
+/** Estimates what other compression methods and block sizes would do to the selected files. */
+class SPakRecompressionView : public SCompoundWidget
+{
+public:
+	enum class ERecompressionGrouping : uint8
+	{
+		Total,
+		Folders,
+		Classes,
+	};
+
+	/** Default constructor. */
+	SPakRecompressionView();
+
+	/** Virtual destructor. */
+	virtual ~SPakRecompressionView();
+
+	SLATE_BEGIN_ARGS(SPakRecompressionView) {}
+	SLATE_END_ARGS()
+
+	/** Constructs this widget. */
+	void Construct(const FArguments& InArgs);
+
+	/** Starts estimating in background, ignored while an estimate is running. */
+	void StartEstimate(const TArray<FPakFileEntryPtr>& InFiles);
+
+	static const FName NameColumnName;
+	static const FName MethodColumnName;
+	static const FName BlockSizeColumnName;
+	static const FName FileCountColumnName;
+	static const FName CurrentSizeColumnName;
+	static const FName EstimatedSizeColumnName;
+	static const FName SavingColumnName;
+	static const FName DecompressSpeedColumnName;
+
+protected:
+	TSharedRef<ITableRow> OnGenerateRow(FRecompressionItemPtr InItem, const TSharedRef<class STableViewBase>& OwnerTable);
+	TSharedRef<SWidget> OnGenerateGroupingWidget(TSharedPtr<ERecompressionGrouping> InGrouping) const;
+	void OnGroupingSelectionChanged(TSharedPtr<ERecompressionGrouping> InGrouping, ESelectInfo::Type SelectInfo);
+	FText GetGroupingText(TSharedPtr<ERecompressionGrouping> InGrouping) const;
+	FText GetSelectedGroupingText() const;
+	FText GetSummaryText() const;
+	FReply OnEstimate();
+	FReply OnCancel();
+	bool IsEstimating() const;
+
+	void FillItems();
+	void GetOptions(FRecompressionOptions& OutOptions) const;
+	void LoadConfig();
+	void SaveConfig();
+
+	void OnLoadPakFinished();
+	void OnEstimateFinished(TSharedPtr<FRecompressionResult> InResult);
+
+protected:
+	TSharedPtr<SListView<FRecompressionItemPtr>> ItemListView;
+	TSharedPtr<SSpinBox<float>> SampleBox;
+	TSharedPtr<class SEditableTextBox> BlockSizesBox;
+	TSharedPtr<class SEditableTextBox> MethodsBox;
+
+	TArray<FRecompressionItemPtr> Items;
+	TArray<TSharedPtr<ERecompressionGrouping>> Groupings;
+	TSharedPtr<ERecompressionGrouping> SelectedGrouping;
+
+	TArray<FPakFileEntryPtr> Files;
+	TSharedPtr<FRecompressionResult> Result;
+
+	double EstimateStartTime = 0.0;
+	double EstimateCost = 0.0;
+};
@@ -7,6 +7,7 @@
 #include "Misc/Paths.h"
 #include "Styling/CoreStyle.h"
 #include "Widgets/Layout/SExpandableArea.h"
+#include "Widgets/Notifications/SProgressBar.h"
 #include "Widgets/Views/STableRow.h"
 
 #include "CommonDefines.h"
@@ -110,13 +111,18 @@ protected:
 };
 
 SPakSummaryView::SPakSummaryView()
+	: AssetRegistryLoadProgress(-1.f)
 {
 	FPakAnalyzerDelegates::OnPakLoadFinish.AddRaw(this, &SPakSummaryView::OnLoadPakFinished);
+	FPakAnalyzerDelegates::OnAssetRegistryLoadProgress.AddRaw(this, &SPakSummaryView::OnAssetRegistryLoadProgress);
+	FPakAnalyzerDelegates::OnAssetRegistryLoadFinish.AddRaw(this, &SPakSummaryView::OnAssetRegistryLoadFinish);
 }
 
 SPakSummaryView::~SPakSummaryView()
 {
 	FPakAnalyzerDelegates::OnPakLoadFinish.RemoveAll(this);
+	FPakAnalyzerDelegates::OnAssetRegistryLoadProgress.RemoveAll(this);
+	FPakAnalyzerDelegates::OnAssetRegistryLoadFinish.RemoveAll(this);
 }
 
 void SPakSummaryView::Construct(const FArguments& InArgs)
@@ -209,6 +215,14 @@ void SPakSummaryView::Construct(const FArguments& InArgs)
 				SNew(SEditableTextBox).IsReadOnly(true).Text(this, &SPakSummaryView::GetAssetRegistryPath)
 			]
 
+			+ SHorizontalBox::Slot().AutoWidth().Padding(0.f, 0.f, 5.f, 0.f).VAlign(VAlign_Center)
+			[
+				SNew(SBox).WidthOverride(150.f).Visibility(this, &SPakSummaryView::GetAssetRegistryLoadProgressVisibility)
+				[
+					SNew(SProgressBar).Percent(this, &SPakSummaryView::GetAssetRegistryLoadProgress)
+				]
+			]
+
 			+ SHorizontalBox::Slot().AutoWidth().Padding(0.f, 0.f, 0.f, 0.f).VAlign(VAlign_Center)
 			[
 				SNew(SButton).Text(LOCTEXT("LoadAssetRegistryText", "Load Asset Registry")).OnClicked(this, &SPakSummaryView::OnLoadAssetRegistry).ToolTipText(LOCTEXT("LoadAssetRegistryTipText", "Default in the path: [Your Project Path]/Saved/Cooked/[PLATFORM]/ProjectName"))
@@ -268,14 +282,39 @@ FReply SPakSummaryView::OnLoadAssetRegistry()
 
 	if (bOpened && OutFiles.Num() > 0)
 	{
-		if (PakAnalyzer->LoadAssetRegistry(OutFiles[0]))
+		if (PakAnalyzer->StartLoadAssetRegistry(OutFiles[0]))
 		{
-			FWidgetDelegates::GetOnLoadAssetRegistryFinishedDelegate().Broadcast();
+			AssetRegistryLoadProgress = 0.f;
 		}
 	}
 	return FReply::Handled();
 }
 
+void SPakSummaryView::OnAssetRegistryLoadProgress(float InProgress)
+{
+	AssetRegistryLoadProgress = InProgress;
+}
+
+void SPakSummaryView::OnAssetRegistryLoadFinish(bool bSuccess)
+{
+	AssetRegistryLoadProgress = -1.f;
+
+	if (bSuccess)
+	{
+		FWidgetDelegates::GetOnLoadAssetRegistryFinishedDelegate().Broadcast();
+	}
+}
+
+TOptional<float> SPakSummaryView::GetAssetRegistryLoadProgress() const
+{
+	return AssetRegistryLoadProgress;
+}
+
+EVisibility SPakSummaryView::GetAssetRegistryLoadProgressVisibility() const
+{
+	return AssetRegistryLoadProgress >= 0.f ? EVisibility::Visible : EVisibility::Collapsed;
+}
+
 TSharedRef<ITableRow> SPakSummaryView::OnGenerateSummaryRow(FPakFileSumaryPtr InSummary, const TSharedRef<class STableViewBase>& OwnerTable)
 {
 	return SNew(SSummaryRow, InSummary, OwnerTable);
@@ -27,10 +27,17 @@ protected:
 
 	void OnLoadPakFinished();
 	FReply OnLoadAssetRegistry();
+	void OnAssetRegistryLoadProgress(float InProgress);
+	void OnAssetRegistryLoadFinish(bool bSuccess);
+	TOptional<float> GetAssetRegistryLoadProgress() const;
+	EVisibility GetAssetRegistryLoadProgressVisibility() const;
 
 	TSharedRef<ITableRow> OnGenerateSummaryRow(FPakFileSumaryPtr InSummary, const TSharedRef<class STableViewBase>& OwnerTable);
 
 protected:
 	TSharedPtr<SListView<FPakFileSumaryPtr>> SummaryListView;
 	TArray<FPakFileSumaryPtr> Summaries;
+
+	/** Negative when no asset registry is loading. */
+	float AssetRegistryLoadProgress;
 };
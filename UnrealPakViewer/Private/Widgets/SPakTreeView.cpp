@@ -28,6 +28,7 @@ SPakTreeView::SPakTreeView()
 	FWidgetDelegates::GetOnLoadAssetRegistryFinishedDelegate().AddRaw(this, &SPakTreeView::OnLoadAssetReigstryFinished);
 	FPakAnalyzerDelegates::OnPakLoadFinish.AddRaw(this, &SPakTreeView::OnLoadPakFinished);
 	FPakAnalyzerDelegates::OnAssetParseFinish.AddRaw(this, &SPakTreeView::OnParseAssetFinished);
+	FPakAnalyzerDelegates::OnPackagesParsed.AddRaw(this, &SPakTreeView::OnPackagesParsed);
 }
 
 SPakTreeView::~SPakTreeView()
@@ -35,6 +36,7 @@ SPakTreeView::~SPakTreeView()
 	FWidgetDelegates::GetOnLoadAssetRegistryFinishedDelegate().RemoveAll(this);
 	FPakAnalyzerDelegates::OnPakLoadFinish.RemoveAll(this);
 	FPakAnalyzerDelegates::OnAssetParseFinish.RemoveAll(this);
+	FPakAnalyzerDelegates::OnPackagesParsed.RemoveAll(this);
 }
 
 void SPakTreeView::Construct(const FArguments& InArgs)
@@ -55,6 +57,7 @@ void SPakTreeView::Construct(const FArguments& InArgs)
 			.OnGetChildren(this, &SPakTreeView::OnGetTreeNodeChildren)
 			.OnGenerateRow(this, &SPakTreeView::OnGenerateTreeRow)
 			.OnSelectionChanged(this, &SPakTreeView::OnSelectionChanged)
+			.OnExpansionChanged(this, &SPakTreeView::OnExpansionChanged)
 			.OnContextMenuOpening(this, &SPakTreeView::OnGenerateContextMenu)
 			//.ClearSelectionOnClick(false)
 			//.OnMouseButtonDoubleClick(this, &SUnrealPakViewer::OnTreeItemDoubleClicked)
@@ -290,6 +293,7 @@ void SPakTreeView::OnGetTreeNodeChildren(FPakTreeEntryPtr InParent, TArray<FPakT
 void SPakTreeView::OnSelectionChanged(FPakTreeEntryPtr SelectedItem, ESelectInfo::Type SelectInfo)
 {
 	CurrentSelectedItem = SelectedItem;
+	PrioritizeAssetParse(CurrentSelectedItem);
 
 	KeyValueBox->SetVisibility(CurrentSelectedItem.IsValid() ? EVisibility::SelfHitTestInvisible : EVisibility::Collapsed);
 
@@ -321,6 +325,42 @@ void SPakTreeView::OnSelectionChanged(FPakTreeEntryPtr SelectedItem, ESelectInfo
 	}
 }
 
+void SPakTreeView::OnExpansionChanged(FPakTreeEntryPtr InItem, bool bIsExpanded)
+{
+	if (bIsExpanded)
+	{
+		PrioritizeAssetParse(InItem);
+	}
+}
+
+void SPakTreeView::PrioritizeAssetParse(FPakTreeEntryPtr InItem)
+{
+	IPakAnalyzer* PakAnalyzer = IPakAnalyzerModule::Get().GetPakAnalyzer();
+	if (!PakAnalyzer || !InItem.IsValid())
+	{
+		return;
+	}
+
+	// Only the visible children of a folder, parsing the whole sub tree first would defeat the purpose
+	TArray<FPakFileEntryPtr> Files;
+	if (InItem->bIsDirectory)
+	{
+		for (auto& Pair : InItem->ChildrenMap)
+		{
+			if (!Pair.Value->bIsDirectory)
+			{
+				Files.Add(Pair.Value);
+			}
+		}
+	}
+	else
+	{
+		Files.Add(InItem);
+	}
+
+	PakAnalyzer->PrioritizeAssetParse(Files);
+}
+
 void SPakTreeView::ExpandTreeItem(const FString& InPath, int32 PakIndex)
 {
 	static const TCHAR* Delims[2] = { TEXT("\\"), TEXT("/") };
@@ -494,7 +534,7 @@ TSharedPtr<SWidget> SPakTreeView::OnGenerateContextMenu()
 	{
 		FUIAction Action_Extract
 		(
-			FExecuteAction::CreateSP(this, &SPakTreeView::OnExtractExecute),
+			FExecuteAction::CreateSP(this, &SPakTreeView::OnExtractExecute, false),
 			FCanExecuteAction::CreateSP(this, &SPakTreeView::HasSelection)
 		);
 		MenuBuilder.AddMenuEntry
@@ -503,6 +543,18 @@ TSharedPtr<SWidget> SPakTreeView::OnGenerateContextMenu()
 			LOCTEXT("ContextMenu_Extract_Desc", "Extract current selected file or folder to disk"),
 			FSlateIcon(FUnrealPakViewerStyle::GetStyleSetName(), "Extract"), Action_Extract, NAME_None, EUserInterfaceActionType::Button
 		);
+
+		FUIAction Action_ExtractWithDependencies
+		(
+			FExecuteAction::CreateSP(this, &SPakTreeView::OnExtractExecute, true),
+			FCanExecuteAction::CreateSP(this, &SPakTreeView::HasSelection)
+		);
+		MenuBuilder.AddMenuEntry
+		(
+			LOCTEXT("ContextMenu_ExtractWithDependencies", "Extract With Dependencies..."),
+			LOCTEXT("ContextMenu_ExtractWithDependencies_Desc", "Extract current selected file or folder and all packages they depend on, from every loaded pak"),
+			FSlateIcon(FUnrealPakViewerStyle::GetStyleSetName(), "Extract"), Action_ExtractWithDependencies, NAME_None, EUserInterfaceActionType::Button
+		);
 	}
 	MenuBuilder.EndSection();
 
@@ -517,7 +569,7 @@ TSharedPtr<SWidget> SPakTreeView::OnGenerateContextMenu()
 			FUIAction
 			(
 				FExecuteAction::CreateSP(this, &SPakTreeView::OnExportToJson),
-				FCanExecuteAction::CreateSP(this, &SPakTreeView::HasSelection)
+				FCanExecuteAction::CreateSP(this, &SPakTreeView::CanExport)
 			),
 			NAME_None, EUserInterfaceActionType::Button
 		);
@@ -530,7 +582,33 @@ TSharedPtr<SWidget> SPakTreeView::OnGenerateContextMenu()
 			FUIAction
 			(
 				FExecuteAction::CreateSP(this, &SPakTreeView::OnExportToCsv),
-				FCanExecuteAction::CreateSP(this, &SPakTreeView::HasSelection)
+				FCanExecuteAction::CreateSP(this, &SPakTreeView::CanExport)
+			),
+			NAME_None, EUserInterfaceActionType::Button
+		);
+
+		MenuBuilder.AddMenuEntry
+		(
+			LOCTEXT("ContextMenu_Export_To_Columnar", "Export To Columnar..."),
+			LOCTEXT("ContextMenu_Export_To_Columnar_Desc", "Export selected file(s) info and their dependency edges to columnar binary, for notebooks and data tools"),
+			FSlateIcon(FUnrealPakViewerStyle::GetStyleSetName(), "Export"),
+			FUIAction
+			(
+				FExecuteAction::CreateSP(this, &SPakTreeView::OnExportToColumnar),
+				FCanExecuteAction::CreateSP(this, &SPakTreeView::CanExport)
+			),
+			NAME_None, EUserInterfaceActionType::Button
+		);
+
+		MenuBuilder.AddMenuEntry
+		(
+			LOCTEXT("ContextMenu_Export_To_Sql", "Export To SQLite Script..."),
+			LOCTEXT("ContextMenu_Export_To_Sql_Desc", "Export selected file(s) with their exports, imports and dependencies as a sqlite script, load it with sqlite3 build.db < file.sql"),
+			FSlateIcon(FUnrealPakViewerStyle::GetStyleSetName(), "Export"),
+			FUIAction
+			(
+				FExecuteAction::CreateSP(this, &SPakTreeView::OnExportToSql),
+				FCanExecuteAction::CreateSP(this, &SPakTreeView::CanExport)
 			),
 			NAME_None, EUserInterfaceActionType::Button
 		);
@@ -551,13 +629,39 @@ TSharedPtr<SWidget> SPakTreeView::OnGenerateContextMenu()
 			LOCTEXT("ContextMenu_JumpToFileView_Desc", "Show current selected file in file view"),
 			FSlateIcon(FUnrealPakViewerStyle::GetStyleSetName(), "Find"), Action_JumpToFileView, NAME_None, EUserInterfaceActionType::Button
 		);
+
+		FUIAction Action_EstimateRecompression
+		(
+			FExecuteAction::CreateSP(this, &SPakTreeView::OnEstimateRecompressionExecute),
+			FCanExecuteAction::CreateSP(this, &SPakTreeView::HasSelection)
+		);
+		MenuBuilder.AddMenuEntry
+		(
+			LOCTEXT("ContextMenu_EstimateRecompression", "Estimate Recompression"),
+			LOCTEXT("ContextMenu_EstimateRecompression_Desc", "Recompress current selected file or folder with other methods and block sizes to compare their size"),
+			FSlateIcon(FUnrealPakViewerStyle::GetStyleSetName(), "View"), Action_EstimateRecompression, NAME_None, EUserInterfaceActionType::Button
+		);
 	}
 	MenuBuilder.EndSection();
 
 	return MenuBuilder.MakeWidget();
 }
 
-void SPakTreeView::OnExtractExecute()
+void SPakTreeView::OnEstimateRecompressionExecute()
+{
+	TArray<FPakFileEntryPtr> TargetFiles;
+	TArray<FPakTreeEntryPtr> SelectedItems;
+
+	TreeView->GetSelectedItems(SelectedItems);
+	for (FPakTreeEntryPtr PakTreeEntry : SelectedItems)
+	{
+		RetriveFiles(PakTreeEntry, TargetFiles);
+	}
+
+	FWidgetDelegates::GetOnEstimateRecompressionDelegate().Broadcast(TargetFiles);
+}
+
+void SPakTreeView::OnExtractExecute(bool bWithDependencies)
 {
 	bool bOpened = false;
 	FString OutputPath;
@@ -587,8 +691,15 @@ void SPakTreeView::OnExtractExecute()
 	{
 		RetriveFiles(PakTreeEntry, TargetFiles);
 	}
-	
-	IPakAnalyzerModule::Get().GetPakAnalyzer()->ExtractFiles(OutputPath, TargetFiles);
+
+	if (bWithDependencies)
+	{
+		IPakAnalyzerModule::Get().GetPakAnalyzer()->ExtractFilesWithDependencies(OutputPath, TargetFiles);
+	}
+	else
+	{
+		IPakAnalyzerModule::Get().GetPakAnalyzer()->ExtractFiles(OutputPath, TargetFiles);
+	}
 }
 
 void SPakTreeView::OnJumpToFileViewExecute()
@@ -608,6 +719,11 @@ bool SPakTreeView::HasSelection() const
 	return SelectedItems.Num() > 0;
 }
 
+bool SPakTreeView::CanExport() const
+{
+	return HasSelection() && !IPakAnalyzerModule::Get().GetPakAnalyzer()->IsExporting();
+}
+
 bool SPakTreeView::HasFileSelection() const
 {
 	TArray<FPakTreeEntryPtr> SelectedItems;
@@ -650,7 +766,7 @@ void SPakTreeView::OnExportToJson()
 		RetriveFiles(PakTreeEntry, TargetFiles);
 	}
 
-	IPakAnalyzerModule::Get().GetPakAnalyzer()->ExportToJson(OutFileNames[0], TargetFiles);
+	IPakAnalyzerModule::Get().GetPakAnalyzer()->StartExport(EPakExportFormat::Json, OutFileNames[0], TargetFiles);
 }
 
 void SPakTreeView::OnExportToCsv()
@@ -687,7 +803,81 @@ void SPakTreeView::OnExportToCsv()
 		RetriveFiles(PakTreeEntry, TargetFiles);
 	}
 
-	IPakAnalyzerModule::Get().GetPakAnalyzer()->ExportToCsv(OutFileNames[0], TargetFiles);
+	IPakAnalyzerModule::Get().GetPakAnalyzer()->StartExport(EPakExportFormat::Csv, OutFileNames[0], TargetFiles);
+}
+
+void SPakTreeView::OnExportToColumnar()
+{
+	bool bOpened = false;
+	TArray<FString> OutFileNames;
+
+	IDesktopPlatform* DesktopPlatform = FDesktopPlatformModule::Get();
+	if (DesktopPlatform)
+	{
+		FSlateApplication::Get().CloseToolTip();
+
+		bOpened = DesktopPlatform->SaveFileDialog(
+			FSlateApplication::Get().FindBestParentWindowHandleForDialogs(nullptr),
+			LOCTEXT("OpenExportDialogTitleText", "Select output columnar file path...").ToString(),
+			TEXT(""),
+			TEXT(""),
+			TEXT("Columnar Files (*.upvc)|*.upvc|All Files (*.*)|*.*"),
+			EFileDialogFlags::None,
+			OutFileNames);
+	}
+
+	if (!bOpened || OutFileNames.Num() <= 0)
+	{
+		return;
+	}
+
+	TArray<FPakFileEntryPtr> TargetFiles;
+	TArray<FPakTreeEntryPtr> SelectedItems;
+
+	TreeView->GetSelectedItems(SelectedItems);
+	for (FPakTreeEntryPtr PakTreeEntry : SelectedItems)
+	{
+		RetriveFiles(PakTreeEntry, TargetFiles);
+	}
+
+	IPakAnalyzerModule::Get().GetPakAnalyzer()->StartExport(EPakExportFormat::Columnar, OutFileNames[0], TargetFiles);
+}
+
+void SPakTreeView::OnExportToSql()
+{
+	bool bOpened = false;
+	TArray<FString> OutFileNames;
+
+	IDesktopPlatform* DesktopPlatform = FDesktopPlatformModule::Get();
+	if (DesktopPlatform)
+	{
+		FSlateApplication::Get().CloseToolTip();
+
+		bOpened = DesktopPlatform->SaveFileDialog(
+			FSlateApplication::Get().FindBestParentWindowHandleForDialogs(nullptr),
+			LOCTEXT("OpenExportDialogTitleText", "Select output sql file path...").ToString(),
+			TEXT(""),
+			TEXT(""),
+			TEXT("SQL Files (*.sql)|*.sql|All Files (*.*)|*.*"),
+			EFileDialogFlags::None,
+			OutFileNames);
+	}
+
+	if (!bOpened || OutFileNames.Num() <= 0)
+	{
+		return;
+	}
+
+	TArray<FPakFileEntryPtr> TargetFiles;
+	TArray<FPakTreeEntryPtr> SelectedItems;
+
+	TreeView->GetSelectedItems(SelectedItems);
+	for (FPakTreeEntryPtr PakTreeEntry : SelectedItems)
+	{
+		RetriveFiles(PakTreeEntry, TargetFiles);
+	}
+
+	IPakAnalyzerModule::Get().GetPakAnalyzer()->StartExport(EPakExportFormat::Sql, OutFileNames[0], TargetFiles);
 }
 
 void SPakTreeView::RetriveFiles(FPakTreeEntryPtr InRoot, TArray<FPakFileEntryPtr>& OutFiles)
@@ -745,4 +935,22 @@ void SPakTreeView::OnParseAssetFinished()
 	}
 }
 
+void SPakTreeView::OnPackagesParsed(const TArray<FPakFileEntryPtr>& InFiles)
+{
+	if (!CurrentSelectedItem.IsValid())
+	{
+		return;
+	}
+
+	if (CurrentSelectedItem->bIsDirectory)
+	{
+		// Class aggregates are updated as packages are parsed
+		ClassView->Reload(CurrentSelectedItem);
+	}
+	else if (InFiles.ContainsByPredicate([this](const FPakFileEntryPtr& InFile) { return InFile.Get() == CurrentSelectedItem.Get(); }))
+	{
+		OnSelectionChanged(CurrentSelectedItem, ESelectInfo::Direct);
+	}
+}
+
 #undef LOCTEXT_NAMESPACE
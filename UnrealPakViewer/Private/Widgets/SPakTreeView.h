@@ -45,6 +45,8 @@ protected:
 	
 	/** Called by STreeView when selection has changed. */
 	void OnSelectionChanged(FPakTreeEntryPtr SelectedItem, ESelectInfo::Type SelectInfo);
+	void OnExpansionChanged(FPakTreeEntryPtr InItem, bool bIsExpanded);
+	void PrioritizeAssetParse(FPakTreeEntryPtr InItem);
 
 	void ExpandTreeItem(const FString& InPath, int32 PakIndex);
 
@@ -74,18 +76,23 @@ protected:
 	// Tree View - Context Menu
 	TSharedPtr<SWidget> OnGenerateContextMenu();
 
-	void OnExtractExecute();
+	void OnExtractExecute(bool bWithDependencies);
 	void OnJumpToFileViewExecute();
+	void OnEstimateRecompressionExecute();
 	bool HasSelection() const;
+	bool CanExport() const;
 	bool HasFileSelection() const;
 	void OnExportToJson();
 	void OnExportToCsv();
+	void OnExportToColumnar();
+	void OnExportToSql();
 
 	void RetriveFiles(FPakTreeEntryPtr InRoot, TArray<FPakFileEntryPtr>& OutFiles);
 
 	void OnLoadPakFinished();
 	void OnLoadAssetReigstryFinished();
 	void OnParseAssetFinished();
+	void OnPackagesParsed(const TArray<FPakFileEntryPtr>& InFiles);
 
 protected:
 	TSharedPtr<STreeView<FPakTreeEntryPtr>> TreeView;
@@ -0,0 +1,353 @@
+#include "SPakUnreferencedView.h"
+
+#include "Misc/ConfigCacheIni.h"
+#include "Misc/Paths.h"
+#include "Widgets/Input/SButton.h"
+#include "Widgets/Input/SComboBox.h"
+#include "Widgets/Input/SEditableTextBox.h"
+#include "Widgets/Layout/SBox.h"
+#include "Widgets/SBoxPanel.h"
+#include "Widgets/Text/STextBlock.h"
+#include "Widgets/Views/STableRow.h"
+#include "Widgets/Views/STableViewBase.h"
+
+#include "CommonDefines.h"
+#include "PakAnalyzerModule.h"
+#include "ViewModels/ClassColumn.h"
+#include "ViewModels/WidgetDelegates.h"
+
+#define LOCTEXT_NAMESPACE "SPakUnreferencedView"
+
+const FName SPakUnreferencedView::PackageColumnName(TEXT("Package"));
+const FName SPakUnreferencedView::ClassColumnName(TEXT("Class"));
+const FName SPakUnreferencedView::FileCountColumnName(TEXT("FileCount"));
+const FName SPakUnreferencedView::SizeColumnName(TEXT("Size"));
+const FName SPakUnreferencedView::CompressedSizeColumnName(TEXT("CompressedSize"));
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+// SPakUnreferencedRow
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+class SPakUnreferencedRow : public SMultiColumnTableRow<FUnreferencedPackagePtr>
+{
+	SLATE_BEGIN_ARGS(SPakUnreferencedRow) {}
+	SLATE_END_ARGS()
+
+public:
+	void Construct(const FArguments& InArgs, FUnreferencedPackagePtr InPackage, const TSharedRef<STableViewBase>& InOwnerTableView)
+	{
+		WeakPackage = MoveTemp(InPackage);
+
+		SMultiColumnTableRow<FUnreferencedPackagePtr>::Construct(FSuperRowType::FArguments(), InOwnerTableView);
+	}
+
+	virtual TSharedRef<SWidget> GenerateWidgetForColumn(const FName& ColumnName) override
+	{
+		FUnreferencedPackagePtr PackagePin = WeakPackage.Pin();
+
+		FText Text;
+		FText ToolTip;
+		FSlateColor Color = FLinearColor::White;
+		if (PackagePin.IsValid())
+		{
+			if (ColumnName == SPakUnreferencedView::PackageColumnName)
+			{
+				Text = FText::FromName(PackagePin->PackageName);
+				ToolTip = Text;
+			}
+			else if (ColumnName == SPakUnreferencedView::ClassColumnName)
+			{
+				Text = FText::FromName(PackagePin->Class);
+				Color = FClassColumn::GetColorByClass(*PackagePin->Class.ToString());
+			}
+			else if (ColumnName == SPakUnreferencedView::FileCountColumnName)
+			{
+				Text = FText::AsNumber(PackagePin->Files.Num());
+			}
+			else if (ColumnName == SPakUnreferencedView::SizeColumnName)
+			{
+				Text = FText::AsMemory(PackagePin->Size, EMemoryUnitStandard::IEC);
+				ToolTip = FText::AsNumber(PackagePin->Size);
+			}
+			else if (ColumnName == SPakUnreferencedView::CompressedSizeColumnName)
+			{
+				Text = FText::AsMemory(PackagePin->CompressedSize, EMemoryUnitStandard::IEC);
+				ToolTip = FText::AsNumber(PackagePin->CompressedSize);
+			}
+		}
+
+		return
+			SNew(SBox).Padding(FMargin(4.0, 0.0))
+			[
+				SNew(STextBlock).Text(Text).ToolTipText(ToolTip).ColorAndOpacity(Color)
+			];
+	}
+
+protected:
+	TWeakPtr<FUnreferencedPackage> WeakPackage;
+};
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+// SPakUnreferencedView
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+SPakUnreferencedView::SPakUnreferencedView()
+{
+	FWidgetDelegates::GetOnLoadAssetRegistryFinishedDelegate().AddRaw(this, &SPakUnreferencedView::OnLoadAssetReigstryFinished);
+	FPakAnalyzerDelegates::OnPakLoadFinish.AddRaw(this, &SPakUnreferencedView::OnLoadPakFinished);
+	FPakAnalyzerDelegates::OnAssetParseFinish.AddRaw(this, &SPakUnreferencedView::OnParseAssetFinished);
+}
+
+SPakUnreferencedView::~SPakUnreferencedView()
+{
+	FWidgetDelegates::GetOnLoadAssetRegistryFinishedDelegate().RemoveAll(this);
+	FPakAnalyzerDelegates::OnPakLoadFinish.RemoveAll(this);
+	FPakAnalyzerDelegates::OnAssetParseFinish.RemoveAll(this);
+}
+
+void SPakUnreferencedView::Construct(const FArguments& InArgs)
+{
+	ChildSlot
+	[
+		SNew(SVerticalBox)
+
+		+ SVerticalBox::Slot().AutoHeight().Padding(2.f)
+		[
+			SNew(SHorizontalBox)
+
+			+ SHorizontalBox::Slot().AutoWidth().VAlign(VAlign_Center).Padding(2.f, 0.f)
+			[
+				SNew(STextBlock).Text(LOCTEXT("Scope", "Scope:"))
+			]
+
+			+ SHorizontalBox::Slot().AutoWidth().Padding(2.f, 0.f)
+			[
+				SNew(SBox).WidthOverride(200.f)
+				[
+					SNew(SComboBox<TSharedPtr<int32>>)
+					.OptionsSource(&PakOptions)
+					.OnGenerateWidget(this, &SPakUnreferencedView::OnGeneratePakWidget)
+					.OnSelectionChanged(this, &SPakUnreferencedView::OnPakSelectionChanged)
+					.Content()
+					[
+						SNew(STextBlock).Text(this, &SPakUnreferencedView::GetSelectedPakText)
+					]
+				]
+			]
+
+			+ SHorizontalBox::Slot().FillWidth(1.f).Padding(2.f, 0.f)
+			[
+				SAssignNew(FolderBox, SEditableTextBox)
+				.HintText(LOCTEXT("FolderHint", "Folder, e.g. Game/Content/Maps"))
+				.ToolTipText(LOCTEXT("FolderTip", "Only report files under this folder"))
+			]
+
+			+ SHorizontalBox::Slot().AutoWidth().Padding(2.f, 0.f)
+			[
+				SNew(SButton)
+				.Text(LOCTEXT("Refresh", "Refresh"))
+				.ToolTipText(LOCTEXT("RefreshTip", "Find unreferenced packages again"))
+				.OnClicked(this, &SPakUnreferencedView::OnRefresh)
+			]
+		]
+
+		+ SVerticalBox::Slot().AutoHeight().Padding(2.f)
+		[
+			SNew(SHorizontalBox)
+
+			+ SHorizontalBox::Slot().AutoWidth().VAlign(VAlign_Center).Padding(2.f, 0.f)
+			[
+				SNew(STextBlock).Text(LOCTEXT("Roots", "Roots:"))
+			]
+
+			+ SHorizontalBox::Slot().FillWidth(1.f).Padding(2.f, 0.f)
+			[
+				SAssignNew(RootClassesBox, SEditableTextBox)
+				.HintText(LOCTEXT("RootClassesHint", "Root classes, comma separated"))
+				.ToolTipText(LOCTEXT("RootClassesTip", "Packages of these classes are loaded directly, maps are always roots"))
+			]
+
+			+ SHorizontalBox::Slot().FillWidth(1.f).Padding(2.f, 0.f)
+			[
+				SAssignNew(RootPathsBox, SEditableTextBox)
+				.HintText(LOCTEXT("RootPathsHint", "Root package paths, comma separated"))
+				.ToolTipText(LOCTEXT("RootPathsTip", "Packages under these paths are loaded directly, e.g. primary asset directories"))
+			]
+		]
+
+		+ SVerticalBox::Slot().AutoHeight().Padding(4.f, 2.f)
+		[
+			SNew(STextBlock).Text(this, &SPakUnreferencedView::GetSummaryText)
+		]
+
+		+ SVerticalBox::Slot().FillHeight(1.f)
+		[
+			SAssignNew(PackageListView, SListView<FUnreferencedPackagePtr>)
+			.ItemHeight(20.f)
+			.SelectionMode(ESelectionMode::Single)
+			.ListItemsSource(&Packages)
+			.OnGenerateRow(this, &SPakUnreferencedView::OnGenerateRow)
+			.OnMouseButtonDoubleClick(this, &SPakUnreferencedView::OnPackageDoubleClicked)
+			.HeaderRow
+			(
+				SNew(SHeaderRow)
+				+ SHeaderRow::Column(PackageColumnName).DefaultLabel(LOCTEXT("PackageColumn", "Package")).DefaultTooltip(LOCTEXT("PackageColumnTip", "Package nothing depends on, double click to show it in tree view")).FillWidth(1.f)
+				+ SHeaderRow::Column(ClassColumnName).DefaultLabel(LOCTEXT("ClassColumn", "Class")).ManualWidth(150.f)
+				+ SHeaderRow::Column(FileCountColumnName).DefaultLabel(LOCTEXT("FileCountColumn", "Files")).DefaultTooltip(LOCTEXT("FileCountColumnTip", "File count of the package in scope, .uexp and .ubulk included")).ManualWidth(60.f)
+				+ SHeaderRow::Column(SizeColumnName).DefaultLabel(LOCTEXT("SizeColumn", "Size")).ManualWidth(120.f)
+				+ SHeaderRow::Column(CompressedSizeColumnName).DefaultLabel(LOCTEXT("CompressedSizeColumn", "Compressed Size")).ManualWidth(120.f)
+			)
+		]
+	];
+
+	LoadConfig();
+	FillPakOptions();
+}
+
+void SPakUnreferencedView::Reload()
+{
+	Packages.Empty();
+	TotalCompressedSize = 0;
+
+	FUnreferencedPackageOptions Options;
+	Options.PakIndex = SelectedPak.IsValid() ? *SelectedPak : INDEX_NONE;
+	Options.Folder = FolderBox->GetText().ToString().TrimStartAndEnd();
+
+	TArray<FString> Items;
+	RootClassesBox->GetText().ToString().ParseIntoArray(Items, TEXT(","));
+	for (const FString& Item : Items)
+	{
+		Options.RootClasses.Add(*Item.TrimStartAndEnd());
+	}
+
+	RootPathsBox->GetText().ToString().ParseIntoArray(Items, TEXT(","));
+	for (const FString& Item : Items)
+	{
+		Options.RootPaths.Add(Item.TrimStartAndEnd());
+	}
+
+	IPakAnalyzer* PakAnalyzer = IPakAnalyzerModule::Get().GetPakAnalyzer();
+	if (PakAnalyzer)
+	{
+		PakAnalyzer->GetUnreferencedPackages(Options, Packages);
+	}
+
+	for (const FUnreferencedPackagePtr& Package : Packages)
+	{
+		TotalCompressedSize += Package->CompressedSize;
+	}
+
+	PackageListView->RebuildList();
+}
+
+TSharedRef<ITableRow> SPakUnreferencedView::OnGenerateRow(FUnreferencedPackagePtr InPackage, const TSharedRef<STableViewBase>& OwnerTable)
+{
+	return SNew(SPakUnreferencedRow, InPackage, OwnerTable);
+}
+
+void SPakUnreferencedView::OnPackageDoubleClicked(FUnreferencedPackagePtr InPackage)
+{
+	if (InPackage.IsValid() && InPackage->Files.Num() > 0)
+	{
+		FWidgetDelegates::GetOnSwitchToTreeViewDelegate().Broadcast(InPackage->Files[0]->Path, InPackage->Files[0]->OwnerPakIndex);
+	}
+}
+
+TSharedRef<SWidget> SPakUnreferencedView::OnGeneratePakWidget(TSharedPtr<int32> InPakIndex) const
+{
+	return SNew(STextBlock).Text(GetPakText(InPakIndex));
+}
+
+void SPakUnreferencedView::OnPakSelectionChanged(TSharedPtr<int32> InPakIndex, ESelectInfo::Type SelectInfo)
+{
+	SelectedPak = InPakIndex;
+
+	if (SelectInfo != ESelectInfo::Direct)
+	{
+		Reload();
+	}
+}
+
+FText SPakUnreferencedView::GetPakText(TSharedPtr<int32> InPakIndex) const
+{
+	if (!InPakIndex.IsValid() || *InPakIndex == INDEX_NONE)
+	{
+		return LOCTEXT("AllPaks", "All Paks");
+	}
+
+	const TArray<FPakFileSumaryPtr>& Summaries = IPakAnalyzerModule::Get().GetPakAnalyzer()->GetPakFileSumary();
+	return Summaries.IsValidIndex(*InPakIndex) ? FText::FromString(FPaths::GetCleanFilename(Summaries[*InPakIndex]->PakFilePath)) : FText();
+}
+
+FText SPakUnreferencedView::GetSelectedPakText() const
+{
+	return GetPakText(SelectedPak);
+}
+
+FText SPakUnreferencedView::GetSummaryText() const
+{
+	return FText::Format(LOCTEXT("UnreferencedSummary", "{0} unreferenced packages, {1} compressed in total."), FText::AsNumber(Packages.Num()), FText::AsMemory(TotalCompressedSize, EMemoryUnitStandard::IEC));
+}
+
+FReply SPakUnreferencedView::OnRefresh()
+{
+	SaveConfig();
+	Reload();
+
+	return FReply::Handled();
+}
+
+void SPakUnreferencedView::FillPakOptions()
+{
+	PakOptions.Empty();
+	PakOptions.Add(MakeShared<int32>(INDEX_NONE));
+
+	IPakAnalyzer* PakAnalyzer = IPakAnalyzerModule::Get().GetPakAnalyzer();
+	if (PakAnalyzer)
+	{
+		for (int32 i = 0; i < PakAnalyzer->GetPakFileSumary().Num(); ++i)
+		{
+			PakOptions.Add(MakeShared<int32>(i));
+		}
+	}
+
+	SelectedPak = PakOptions[0];
+}
+
+void SPakUnreferencedView::LoadConfig()
+{
+	FString RootClasses = TEXT("PrimaryAssetLabel");
+	FString RootPaths;
+
+	GConfig->GetString(TEXT("UnrealPakViewer"), TEXT("UnreferencedRootClasses"), RootClasses, GGameIni);
+	GConfig->GetString(TEXT("UnrealPakViewer"), TEXT("UnreferencedRootPaths"), RootPaths, GGameIni);
+
+	RootClassesBox->SetText(FText::FromString(RootClasses));
+	RootPathsBox->SetText(FText::FromString(RootPaths));
+}
+
+void SPakUnreferencedView::SaveConfig()
+{
+	GConfig->SetString(TEXT("UnrealPakViewer"), TEXT("UnreferencedRootClasses"), *RootClassesBox->GetText().ToString(), GGameIni);
+	GConfig->SetString(TEXT("UnrealPakViewer"), TEXT("UnreferencedRootPaths"), *RootPathsBox->GetText().ToString(), GGameIni);
+
+	GConfig->Flush(false, GGameIni);
+}
+
+void SPakUnreferencedView::OnLoadPakFinished()
+{
+	FillPakOptions();
+	Reload();
+}
+
+void SPakUnreferencedView::OnParseAssetFinished()
+{
+	Reload();
+}
+
+void SPakUnreferencedView::OnLoadAssetReigstryFinished()
+{
+	Reload();
+}
+
+#undef LOCTEXT_NAMESPACE
@@ -0,0 +1,62 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Widgets/SCompoundWidget.h"
+#include "Widgets/Views/SListView.h"
+
+#include "PakFileEntry.h"
+
+/** Lists packages nothing depends on, ranked by compressed size. */
+class SPakUnreferencedView : public SCompoundWidget
+{
+public:
+	/** Default constructor. */
+	SPakUnreferencedView();
+
+	/** Virtual destructor. */
+	virtual ~SPakUnreferencedView();
+
+	SLATE_BEGIN_ARGS(SPakUnreferencedView) {}
+	SLATE_END_ARGS()
+
+	/** Constructs this widget. */
+	void Construct(const FArguments& InArgs);
+
+	void Reload();
+
+	static const FName PackageColumnName;
+	static const FName ClassColumnName;
+	static const FName FileCountColumnName;
+	static const FName SizeColumnName;
+	static const FName CompressedSizeColumnName;
+
+protected:
+	TSharedRef<ITableRow> OnGenerateRow(FUnreferencedPackagePtr InPackage, const TSharedRef<class STableViewBase>& OwnerTable);
+	void OnPackageDoubleClicked(FUnreferencedPackagePtr InPackage);
+	TSharedRef<SWidget> OnGeneratePakWidget(TSharedPtr<int32> InPakIndex) const;
+	void OnPakSelectionChanged(TSharedPtr<int32> InPakIndex, ESelectInfo::Type SelectInfo);
+	FText GetPakText(TSharedPtr<int32> InPakIndex) const;
+	FText GetSelectedPakText() const;
+	FText GetSummaryText() const;
+	FReply OnRefresh();
+
+	void FillPakOptions();
+	void LoadConfig();
+	void SaveConfig();
+
+	void OnLoadPakFinished();
+	void OnParseAssetFinished();
+	void OnLoadAssetReigstryFinished();
+
+protected:
+	TSharedPtr<SListView<FUnreferencedPackagePtr>> PackageListView;
+	TSharedPtr<class SEditableTextBox> FolderBox;
+	TSharedPtr<class SEditableTextBox> RootClassesBox;
+	TSharedPtr<class SEditableTextBox> RootPathsBox;
+
+	TArray<FUnreferencedPackagePtr> Packages;
+	TArray<TSharedPtr<int32>> PakOptions;
+	TSharedPtr<int32> SelectedPak;
+
+	int64 TotalCompressedSize = 0;
+};
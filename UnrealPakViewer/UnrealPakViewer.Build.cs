@@ -22,6 +22,7 @@ public class UnrealPakViewer : ModuleRules
 			{
 				"AppFramework",
 				"Core",
+				"CoreUObject",
 				"ApplicationCore",
 				"Slate",
 				"SlateCore",